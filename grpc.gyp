@@ -284,6 +284,7 @@
         'test/core/end2end/tests/simple_metadata.cc',
         'test/core/end2end/tests/simple_request.cc',
         'test/core/end2end/tests/streaming_error_response.cc',
+        'test/core/end2end/tests/subchannel_connection_pool.cc',
         'test/core/end2end/tests/trailing_metadata.cc',
         'test/core/end2end/tests/write_buffering.cc',
         'test/core/end2end/tests/write_buffering_at_end.cc',
@@ -395,11 +396,14 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
         'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -453,6 +457,7 @@
         'src/core/ext/transport/chttp2/transport/bin_encoder.cc',
         'src/core/ext/transport/chttp2/transport/chttp2_transport.cc',
         'src/core/ext/transport/chttp2/transport/context_list.cc',
+        'src/core/ext/transport/chttp2/transport/decode_huff.cc',
         'src/core/ext/transport/chttp2/transport/flow_control.cc',
         'src/core/ext/transport/chttp2/transport/frame_data.cc',
         'src/core/ext/transport/chttp2/transport/frame_goaway.cc',
@@ -473,6 +478,9 @@
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
+        'src/core/ext/transport/shm/shm_endpoint.cc',
+        'src/core/ext/transport/shm/shm_ring.cc',
+        'src/core/ext/transport/shm/shm_transport.cc',
         'src/core/ext/upb-generated/envoy/admin/v3/certs.upb.c',
         'src/core/ext/upb-generated/envoy/admin/v3/clusters.upb.c',
         'src/core/ext/upb-generated/envoy/admin/v3/config_dump.upb.c',
@@ -796,8 +804,11 @@
         'src/core/lib/event_engine/default_event_engine_factory.cc',
         'src/core/lib/event_engine/event_engine.cc',
         'src/core/lib/event_engine/memory_allocator.cc',
+        'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+        'src/core/lib/event_engine/posix_engine/timer_manager.cc',
         'src/core/lib/event_engine/resolved_address.cc',
         'src/core/lib/event_engine/sockaddr.cc',
+        'src/core/lib/event_engine/thread_pool.cc',
         'src/core/lib/gprpp/time.cc',
         'src/core/lib/http/format_request.cc',
         'src/core/lib/http/httpcli.cc',
@@ -832,6 +843,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing_queue.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -840,6 +852,7 @@
         'src/core/lib/iomgr/grpc_if_nametoindex_posix.cc',
         'src/core/lib/iomgr/grpc_if_nametoindex_unsupported.cc',
         'src/core/lib/iomgr/internal_errqueue.cc',
+        'src/core/lib/iomgr/io_uring_linux.cc',
         'src/core/lib/iomgr/iocp_windows.cc',
         'src/core/lib/iomgr/iomgr.cc',
         'src/core/lib/iomgr/iomgr_internal.cc',
@@ -881,6 +894,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
         'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -993,6 +1007,7 @@
         'src/core/lib/surface/server.cc',
         'src/core/lib/surface/validate_metadata.cc',
         'src/core/lib/surface/version.cc',
+        'src/core/lib/transport/bbr_estimator.cc',
         'src/core/lib/transport/bdp_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
@@ -1152,11 +1167,14 @@
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
         'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+        'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
         'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
         'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
+        'src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
         'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
         'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+        'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
         'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
         'src/core/ext/filters/client_channel/lb_policy_registry.cc',
         'src/core/ext/filters/client_channel/local_subchannel_pool.cc',
@@ -1200,6 +1218,7 @@
         'src/core/ext/transport/chttp2/transport/bin_encoder.cc',
         'src/core/ext/transport/chttp2/transport/chttp2_transport.cc',
         'src/core/ext/transport/chttp2/transport/context_list.cc',
+        'src/core/ext/transport/chttp2/transport/decode_huff.cc',
         'src/core/ext/transport/chttp2/transport/flow_control.cc',
         'src/core/ext/transport/chttp2/transport/frame_data.cc',
         'src/core/ext/transport/chttp2/transport/frame_goaway.cc',
@@ -1220,6 +1239,9 @@
         'src/core/ext/transport/chttp2/transport/writing.cc',
         'src/core/ext/transport/inproc/inproc_plugin.cc',
         'src/core/ext/transport/inproc/inproc_transport.cc',
+        'src/core/ext/transport/shm/shm_endpoint.cc',
+        'src/core/ext/transport/shm/shm_ring.cc',
+        'src/core/ext/transport/shm/shm_transport.cc',
         'src/core/ext/upb-generated/google/api/annotations.upb.c',
         'src/core/ext/upb-generated/google/api/http.upb.c',
         'src/core/ext/upb-generated/google/protobuf/any.upb.c',
@@ -1262,8 +1284,11 @@
         'src/core/lib/event_engine/default_event_engine_factory.cc',
         'src/core/lib/event_engine/event_engine.cc',
         'src/core/lib/event_engine/memory_allocator.cc',
+        'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+        'src/core/lib/event_engine/posix_engine/timer_manager.cc',
         'src/core/lib/event_engine/resolved_address.cc',
         'src/core/lib/event_engine/sockaddr.cc',
+        'src/core/lib/event_engine/thread_pool.cc',
         'src/core/lib/gprpp/time.cc',
         'src/core/lib/http/format_request.cc',
         'src/core/lib/http/httpcli.cc',
@@ -1297,6 +1322,7 @@
         'src/core/lib/iomgr/executor.cc',
         'src/core/lib/iomgr/executor/mpmcqueue.cc',
         'src/core/lib/iomgr/executor/threadpool.cc',
+        'src/core/lib/iomgr/executor/work_stealing_queue.cc',
         'src/core/lib/iomgr/fork_posix.cc',
         'src/core/lib/iomgr/fork_windows.cc',
         'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -1305,6 +1331,7 @@
         'src/core/lib/iomgr/grpc_if_nametoindex_posix.cc',
         'src/core/lib/iomgr/grpc_if_nametoindex_unsupported.cc',
         'src/core/lib/iomgr/internal_errqueue.cc',
+        'src/core/lib/iomgr/io_uring_linux.cc',
         'src/core/lib/iomgr/iocp_windows.cc',
         'src/core/lib/iomgr/iomgr.cc',
         'src/core/lib/iomgr/iomgr_internal.cc',
@@ -1346,6 +1373,7 @@
         'src/core/lib/iomgr/timer_generic.cc',
         'src/core/lib/iomgr/timer_heap.cc',
         'src/core/lib/iomgr/timer_manager.cc',
+        'src/core/lib/iomgr/timer_wheel.cc',
         'src/core/lib/iomgr/unix_sockets_posix.cc',
         'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
         'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -1419,6 +1447,7 @@
         'src/core/lib/surface/server.cc',
         'src/core/lib/surface/validate_metadata.cc',
         'src/core/lib/surface/version.cc',
+        'src/core/lib/transport/bbr_estimator.cc',
         'src/core/lib/transport/bdp_estimator.cc',
         'src/core/lib/transport/byte_stream.cc',
         'src/core/lib/transport/connectivity_state.cc',
@@ -1523,6 +1552,7 @@
         'src/cpp/server/server_context.cc',
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
+        'src/cpp/server/work_stealing_thread_pool.cc',
         'src/cpp/server/xds_server_credentials.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
@@ -1647,6 +1677,7 @@
         'src/cpp/server/server_context.cc',
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
+        'src/cpp/server/work_stealing_thread_pool.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
         'src/cpp/util/status.cc',
@@ -231,6 +231,16 @@ typedef struct {
 /** How much data are we willing to queue up per stream if
     GRPC_WRITE_BUFFER_HINT is set? This is an upper bound */
 #define GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE "grpc.http2.write_buffer_size"
+/** How long may the http2 transport hold back a write of stream frames so
+    that frames from other streams can share the same syscall? Only applies
+    while the connection is busy (another write finished within this window);
+    control frames such as pings, settings and resets are never held back.
+    Int valued, milliseconds. Defaults to 0 (disabled). */
+#define GRPC_ARG_HTTP2_WRITE_COALESCE_DELAY_MS \
+  "grpc.http2.write_coalesce_delay_ms"
+/** A held back http2 write is flushed early once this many bytes of messages
+    are queued behind it. Int valued, bytes. Defaults to 64kb. */
+#define GRPC_ARG_HTTP2_WRITE_COALESCE_BYTES "grpc.http2.write_coalesce_bytes"
 /** Should we allow receipt of true-binary data on http2 connections?
     Defaults to on (1) */
 #define GRPC_ARG_HTTP2_ENABLE_TRUE_BINARY "grpc.http2.true_binary"
@@ -440,6 +450,17 @@ typedef struct {
 /** If set, uses a local subchannel pool within the channel. Otherwise, uses the
  * global subchannel pool. */
 #define GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL "grpc.use_local_subchannel_pool"
+/** Maximum number of connections a subchannel may open to its address. When
+ * more than 1, the subchannel opens additional connections once every
+ * connection it has carries GRPC_ARG_SUBCHANNEL_MAX_STREAMS_PER_CONNECTION
+ * calls, and sends each new call on its least loaded connection. Int valued,
+ * defaults to 1. */
+#define GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS "grpc.subchannel_max_connections"
+/** Number of concurrent calls on a connection at which a subchannel considers
+ * it saturated, see GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS. Should usually match
+ * the server's MAX_CONCURRENT_STREAMS setting. Int valued, defaults to 100. */
+#define GRPC_ARG_SUBCHANNEL_MAX_STREAMS_PER_CONNECTION \
+  "grpc.subchannel_max_streams_per_connection"
 /** gRPC Objective-C channel pooling domain string. */
 #define GRPC_ARG_CHANNEL_POOL_DOMAIN "grpc.channel_pooling_domain"
 /** gRPC Objective-C channel pooling id. */
@@ -187,6 +187,22 @@ class CompletionQueue : private grpc::GrpcLibraryCodegen {
                                   GPR_CLOCK_REALTIME)) == GOT_EVENT);
   }
 
+  /// Read up to \a max_events events from the queue, blocking until at least
+  /// one is available or the queue is shut down. Events that are already
+  /// queued behind the first one are returned along with it, which costs less
+  /// per event than calling \a Next for each of them.
+  ///
+  /// \param[out] tags Upon success, the first n entries are updated to point
+  ///        to the events' tags.
+  /// \param[out] oks Upon success, the first n entries are updated to each
+  ///        event's \a ok. See documentation for CompletionQueue::Next for
+  ///        explanation of ok.
+  /// \param[in] max_events The number of entries in \a tags and \a oks.
+  ///
+  /// \return The number n of events read, or 0 if the queue is fully drained
+  ///         and shut down.
+  int NextBatch(void** tags, bool* oks, int max_events);
+
   /// Read from the queue, blocking up to \a deadline (or the queue's shutdown).
   /// Both \a tag and \a ok are updated upon success (if an event is available
   /// within the \a deadline).  A \a tag points to an arbitrary location usually
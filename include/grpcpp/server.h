@@ -247,6 +247,20 @@ class Server : public ServerInterface, private GrpcLibraryCodegen {
     context_allocator_ = std::move(context_allocator);
   }
 
+  /// Ties the sync server's completion queues and then \a cqs to the CPU
+  /// sets in \a cpu_sets, round-robin, and pins sync server threads to the
+  /// CPUs of their queue. Must be called before Start.
+  void BindCompletionQueuesToCpus(
+      const std::vector<std::vector<int>>& cpu_sets,
+      const std::vector<grpc::ServerCompletionQueue*>& cqs);
+
+  /// Has the sync server's pollers hand incoming RPCs over to \a
+  /// worker_threads threads per completion queue, which run the handlers.
+  /// The worker threads are not counted against the resource quota. Zero (the
+  /// default) runs handlers on the polling threads. Must be called before
+  /// Start.
+  void SetSyncServerWorkerThreads(int worker_threads);
+
   void PerformOpsOnCall(internal::CallOpSetInterface* ops,
                         internal::Call* call) override;
 
@@ -228,7 +228,8 @@ class ServerBuilder {
     NUM_CQS,         ///< Number of completion queues.
     MIN_POLLERS,     ///< Minimum number of polling threads.
     MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    CQ_TIMEOUT_MSEC, ///< Completion queue timeout in milliseconds.
+    WORKER_THREADS   ///< Number of threads running handlers, if not pollers.
   };
 
   /// Only useful if this is a Synchronous server.
@@ -282,6 +283,17 @@ class ServerBuilder {
         std::shared_ptr<experimental::AuthorizationPolicyProviderInterface>
             provider);
 
+    /// Binds completion queues to CPUs: queue i is tied to cpu_sets[i % n],
+    /// counting the sync server's queues first and then those added with
+    /// \a AddCompletionQueue(), in order. Calls arriving on a CPU are matched
+    /// first to requests from the queue bound to it, and sync server threads
+    /// are pinned to the CPUs of the queue they poll. Threads that drain the
+    /// async queues should be pinned by the application. Only has an effect
+    /// on Linux.
+    void SetCompletionQueueCpuSets(std::vector<std::vector<int>> cpu_sets) {
+      builder_->cq_cpu_sets_ = std::move(cpu_sets);
+    }
+
    private:
     ServerBuilder* builder_;
   };
@@ -355,7 +367,11 @@ class ServerBuilder {
 
   struct SyncServerSettings {
     SyncServerSettings()
-        : num_cqs(1), min_pollers(1), max_pollers(2), cq_timeout_msec(10000) {}
+        : num_cqs(1),
+          min_pollers(1),
+          max_pollers(2),
+          cq_timeout_msec(10000),
+          worker_threads(0) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -370,6 +386,10 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Number of threads per completion queue that run the RPC handlers,
+    /// taking the RPCs over from the pollers. If zero, pollers run handlers.
+    int worker_threads;
   };
 
   int max_receive_message_size_;
@@ -383,6 +403,9 @@ class ServerBuilder {
   /// List of completion queues added via \a AddCompletionQueue method.
   std::vector<grpc::ServerCompletionQueue*> cqs_;
 
+  /// CPU sets given to \a experimental().SetCompletionQueueCpuSets().
+  std::vector<std::vector<int>> cq_cpu_sets_;
+
   std::shared_ptr<grpc::ServerCredentials> creds_;
   std::vector<std::unique_ptr<grpc::ServerBuilderPlugin>> plugins_;
   grpc_resource_quota* resource_quota_;
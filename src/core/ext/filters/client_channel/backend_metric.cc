@@ -18,12 +18,23 @@
 
 #include "src/core/ext/filters/client_channel/backend_metric.h"
 
+#include <string.h>
+
+#include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
+#include "google/protobuf/duration.upb.h"
 #include "upb/upb.hpp"
 #include "xds/data/orca/v3/orca_load_report.upb.h"
 
+#include <grpc/status.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/debug/trace.h"
+
 namespace grpc_core {
 
+TraceFlag grpc_orca_client_trace(false, "orca_client");
+
 namespace {
 
 template <typename EntryType>
@@ -39,13 +50,106 @@ std::map<absl::string_view, double> ParseMap(
     const auto* entry = entry_func(msg, &i);
     if (entry == nullptr) break;
     upb_StringView key_view = key_func(entry);
-    char* key = static_cast<char*>(arena->Alloc(key_view.size));
-    memcpy(key, key_view.data, key_view.size);
+    const char* key = key_view.data;
+    if (arena != nullptr) {
+      char* copy = static_cast<char*>(arena->Alloc(key_view.size));
+      memcpy(copy, key_view.data, key_view.size);
+      key = copy;
+    }
     result[absl::string_view(key, key_view.size)] = value_func(entry);
   }
   return result;
 }
 
+// Fills in *data from msg.  Map keys are copied onto arena if it is
+// non-null; otherwise they point into the upb arena that msg is on.
+void ParseLoadReport(xds_data_orca_v3_OrcaLoadReport* msg, Arena* arena,
+                     BackendMetricData* data) {
+  data->cpu_utilization = xds_data_orca_v3_OrcaLoadReport_cpu_utilization(msg);
+  data->mem_utilization = xds_data_orca_v3_OrcaLoadReport_mem_utilization(msg);
+  data->requests_per_second = xds_data_orca_v3_OrcaLoadReport_rps(msg);
+  data->request_cost =
+      ParseMap<xds_data_orca_v3_OrcaLoadReport_RequestCostEntry>(
+          msg, xds_data_orca_v3_OrcaLoadReport_request_cost_next,
+          xds_data_orca_v3_OrcaLoadReport_RequestCostEntry_key,
+          xds_data_orca_v3_OrcaLoadReport_RequestCostEntry_value, arena);
+  data->utilization =
+      ParseMap<xds_data_orca_v3_OrcaLoadReport_UtilizationEntry>(
+          msg, xds_data_orca_v3_OrcaLoadReport_utilization_next,
+          xds_data_orca_v3_OrcaLoadReport_UtilizationEntry_key,
+          xds_data_orca_v3_OrcaLoadReport_UtilizationEntry_value, arena);
+}
+
+class OrcaStreamEventHandler : public SubchannelStreamClient::CallEventHandler {
+ public:
+  OrcaStreamEventHandler(
+      Duration report_interval,
+      std::function<void(const BackendMetricData&)> on_report)
+      : report_interval_(report_interval), on_report_(std::move(on_report)) {}
+
+  Slice GetPathLocked() override {
+    return Slice::FromStaticString(
+        "/xds.service.orca.v3.OpenRcaService/StreamCoreMetrics");
+  }
+
+  void OnCallStartLocked(SubchannelStreamClient* /*client*/) override {}
+
+  void OnRetryTimerStartLocked(SubchannelStreamClient* /*client*/) override {}
+
+  grpc_slice EncodeSendMessageLocked() override {
+    // There is no generated code for the ORCA service, so the
+    // OrcaLoadReportRequest is encoded by hand.  The only field we set is
+    // report_interval (field 1), a google.protobuf.Duration, which always
+    // serializes to fewer than 128 bytes and so has a one-byte length.
+    upb::Arena arena;
+    google_protobuf_Duration* duration =
+        google_protobuf_Duration_new(arena.ptr());
+    gpr_timespec timespec = report_interval_.as_timespec();
+    google_protobuf_Duration_set_seconds(duration, timespec.tv_sec);
+    google_protobuf_Duration_set_nanos(duration, timespec.tv_nsec);
+    size_t buf_length;
+    char* buf =
+        google_protobuf_Duration_serialize(duration, arena.ptr(), &buf_length);
+    grpc_slice request_slice = GRPC_SLICE_MALLOC(buf_length + 2);
+    uint8_t* p = GRPC_SLICE_START_PTR(request_slice);
+    p[0] = 0x0a;  // Field 1, length-delimited.
+    p[1] = static_cast<uint8_t>(buf_length);
+    memcpy(p + 2, buf, buf_length);
+    return request_slice;
+  }
+
+  absl::Status RecvMessageReadyLocked(
+      SubchannelStreamClient* /*client*/,
+      absl::string_view serialized_message) override {
+    upb::Arena arena;
+    xds_data_orca_v3_OrcaLoadReport* msg =
+        xds_data_orca_v3_OrcaLoadReport_parse(
+            serialized_message.data(), serialized_message.size(), arena.ptr());
+    if (msg == nullptr) {
+      return absl::InvalidArgumentError("cannot parse ORCA load report");
+    }
+    BackendMetricData data;
+    ParseLoadReport(msg, nullptr, &data);
+    on_report_(data);
+    return absl::OkStatus();
+  }
+
+  void RecvTrailingMetadataReadyLocked(SubchannelStreamClient* client,
+                                       grpc_status_code status) override {
+    // The stream client gives up on UNIMPLEMENTED.
+    if (status == GRPC_STATUS_UNIMPLEMENTED) {
+      gpr_log(GPR_ERROR,
+              "OrcaClient %p: ORCA stream returned UNIMPLEMENTED; no "
+              "out-of-band load reports will be received",
+              client);
+    }
+  }
+
+ private:
+  const Duration report_interval_;
+  std::function<void(const BackendMetricData&)> on_report_;
+};
+
 }  // namespace
 
 const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData*
@@ -57,23 +161,20 @@ ParseBackendMetricData(const Slice& serialized_load_report, Arena* arena) {
   if (msg == nullptr) return nullptr;
   auto* backend_metric_data = arena->New<
       LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData>();
-  backend_metric_data->cpu_utilization =
-      xds_data_orca_v3_OrcaLoadReport_cpu_utilization(msg);
-  backend_metric_data->mem_utilization =
-      xds_data_orca_v3_OrcaLoadReport_mem_utilization(msg);
-  backend_metric_data->requests_per_second =
-      xds_data_orca_v3_OrcaLoadReport_rps(msg);
-  backend_metric_data->request_cost =
-      ParseMap<xds_data_orca_v3_OrcaLoadReport_RequestCostEntry>(
-          msg, xds_data_orca_v3_OrcaLoadReport_request_cost_next,
-          xds_data_orca_v3_OrcaLoadReport_RequestCostEntry_key,
-          xds_data_orca_v3_OrcaLoadReport_RequestCostEntry_value, arena);
-  backend_metric_data->utilization =
-      ParseMap<xds_data_orca_v3_OrcaLoadReport_UtilizationEntry>(
-          msg, xds_data_orca_v3_OrcaLoadReport_utilization_next,
-          xds_data_orca_v3_OrcaLoadReport_UtilizationEntry_key,
-          xds_data_orca_v3_OrcaLoadReport_UtilizationEntry_value, arena);
+  ParseLoadReport(msg, arena, backend_metric_data);
   return backend_metric_data;
 }
 
+OrphanablePtr<SubchannelStreamClient> MakeOrcaClient(
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties, Duration report_interval,
+    std::function<void(const BackendMetricData&)> on_report) {
+  return MakeOrphanable<SubchannelStreamClient>(
+      std::move(connected_subchannel), interested_parties,
+      absl::make_unique<OrcaStreamEventHandler>(report_interval,
+                                                std::move(on_report)),
+      GRPC_TRACE_FLAG_ENABLED(grpc_orca_client_trace) ? "OrcaClient"
+                                                      : nullptr);
+}
+
 }  // namespace grpc_core
@@ -19,9 +19,17 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <functional>
+
 #include <grpc/slice.h>
 
+#include "src/core/ext/filters/client_channel/backend_metric_data.h"
 #include "src/core/ext/filters/client_channel/lb_policy.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/ext/filters/client_channel/subchannel_stream_client.h"
+#include "src/core/lib/gprpp/orphanable.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice.h"
 
@@ -32,6 +40,14 @@ namespace grpc_core {
 const LoadBalancingPolicy::BackendMetricAccessor::BackendMetricData*
 ParseBackendMetricData(const Slice& serialized_load_report, Arena* arena);
 
+// Starts an ORCA stream on connected_subchannel that asks the backend for a
+// load report every report_interval, and passes each report it receives to
+// on_report.  on_report is called with the stream's lock held.
+OrphanablePtr<SubchannelStreamClient> MakeOrcaClient(
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel,
+    grpc_pollset_set* interested_parties, Duration report_interval,
+    std::function<void(const BackendMetricData&)> on_report);
+
 }  // namespace grpc_core
 
 #endif /* GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_BACKEND_METRIC_H */
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include <set>
+#include <thread>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/numbers.h"
@@ -475,6 +476,11 @@ class ClientChannel::SubchannelWrapper : public SubchannelInterface {
               chand_, this, subchannel_.get());
     }
     chand_->subchannel_wrappers_.erase(this);
+    // The subchannel may be shared with other channels, so it must not keep
+    // reporting to watchers that the LB policy has left behind.
+    for (OobBackendMetricWatcherInterface* watcher : oob_watchers_) {
+      subchannel_->CancelOobBackendMetricWatch(watcher);
+    }
     if (chand_->channelz_node_ != nullptr) {
       auto* subchannel_node = subchannel_->channelz_node();
       if (subchannel_node != nullptr) {
@@ -519,6 +525,20 @@ class ClientChannel::SubchannelWrapper : public SubchannelInterface {
     watcher_map_.erase(it);
   }
 
+  void WatchOobBackendMetrics(
+      Duration report_interval,
+      std::unique_ptr<OobBackendMetricWatcherInterface> watcher) override
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(*chand_->work_serializer_) {
+    oob_watchers_.insert(watcher.get());
+    subchannel_->WatchOobBackendMetrics(report_interval, std::move(watcher));
+  }
+
+  void CancelOobBackendMetricWatch(OobBackendMetricWatcherInterface* watcher)
+      override ABSL_EXCLUSIVE_LOCKS_REQUIRED(*chand_->work_serializer_) {
+    if (oob_watchers_.erase(watcher) == 0) return;
+    subchannel_->CancelOobBackendMetricWatch(watcher);
+  }
+
   RefCountedPtr<ConnectedSubchannel> connected_subchannel() const {
     return subchannel_->connected_subchannel();
   }
@@ -667,6 +687,10 @@ class ClientChannel::SubchannelWrapper : public SubchannelInterface {
   // corresponding WrapperWatcher to cancel on the underlying subchannel.
   std::map<ConnectivityStateWatcherInterface*, WatcherWrapper*> watcher_map_
       ABSL_GUARDED_BY(*chand_->work_serializer_);
+  // Out-of-band backend metric watchers that the LB policy has started and
+  // not yet cancelled.
+  std::set<OobBackendMetricWatcherInterface*> oob_watchers_
+      ABSL_GUARDED_BY(*chand_->work_serializer_);
 };
 
 //
@@ -1610,9 +1634,10 @@ void ClientChannel::UpdateStateAndPickerLocked(
   // Grab data plane lock to update the picker.
   {
     MutexLock lock(&data_plane_mu_);
-    // Swap out the picker.
-    // Note: Original value will be destroyed after the lock is released.
-    picker_.swap(picker);
+    // Publish the new picker.  Picks that see the old one and need to be
+    // queued take the lock and re-pick, so none of them can miss the
+    // re-processing below.
+    picker_.Publish(std::move(picker));
     // Re-process queued picks.
     for (LbQueuedCall* call = lb_queued_calls_; call != nullptr;
          call = call->next) {
@@ -1631,6 +1656,9 @@ void ClientChannel::UpdateStateAndPickerLocked(
       }
     }
   }
+  // The previous picker is destroyed once the picks still using it are done,
+  // outside of the lock.
+  picker = picker_.RetirePrevious();
 }
 
 namespace {
@@ -1673,8 +1701,8 @@ grpc_error_handle ClientChannel::DoPingLocked(grpc_transport_op* op) {
   }
   LoadBalancingPolicy::PickResult result;
   {
-    MutexLock lock(&data_plane_mu_);
-    result = picker_->Pick(LoadBalancingPolicy::PickArgs());
+    PickerSlots::Reader reader(&picker_);
+    result = reader.picker()->Pick(LoadBalancingPolicy::PickArgs());
   }
   return HandlePickResult<grpc_error_handle>(
       &result,
@@ -1791,6 +1819,44 @@ void ClientChannel::GetChannelInfo(grpc_channel_element* elem,
   }
 }
 
+//
+// ClientChannel::PickerSlots
+//
+
+ClientChannel::PickerSlots::Reader::Reader(PickerSlots* slots) {
+  // Once registered with a slot that is still current, the writer will
+  // wait for us before reusing it: it makes the other slot current before
+  // checking for readers, and the sequentially consistent accesses on both
+  // sides mean that either we see that or it sees us.
+  while (true) {
+    slot_ = slots->current_.load(std::memory_order_acquire);
+    slot_->readers.fetch_add(1);
+    if (slots->current_.load() == slot_) return;
+    slot_->readers.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+void ClientChannel::PickerSlots::Publish(
+    std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker) {
+  Slot* current = current_.load(std::memory_order_relaxed);
+  Slot* next = Other(current);
+  GPR_DEBUG_ASSERT(next->picker == nullptr);
+  next->picker = std::move(picker);
+  next->generation = current->generation + 1;
+  current_.store(next);
+}
+
+std::unique_ptr<LoadBalancingPolicy::SubchannelPicker>
+ClientChannel::PickerSlots::RetirePrevious() {
+  Slot* previous = Other(current_.load());
+  // Picks do not block, so this only waits for the few that read the old
+  // picker just before it was replaced.
+  while (previous->readers.load(std::memory_order_acquire) != 0) {
+    std::this_thread::yield();
+  }
+  return std::move(previous->picker);
+}
+
 void ClientChannel::AddLbQueuedCall(LbQueuedCall* call,
                                     grpc_polling_entity* pollent) {
   // Add call to queued picks list.
@@ -3122,10 +3188,19 @@ void ClientChannel::LoadBalancedCall::PickDone(void* arg,
 void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
                                                      grpc_error_handle error) {
   auto* self = static_cast<LoadBalancedCall*>(arg);
-  bool pick_complete;
-  {
+  // Most picks complete right away and never need the data plane mutex.
+  uint64_t generation;
+  bool pick_complete = self->PickSubchannelImpl(&error, &generation);
+  if (!pick_complete) {
     MutexLock lock(&self->chand_->data_plane_mu_);
-    pick_complete = self->PickSubchannelLocked(&error);
+    if (self->chand_->picker_.generation() == generation) {
+      // No new picker yet, so the call will be re-picked when there is one.
+      self->MaybeAddCallToLbQueuedCallsLocked();
+    } else {
+      // A new picker came in after our pick and has already re-processed
+      // the queued calls, so try it now.
+      pick_complete = self->PickSubchannelLocked(&error);
+    }
   }
   if (pick_complete) {
     PickDone(self, error);
@@ -3135,8 +3210,23 @@ void ClientChannel::LoadBalancedCall::PickSubchannel(void* arg,
 
 bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
     grpc_error_handle* error) {
+  uint64_t generation;
+  if (PickSubchannelImpl(error, &generation)) {
+    MaybeRemoveCallFromLbQueuedCallsLocked();
+    return true;
+  }
+  MaybeAddCallToLbQueuedCallsLocked();
+  return false;
+}
+
+bool ClientChannel::LoadBalancedCall::PickSubchannelImpl(
+    grpc_error_handle* error, uint64_t* generation) {
   GPR_ASSERT(connected_subchannel_ == nullptr);
   GPR_ASSERT(subchannel_call_ == nullptr);
+  PickerSlots::Reader reader(&chand_->picker_);
+  *generation = reader.generation();
+  // There is no picker while the channel is IDLE; wait for one.
+  if (reader.picker() == nullptr) return false;
   // Grab initial metadata.
   auto& send_initial_metadata =
       pending_batches_[0]->payload->send_initial_metadata;
@@ -3151,93 +3241,81 @@ bool ClientChannel::LoadBalancedCall::PickSubchannelLocked(
   pick_args.call_state = &lb_call_state;
   Metadata initial_metadata(initial_metadata_batch);
   pick_args.initial_metadata = &initial_metadata;
-  auto result = chand_->picker_->Pick(pick_args);
+  auto result = reader.picker()->Pick(pick_args);
   return HandlePickResult<bool>(
       &result,
       // CompletePick
-      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO,
-                      "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
-                      chand_, this, complete_pick->subchannel.get());
-            }
-            GPR_ASSERT(complete_pick->subchannel != nullptr);
-            // Grab a ref to the connected subchannel while we're still
-            // holding the data plane mutex.
-            SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
-                complete_pick->subchannel.get());
-            connected_subchannel_ = subchannel->connected_subchannel();
-            // If the subchannel has no connected subchannel (e.g., if the
-            // subchannel has moved out of state READY but the LB policy hasn't
-            // yet seen that change and given us a new picker), then just
-            // queue the pick.  We'll try again as soon as we get a new picker.
-            if (connected_subchannel_ == nullptr) {
-              if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-                gpr_log(GPR_INFO,
-                        "chand=%p lb_call=%p: subchannel returned by LB picker "
-                        "has no connected subchannel; queueing pick",
-                        chand_, this);
-              }
-              MaybeAddCallToLbQueuedCallsLocked();
-              return false;
-            }
-            lb_subchannel_call_tracker_ =
-                std::move(complete_pick->subchannel_call_tracker);
-            if (lb_subchannel_call_tracker_ != nullptr) {
-              lb_subchannel_call_tracker_->Start();
-            }
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          },
+      [this](LoadBalancingPolicy::PickResult::Complete* complete_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO,
+                  "chand=%p lb_call=%p: LB pick succeeded: subchannel=%p",
+                  chand_, this, complete_pick->subchannel.get());
+        }
+        GPR_ASSERT(complete_pick->subchannel != nullptr);
+        // Grab a ref to the connected subchannel.
+        SubchannelWrapper* subchannel = static_cast<SubchannelWrapper*>(
+            complete_pick->subchannel.get());
+        connected_subchannel_ = subchannel->connected_subchannel();
+        // If the subchannel has no connected subchannel (e.g., if the
+        // subchannel has moved out of state READY but the LB policy hasn't
+        // yet seen that change and given us a new picker), then just
+        // queue the pick.  We'll try again as soon as we get a new picker.
+        if (connected_subchannel_ == nullptr) {
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+            gpr_log(GPR_INFO,
+                    "chand=%p lb_call=%p: subchannel returned by LB picker "
+                    "has no connected subchannel; queueing pick", chand_, this);
+          }
+          return false;
+        }
+        lb_subchannel_call_tracker_ =
+            std::move(complete_pick->subchannel_call_tracker);
+        if (lb_subchannel_call_tracker_ != nullptr) {
+          lb_subchannel_call_tracker_->Start();
+        }
+        return true;
+      },
       // QueuePick
-      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
-                      this);
-            }
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+      [this](LoadBalancingPolicy::PickResult::Queue* /*queue_pick*/) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick queued", chand_,
+                  this);
+        }
+        return false;
+      },
       // FailPick
       [this, send_initial_metadata_flags,
-       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s",
-                      chand_, this, fail_pick->status.ToString().c_str());
-            }
-            // If wait_for_ready is false, then the error indicates the RPC
-            // attempt's final status.
-            if ((send_initial_metadata_flags &
-                 GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
-              grpc_error_handle lb_error =
-                  absl_status_to_grpc_error(fail_pick->status);
-              *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
-                  "Failed to pick subchannel", &lb_error, 1);
-              GRPC_ERROR_UNREF(lb_error);
-              MaybeRemoveCallFromLbQueuedCallsLocked();
-              return true;
-            }
-            // If wait_for_ready is true, then queue to retry when we get a new
-            // picker.
-            MaybeAddCallToLbQueuedCallsLocked();
-            return false;
-          },
+       &error](LoadBalancingPolicy::PickResult::Fail* fail_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick failed: %s", chand_,
+                  this, fail_pick->status.ToString().c_str());
+        }
+        // If wait_for_ready is false, then the error indicates the RPC
+        // attempt's final status.
+        if ((send_initial_metadata_flags &
+             GRPC_INITIAL_METADATA_WAIT_FOR_READY) == 0) {
+          grpc_error_handle lb_error =
+              absl_status_to_grpc_error(fail_pick->status);
+          *error = GRPC_ERROR_CREATE_REFERENCING_FROM_STATIC_STRING(
+              "Failed to pick subchannel", &lb_error, 1);
+          GRPC_ERROR_UNREF(lb_error);
+          return true;
+        }
+        // If wait_for_ready is true, then queue to retry when we get a new
+        // picker.
+        return false;
+      },
       // DropPick
-      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick)
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_) {
-            if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
-              gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s",
-                      chand_, this, drop_pick->status.ToString().c_str());
-            }
-            *error =
-                grpc_error_set_int(absl_status_to_grpc_error(drop_pick->status),
-                                   GRPC_ERROR_INT_LB_POLICY_DROP, 1);
-            MaybeRemoveCallFromLbQueuedCallsLocked();
-            return true;
-          });
+      [this, &error](LoadBalancingPolicy::PickResult::Drop* drop_pick) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_client_channel_lb_call_trace)) {
+          gpr_log(GPR_INFO, "chand=%p lb_call=%p: LB pick dropped: %s", chand_,
+                  this, drop_pick->status.ToString().c_str());
+        }
+        *error =
+            grpc_error_set_int(absl_status_to_grpc_error(drop_pick->status),
+                               GRPC_ERROR_INT_LB_POLICY_DROP, 1);
+        return true;
+      });
 }
 
 }  // namespace grpc_core
@@ -19,6 +19,9 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stdint.h>
+
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -199,6 +202,60 @@ class ClientChannel {
     LbQueuedCall* next = nullptr;
   };
 
+  // Holds the channel's current LB picker so that picks can use it without
+  // taking data_plane_mu_. The picker lives in one of two slots, and each
+  // pick registers with the slot it reads. Publish() fills the other slot
+  // and makes it current; RetirePrevious() then waits for the picks still
+  // using the replaced picker before handing it back to be destroyed.
+  // Publish() and RetirePrevious() are called in turn, serialized by the
+  // caller.
+  class PickerSlots {
+   private:
+    struct Slot {
+      std::atomic<size_t> readers{0};
+      std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker;
+      // Number of pickers published before this one.
+      uint64_t generation = 0;
+    };
+
+   public:
+    // Keeps the current picker alive for as long as it exists.
+    class Reader {
+     public:
+      explicit Reader(PickerSlots* slots);
+      ~Reader() { slot_->readers.fetch_sub(1, std::memory_order_release); }
+
+      Reader(const Reader&) = delete;
+      Reader& operator=(const Reader&) = delete;
+
+      LoadBalancingPolicy::SubchannelPicker* picker() const {
+        return slot_->picker.get();
+      }
+      uint64_t generation() const { return slot_->generation; }
+
+     private:
+      Slot* slot_;
+    };
+
+    void Publish(
+        std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker);
+    std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> RetirePrevious();
+
+    // Generation of the current picker. Only stable while Publish() cannot
+    // run, i.e. while holding data_plane_mu_.
+    uint64_t generation() const {
+      return current_.load(std::memory_order_relaxed)->generation;
+    }
+
+   private:
+    Slot* Other(Slot* slot) {
+      return slot == &slots_[0] ? &slots_[1] : &slots_[0];
+    }
+
+    Slot slots_[2];
+    std::atomic<Slot*> current_{&slots_[0]};
+  };
+
   ClientChannel(grpc_channel_element_args* args, grpc_error_handle* error);
   ~ClientChannel();
 
@@ -302,8 +359,8 @@ class ClientChannel {
   // Fields used in the data plane.  Guarded by data_plane_mu_.
   //
   mutable Mutex data_plane_mu_;
-  std::unique_ptr<LoadBalancingPolicy::SubchannelPicker> picker_
-      ABSL_GUARDED_BY(data_plane_mu_);
+  // Published under data_plane_mu_, but read without it.
+  PickerSlots picker_;
   // Linked list of calls queued waiting for LB pick.
   LbQueuedCall* lb_queued_calls_ ABSL_GUARDED_BY(data_plane_mu_) = nullptr;
 
@@ -378,10 +435,12 @@ class ClientChannel::LoadBalancedCall
 
   void StartTransportStreamOpBatch(grpc_transport_stream_op_batch* batch);
 
-  // Invoked by channel for queued LB picks when the picker is updated.
+  // Performs the call's first LB pick.  Only takes the data plane mutex if
+  // the call needs to be queued.
   static void PickSubchannel(void* arg, grpc_error_handle error);
   // Helper function for performing an LB pick while holding the data plane
-  // mutex.  Returns true if the pick is complete, in which case the caller
+  // mutex, which adds the call to or removes it from the queued picks.
+  // Returns true if the pick is complete, in which case the caller
   // must invoke PickDone() or AsyncPickDone() with the returned error.
   bool PickSubchannelLocked(grpc_error_handle* error)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&ClientChannel::data_plane_mu_);
@@ -436,6 +495,10 @@ class ClientChannel::LoadBalancedCall
   void RecordCallCompletion(absl::Status status);
 
   void CreateSubchannelCall();
+  // Performs an LB pick with the current picker, whose generation is
+  // returned in \a generation.  Returns true if the pick is complete, false
+  // if the call should be queued until there is a new picker.
+  bool PickSubchannelImpl(grpc_error_handle* error, uint64_t* generation);
   // Invoked when a pick is completed, on both success or failure.
   static void PickDone(void* arg, grpc_error_handle error);
   // Removes the call from the channel's list of queued picks if present.
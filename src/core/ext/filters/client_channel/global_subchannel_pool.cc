@@ -21,6 +21,7 @@
 #include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
 
 #include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/gprpp/debug_location.h"
 
 namespace grpc_core {
 
@@ -29,35 +30,65 @@ RefCountedPtr<GlobalSubchannelPool> GlobalSubchannelPool::instance() {
   return p->Ref();
 }
 
+GlobalSubchannelPool::SubchannelMap GlobalSubchannelPool::PublishLocked(
+    size_t shard, const SubchannelMap& map) {
+  LockedMap* read_shard = &read_shards_[shard];
+  MutexLock lock(&read_shard->mu);
+  SubchannelMap old_map = std::move(read_shard->map);
+  read_shard->map = map;
+  return old_map;
+}
+
 RefCountedPtr<Subchannel> GlobalSubchannelPool::RegisterSubchannel(
     const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it != subchannel_map_.end()) {
-    RefCountedPtr<Subchannel> existing = it->second->RefIfNonZero();
-    if (existing != nullptr) return existing;
+  const size_t shard = ShardIndex(key);
+  LockedMap* write_shard = &write_shards_[shard];
+  // Declared before the lock so that they are destroyed after it is
+  // released.
+  SubchannelMap old_write_map;
+  SubchannelMap old_read_map;
+  MutexLock lock(&write_shard->mu);
+  const WeakRefCountedPtr<Subchannel>* existing =
+      write_shard->map.Lookup(key);
+  if (existing != nullptr) {
+    RefCountedPtr<Subchannel> subchannel = (*existing)->RefIfNonZero();
+    if (subchannel != nullptr) return subchannel;
   }
-  subchannel_map_[key] = constructed.get();
+  old_write_map = write_shard->map;
+  write_shard->map = write_shard->map.Add(
+      MapKey(key), constructed->WeakRef(DEBUG_LOCATION, "subchannel_pool"));
+  old_read_map = PublishLocked(shard, write_shard->map);
   return constructed;
 }
 
 void GlobalSubchannelPool::UnregisterSubchannel(const SubchannelKey& key,
                                                 Subchannel* subchannel) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
+  const size_t shard = ShardIndex(key);
+  LockedMap* write_shard = &write_shards_[shard];
+  SubchannelMap old_write_map;
+  SubchannelMap old_read_map;
+  MutexLock lock(&write_shard->mu);
+  const WeakRefCountedPtr<Subchannel>* existing =
+      write_shard->map.Lookup(key);
   // delete only if key hasn't been re-registered to a different subchannel
   // between strong-unreffing and unregistration of subchannel.
-  if (it != subchannel_map_.end() && it->second == subchannel) {
-    subchannel_map_.erase(it);
-  }
+  if (existing == nullptr || existing->get() != subchannel) return;
+  old_write_map = write_shard->map;
+  write_shard->map = write_shard->map.Remove(key);
+  old_read_map = PublishLocked(shard, write_shard->map);
 }
 
 RefCountedPtr<Subchannel> GlobalSubchannelPool::FindSubchannel(
     const SubchannelKey& key) {
-  MutexLock lock(&mu_);
-  auto it = subchannel_map_.find(key);
-  if (it == subchannel_map_.end()) return nullptr;
-  return it->second->RefIfNonZero();
+  LockedMap* read_shard = &read_shards_[ShardIndex(key)];
+  SubchannelMap map;
+  {
+    MutexLock lock(&read_shard->mu);
+    map = read_shard->map;
+  }
+  const WeakRefCountedPtr<Subchannel>* subchannel = map.Lookup(key);
+  if (subchannel == nullptr) return nullptr;
+  return (*subchannel)->RefIfNonZero();
 }
 
 }  // namespace grpc_core
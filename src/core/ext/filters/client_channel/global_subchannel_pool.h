@@ -21,15 +21,27 @@
 
 #include <grpc/support/port_platform.h>
 
-#include <map>
+#include <stddef.h>
+
+#include <array>
+#include <memory>
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
+#include "src/core/lib/avl/avl.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 
 namespace grpc_core {
 
 // The global subchannel pool. It shares subchannels among channels. There
 // should be only one instance of this class.
+//
+// Keys are spread over kShards shards by their precomputed hash, so channels
+// created concurrently rarely contend. Each shard's map is a persistent AVL
+// tree kept twice: writers update the write copy under the write lock and
+// then publish it as the read copy, while readers only hold the read lock
+// long enough to take a reference to the current tree, and search it after
+// releasing the lock.
 class GlobalSubchannelPool final : public SubchannelPoolInterface {
  public:
   // Gets the singleton instance.
@@ -37,22 +49,58 @@ class GlobalSubchannelPool final : public SubchannelPoolInterface {
 
   // Implements interface methods.
   RefCountedPtr<Subchannel> RegisterSubchannel(
-      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+      const SubchannelKey& key, RefCountedPtr<Subchannel> constructed) override;
   void UnregisterSubchannel(const SubchannelKey& key,
-                            Subchannel* subchannel) override
-      ABSL_LOCKS_EXCLUDED(mu_);
-  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override
-      ABSL_LOCKS_EXCLUDED(mu_);
+                            Subchannel* subchannel) override;
+  RefCountedPtr<Subchannel> FindSubchannel(const SubchannelKey& key) override;
 
  private:
+  static constexpr size_t kShards = 127;
+
+  // Every tree update copies the keys on the path it rebuilds, and copying a
+  // SubchannelKey copies its channel args, so the nodes share one copy.
+  class MapKey {
+   public:
+    explicit MapKey(const SubchannelKey& key)
+        : key_(std::make_shared<const SubchannelKey>(key)) {}
+
+    bool operator<(const MapKey& other) const { return *key_ < *other.key_; }
+    bool operator>(const MapKey& other) const { return *other.key_ < *key_; }
+    bool operator<(const SubchannelKey& other) const { return *key_ < other; }
+    bool operator>(const SubchannelKey& other) const { return other < *key_; }
+    friend bool operator<(const SubchannelKey& a, const MapKey& b) {
+      return a < *b.key_;
+    }
+
+   private:
+    std::shared_ptr<const SubchannelKey> key_;
+  };
+
+  // Values are weak refs so that a reader searching a tree that has since
+  // been replaced never touches a freed subchannel.
+  using SubchannelMap = AVL<MapKey, WeakRefCountedPtr<Subchannel>>;
+
+  struct LockedMap {
+    Mutex mu;
+    SubchannelMap map ABSL_GUARDED_BY(mu);
+  };
+
   GlobalSubchannelPool() {}
   ~GlobalSubchannelPool() override {}
 
-  // A map from subchannel key to subchannel.
-  std::map<SubchannelKey, Subchannel*> subchannel_map_ ABSL_GUARDED_BY(mu_);
-  // To protect subchannel_map_.
-  Mutex mu_;
+  static size_t ShardIndex(const SubchannelKey& key) {
+    return key.hash() % kShards;
+  }
+
+  // Replaces the read copy of shard \a shard with \a map. Returns the tree it
+  // replaced, so that the caller drops it (possibly the last ref to a
+  // subchannel) outside of any lock.
+  SubchannelMap PublishLocked(size_t shard, const SubchannelMap& map);
+
+  // Writers serialize on these; lookups never take them.
+  std::array<LockedMap, kShards> write_shards_;
+  // What lookups search.
+  std::array<LockedMap, kShards> read_shards_;
 };
 
 }  // namespace grpc_core
@@ -19,6 +19,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <functional>
 #include <iterator>
 
@@ -27,6 +28,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/types/variant.h"
 
+#include "src/core/ext/filters/client_channel/backend_metric_data.h"
 #include "src/core/ext/filters/client_channel/subchannel_interface.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
@@ -149,25 +151,7 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   /// SubchannelCallTrackerInterface.
   class BackendMetricAccessor {
    public:
-    // Represents backend metrics reported by the backend to the client.
-    struct BackendMetricData {
-      /// CPU utilization expressed as a fraction of available CPU resources.
-      double cpu_utilization;
-      /// Memory utilization expressed as a fraction of available memory
-      /// resources.
-      double mem_utilization;
-      /// Total requests per second being served by the backend.  This
-      /// should include all services that a backend is responsible for.
-      uint64_t requests_per_second;
-      /// Application-specific requests cost metrics.  Metric names are
-      /// determined by the application.  Each value is an absolute cost
-      /// (e.g. 3487 bytes of storage) associated with the request.
-      std::map<absl::string_view, double> request_cost;
-      /// Application-specific resource utilization metrics.  Metric names
-      /// are determined by the application.  Each value is expressed as a
-      /// fraction of total resources available.
-      std::map<absl::string_view, double> utilization;
-    };
+    using BackendMetricData = ::grpc_core::BackendMetricData;
 
     virtual ~BackendMetricAccessor() = default;
 
@@ -267,9 +251,10 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
   /// updates, connectivity state notifications, etc); the latter should
   /// live in the LB policy object itself.
   ///
-  /// Currently, pickers are always accessed from within the
-  /// client_channel data plane mutex, so they do not have to be
-  /// thread-safe.
+  /// Pickers are called from many threads at once without any lock
+  /// held by the client channel, so they must be thread-safe.  A pick
+  /// must not block: the channel waits for the picks still using a
+  /// picker before destroying it.
   class SubchannelPicker {
    public:
     SubchannelPicker() = default;
@@ -413,7 +398,7 @@ class LoadBalancingPolicy : public InternallyRefCounted<LoadBalancingPolicy> {
 
    private:
     RefCountedPtr<LoadBalancingPolicy> parent_;
-    bool exit_idle_called_ = false;
+    std::atomic<bool> exit_idle_called_{false};
   };
 
   // A picker that returns PickResult::Fail for all picks.
@@ -57,6 +57,8 @@
 #include <limits.h>
 #include <string.h>
 
+#include <atomic>
+
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -309,19 +311,18 @@ class GrpcLb : public LoadBalancingPolicy {
     // Returns the LB token to use for a drop, or null if the call
     // should not be dropped.
     //
-    // Note: This is called from the picker, so it will be invoked in
-    // the channel's data plane mutex, NOT the control plane
-    // work_serializer.  It should not be accessed by any other part of the LB
-    // policy.
+    // Note: This is called from the picker, so it may be invoked from
+    // many threads at once, NOT in the control plane work_serializer.  It
+    // should not be accessed by any other part of the LB policy.
     const char* ShouldDrop();
 
    private:
     std::vector<GrpcLbServer> serverlist_;
 
-    // Guarded by the channel's data plane mutex, NOT the control
+    // Updated atomically by concurrent picks, NOT under the control
     // plane work_serializer.  It should not be accessed by anything but the
     // picker via the ShouldDrop() method.
-    size_t drop_index_ = 0;
+    std::atomic<size_t> drop_index_{0};
   };
 
   class Picker : public SubchannelPicker {
@@ -609,8 +610,9 @@ bool GrpcLb::Serverlist::ContainsAllDropEntries() const {
 
 const char* GrpcLb::Serverlist::ShouldDrop() {
   if (serverlist_.empty()) return nullptr;
-  GrpcLbServer& server = serverlist_[drop_index_];
-  drop_index_ = (drop_index_ + 1) % serverlist_.size();
+  GrpcLbServer& server =
+      serverlist_[drop_index_.fetch_add(1, std::memory_order_relaxed) %
+                  serverlist_.size()];
   return server.drop ? server.load_balance_token : nullptr;
 }
 
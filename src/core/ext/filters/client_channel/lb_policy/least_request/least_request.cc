@@ -0,0 +1,688 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_least_request_trace(false, "least_request_lb");
+
+namespace {
+
+//
+// least_request LB policy
+//
+// Each pick looks at choice_count READY subchannels chosen at random and
+// takes the one with the lowest cost, where the cost of a subchannel is its
+// peak-EWMA latency times one more than its number of outstanding calls.
+// The latency estimate jumps up to any slower call right away and decays
+// back towards faster ones over decay_time, so a backend that slows down
+// sheds load immediately and only wins it back gradually.
+//
+
+constexpr char kLeastRequest[] = "least_request";
+
+constexpr uint32_t kDefaultChoiceCount = 2;
+constexpr uint32_t kMaxChoiceCount = 10;
+constexpr Duration kDefaultDecayTime = Duration::Seconds(10);
+
+class LeastRequestConfig : public LoadBalancingPolicy::Config {
+ public:
+  LeastRequestConfig(uint32_t choice_count, Duration decay_time)
+      : choice_count_(choice_count), decay_time_(decay_time) {}
+
+  const char* name() const override { return kLeastRequest; }
+
+  uint32_t choice_count() const { return choice_count_; }
+  Duration decay_time() const { return decay_time_; }
+
+ private:
+  uint32_t choice_count_;
+  Duration decay_time_;
+};
+
+// Load seen on one address.  Shared by the subchannel lists, pickers and
+// call trackers of that address, and carried over to the next subchannel
+// list when an update keeps the address.
+class SubchannelStats : public RefCounted<SubchannelStats> {
+ public:
+  size_t outstanding_calls() const {
+    return outstanding_calls_.load(std::memory_order_relaxed);
+  }
+
+  // Latency estimate in nanoseconds, or 0 if no call has finished yet.
+  double latency_ewma() const {
+    return latency_ewma_.load(std::memory_order_relaxed);
+  }
+
+  void CallStarted() {
+    outstanding_calls_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Records a call that started at \a start.  Failed calls can only raise
+  // the estimate, so that a backend failing fast does not attract traffic.
+  void CallFinished(gpr_timespec start, bool ok, double decay_time_ns) {
+    outstanding_calls_.fetch_sub(1, std::memory_order_relaxed);
+    const gpr_timespec now = gpr_now(GPR_CLOCK_MONOTONIC);
+    const double latency = Nanoseconds(gpr_time_sub(now, start));
+    MutexLock lock(&mu_);
+    double ewma = latency_ewma_.load(std::memory_order_relaxed);
+    if (ewma == 0 || latency > ewma) {
+      ewma = latency;
+    } else if (ok) {
+      const double elapsed = Nanoseconds(gpr_time_sub(now, last_update_));
+      const double w = exp(-elapsed / decay_time_ns);
+      ewma = ewma * w + latency * (1 - w);
+    } else {
+      return;
+    }
+    last_update_ = now;
+    latency_ewma_.store(ewma, std::memory_order_relaxed);
+  }
+
+ private:
+  static double Nanoseconds(gpr_timespec t) {
+    return static_cast<double>(t.tv_sec) * GPR_NS_PER_SEC + t.tv_nsec;
+  }
+
+  std::atomic<size_t> outstanding_calls_{0};
+  std::atomic<double> latency_ewma_{0};
+  Mutex mu_;
+  gpr_timespec last_update_ ABSL_GUARDED_BY(mu_) =
+      gpr_inf_past(GPR_CLOCK_MONOTONIC);
+};
+
+class LeastRequest : public LoadBalancingPolicy {
+ public:
+  explicit LeastRequest(Args args);
+
+  const char* name() const override { return kLeastRequest; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~LeastRequest() override;
+
+  // Forward declaration.
+  class LeastRequestSubchannelList;
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the load stats of the subchannel's address.
+  class LeastRequestSubchannelData
+      : public SubchannelData<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelData(
+        SubchannelList<LeastRequestSubchannelList, LeastRequestSubchannelData>*
+            subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          address_key_(address.address().addr, address.address().len) {}
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    // The raw socket address, which identifies the address across updates.
+    const std::string& address_key() const { return address_key_; }
+
+    const RefCountedPtr<SubchannelStats>& stats() const { return stats_; }
+    void set_stats(RefCountedPtr<SubchannelStats> stats) {
+      stats_ = std::move(stats);
+    }
+
+    // Performs connectivity state updates that need to be done both when we
+    // first start watching and when a watcher notification is received.
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    const std::string address_key_;
+    RefCountedPtr<SubchannelStats> stats_;
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    bool seen_failure_since_ready_ = false;
+  };
+
+  // A list of subchannels.
+  class LeastRequestSubchannelList
+      : public SubchannelList<LeastRequestSubchannelList,
+                              LeastRequestSubchannelData> {
+   public:
+    LeastRequestSubchannelList(LeastRequest* policy, TraceFlag* tracer,
+                               ServerAddressList addresses,
+                               const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, std::move(addresses),
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~LeastRequestSubchannelList() override {
+      LeastRequest* p = static_cast<LeastRequest*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the policy's current subchannel list,
+    // updates the policy's connectivity state based on the subchannel
+    // list's state counters.
+    void MaybeUpdateConnectivityStateLocked();
+
+    // Updates the policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateStateFromSubchannelStateCountsLocked();
+
+   private:
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  // Tracks one call on a subchannel into that subchannel's stats.
+  class CallTracker : public SubchannelCallTrackerInterface {
+   public:
+    CallTracker(RefCountedPtr<SubchannelStats> stats, double decay_time_ns)
+        : stats_(std::move(stats)), decay_time_ns_(decay_time_ns) {}
+
+    ~CallTracker() override {
+      // A call that started but was never finished still has to stop
+      // counting as outstanding.
+      if (in_flight_) {
+        stats_->CallFinished(start_, /*ok=*/false, decay_time_ns_);
+      }
+    }
+
+    void Start() override {
+      start_ = gpr_now(GPR_CLOCK_MONOTONIC);
+      stats_->CallStarted();
+      in_flight_ = true;
+    }
+
+    void Finish(FinishArgs args) override {
+      stats_->CallFinished(start_, args.status.ok(), decay_time_ns_);
+      in_flight_ = false;
+    }
+
+   private:
+    RefCountedPtr<SubchannelStats> stats_;
+    const double decay_time_ns_;
+    gpr_timespec start_;
+    bool in_flight_ = false;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(LeastRequest* parent, LeastRequestSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct Entry {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<SubchannelStats> stats;
+    };
+
+    // Returns true if a is less loaded than b.
+    static bool LessLoaded(const Entry& a, const Entry& b);
+
+    // Using pointer value only, no ref held -- do not dereference!
+    LeastRequest* parent_;
+
+    const uint32_t choice_count_;
+    const double decay_time_ns_;
+    // Random choices are a splitmix64 sequence.  Each pick takes its own
+    // stretch of it with a single atomic add, so picks need no lock.
+    std::atomic<uint64_t> random_state_;
+    absl::InlinedVector<Entry, 10> subchannels_;
+  };
+
+  void ShutdownLocked() override;
+
+  RefCountedPtr<LeastRequestConfig> config_;
+  // List of subchannels.
+  OrphanablePtr<LeastRequestSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  OrphanablePtr<LeastRequestSubchannelList> latest_pending_subchannel_list_;
+  // Stats of the addresses in the latest update, by address.
+  std::map<std::string, RefCountedPtr<SubchannelStats>> stats_;
+};
+
+//
+// LeastRequest::Picker
+//
+
+constexpr uint64_t kSplitMixGamma = 0x9e3779b97f4a7c15ull;
+
+uint64_t SplitMix64(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+LeastRequest::Picker::Picker(LeastRequest* parent,
+                             LeastRequestSubchannelList* subchannel_list)
+    : parent_(parent),
+      choice_count_(parent->config_->choice_count()),
+      decay_time_ns_(static_cast<double>(
+                         parent->config_->decay_time().millis()) *
+                     GPR_NS_PER_MS),
+      random_state_((static_cast<uint64_t>(rand()) << 32) ^ rand()) {
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    LeastRequestSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back({sd->subchannel()->Ref(), sd->stats()});
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels; choice_count=%u",
+            parent_, this, subchannel_list, subchannels_.size(),
+            choice_count_);
+  }
+}
+
+bool LeastRequest::Picker::LessLoaded(const Entry& a, const Entry& b) {
+  const size_t a_calls = a.stats->outstanding_calls();
+  const size_t b_calls = b.stats->outstanding_calls();
+  const double a_latency = a.stats->latency_ewma();
+  const double b_latency = b.stats->latency_ewma();
+  // Until both have a latency estimate, go by outstanding calls alone.
+  if (a_latency == 0 || b_latency == 0) return a_calls < b_calls;
+  return a_latency * (a_calls + 1) < b_latency * (b_calls + 1);
+}
+
+LeastRequest::PickResult LeastRequest::Picker::Pick(PickArgs /*args*/) {
+  const Entry* picked = &subchannels_[0];
+  if (subchannels_.size() > 1) {
+    uint64_t x = random_state_.fetch_add(kSplitMixGamma * choice_count_,
+                                         std::memory_order_relaxed);
+    picked = nullptr;
+    for (uint32_t i = 0; i < choice_count_; ++i) {
+      x += kSplitMixGamma;
+      const Entry& candidate =
+          subchannels_[SplitMix64(x) % subchannels_.size()];
+      if (picked == nullptr || LessLoaded(candidate, *picked)) {
+        picked = &candidate;
+      }
+    }
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO,
+            "[LR %p picker %p] returning index %" PRIuPTR
+            ", subchannel=%p outstanding_calls=%" PRIuPTR
+            " latency_ewma=%.0fns",
+            parent_, this, static_cast<size_t>(picked - &subchannels_[0]),
+            picked->subchannel.get(), picked->stats->outstanding_calls(),
+            picked->stats->latency_ewma());
+  }
+  return PickResult::Complete(
+      picked->subchannel,
+      absl::make_unique<CallTracker>(picked->stats, decay_time_ns_));
+}
+
+//
+// LeastRequest
+//
+
+LeastRequest::LeastRequest(Args args) : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Created", this);
+  }
+}
+
+LeastRequest::~LeastRequest() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Destroying least_request policy", this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void LeastRequest::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(GPR_INFO, "[LR %p] Shutting down", this);
+  }
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+  stats_.clear();
+}
+
+void LeastRequest::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void LeastRequest::LeastRequestSubchannelList::StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateStateFromSubchannelStateCountsLocked();
+}
+
+void LeastRequest::LeastRequestSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the policy's connectivity state and generates a new picker based
+// on the current subchannel list.  Follows the same rules as round_robin.
+void LeastRequest::LeastRequestSubchannelList::
+    MaybeUpdateConnectivityStateLocked() {
+  LeastRequest* p = static_cast<LeastRequest*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  if (num_ready_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    absl::Status status =
+        absl::UnavailableError("connections to all backends failing");
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+  }
+}
+
+void LeastRequest::LeastRequestSubchannelList::
+    UpdateStateFromSubchannelStateCountsLocked() {
+  LeastRequest* p = static_cast<LeastRequest*>(policy());
+  // If we have at least one READY subchannel, then swap to the new list.
+  // Also, if all of the subchannels are in TRANSIENT_FAILURE, then we know
+  // we've tried all of them and failed, so we go ahead and swap over
+  // anyway.
+  if (num_ready_ > 0 || num_transient_failure_ == num_subchannels()) {
+    if (p->subchannel_list_.get() != this) {
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[LR %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  MaybeUpdateConnectivityStateLocked();
+}
+
+void LeastRequest::LeastRequestSubchannelData::UpdateConnectivityStateLocked(
+    grpc_connectivity_state connectivity_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[LR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(last_connectivity_state_),
+        ConnectivityStateName(connectivity_state));
+  }
+  // Once we see a failure, we report TRANSIENT_FAILURE and do not report
+  // any subsequent state changes until we go back into state READY.
+  if (!seen_failure_since_ready_) {
+    if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      seen_failure_since_ready_ = true;
+    }
+    subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                                 connectivity_state);
+  } else {
+    if (connectivity_state == GRPC_CHANNEL_READY) {
+      seen_failure_since_ready_ = false;
+      subchannel_list()->UpdateStateCountersLocked(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, connectivity_state);
+    }
+  }
+  last_connectivity_state_ = connectivity_state;
+}
+
+void LeastRequest::LeastRequestSubchannelData::ProcessConnectivityChangeLocked(
+    grpc_connectivity_state connectivity_state) {
+  LeastRequest* p = static_cast<LeastRequest*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve and attempt to
+  // reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO,
+              "[LR %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  UpdateConnectivityStateLocked(connectivity_state);
+  subchannel_list()->UpdateStateFromSubchannelStateCountsLocked();
+}
+
+void LeastRequest::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace)) {
+      gpr_log(GPR_INFO, "[LR %p] received update with address error: %s", this,
+              args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then ignore the resolver
+    // failure and keep using the existing list.
+    if (subchannel_list_ != nullptr) return;
+  }
+  // Replace latest_pending_subchannel_list_.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_least_request_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO,
+            "[LR %p] Shutting down previous pending subchannel list %p", this,
+            latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<LeastRequestSubchannelList>(
+      this, &grpc_lb_least_request_trace, std::move(addresses), *args.args);
+  // Addresses that were already in the previous update keep their stats,
+  // so that calls still running on the old list count against the new one.
+  std::map<std::string, RefCountedPtr<SubchannelStats>> stats;
+  for (size_t i = 0; i < latest_pending_subchannel_list_->num_subchannels();
+       ++i) {
+    LeastRequestSubchannelData* sd =
+        latest_pending_subchannel_list_->subchannel(i);
+    RefCountedPtr<SubchannelStats>& entry = stats[sd->address_key()];
+    if (entry == nullptr) {
+      auto it = stats_.find(sd->address_key());
+      entry = it != stats_.end() ? std::move(it->second)
+                                 : MakeRefCounted<SubchannelStats>();
+    }
+    sd->set_stats(entry);
+  }
+  stats_ = std::move(stats);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+}
+
+//
+// factory
+//
+
+class LeastRequestFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<LeastRequest>(std::move(args));
+  }
+
+  const char* name() const override { return kLeastRequest; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    std::vector<grpc_error_handle> error_list;
+    uint32_t choice_count = kDefaultChoiceCount;
+    Duration decay_time = kDefaultDecayTime;
+    if (json.type() != Json::Type::OBJECT) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "least_request should be of type object"));
+    } else {
+      const Json::Object& object = json.object_value();
+      if (ParseJsonObjectField(object, "choiceCount", &choice_count,
+                               &error_list, /*required=*/false)) {
+        if (choice_count < 2) {
+          error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+              "field:choiceCount error:must be at least 2"));
+        }
+        // Larger values are allowed but clamped.
+        choice_count = std::min(choice_count, kMaxChoiceCount);
+      }
+      if (ParseJsonObjectFieldAsDuration(object, "decayTime", &decay_time,
+                                         &error_list, /*required=*/false) &&
+          decay_time <= Duration::Zero()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:decayTime error:must be positive"));
+      }
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR("least_request LB policy config",
+                                             &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<LeastRequestConfig>(choice_count, decay_time);
+  }
+};
+
+}  // namespace
+
+void GrpcLbPolicyLeastRequestInit() {
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<LeastRequestFactory>());
+}
+
+void GrpcLbPolicyLeastRequestShutdown() {}
+
+}  // namespace grpc_core
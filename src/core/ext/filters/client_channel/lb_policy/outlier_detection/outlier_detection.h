@@ -0,0 +1,87 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_OUTLIER_DETECTION_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_OUTLIER_DETECTION_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+
+// Parameters of the outlier_detection_experimental LB policy, other than
+// its child policy.  The xDS Cluster resource carries the same parameters,
+// which the cds policy passes down in the policy's config.
+struct OutlierDetectionConfig {
+  // Ejects an address when its success rate over an interval is more than
+  // stdev_factor / 1000 standard deviations below the mean of the addresses
+  // that saw at least request_volume calls, provided that there are at
+  // least minimum_hosts of those.
+  struct SuccessRateEjection {
+    uint32_t stdev_factor = 1900;
+    uint32_t enforcement_percentage = 100;
+    uint32_t minimum_hosts = 5;
+    uint32_t request_volume = 100;
+
+    bool operator==(const SuccessRateEjection& other) const {
+      return stdev_factor == other.stdev_factor &&
+             enforcement_percentage == other.enforcement_percentage &&
+             minimum_hosts == other.minimum_hosts &&
+             request_volume == other.request_volume;
+    }
+  };
+
+  // Ejects an address as soon as threshold calls to it in a row have
+  // failed.
+  struct ConsecutiveFailureEjection {
+    uint32_t threshold = 5;
+    uint32_t enforcement_percentage = 100;
+
+    bool operator==(const ConsecutiveFailureEjection& other) const {
+      return threshold == other.threshold &&
+             enforcement_percentage == other.enforcement_percentage;
+    }
+  };
+
+  // How often success rates are computed and ejections are reconsidered.
+  Duration interval = Duration::Seconds(10);
+  // An address is ejected for base_ejection_time times the number of times
+  // it was ejected recently, but never for longer than the larger of
+  // base_ejection_time and max_ejection_time.
+  Duration base_ejection_time = Duration::Seconds(30);
+  Duration max_ejection_time = Duration::Seconds(300);
+  // No more ejections are made while this share of the addresses is
+  // ejected.
+  uint32_t max_ejection_percent = 10;
+  absl::optional<SuccessRateEjection> success_rate_ejection;
+  absl::optional<ConsecutiveFailureEjection> consecutive_failure_ejection;
+
+  bool operator==(const OutlierDetectionConfig& other) const {
+    return interval == other.interval &&
+           base_ejection_time == other.base_ejection_time &&
+           max_ejection_time == other.max_ejection_time &&
+           max_ejection_percent == other.max_ejection_percent &&
+           success_rate_ejection == other.success_rate_ejection &&
+           consecutive_failure_ejection == other.consecutive_failure_ejection;
+  }
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_OUTLIER_DETECTION_OUTLIER_DETECTION_H
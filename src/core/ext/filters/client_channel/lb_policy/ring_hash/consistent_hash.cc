@@ -0,0 +1,254 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+//
+// HashRing
+//
+
+namespace {
+
+constexpr uint32_t kNoEndpoint = std::numeric_limits<uint32_t>::max();
+
+// Returns the index of each key in keys, or kNoEndpoint for keys that occur
+// more than once.
+absl::flat_hash_map<absl::string_view, uint32_t> IndexUniqueKeys(
+    const std::vector<std::string>& keys) {
+  absl::flat_hash_map<absl::string_view, uint32_t> index_by_key;
+  index_by_key.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    auto it = index_by_key.emplace(keys[i], i);
+    if (!it.second) it.first->second = kNoEndpoint;
+  }
+  return index_by_key;
+}
+
+}  // namespace
+
+HashRing::HashRing(const std::vector<Endpoint>& endpoints,
+                   size_t min_ring_size, size_t max_ring_size,
+                   const HashRing* previous) {
+  GPR_ASSERT(!endpoints.empty());
+  const size_t num_endpoints = endpoints.size();
+  uint64_t sum = 0;
+  for (const Endpoint& endpoint : endpoints) {
+    GPR_ASSERT(endpoint.weight != 0);
+    sum += endpoint.weight;
+  }
+  double min_normalized_weight = 1.0;
+  for (const Endpoint& endpoint : endpoints) {
+    min_normalized_weight = std::min(
+        static_cast<double>(endpoint.weight) / sum, min_normalized_weight);
+  }
+  // Scale up the number of hashes per endpoint such that the least-weighted
+  // endpoint gets a whole number of hashes on the ring.  Other endpoints
+  // might not end up with whole numbers, and that's fine: the running sums
+  // below hand out the fractions in a mostly stable way.  When weights
+  // aren't provided, all endpoints get an equal number of hashes.  If this
+  // exceeds max_ring_size, it's scaled back down to fit.
+  const double scale = std::min(
+      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
+      static_cast<double>(max_ring_size));
+  // Decide the number of entries of each endpoint up front, so that we know
+  // which ones can be copied from the previous ring.
+  keys_.reserve(num_endpoints);
+  counts_.reserve(num_endpoints);
+  size_t ring_size = 0;
+  double current_hashes = 0.0;
+  double target_hashes = 0.0;
+  for (const Endpoint& endpoint : endpoints) {
+    target_hashes += scale * (static_cast<double>(endpoint.weight) / sum);
+    uint32_t count = 0;
+    while (current_hashes < target_hashes) {
+      ++count;
+      ++current_hashes;
+    }
+    keys_.push_back(endpoint.key);
+    counts_.push_back(count);
+    ring_size += count;
+  }
+  // Map each endpoint of the previous ring that can be reused to its index
+  // in this one.  Endpoints whose key is not unique are never reused, since
+  // their entries cannot be told apart.  Matching an endpoint costs about
+  // as much as hashing and sorting a few entries, so this is skipped when
+  // endpoints have only a few entries each.
+  std::vector<uint32_t> new_index_for_previous;
+  std::vector<bool> reused(num_endpoints, false);
+  size_t num_reused_entries = 0;
+  if (previous != nullptr &&
+      ring_size >= 4 * (num_endpoints + previous->keys_.size())) {
+    new_index_for_previous.assign(previous->keys_.size(), kNoEndpoint);
+    absl::flat_hash_map<absl::string_view, uint32_t> index_by_key =
+        IndexUniqueKeys(keys_);
+    for (const auto& p : IndexUniqueKeys(previous->keys_)) {
+      if (p.second == kNoEndpoint) continue;
+      auto it = index_by_key.find(p.first);
+      if (it == index_by_key.end() || it->second == kNoEndpoint) continue;
+      if (previous->counts_[p.second] != counts_[it->second]) continue;
+      new_index_for_previous[p.second] = it->second;
+      reused[it->second] = true;
+      num_reused_entries += counts_[it->second];
+    }
+  }
+  // Hash the entries of the remaining endpoints.  The hash of an entry is
+  // that of "<key>_<n>", where n counts the endpoint's entries from 0.
+  struct Entry {
+    uint64_t hash;
+    uint32_t endpoint_index;
+  };
+  std::vector<Entry> new_entries;
+  new_entries.reserve(ring_size - num_reused_entries);
+  std::string hash_key;
+  for (size_t i = 0; i < num_endpoints; ++i) {
+    if (reused[i]) continue;
+    hash_key.assign(keys_[i]);
+    hash_key.push_back('_');
+    const size_t prefix_length = hash_key.size();
+    for (uint32_t n = 0; n < counts_[i]; ++n) {
+      hash_key.resize(prefix_length);
+      absl::StrAppend(&hash_key, n);
+      new_entries.push_back({XXH64(hash_key.data(), hash_key.size(), 0),
+                             static_cast<uint32_t>(i)});
+    }
+  }
+  std::sort(new_entries.begin(), new_entries.end(),
+            [](const Entry& lhs, const Entry& rhs) {
+              return lhs.hash < rhs.hash;
+            });
+  // Merge the new entries with the ones kept from the previous ring, which
+  // are already sorted.
+  hashes_.reserve(ring_size);
+  endpoint_indexes_.reserve(ring_size);
+  auto next_new_entry = new_entries.begin();
+  if (num_reused_entries > 0) {
+    for (size_t slot = 0; slot < previous->size(); ++slot) {
+      const uint32_t endpoint_index =
+          new_index_for_previous[previous->endpoint_indexes_[slot]];
+      if (endpoint_index == kNoEndpoint) continue;
+      const uint64_t hash = previous->hashes_[slot];
+      for (; next_new_entry != new_entries.end() &&
+             next_new_entry->hash < hash;
+           ++next_new_entry) {
+        hashes_.push_back(next_new_entry->hash);
+        endpoint_indexes_.push_back(next_new_entry->endpoint_index);
+      }
+      hashes_.push_back(hash);
+      endpoint_indexes_.push_back(endpoint_index);
+    }
+  }
+  for (; next_new_entry != new_entries.end(); ++next_new_entry) {
+    hashes_.push_back(next_new_entry->hash);
+    endpoint_indexes_.push_back(next_new_entry->endpoint_index);
+  }
+}
+
+size_t HashRing::Pick(uint64_t hash) const {
+  // The first entry whose hash is not less than the request's, or the first
+  // entry if there is none.  This is what the ketama binary search finds.
+  auto it = std::lower_bound(hashes_.begin(), hashes_.end(), hash);
+  return it == hashes_.end() ? 0 : it - hashes_.begin();
+}
+
+size_t HashRing::SizeInBytes() const {
+  size_t size = hashes_.capacity() * sizeof(uint64_t) +
+                endpoint_indexes_.capacity() * sizeof(uint32_t) +
+                keys_.capacity() * sizeof(std::string) +
+                counts_.capacity() * sizeof(uint32_t);
+  for (const std::string& key : keys_) size += key.capacity();
+  return size;
+}
+
+//
+// MaglevTable
+//
+
+constexpr size_t MaglevTable::kDefaultTableSize;
+constexpr size_t MaglevTable::kMaxTableSize;
+
+MaglevTable::MaglevTable(const std::vector<Endpoint>& endpoints,
+                         size_t table_size) {
+  GPR_ASSERT(!endpoints.empty());
+  GPR_ASSERT(table_size > 1);
+  // The position of an endpoint in the permutations of the slots, along with
+  // how much of the table it is due.
+  struct Permutation {
+    uint64_t offset;
+    uint64_t skip;
+    uint64_t next;
+    double weight;
+    double target_weight;
+  };
+  std::vector<Permutation> permutations;
+  permutations.reserve(endpoints.size());
+  uint64_t sum = 0;
+  for (const Endpoint& endpoint : endpoints) {
+    GPR_ASSERT(endpoint.weight != 0);
+    sum += endpoint.weight;
+  }
+  double max_normalized_weight = 0.0;
+  for (const Endpoint& endpoint : endpoints) {
+    const uint64_t offset_hash =
+        XXH64(endpoint.key.data(), endpoint.key.size(), 0);
+    const uint64_t skip_hash =
+        XXH64(endpoint.key.data(), endpoint.key.size(), 1);
+    const double weight = static_cast<double>(endpoint.weight) / sum;
+    permutations.push_back({offset_hash % table_size,
+                            skip_hash % (table_size - 1) + 1, 0, weight, 0.0});
+    max_normalized_weight = std::max(weight, max_normalized_weight);
+  }
+  // Let the endpoints take turns.  In each round, an endpoint whose weight
+  // is the largest one takes the next free slot of its permutation, and
+  // one with a third of that weight only does so every third round.
+  endpoint_indexes_.assign(table_size, kNoEndpoint);
+  size_t num_filled = 0;
+  for (uint64_t round = 1; num_filled < table_size; ++round) {
+    for (size_t i = 0; i < permutations.size() && num_filled < table_size;
+         ++i) {
+      Permutation& permutation = permutations[i];
+      if (round * permutation.weight < permutation.target_weight) continue;
+      permutation.target_weight += max_normalized_weight;
+      size_t slot;
+      do {
+        slot = (permutation.offset + permutation.skip * permutation.next) %
+               table_size;
+        ++permutation.next;
+      } while (endpoint_indexes_[slot] != kNoEndpoint);
+      endpoint_indexes_[slot] = static_cast<uint32_t>(i);
+      ++num_filled;
+    }
+  }
+}
+
+size_t MaglevTable::SizeInBytes() const {
+  return endpoint_indexes_.capacity() * sizeof(uint32_t);
+}
+
+}  // namespace grpc_core
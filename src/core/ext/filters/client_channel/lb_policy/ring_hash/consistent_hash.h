@@ -0,0 +1,108 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_CONSISTENT_HASH_H
+#define GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_CONSISTENT_HASH_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace grpc_core {
+
+// Maps request hashes onto a list of weighted endpoints, such that adding
+// or removing an endpoint moves only a small share of the hash space.
+//
+// The table is a sequence of slots, each holding the index of an endpoint
+// in the list that the table was built from. Pick() returns the slot for a
+// hash; a caller that cannot use that slot's endpoint walks the slots after
+// it, wrapping around at the end.
+class ConsistentHashTable {
+ public:
+  struct Endpoint {
+    // Places the endpoint in the hash space; typically its address.
+    std::string key;
+    // Relative share of the hash space.  Must not be zero.
+    uint32_t weight;
+  };
+
+  virtual ~ConsistentHashTable() = default;
+
+  // Returns the slot that hash maps to.  The table must not be empty.
+  virtual size_t Pick(uint64_t hash) const = 0;
+
+  // Returns the approximate amount of heap memory held by the table.
+  virtual size_t SizeInBytes() const = 0;
+
+  size_t size() const { return endpoint_indexes_.size(); }
+
+  uint32_t endpoint_index(size_t slot) const {
+    return endpoint_indexes_[slot];
+  }
+
+ protected:
+  std::vector<uint32_t> endpoint_indexes_;
+};
+
+// The ring used by the ring_hash policy.  Each endpoint gets a number of
+// hashes proportional to its weight, and a request hash maps to the first
+// endpoint hash at or after it on the ring.  The ring is stored as two
+// parallel arrays, so that the binary search of a pick only touches the
+// hashes and an entry takes 12 bytes.
+class HashRing : public ConsistentHashTable {
+ public:
+  // Builds a ring of at least min_ring_size and at most max_ring_size
+  // entries.  If previous is set, the entries of endpoints that keep both
+  // their key and their number of entries are copied from it rather than
+  // being hashed and sorted again, which makes a rebuild after a small
+  // change to the endpoints linear in the ring size.  The resulting ring is
+  // the same either way.
+  HashRing(const std::vector<Endpoint>& endpoints, size_t min_ring_size,
+           size_t max_ring_size, const HashRing* previous = nullptr);
+
+  size_t Pick(uint64_t hash) const override;
+  size_t SizeInBytes() const override;
+
+ private:
+  // Sorted; hashes_[i] belongs to the endpoint in endpoint_indexes_[i].
+  std::vector<uint64_t> hashes_;
+  // The key and number of ring entries of each endpoint, for building the
+  // next ring from this one.
+  std::vector<std::string> keys_;
+  std::vector<uint32_t> counts_;
+};
+
+// A Maglev lookup table: a prime number of slots, which the endpoints fill
+// in turns, each in the order of its own permutation of the slots and in
+// proportion to its weight.  A pick is a single modulo, and the table does
+// not grow with the number of endpoints.
+class MaglevTable : public ConsistentHashTable {
+ public:
+  static constexpr size_t kDefaultTableSize = 65537;
+  static constexpr size_t kMaxTableSize = 5000011;
+
+  // table_size must be a prime.
+  MaglevTable(const std::vector<Endpoint>& endpoints, size_t table_size);
+
+  size_t Pick(uint64_t hash) const override { return hash % size(); }
+  size_t SizeInBytes() const override;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_FILTERS_CLIENT_CHANNEL_LB_POLICY_RING_HASH_CONSISTENT_HASH_H
@@ -21,11 +21,10 @@
 
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
-#define XXH_INLINE_ALL
-#include "xxhash.h"
 
 #include <grpc/support/alloc.h>
 
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash.h"
 #include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
 #include "src/core/ext/filters/client_channel/lb_policy_registry.h"
 #include "src/core/ext/filters/client_channel/subchannel.h"
@@ -35,6 +34,7 @@
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/json/json_util.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/transport/error_utils.h"
 
@@ -88,18 +88,28 @@ void ParseRingHashLbConfig(const Json& json, size_t* min_ring_size,
 namespace {
 
 constexpr char kRingHash[] = "ring_hash_experimental";
+constexpr char kMaglev[] = "maglev_experimental";
 
+// Config for both ring_hash_experimental and maglev_experimental, which
+// differ only in how they map request hashes to subchannels.
 class RingHashLbConfig : public LoadBalancingPolicy::Config {
  public:
   RingHashLbConfig(size_t min_ring_size, size_t max_ring_size)
       : min_ring_size_(min_ring_size), max_ring_size_(max_ring_size) {}
-  const char* name() const override { return kRingHash; }
+  explicit RingHashLbConfig(size_t maglev_table_size)
+      : maglev_table_size_(maglev_table_size) {}
+  const char* name() const override {
+    return maglev_table_size_ == 0 ? kRingHash : kMaglev;
+  }
   size_t min_ring_size() const { return min_ring_size_; }
   size_t max_ring_size() const { return max_ring_size_; }
+  // Zero for ring_hash_experimental.
+  size_t maglev_table_size() const { return maglev_table_size_; }
 
  private:
-  size_t min_ring_size_;
-  size_t max_ring_size_;
+  size_t min_ring_size_ = 0;
+  size_t max_ring_size_ = 0;
+  size_t maglev_table_size_ = 0;
 };
 
 //
@@ -108,9 +118,9 @@ class RingHashLbConfig : public LoadBalancingPolicy::Config {
 
 class RingHash : public LoadBalancingPolicy {
  public:
-  explicit RingHash(Args args);
+  RingHash(Args args, const char* name);
 
-  const char* name() const override { return kRingHash; }
+  const char* name() const override { return name_; }
 
   void UpdateLocked(UpdateArgs args) override;
   void ResetBackoffLocked() override;
@@ -207,21 +217,23 @@ class RingHash : public LoadBalancingPolicy {
     size_t num_transient_failure_ = 0;
   };
 
+  // Maps request hashes to the subchannels of a subchannel list, using a
+  // HashRing or, for maglev_experimental, a MaglevTable.
   class Ring : public RefCounted<Ring> {
    public:
-    struct Entry {
-      uint64_t hash;
-      RingHashSubchannelData* subchannel;
-    };
-
     Ring(RingHash* parent,
          RefCountedPtr<RingHashSubchannelList> subchannel_list);
 
-    const std::vector<Entry>& ring() const { return ring_; }
+    const ConsistentHashTable& table() const { return *table_; }
+
+    // Returns the subchannel in the given slot of the table.
+    RingHashSubchannelData* subchannel(size_t slot) const {
+      return subchannel_list_->subchannel(table_->endpoint_index(slot));
+    }
 
    private:
     RefCountedPtr<RingHashSubchannelList> subchannel_list_;
-    std::vector<Entry> ring_;
+    std::unique_ptr<ConsistentHashTable> table_;
   };
 
   class Picker : public SubchannelPicker {
@@ -247,8 +259,8 @@ class RingHash : public LoadBalancingPolicy {
       }
 
       void Orphan() override {
-        // Hop into ExecCtx, so that we're not holding the data plane mutex
-        // while we run control-plane code.
+        // Hop into ExecCtx, so that we're not running control-plane code
+        // from inside a pick.
         ExecCtx::Run(DEBUG_LOCATION, &closure_, GRPC_ERROR_NONE);
       }
 
@@ -278,6 +290,8 @@ class RingHash : public LoadBalancingPolicy {
 
   void ShutdownLocked() override;
 
+  const char* const name_;
+
   // Current config from resolver.
   RefCountedPtr<RingHashLbConfig> config_;
 
@@ -298,99 +312,44 @@ RingHash::Ring::Ring(RingHash* parent,
                      RefCountedPtr<RingHashSubchannelList> subchannel_list)
     : subchannel_list_(std::move(subchannel_list)) {
   size_t num_subchannels = subchannel_list_->num_subchannels();
-  // Store the weights while finding the sum.
-  struct AddressWeight {
-    std::string address;
-    // Default weight is 1 for the cases where a weight is not provided,
-    // each occurrence of the address will be counted a weight value of 1.
-    uint32_t weight = 1;
-    double normalized_weight;
-  };
-  std::vector<AddressWeight> address_weights;
-  size_t sum = 0;
-  address_weights.reserve(num_subchannels);
+  std::vector<ConsistentHashTable::Endpoint> endpoints;
+  endpoints.reserve(num_subchannels);
   for (size_t i = 0; i < num_subchannels; ++i) {
     RingHashSubchannelData* sd = subchannel_list_->subchannel(i);
     const ServerAddressWeightAttribute* weight_attribute = static_cast<
         const ServerAddressWeightAttribute*>(sd->address().GetAttribute(
         ServerAddressWeightAttribute::kServerAddressWeightAttributeKey));
-    AddressWeight address_weight;
-    address_weight.address =
-        grpc_sockaddr_to_string(&sd->address().address(), false);
+    // Default weight is 1 for the cases where a weight is not provided,
+    // each occurrence of the address will be counted a weight value of 1.
+    uint32_t weight = 1;
     if (weight_attribute != nullptr) {
       GPR_ASSERT(weight_attribute->weight() != 0);
-      address_weight.weight = weight_attribute->weight();
-    }
-    sum += address_weight.weight;
-    address_weights.push_back(std::move(address_weight));
-  }
-  // Calculating normalized weights and find min and max.
-  double min_normalized_weight = 1.0;
-  double max_normalized_weight = 0.0;
-  for (auto& address : address_weights) {
-    address.normalized_weight = static_cast<double>(address.weight) / sum;
-    min_normalized_weight =
-        std::min(address.normalized_weight, min_normalized_weight);
-    max_normalized_weight =
-        std::max(address.normalized_weight, max_normalized_weight);
-  }
-  // Scale up the number of hashes per host such that the least-weighted host
-  // gets a whole number of hashes on the ring. Other hosts might not end up
-  // with whole numbers, and that's fine (the ring-building algorithm below can
-  // handle this). This preserves the original implementation's behavior: when
-  // weights aren't provided, all hosts should get an equal number of hashes. In
-  // the case where this number exceeds the max_ring_size, it's scaled back down
-  // to fit.
-  const size_t min_ring_size = parent->config_->min_ring_size();
-  const size_t max_ring_size = parent->config_->max_ring_size();
-  const double scale = std::min(
-      std::ceil(min_normalized_weight * min_ring_size) / min_normalized_weight,
-      static_cast<double>(max_ring_size));
-  // Reserve memory for the entire ring up front.
-  const uint64_t ring_size = std::ceil(scale);
-  ring_.reserve(ring_size);
-  // Populate the hash ring by walking through the (host, weight) pairs in
-  // normalized_host_weights, and generating (scale * weight) hashes for each
-  // host. Since these aren't necessarily whole numbers, we maintain running
-  // sums -- current_hashes and target_hashes -- which allows us to populate the
-  // ring in a mostly stable way.
-  absl::InlinedVector<char, 196> hash_key_buffer;
-  double current_hashes = 0.0;
-  double target_hashes = 0.0;
-  uint64_t min_hashes_per_host = ring_size;
-  uint64_t max_hashes_per_host = 0;
-  for (size_t i = 0; i < num_subchannels; ++i) {
-    const std::string& address_string = address_weights[i].address;
-    hash_key_buffer.assign(address_string.begin(), address_string.end());
-    hash_key_buffer.emplace_back('_');
-    auto offset_start = hash_key_buffer.end();
-    target_hashes += scale * address_weights[i].normalized_weight;
-    size_t count = 0;
-    while (current_hashes < target_hashes) {
-      const std::string count_str = absl::StrCat(count);
-      hash_key_buffer.insert(offset_start, count_str.begin(), count_str.end());
-      absl::string_view hash_key(hash_key_buffer.data(),
-                                 hash_key_buffer.size());
-      const uint64_t hash = XXH64(hash_key.data(), hash_key.size(), 0);
-      ring_.push_back({hash, subchannel_list_->subchannel(i)});
-      ++count;
-      ++current_hashes;
-      hash_key_buffer.erase(offset_start, hash_key_buffer.end());
+      weight = weight_attribute->weight();
     }
-    min_hashes_per_host =
-        std::min(static_cast<uint64_t>(i), min_hashes_per_host);
-    max_hashes_per_host =
-        std::max(static_cast<uint64_t>(i), max_hashes_per_host);
-  }
-  std::sort(ring_.begin(), ring_.end(),
-            [](const Entry& lhs, const Entry& rhs) -> bool {
-              return lhs.hash < rhs.hash;
-            });
+    endpoints.push_back(
+        {grpc_sockaddr_to_string(&sd->address().address(), false), weight});
+  }
+  if (parent->config_->maglev_table_size() != 0) {
+    table_ = absl::make_unique<MaglevTable>(
+        endpoints, parent->config_->maglev_table_size());
+  } else {
+    // Start from the current ring, so that only the entries of endpoints
+    // that changed are computed again.  A policy always builds the same
+    // kind of table, so the current one is a HashRing as well.
+    const HashRing* previous =
+        parent->ring_ == nullptr
+            ? nullptr
+            : static_cast<const HashRing*>(&parent->ring_->table());
+    table_ = absl::make_unique<HashRing>(
+        endpoints, parent->config_->min_ring_size(),
+        parent->config_->max_ring_size(), previous);
+  }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO,
             "[RH %p picker %p] created ring from subchannel_list=%p "
-            "with %" PRIuPTR " ring entries",
-            parent, this, subchannel_list_.get(), ring_.size());
+            "with %" PRIuPTR " ring entries (%" PRIuPTR " bytes)",
+            parent, this, subchannel_list_.get(), table_->size(),
+            table_->SizeInBytes());
   }
 }
 
@@ -406,34 +365,9 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     return PickResult::Fail(
         absl::InternalError("xds ring hash value is not a number"));
   }
-  const std::vector<Ring::Entry>& ring = ring_->ring();
-  // Ported from https://github.com/RJ/ketama/blob/master/libketama/ketama.c
-  // (ketama_get_server) NOTE: The algorithm depends on using signed integers
-  // for lowp, highp, and first_index. Do not change them!
-  int64_t lowp = 0;
-  int64_t highp = ring.size();
-  int64_t first_index = 0;
-  while (true) {
-    first_index = (lowp + highp) / 2;
-    if (first_index == static_cast<int64_t>(ring.size())) {
-      first_index = 0;
-      break;
-    }
-    uint64_t midval = ring[first_index].hash;
-    uint64_t midval1 = first_index == 0 ? 0 : ring[first_index - 1].hash;
-    if (h <= midval && h > midval1) {
-      break;
-    }
-    if (midval < h) {
-      lowp = first_index + 1;
-    } else {
-      highp = first_index - 1;
-    }
-    if (lowp > highp) {
-      first_index = 0;
-      break;
-    }
-  }
+  const size_t ring_size = ring_->table().size();
+  const size_t first_index = ring_->table().Pick(h);
+  RingHashSubchannelData* first_sd = ring_->subchannel(first_index);
   OrphanablePtr<SubchannelConnectionAttempter> subchannel_connection_attempter;
   auto ScheduleSubchannelConnectionAttempt =
       [&](RefCountedPtr<SubchannelInterface> subchannel) {
@@ -443,41 +377,37 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
         }
         subchannel_connection_attempter->AddSubchannel(std::move(subchannel));
       };
-  switch (ring[first_index].subchannel->GetConnectivityState()) {
+  switch (first_sd->GetConnectivityState()) {
     case GRPC_CHANNEL_READY:
-      return PickResult::Complete(
-          ring[first_index].subchannel->subchannel()->Ref());
+      return PickResult::Complete(first_sd->subchannel()->Ref());
     case GRPC_CHANNEL_IDLE:
-      ScheduleSubchannelConnectionAttempt(
-          ring[first_index].subchannel->subchannel()->Ref());
+      ScheduleSubchannelConnectionAttempt(first_sd->subchannel()->Ref());
       ABSL_FALLTHROUGH_INTENDED;
     case GRPC_CHANNEL_CONNECTING:
       return PickResult::Queue();
     default:  // GRPC_CHANNEL_TRANSIENT_FAILURE
       break;
   }
-  ScheduleSubchannelConnectionAttempt(
-      ring[first_index].subchannel->subchannel()->Ref());
+  ScheduleSubchannelConnectionAttempt(first_sd->subchannel()->Ref());
   // Loop through remaining subchannels to find one in READY.
   // On the way, we make sure the right set of connection attempts
   // will happen.
   bool found_second_subchannel = false;
   bool found_first_non_failed = false;
-  for (size_t i = 1; i < ring.size(); ++i) {
-    const Ring::Entry& entry = ring[(first_index + i) % ring.size()];
-    if (entry.subchannel == ring[first_index].subchannel) {
+  for (size_t i = 1; i < ring_size; ++i) {
+    RingHashSubchannelData* sd =
+        ring_->subchannel((first_index + i) % ring_size);
+    if (sd == first_sd) {
       continue;
     }
-    grpc_connectivity_state connectivity_state =
-        entry.subchannel->GetConnectivityState();
+    grpc_connectivity_state connectivity_state = sd->GetConnectivityState();
     if (connectivity_state == GRPC_CHANNEL_READY) {
-      return PickResult::Complete(entry.subchannel->subchannel()->Ref());
+      return PickResult::Complete(sd->subchannel()->Ref());
     }
     if (!found_second_subchannel) {
       switch (connectivity_state) {
         case GRPC_CHANNEL_IDLE:
-          ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+          ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
           ABSL_FALLTHROUGH_INTENDED;
         case GRPC_CHANNEL_CONNECTING:
           return PickResult::Queue();
@@ -488,12 +418,10 @@ RingHash::PickResult RingHash::Picker::Pick(PickArgs args) {
     }
     if (!found_first_non_failed) {
       if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
-        ScheduleSubchannelConnectionAttempt(
-            entry.subchannel->subchannel()->Ref());
+        ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
       } else {
         if (connectivity_state == GRPC_CHANNEL_IDLE) {
-          ScheduleSubchannelConnectionAttempt(
-              entry.subchannel->subchannel()->Ref());
+          ScheduleSubchannelConnectionAttempt(sd->subchannel()->Ref());
         }
         found_first_non_failed = true;
       }
@@ -637,15 +565,17 @@ void RingHash::RingHashSubchannelData::UpdateConnectivityStateLocked(
   }
   // Record last seen connectivity state.
   last_connectivity_state_ = connectivity_state;
+  // Update connectivity state used by picker.  This is also done for the
+  // initial state, so that a new subchannel list picks subchannels that are
+  // already READY rather than waiting on them forever.
+  connectivity_state_for_picker_.store(connectivity_state,
+                                       std::memory_order_relaxed);
 }
 
 void RingHash::RingHashSubchannelData::ProcessConnectivityChangeLocked(
     grpc_connectivity_state connectivity_state) {
   RingHash* p = static_cast<RingHash*>(subchannel_list()->policy());
   GPR_ASSERT(subchannel() != nullptr);
-  // Update connectivity state used by picker.
-  connectivity_state_for_picker_.store(connectivity_state,
-                                       std::memory_order_relaxed);
   // If the new state is TRANSIENT_FAILURE, re-resolve.
   // Only do this if we've started watching, not at startup time.
   // Otherwise, if the subchannel was already in state TRANSIENT_FAILURE
@@ -693,7 +623,8 @@ void RingHash::RingHashSubchannelData::ProcessConnectivityChangeLocked(
 // RingHash
 //
 
-RingHash::RingHash(Args args) : LoadBalancingPolicy(std::move(args)) {
+RingHash::RingHash(Args args, const char* name)
+    : LoadBalancingPolicy(std::move(args)), name_(name) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_ring_hash_trace)) {
     gpr_log(GPR_INFO, "[RH %p] Created", this);
   }
@@ -771,7 +702,7 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
  public:
   OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
       LoadBalancingPolicy::Args args) const override {
-    return MakeOrphanable<RingHash>(std::move(args));
+    return MakeOrphanable<RingHash>(std::move(args), kRingHash);
   }
 
   const char* name() const override { return kRingHash; }
@@ -792,11 +723,56 @@ class RingHashFactory : public LoadBalancingPolicyFactory {
   }
 };
 
+class MaglevFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<RingHash>(std::move(args), kMaglev);
+  }
+
+  const char* name() const override { return kMaglev; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    size_t table_size = MaglevTable::kDefaultTableSize;
+    std::vector<grpc_error_handle> error_list;
+    if (json.type() != Json::Type::OBJECT) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "maglev_experimental should be of type object"));
+    } else if (ParseJsonObjectField(json.object_value(), "table_size",
+                                    &table_size, &error_list,
+                                    /*required=*/false) &&
+               (table_size > MaglevTable::kMaxTableSize ||
+                !IsPrime(table_size))) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "field:table_size error:must be a prime no larger than 5000011"));
+    }
+    if (error_list.empty()) {
+      return MakeRefCounted<RingHashLbConfig>(table_size);
+    } else {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "maglev_experimental LB policy config", &error_list);
+      return nullptr;
+    }
+  }
+
+ private:
+  static bool IsPrime(size_t n) {
+    if (n < 2) return false;
+    for (size_t d = 2; d * d <= n; ++d) {
+      if (n % d == 0) return false;
+    }
+    return true;
+  }
+};
+
 }  // namespace
 
 void GrpcLbPolicyRingHashInit() {
   LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
       absl::make_unique<RingHashFactory>());
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<MaglevFactory>());
 }
 
 void GrpcLbPolicyRingHashShutdown() {}
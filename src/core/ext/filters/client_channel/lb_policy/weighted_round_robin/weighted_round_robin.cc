@@ -0,0 +1,872 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/types/optional.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/subchannel_list.h"
+#include "src/core/ext/filters/client_channel/lb_policy_registry.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/json/json_util.h"
+#include "src/core/lib/transport/connectivity_state.h"
+
+namespace grpc_core {
+
+TraceFlag grpc_lb_wrr_trace(false, "weighted_round_robin_lb");
+
+namespace {
+
+//
+// weighted_round_robin LB policy
+//
+// Like round_robin, but each READY subchannel is picked in proportion to a
+// weight computed from the load its backend reports through ORCA, either in
+// the trailing metadata of each call or on an out-of-band stream: the
+// backend's queries per second divided by its CPU utilization, so that
+// backends that spend less CPU per request get more of them.
+//
+// An address's weight is only used once it has been reported for
+// blackout_period, and is dropped if it has not been reported for
+// weight_expiration_period.  Addresses without a weight are picked as if
+// they had the mean weight.  The picker is rebuilt with fresh weights every
+// weight_update_period.
+//
+
+constexpr char kWeightedRoundRobin[] = "weighted_round_robin";
+
+constexpr Duration kDefaultOobReportingPeriod = Duration::Seconds(10);
+constexpr Duration kDefaultBlackoutPeriod = Duration::Seconds(10);
+constexpr Duration kDefaultWeightUpdatePeriod = Duration::Seconds(1);
+constexpr Duration kMinWeightUpdatePeriod = Duration::Milliseconds(100);
+constexpr Duration kDefaultWeightExpirationPeriod = Duration::Minutes(3);
+
+class WeightedRoundRobinConfig : public LoadBalancingPolicy::Config {
+ public:
+  WeightedRoundRobinConfig(bool enable_oob_load_report,
+                           Duration oob_reporting_period,
+                           Duration blackout_period,
+                           Duration weight_update_period,
+                           Duration weight_expiration_period)
+      : enable_oob_load_report_(enable_oob_load_report),
+        oob_reporting_period_(oob_reporting_period),
+        blackout_period_(blackout_period),
+        weight_update_period_(weight_update_period),
+        weight_expiration_period_(weight_expiration_period) {}
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  bool enable_oob_load_report() const { return enable_oob_load_report_; }
+  Duration oob_reporting_period() const { return oob_reporting_period_; }
+  Duration blackout_period() const { return blackout_period_; }
+  Duration weight_update_period() const { return weight_update_period_; }
+  Duration weight_expiration_period() const {
+    return weight_expiration_period_;
+  }
+
+ private:
+  bool enable_oob_load_report_;
+  Duration oob_reporting_period_;
+  Duration blackout_period_;
+  Duration weight_update_period_;
+  Duration weight_expiration_period_;
+};
+
+// Weight of one address.  Shared by the subchannel lists, pickers, call
+// trackers and out-of-band watchers of that address, and carried over to
+// the next subchannel list when an update keeps the address.
+class EndpointWeight : public RefCounted<EndpointWeight> {
+ public:
+  // Records a load report.  Reports without both a QPS and a CPU
+  // utilization say nothing about the backend's cost per request, and are
+  // ignored.
+  void MaybeUpdateWeight(double qps, double cpu_utilization) {
+    if (qps <= 0 || cpu_utilization <= 0) return;
+    const Timestamp now = ExecCtx::Get()->Now();
+    MutexLock lock(&mu_);
+    if (non_empty_since_ == Timestamp::InfFuture()) non_empty_since_ = now;
+    last_update_time_ = now;
+    weight_ = qps / cpu_utilization;
+  }
+
+  // Returns the weight to use at \a now, or 0 if there is none yet.
+  double GetWeight(Timestamp now, Duration weight_expiration_period,
+                   Duration blackout_period) {
+    MutexLock lock(&mu_);
+    if (weight_ == 0) return 0;
+    if (now - last_update_time_ >= weight_expiration_period) {
+      // Reports stopped; start over, blackout period included.
+      weight_ = 0;
+      non_empty_since_ = Timestamp::InfFuture();
+      return 0;
+    }
+    if (now - non_empty_since_ < blackout_period) return 0;
+    return weight_;
+  }
+
+  // Restarts the blackout period, for when the backend reconnects and its
+  // reports may describe a different process.
+  void ResetNonEmptySince() {
+    MutexLock lock(&mu_);
+    non_empty_since_ = Timestamp::InfFuture();
+  }
+
+ private:
+  Mutex mu_;
+  double weight_ ABSL_GUARDED_BY(mu_) = 0;
+  Timestamp non_empty_since_ ABSL_GUARDED_BY(mu_) = Timestamp::InfFuture();
+  Timestamp last_update_time_ ABSL_GUARDED_BY(mu_);
+};
+
+// Picks indexes in proportion to their weights with a static stride
+// scheduler, which approximates earliest-deadline-first scheduling without
+// a heap or a lock.  A shared sequence number walks over the indexes round
+// robin; the n-th visit to an index with weight w (scaled so that the
+// largest weight is kMaxWeight) is accepted in w out of every kMaxWeight
+// visits, spread evenly, and rejected visits just move on to the next
+// sequence number.  Weights are kept to at least kMinRatio of the largest
+// so that the expected number of visits per pick stays small.
+class StaticStrideScheduler {
+ public:
+  static constexpr uint16_t kMaxWeight = 0xffff;
+  static constexpr double kMinRatio = 0.01;
+
+  // Returns a scheduler for \a weights, or nullopt if picks should simply
+  // go round robin because there are fewer than two indexes or no weights.
+  // Indexes with a weight of 0 get the mean of the others.
+  static absl::optional<StaticStrideScheduler> Make(
+      const std::vector<double>& weights) {
+    if (weights.size() < 2) return absl::nullopt;
+    double sum = 0;
+    double max = 0;
+    size_t num_weighted = 0;
+    for (double weight : weights) {
+      if (weight <= 0) continue;
+      sum += weight;
+      max = std::max(max, weight);
+      ++num_weighted;
+    }
+    if (num_weighted == 0) return absl::nullopt;
+    const double mean = sum / num_weighted;
+    const double scale = kMaxWeight / max;
+    const uint16_t min_weight =
+        static_cast<uint16_t>(kMinRatio * kMaxWeight + 0.5);
+    std::vector<uint16_t> scaled_weights;
+    scaled_weights.reserve(weights.size());
+    bool all_equal = true;
+    for (double weight : weights) {
+      if (weight <= 0) weight = mean;
+      const uint16_t scaled = std::max(
+          min_weight, static_cast<uint16_t>(std::min<double>(
+                          kMaxWeight, weight * scale + 0.5)));
+      all_equal = all_equal && (scaled_weights.empty() ||
+                                scaled == scaled_weights.front());
+      scaled_weights.push_back(scaled);
+    }
+    if (all_equal) return absl::nullopt;
+    return StaticStrideScheduler(std::move(scaled_weights));
+  }
+
+  // Returns whether the visit of \a index that comes with sequence number
+  // \a sequence is accepted.
+  bool Accept(size_t index, uint64_t sequence) const {
+    const uint64_t weight = weights_[index];
+    const uint64_t generation = sequence / weights_.size();
+    // Offset the indexes' phases, so that they don't all accept the same
+    // generations.
+    const uint64_t offset = index * (kMaxWeight / 2);
+    return (weight * generation + offset) % kMaxWeight >= kMaxWeight - weight;
+  }
+
+  uint16_t weight(size_t index) const { return weights_[index]; }
+
+ private:
+  explicit StaticStrideScheduler(std::vector<uint16_t> weights)
+      : weights_(std::move(weights)) {}
+
+  std::vector<uint16_t> weights_;
+};
+
+constexpr uint16_t StaticStrideScheduler::kMaxWeight;
+constexpr double StaticStrideScheduler::kMinRatio;
+
+class WeightedRoundRobin : public LoadBalancingPolicy {
+ public:
+  explicit WeightedRoundRobin(Args args);
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  void UpdateLocked(UpdateArgs args) override;
+  void ResetBackoffLocked() override;
+
+ private:
+  ~WeightedRoundRobin() override;
+
+  // Forward declaration.
+  class WrrSubchannelList;
+
+  // Feeds out-of-band load reports into an address's weight.
+  class OobWatcher
+      : public SubchannelInterface::OobBackendMetricWatcherInterface {
+   public:
+    explicit OobWatcher(RefCountedPtr<EndpointWeight> weight)
+        : weight_(std::move(weight)) {}
+
+    void OnBackendMetricReport(const BackendMetricData& data) override {
+      weight_->MaybeUpdateWeight(static_cast<double>(data.requests_per_second),
+                                 data.cpu_utilization);
+    }
+
+   private:
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  // Data for a particular subchannel in a subchannel list.
+  // This subclass adds the following functionality:
+  // - Tracks the previous connectivity state of the subchannel, so that
+  //   we know how many subchannels are in each state.
+  // - Holds the weight of the subchannel's address, and the out-of-band
+  //   watch that updates it.
+  class WrrSubchannelData
+      : public SubchannelData<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelData(
+        SubchannelList<WrrSubchannelList, WrrSubchannelData>* subchannel_list,
+        const ServerAddress& address,
+        RefCountedPtr<SubchannelInterface> subchannel)
+        : SubchannelData(subchannel_list, address, std::move(subchannel)),
+          address_key_(address.address().addr, address.address().len) {}
+
+    grpc_connectivity_state connectivity_state() const {
+      return last_connectivity_state_;
+    }
+
+    // The raw socket address, which identifies the address across updates.
+    const std::string& address_key() const { return address_key_; }
+
+    const RefCountedPtr<EndpointWeight>& weight() const { return weight_; }
+    void set_weight(RefCountedPtr<EndpointWeight> weight) {
+      weight_ = std::move(weight);
+    }
+
+    // Starts and cancels the out-of-band load report watch.
+    void StartOobWatchLocked(Duration reporting_period);
+    void CancelOobWatchLocked();
+
+    // Performs connectivity state updates that need to be done both when we
+    // first start watching and when a watcher notification is received.
+    void UpdateConnectivityStateLocked(
+        grpc_connectivity_state connectivity_state);
+
+   private:
+    // Performs connectivity state updates that need to be done only
+    // after we have started watching.
+    void ProcessConnectivityChangeLocked(
+        grpc_connectivity_state connectivity_state) override;
+
+    const std::string address_key_;
+    RefCountedPtr<EndpointWeight> weight_;
+    // Owned by the subchannel.
+    OobWatcher* oob_watcher_ = nullptr;
+    grpc_connectivity_state last_connectivity_state_ = GRPC_CHANNEL_IDLE;
+    bool seen_failure_since_ready_ = false;
+  };
+
+  // A list of subchannels.
+  class WrrSubchannelList
+      : public SubchannelList<WrrSubchannelList, WrrSubchannelData> {
+   public:
+    WrrSubchannelList(WeightedRoundRobin* policy, TraceFlag* tracer,
+                      ServerAddressList addresses,
+                      const grpc_channel_args& args)
+        : SubchannelList(policy, tracer, std::move(addresses),
+                         policy->channel_control_helper(), args) {
+      // Need to maintain a ref to the LB policy as long as we maintain
+      // any references to subchannels, since the subchannels'
+      // pollset_sets will include the LB policy's pollset_set.
+      policy->Ref(DEBUG_LOCATION, "subchannel_list").release();
+    }
+
+    ~WrrSubchannelList() override {
+      WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+      p->Unref(DEBUG_LOCATION, "subchannel_list");
+    }
+
+    void Orphan() override {
+      // The subchannels are unreffed on shutdown, so the out-of-band
+      // watches have to go first.
+      for (size_t i = 0; i < num_subchannels(); ++i) {
+        subchannel(i)->CancelOobWatchLocked();
+      }
+      SubchannelList::Orphan();
+    }
+
+    // Starts watching the subchannels in this list.
+    void StartWatchingLocked();
+
+    size_t num_ready() const { return num_ready_; }
+
+    // Updates the counters of subchannels in each state when a
+    // subchannel transitions from old_state to new_state.
+    void UpdateStateCountersLocked(grpc_connectivity_state old_state,
+                                   grpc_connectivity_state new_state);
+
+    // If this subchannel list is the policy's current subchannel list,
+    // updates the policy's connectivity state based on the subchannel
+    // list's state counters.
+    void MaybeUpdateConnectivityStateLocked();
+
+    // Updates the policy's overall state based on the counters of
+    // subchannels in each state.
+    void UpdateStateFromSubchannelStateCountsLocked();
+
+   private:
+    size_t num_ready_ = 0;
+    size_t num_connecting_ = 0;
+    size_t num_transient_failure_ = 0;
+  };
+
+  // Feeds the load report in a call's trailing metadata into the weight of
+  // the address it was sent to.
+  class CallTracker : public SubchannelCallTrackerInterface {
+   public:
+    explicit CallTracker(RefCountedPtr<EndpointWeight> weight)
+        : weight_(std::move(weight)) {}
+
+    void Start() override {}
+
+    void Finish(FinishArgs args) override {
+      if (args.backend_metric_accessor == nullptr) return;
+      const BackendMetricAccessor::BackendMetricData* data =
+          args.backend_metric_accessor->GetBackendMetricData();
+      if (data == nullptr) return;
+      weight_->MaybeUpdateWeight(static_cast<double>(data->requests_per_second),
+                                 data->cpu_utilization);
+    }
+
+   private:
+    RefCountedPtr<EndpointWeight> weight_;
+  };
+
+  class Picker : public SubchannelPicker {
+   public:
+    Picker(WeightedRoundRobin* parent, WrrSubchannelList* subchannel_list);
+
+    PickResult Pick(PickArgs args) override;
+
+   private:
+    struct Entry {
+      RefCountedPtr<SubchannelInterface> subchannel;
+      RefCountedPtr<EndpointWeight> weight;
+    };
+
+    // Using pointer value only, no ref held -- do not dereference!
+    WeightedRoundRobin* parent_;
+
+    const bool track_calls_;
+    std::vector<Entry> subchannels_;
+    absl::optional<StaticStrideScheduler> scheduler_;
+    // Each pick takes the next sequence number with a single atomic add,
+    // so picks need no lock.
+    std::atomic<uint64_t> sequence_;
+  };
+
+  void ShutdownLocked() override;
+
+  // The weight update timer re-publishes the picker, with fresh weights,
+  // every weight_update_period.
+  void StartWeightUpdateTimerLocked();
+  static void OnWeightUpdateTimer(void* arg, grpc_error_handle error);
+  void OnWeightUpdateTimerLocked(grpc_error_handle error);
+
+  RefCountedPtr<WeightedRoundRobinConfig> config_;
+  // List of subchannels.
+  OrphanablePtr<WrrSubchannelList> subchannel_list_;
+  // Latest pending subchannel list.
+  // When we get an updated address list, we create a new subchannel list
+  // for it here, and we wait to swap it into subchannel_list_ until the new
+  // list becomes READY.
+  OrphanablePtr<WrrSubchannelList> latest_pending_subchannel_list_;
+  // Weights of the addresses in the latest update, by address.
+  std::map<std::string, RefCountedPtr<EndpointWeight>> weights_;
+  grpc_timer weight_update_timer_;
+  grpc_closure on_weight_update_timer_;
+  bool weight_update_timer_pending_ = false;
+  bool shutdown_ = false;
+};
+
+//
+// WeightedRoundRobin::Picker
+//
+
+WeightedRoundRobin::Picker::Picker(WeightedRoundRobin* parent,
+                                   WrrSubchannelList* subchannel_list)
+    : parent_(parent),
+      track_calls_(!parent->config_->enable_oob_load_report()),
+      sequence_((static_cast<uint64_t>(rand()) << 32) ^ rand()) {
+  std::vector<double> weights;
+  const Timestamp now = ExecCtx::Get()->Now();
+  for (size_t i = 0; i < subchannel_list->num_subchannels(); ++i) {
+    WrrSubchannelData* sd = subchannel_list->subchannel(i);
+    if (sd->connectivity_state() == GRPC_CHANNEL_READY) {
+      subchannels_.push_back({sd->subchannel()->Ref(), sd->weight()});
+      weights.push_back(sd->weight()->GetWeight(
+          now, parent->config_->weight_expiration_period(),
+          parent->config_->blackout_period()));
+    }
+  }
+  scheduler_ = StaticStrideScheduler::Make(weights);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] created picker from subchannel_list=%p "
+            "with %" PRIuPTR " READY subchannels; %s",
+            parent_, this, subchannel_list, subchannels_.size(),
+            scheduler_.has_value() ? "weighted" : "unweighted");
+    for (size_t i = 0; i < subchannels_.size(); ++i) {
+      gpr_log(GPR_INFO,
+              "[WRR %p picker %p] index %" PRIuPTR
+              ": subchannel=%p weight=%f scheduler_weight=%u",
+              parent_, this, i, subchannels_[i].subchannel.get(), weights[i],
+              scheduler_.has_value() ? scheduler_->weight(i) : 0u);
+    }
+  }
+}
+
+WeightedRoundRobin::PickResult WeightedRoundRobin::Picker::Pick(
+    PickArgs /*args*/) {
+  size_t index;
+  while (true) {
+    const uint64_t sequence =
+        sequence_.fetch_add(1, std::memory_order_relaxed);
+    index = sequence % subchannels_.size();
+    if (!scheduler_.has_value() || scheduler_->Accept(index, sequence)) break;
+  }
+  const Entry& picked = subchannels_[index];
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO,
+            "[WRR %p picker %p] returning index %" PRIuPTR ", subchannel=%p",
+            parent_, this, index, picked.subchannel.get());
+  }
+  return PickResult::Complete(
+      picked.subchannel,
+      track_calls_ ? absl::make_unique<CallTracker>(picked.weight) : nullptr);
+}
+
+//
+// WeightedRoundRobin
+//
+
+WeightedRoundRobin::WeightedRoundRobin(Args args)
+    : LoadBalancingPolicy(std::move(args)) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Created", this);
+  }
+  GRPC_CLOSURE_INIT(&on_weight_update_timer_, OnWeightUpdateTimer, this,
+                    nullptr);
+}
+
+WeightedRoundRobin::~WeightedRoundRobin() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Destroying weighted_round_robin policy",
+            this);
+  }
+  GPR_ASSERT(subchannel_list_ == nullptr);
+  GPR_ASSERT(latest_pending_subchannel_list_ == nullptr);
+}
+
+void WeightedRoundRobin::ShutdownLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(GPR_INFO, "[WRR %p] Shutting down", this);
+  }
+  shutdown_ = true;
+  if (weight_update_timer_pending_) grpc_timer_cancel(&weight_update_timer_);
+  subchannel_list_.reset();
+  latest_pending_subchannel_list_.reset();
+  weights_.clear();
+}
+
+void WeightedRoundRobin::ResetBackoffLocked() {
+  subchannel_list_->ResetBackoffLocked();
+  if (latest_pending_subchannel_list_ != nullptr) {
+    latest_pending_subchannel_list_->ResetBackoffLocked();
+  }
+}
+
+void WeightedRoundRobin::StartWeightUpdateTimerLocked() {
+  if (shutdown_ || weight_update_timer_pending_) return;
+  weight_update_timer_pending_ = true;
+  Ref(DEBUG_LOCATION, "WeightUpdateTimer").release();
+  grpc_timer_init(&weight_update_timer_,
+                  ExecCtx::Get()->Now() + config_->weight_update_period(),
+                  &on_weight_update_timer_);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimer(void* arg,
+                                             grpc_error_handle error) {
+  auto* self = static_cast<WeightedRoundRobin*>(arg);
+  (void)GRPC_ERROR_REF(error);  // ref owned by lambda
+  self->work_serializer()->Run(
+      [self, error]() { self->OnWeightUpdateTimerLocked(error); },
+      DEBUG_LOCATION);
+}
+
+void WeightedRoundRobin::OnWeightUpdateTimerLocked(grpc_error_handle error) {
+  weight_update_timer_pending_ = false;
+  if (error == GRPC_ERROR_NONE && !shutdown_) {
+    // Only a READY policy has a picker that uses the weights.
+    if (subchannel_list_ != nullptr && subchannel_list_->num_ready() > 0) {
+      subchannel_list_->MaybeUpdateConnectivityStateLocked();
+    }
+    StartWeightUpdateTimerLocked();
+  }
+  Unref(DEBUG_LOCATION, "WeightUpdateTimer");
+  GRPC_ERROR_UNREF(error);
+}
+
+void WeightedRoundRobin::WrrSubchannelList::StartWatchingLocked() {
+  if (num_subchannels() == 0) return;
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // Check current state of each subchannel synchronously, since any
+  // subchannel already used by some other channel may have a non-IDLE
+  // state.
+  for (size_t i = 0; i < num_subchannels(); ++i) {
+    grpc_connectivity_state state =
+        subchannel(i)->CheckConnectivityStateLocked();
+    if (state != GRPC_CHANNEL_IDLE) {
+      subchannel(i)->UpdateConnectivityStateLocked(state);
+    }
+  }
+  // Start connectivity watch for each subchannel, and the out-of-band
+  // load report watch if enabled.
+  for (size_t i = 0; i < num_subchannels(); i++) {
+    if (subchannel(i)->subchannel() != nullptr) {
+      subchannel(i)->StartConnectivityWatchLocked();
+      if (p->config_->enable_oob_load_report()) {
+        subchannel(i)->StartOobWatchLocked(
+            p->config_->oob_reporting_period());
+      }
+      subchannel(i)->subchannel()->AttemptToConnect();
+    }
+  }
+  // Now set the LB policy's state based on the subchannels' states.
+  UpdateStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::WrrSubchannelList::UpdateStateCountersLocked(
+    grpc_connectivity_state old_state, grpc_connectivity_state new_state) {
+  GPR_ASSERT(old_state != GRPC_CHANNEL_SHUTDOWN);
+  GPR_ASSERT(new_state != GRPC_CHANNEL_SHUTDOWN);
+  if (old_state == GRPC_CHANNEL_READY) {
+    GPR_ASSERT(num_ready_ > 0);
+    --num_ready_;
+  } else if (old_state == GRPC_CHANNEL_CONNECTING) {
+    GPR_ASSERT(num_connecting_ > 0);
+    --num_connecting_;
+  } else if (old_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    GPR_ASSERT(num_transient_failure_ > 0);
+    --num_transient_failure_;
+  }
+  if (new_state == GRPC_CHANNEL_READY) {
+    ++num_ready_;
+  } else if (new_state == GRPC_CHANNEL_CONNECTING) {
+    ++num_connecting_;
+  } else if (new_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    ++num_transient_failure_;
+  }
+}
+
+// Sets the policy's connectivity state and generates a new picker based
+// on the current subchannel list.  Follows the same rules as round_robin.
+void WeightedRoundRobin::WrrSubchannelList::
+    MaybeUpdateConnectivityStateLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // Only set connectivity state if this is the current subchannel list.
+  if (p->subchannel_list_.get() != this) return;
+  if (num_ready_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_READY, absl::Status(), absl::make_unique<Picker>(p, this));
+  } else if (num_connecting_ > 0) {
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_CONNECTING, absl::Status(),
+        absl::make_unique<QueuePicker>(p->Ref(DEBUG_LOCATION, "QueuePicker")));
+  } else if (num_transient_failure_ == num_subchannels()) {
+    absl::Status status =
+        absl::UnavailableError("connections to all backends failing");
+    p->channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+  }
+}
+
+void WeightedRoundRobin::WrrSubchannelList::
+    UpdateStateFromSubchannelStateCountsLocked() {
+  WeightedRoundRobin* p = static_cast<WeightedRoundRobin*>(policy());
+  // If we have at least one READY subchannel, then swap to the new list.
+  // Also, if all of the subchannels are in TRANSIENT_FAILURE, then we know
+  // we've tried all of them and failed, so we go ahead and swap over
+  // anyway.
+  if (num_ready_ > 0 || num_transient_failure_ == num_subchannels()) {
+    if (p->subchannel_list_.get() != this) {
+      // This list must be p->latest_pending_subchannel_list_, because
+      // any previous update would have been shut down already and
+      // therefore we would not be receiving a notification for them.
+      GPR_ASSERT(p->latest_pending_subchannel_list_.get() == this);
+      GPR_ASSERT(!shutting_down());
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+        const size_t old_num_subchannels =
+            p->subchannel_list_ != nullptr
+                ? p->subchannel_list_->num_subchannels()
+                : 0;
+        gpr_log(GPR_INFO,
+                "[WRR %p] phasing out subchannel list %p (size %" PRIuPTR
+                ") in favor of %p (size %" PRIuPTR ")",
+                p, p->subchannel_list_.get(), old_num_subchannels, this,
+                num_subchannels());
+      }
+      p->subchannel_list_ = std::move(p->latest_pending_subchannel_list_);
+    }
+  }
+  MaybeUpdateConnectivityStateLocked();
+}
+
+void WeightedRoundRobin::WrrSubchannelData::StartOobWatchLocked(
+    Duration reporting_period) {
+  auto watcher = absl::make_unique<OobWatcher>(weight_);
+  oob_watcher_ = watcher.get();
+  subchannel()->WatchOobBackendMetrics(reporting_period, std::move(watcher));
+}
+
+void WeightedRoundRobin::WrrSubchannelData::CancelOobWatchLocked() {
+  if (oob_watcher_ == nullptr) return;
+  subchannel()->CancelOobBackendMetricWatch(oob_watcher_);
+  oob_watcher_ = nullptr;
+}
+
+void WeightedRoundRobin::WrrSubchannelData::UpdateConnectivityStateLocked(
+    grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+    gpr_log(
+        GPR_INFO,
+        "[WRR %p] connectivity changed for subchannel %p, subchannel_list %p "
+        "(index %" PRIuPTR " of %" PRIuPTR "): prev_state=%s new_state=%s",
+        p, subchannel(), subchannel_list(), Index(),
+        subchannel_list()->num_subchannels(),
+        ConnectivityStateName(last_connectivity_state_),
+        ConnectivityStateName(connectivity_state));
+  }
+  // A backend that comes back may be a different process, so its weight
+  // has to sit out the blackout period again.
+  if (last_connectivity_state_ == GRPC_CHANNEL_READY &&
+      connectivity_state != GRPC_CHANNEL_READY) {
+    weight_->ResetNonEmptySince();
+  }
+  // Once we see a failure, we report TRANSIENT_FAILURE and do not report
+  // any subsequent state changes until we go back into state READY.
+  if (!seen_failure_since_ready_) {
+    if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+      seen_failure_since_ready_ = true;
+    }
+    subchannel_list()->UpdateStateCountersLocked(last_connectivity_state_,
+                                                 connectivity_state);
+  } else {
+    if (connectivity_state == GRPC_CHANNEL_READY) {
+      seen_failure_since_ready_ = false;
+      subchannel_list()->UpdateStateCountersLocked(
+          GRPC_CHANNEL_TRANSIENT_FAILURE, connectivity_state);
+    }
+  }
+  last_connectivity_state_ = connectivity_state;
+}
+
+void WeightedRoundRobin::WrrSubchannelData::ProcessConnectivityChangeLocked(
+    grpc_connectivity_state connectivity_state) {
+  WeightedRoundRobin* p =
+      static_cast<WeightedRoundRobin*>(subchannel_list()->policy());
+  GPR_ASSERT(subchannel() != nullptr);
+  // If the new state is TRANSIENT_FAILURE, re-resolve and attempt to
+  // reconnect.
+  if (connectivity_state == GRPC_CHANNEL_TRANSIENT_FAILURE) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO,
+              "[WRR %p] Subchannel %p has gone into TRANSIENT_FAILURE. "
+              "Requesting re-resolution",
+              p, subchannel());
+    }
+    p->channel_control_helper()->RequestReresolution();
+    subchannel()->AttemptToConnect();
+  }
+  UpdateConnectivityStateLocked(connectivity_state);
+  subchannel_list()->UpdateStateFromSubchannelStateCountsLocked();
+}
+
+void WeightedRoundRobin::UpdateLocked(UpdateArgs args) {
+  config_ = std::move(args.config);
+  ServerAddressList addresses;
+  if (args.addresses.ok()) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with %" PRIuPTR " addresses",
+              this, args.addresses->size());
+    }
+    addresses = std::move(*args.addresses);
+  } else {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace)) {
+      gpr_log(GPR_INFO, "[WRR %p] received update with address error: %s",
+              this, args.addresses.status().ToString().c_str());
+    }
+    // If we already have a subchannel list, then ignore the resolver
+    // failure and keep using the existing list.
+    if (subchannel_list_ != nullptr) return;
+  }
+  // Replace latest_pending_subchannel_list_.
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_wrr_trace) &&
+      latest_pending_subchannel_list_ != nullptr) {
+    gpr_log(GPR_INFO,
+            "[WRR %p] Shutting down previous pending subchannel list %p", this,
+            latest_pending_subchannel_list_.get());
+  }
+  latest_pending_subchannel_list_ = MakeOrphanable<WrrSubchannelList>(
+      this, &grpc_lb_wrr_trace, std::move(addresses), *args.args);
+  // Addresses that were already in the previous update keep their weights,
+  // so that an update does not send them back into the blackout period.
+  std::map<std::string, RefCountedPtr<EndpointWeight>> weights;
+  for (size_t i = 0; i < latest_pending_subchannel_list_->num_subchannels();
+       ++i) {
+    WrrSubchannelData* sd = latest_pending_subchannel_list_->subchannel(i);
+    RefCountedPtr<EndpointWeight>& entry = weights[sd->address_key()];
+    if (entry == nullptr) {
+      auto it = weights_.find(sd->address_key());
+      entry = it != weights_.end() ? std::move(it->second)
+                                   : MakeRefCounted<EndpointWeight>();
+    }
+    sd->set_weight(entry);
+  }
+  weights_ = std::move(weights);
+  if (latest_pending_subchannel_list_->num_subchannels() == 0) {
+    // If the new list is empty, immediately promote the new list to the
+    // current list and transition to TRANSIENT_FAILURE.
+    absl::Status status =
+        args.addresses.ok() ? absl::UnavailableError(absl::StrCat(
+                                  "empty address list: ", args.resolution_note))
+                            : args.addresses.status();
+    channel_control_helper()->UpdateState(
+        GRPC_CHANNEL_TRANSIENT_FAILURE, status,
+        absl::make_unique<TransientFailurePicker>(status));
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+  } else if (subchannel_list_ == nullptr) {
+    // If there is no current list, immediately promote the new list to
+    // the current list and start watching it.
+    subchannel_list_ = std::move(latest_pending_subchannel_list_);
+    subchannel_list_->StartWatchingLocked();
+  } else {
+    // Start watching the pending list.  It will get swapped into the
+    // current list when it reports READY.
+    latest_pending_subchannel_list_->StartWatchingLocked();
+  }
+  StartWeightUpdateTimerLocked();
+}
+
+//
+// factory
+//
+
+class WeightedRoundRobinFactory : public LoadBalancingPolicyFactory {
+ public:
+  OrphanablePtr<LoadBalancingPolicy> CreateLoadBalancingPolicy(
+      LoadBalancingPolicy::Args args) const override {
+    return MakeOrphanable<WeightedRoundRobin>(std::move(args));
+  }
+
+  const char* name() const override { return kWeightedRoundRobin; }
+
+  RefCountedPtr<LoadBalancingPolicy::Config> ParseLoadBalancingConfig(
+      const Json& json, grpc_error_handle* error) const override {
+    std::vector<grpc_error_handle> error_list;
+    bool enable_oob_load_report = false;
+    Duration oob_reporting_period = kDefaultOobReportingPeriod;
+    Duration blackout_period = kDefaultBlackoutPeriod;
+    Duration weight_update_period = kDefaultWeightUpdatePeriod;
+    Duration weight_expiration_period = kDefaultWeightExpirationPeriod;
+    if (json.type() != Json::Type::OBJECT) {
+      error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "weighted_round_robin should be of type object"));
+    } else {
+      const Json::Object& object = json.object_value();
+      ParseJsonObjectField(object, "enableOobLoadReport",
+                           &enable_oob_load_report, &error_list,
+                           /*required=*/false);
+      if (ParseJsonObjectFieldAsDuration(object, "oobReportingPeriod",
+                                         &oob_reporting_period, &error_list,
+                                         /*required=*/false) &&
+          oob_reporting_period <= Duration::Zero()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:oobReportingPeriod error:must be positive"));
+      }
+      ParseJsonObjectFieldAsDuration(object, "blackoutPeriod",
+                                     &blackout_period, &error_list,
+                                     /*required=*/false);
+      // Shorter periods are allowed but clamped.
+      if (ParseJsonObjectFieldAsDuration(object, "weightUpdatePeriod",
+                                         &weight_update_period, &error_list,
+                                         /*required=*/false)) {
+        weight_update_period =
+            std::max(weight_update_period, kMinWeightUpdatePeriod);
+      }
+      if (ParseJsonObjectFieldAsDuration(object, "weightExpirationPeriod",
+                                         &weight_expiration_period,
+                                         &error_list, /*required=*/false) &&
+          weight_expiration_period <= Duration::Zero()) {
+        error_list.push_back(GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "field:weightExpirationPeriod error:must be positive"));
+      }
+    }
+    if (!error_list.empty()) {
+      *error = GRPC_ERROR_CREATE_FROM_VECTOR(
+          "weighted_round_robin LB policy config", &error_list);
+      return nullptr;
+    }
+    return MakeRefCounted<WeightedRoundRobinConfig>(
+        enable_oob_load_report, oob_reporting_period, blackout_period,
+        weight_update_period, weight_expiration_period);
+  }
+};
+
+}  // namespace
+
+void GrpcLbPolicyWeightedRoundRobinInit() {
+  LoadBalancingPolicyRegistry::Builder::RegisterLoadBalancingPolicyFactory(
+      absl::make_unique<WeightedRoundRobinFactory>());
+}
+
+void GrpcLbPolicyWeightedRoundRobinShutdown() {}
+
+}  // namespace grpc_core
@@ -30,6 +30,7 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/string_util.h>
 
+#include "src/core/ext/filters/client_channel/backend_metric.h"
 #include "src/core/ext/filters/client_channel/client_channel.h"
 #include "src/core/ext/filters/client_channel/health/health_check_client.h"
 #include "src/core/ext/filters/client_channel/proxy_mapper_registry.h"
@@ -140,6 +141,7 @@ RefCountedPtr<SubchannelCall> SubchannelCall::Create(Args args,
 SubchannelCall::SubchannelCall(Args args, grpc_error_handle* error)
     : connected_subchannel_(std::move(args.connected_subchannel)),
       deadline_(args.deadline) {
+  connected_subchannel_->active_calls_.fetch_add(1, std::memory_order_relaxed);
   grpc_call_stack* callstk = SUBCHANNEL_CALL_TO_CALL_STACK(this);
   const grpc_call_element_args call_args = {
       callstk,             /* call_stack */
@@ -211,6 +213,7 @@ void SubchannelCall::Destroy(void* arg, grpc_error_handle /*error*/) {
   grpc_closure* after_call_stack_destroy = self->after_call_stack_destroy_;
   RefCountedPtr<ConnectedSubchannel> connected_subchannel =
       std::move(self->connected_subchannel_);
+  connected_subchannel->active_calls_.fetch_sub(1, std::memory_order_relaxed);
   // Destroy the subchannel call.
   self->~SubchannelCall();
   // Destroy the call stack. This should be after destroying the subchannel
@@ -296,8 +299,9 @@ class Subchannel::ConnectedSubchannelStateWatcher
     : public AsyncConnectivityStateWatcherInterface {
  public:
   // Must be instantiated while holding c->mu.
-  explicit ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c)
-      : subchannel_(std::move(c)) {}
+  ConnectedSubchannelStateWatcher(WeakRefCountedPtr<Subchannel> c,
+                                  uint64_t connection_id)
+      : subchannel_(std::move(c)), connection_id_(connection_id) {}
 
   ~ConnectedSubchannelStateWatcher() override {
     subchannel_.reset(DEBUG_LOCATION, "state_watcher");
@@ -308,10 +312,57 @@ class Subchannel::ConnectedSubchannelStateWatcher
                                  const absl::Status& status) override {
     Subchannel* c = subchannel_.get();
     MutexLock lock(&c->mu_);
+    if (c->disconnected_) return;
+    if (connection_id_ != c->connected_subchannel_id_) {
+      // One of the additional pooled connections.  It never affects the
+      // subchannel's state; just stop using it once it goes away.
+      if (new_state != GRPC_CHANNEL_TRANSIENT_FAILURE &&
+          new_state != GRPC_CHANNEL_SHUTDOWN) {
+        return;
+      }
+      auto it = std::find_if(
+          c->pooled_connections_.begin(), c->pooled_connections_.end(),
+          [this](const PooledConnection& connection) {
+            return connection.id == connection_id_;
+          });
+      if (it != c->pooled_connections_.end()) {
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+          gpr_log(GPR_INFO,
+                  "subchannel %p %s: pooled connection %p has gone into %s",
+                  c, c->key_.ToString().c_str(),
+                  it->connected_subchannel.get(),
+                  ConnectivityStateName(new_state));
+        }
+        c->pooled_connections_.erase(it);
+      }
+      return;
+    }
     switch (new_state) {
       case GRPC_CHANNEL_TRANSIENT_FAILURE:
       case GRPC_CHANNEL_SHUTDOWN: {
-        if (!c->disconnected_ && c->connected_subchannel_ != nullptr) {
+        if (c->connected_subchannel_ != nullptr &&
+            !c->pooled_connections_.empty()) {
+          // Promote a pooled connection; the subchannel stays READY.
+          PooledConnection& replacement = c->pooled_connections_.front();
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+            gpr_log(GPR_INFO,
+                    "subchannel %p %s: Connected subchannel %p has gone into "
+                    "%s. Switching to pooled connection %p.",
+                    c, c->key_.ToString().c_str(),
+                    c->connected_subchannel_.get(),
+                    ConnectivityStateName(new_state),
+                    replacement.connected_subchannel.get());
+          }
+          c->connected_subchannel_ =
+              std::move(replacement.connected_subchannel);
+          c->connected_subchannel_id_ = replacement.id;
+          if (c->channelz_node() != nullptr) {
+            c->channelz_node()->SetChildSocket(std::move(replacement.socket));
+          }
+          c->pooled_connections_.erase(c->pooled_connections_.begin());
+          c->health_watcher_map_.RestartHealthCheckingLocked();
+          c->UpdateOrcaClientLocked(/*restart=*/true);
+        } else if (c->connected_subchannel_ != nullptr) {
           if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
             gpr_log(GPR_INFO,
                     "subchannel %p %s: Connected subchannel %p has gone into "
@@ -321,18 +372,28 @@ class Subchannel::ConnectedSubchannelStateWatcher
                     ConnectivityStateName(new_state));
           }
           c->connected_subchannel_.reset();
+          c->connected_subchannel_id_ = 0;
           if (c->channelz_node() != nullptr) {
             c->channelz_node()->SetChildSocket(nullptr);
           }
-          // We need to construct our own status if the underlying state was
-          // shutdown since the accompanying status will be StatusCode::OK
-          // otherwise.
-          c->SetConnectivityStateLocked(
-              GRPC_CHANNEL_TRANSIENT_FAILURE,
-              new_state == GRPC_CHANNEL_SHUTDOWN
-                  ? absl::Status(absl::StatusCode::kUnavailable,
-                                 "Subchannel has disconnected.")
-                  : status);
+          if (c->connecting_) {
+            // An attempt to add a pooled connection is in flight.  It now
+            // replaces the lost connection, and reports READY or
+            // TRANSIENT_FAILURE when it finishes.
+            c->connecting_pooled_ = false;
+            c->SetConnectivityStateLocked(GRPC_CHANNEL_CONNECTING,
+                                          absl::Status());
+          } else {
+            // We need to construct our own status if the underlying state
+            // was shutdown since the accompanying status will be
+            // StatusCode::OK otherwise.
+            c->SetConnectivityStateLocked(
+                GRPC_CHANNEL_TRANSIENT_FAILURE,
+                new_state == GRPC_CHANNEL_SHUTDOWN
+                    ? absl::Status(absl::StatusCode::kUnavailable,
+                                   "Subchannel has disconnected.")
+                    : status);
+          }
           c->backoff_begun_ = false;
           c->backoff_.Reset();
         }
@@ -349,6 +410,7 @@ class Subchannel::ConnectedSubchannelStateWatcher
   }
 
   WeakRefCountedPtr<Subchannel> subchannel_;
+  const uint64_t connection_id_;
 };
 
 // Asynchronously notifies the \a watcher of a change in the connectvity state
@@ -468,6 +530,14 @@ class Subchannel::HealthWatcherMap::HealthWatcher
     }
   }
 
+  // Moves health checking over to a new connected_subchannel_.
+  void RestartHealthCheckingLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(subchannel_->mu_) {
+    if (health_check_client_ == nullptr) return;
+    health_check_client_.reset();
+    StartHealthCheckingLocked();
+  }
+
   void Orphan() override {
     watcher_list_.Clear();
     health_check_client_.reset();
@@ -561,8 +631,58 @@ Subchannel::HealthWatcherMap::CheckConnectivityStateLocked(
   return health_watcher->state();
 }
 
+void Subchannel::HealthWatcherMap::RestartHealthCheckingLocked() {
+  for (const auto& p : map_) {
+    p.second->RestartHealthCheckingLocked();
+  }
+}
+
 void Subchannel::HealthWatcherMap::ShutdownLocked() { map_.clear(); }
 
+//
+// Subchannel::OobBackendMetricWatcherList
+//
+
+void Subchannel::OobBackendMetricWatcherList::Add(
+    Duration report_interval,
+    std::unique_ptr<SubchannelInterface::OobBackendMetricWatcherInterface>
+        watcher) {
+  MutexLock lock(&mu_);
+  auto* key = watcher.get();
+  watchers_[key] = Watcher{report_interval, std::move(watcher)};
+}
+
+void Subchannel::OobBackendMetricWatcherList::Remove(
+    SubchannelInterface::OobBackendMetricWatcherInterface* watcher) {
+  MutexLock lock(&mu_);
+  watchers_.erase(watcher);
+}
+
+void Subchannel::OobBackendMetricWatcherList::Clear() {
+  MutexLock lock(&mu_);
+  watchers_.clear();
+}
+
+absl::optional<Duration>
+Subchannel::OobBackendMetricWatcherList::MinReportInterval() {
+  MutexLock lock(&mu_);
+  absl::optional<Duration> min_interval;
+  for (const auto& p : watchers_) {
+    if (!min_interval.has_value() || p.second.report_interval < *min_interval) {
+      min_interval = p.second.report_interval;
+    }
+  }
+  return min_interval;
+}
+
+void Subchannel::OobBackendMetricWatcherList::Notify(
+    const BackendMetricData& data) {
+  MutexLock lock(&mu_);
+  for (const auto& p : watchers_) {
+    p.second.watcher->OnBackendMetricReport(data);
+  }
+}
+
 //
 // Subchannel
 //
@@ -646,6 +766,13 @@ Subchannel::Subchannel(SubchannelKey key,
       key_(std::move(key)),
       pollset_set_(grpc_pollset_set_create()),
       connector_(std::move(connector)),
+      max_connections_(grpc_channel_args_find_integer(
+          args, GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS, {1, 1, INT_MAX})),
+      max_streams_per_connection_(grpc_channel_args_find_integer(
+          args, GRPC_ARG_SUBCHANNEL_MAX_STREAMS_PER_CONNECTION,
+          {100, 1, INT_MAX})),
+      oob_backend_metric_watchers_(
+          MakeRefCounted<OobBackendMetricWatcherList>()),
       backoff_(ParseArgsForBackoffValues(args, &min_connect_timeout_)) {
   GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED();
   GRPC_CLOSURE_INIT(&on_connecting_finished_, OnConnectingFinished, this,
@@ -787,6 +914,42 @@ void Subchannel::CancelConnectivityStateWatch(
   }
 }
 
+void Subchannel::WatchOobBackendMetrics(
+    Duration report_interval,
+    std::unique_ptr<SubchannelInterface::OobBackendMetricWatcherInterface>
+        watcher) {
+  MutexLock lock(&mu_);
+  oob_backend_metric_watchers_->Add(report_interval, std::move(watcher));
+  UpdateOrcaClientLocked(/*restart=*/false);
+}
+
+void Subchannel::CancelOobBackendMetricWatch(
+    SubchannelInterface::OobBackendMetricWatcherInterface* watcher) {
+  MutexLock lock(&mu_);
+  oob_backend_metric_watchers_->Remove(watcher);
+  UpdateOrcaClientLocked(/*restart=*/false);
+}
+
+RefCountedPtr<ConnectedSubchannel> Subchannel::connected_subchannel() {
+  MutexLock lock(&mu_);
+  if (max_connections_ <= 1 || connected_subchannel_ == nullptr) {
+    return connected_subchannel_;
+  }
+  ConnectedSubchannel* least_loaded = connected_subchannel_.get();
+  size_t least_load = least_loaded->active_calls();
+  for (const PooledConnection& connection : pooled_connections_) {
+    const size_t load = connection.connected_subchannel->active_calls();
+    if (load < least_load) {
+      least_loaded = connection.connected_subchannel.get();
+      least_load = load;
+    }
+  }
+  if (least_load >= max_streams_per_connection_) {
+    MaybeGrowConnectionPoolLocked();
+  }
+  return least_loaded->Ref();
+}
+
 void Subchannel::AttemptToConnect() {
   MutexLock lock(&mu_);
   MaybeStartConnectingLocked();
@@ -795,6 +958,7 @@ void Subchannel::AttemptToConnect() {
 void Subchannel::ResetBackoff() {
   MutexLock lock(&mu_);
   backoff_.Reset();
+  next_pool_attempt_ = Timestamp();
   if (have_retry_alarm_) {
     retry_immediately_ = true;
     grpc_timer_cancel(&retry_alarm_);
@@ -816,7 +980,10 @@ void Subchannel::Orphan() {
   disconnected_ = true;
   connector_.reset();
   connected_subchannel_.reset();
+  pooled_connections_.clear();
   health_watcher_map_.ShutdownLocked();
+  orca_client_.reset();
+  oob_backend_metric_watchers_->Clear();
 }
 
 namespace {
@@ -858,6 +1025,28 @@ void Subchannel::SetConnectivityStateLocked(grpc_connectivity_state state,
   watcher_list_.NotifyLocked(state, status);
   // Notify health watchers.
   health_watcher_map_.NotifyLocked(state, status);
+  // Out-of-band backend metrics are only streamed while READY.
+  UpdateOrcaClientLocked(/*restart=*/false);
+}
+
+void Subchannel::UpdateOrcaClientLocked(bool restart) {
+  absl::optional<Duration> report_interval =
+      oob_backend_metric_watchers_->MinReportInterval();
+  if (disconnected_ || state_ != GRPC_CHANNEL_READY ||
+      !report_interval.has_value()) {
+    orca_client_.reset();
+    return;
+  }
+  if (orca_client_ != nullptr && !restart &&
+      *report_interval == orca_report_interval_) {
+    return;
+  }
+  orca_report_interval_ = *report_interval;
+  RefCountedPtr<OobBackendMetricWatcherList> watchers =
+      oob_backend_metric_watchers_;
+  orca_client_ = MakeOrcaClient(
+      connected_subchannel_, pollset_set_, *report_interval,
+      [watchers](const BackendMetricData& data) { watchers->Notify(data); });
 }
 
 void Subchannel::MaybeStartConnectingLocked() {
@@ -934,6 +1123,28 @@ void Subchannel::ContinueConnectingLocked() {
   connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
 }
 
+void Subchannel::MaybeGrowConnectionPoolLocked() {
+  if (disconnected_ || connecting_) return;
+  if (1 + pooled_connections_.size() >= max_connections_) return;
+  if (ExecCtx::Get()->Now() < next_pool_attempt_) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+    gpr_log(GPR_INFO,
+            "subchannel %p %s: all %" PRIuPTR
+            " connections saturated, opening another one",
+            this, key_.ToString().c_str(), 1 + pooled_connections_.size());
+  }
+  connecting_ = true;
+  connecting_pooled_ = true;
+  WeakRef(DEBUG_LOCATION, "connecting")
+      .release();  // ref held by pending connect
+  SubchannelConnector::Args args;
+  args.address = &address_for_connect_;
+  args.interested_parties = pollset_set_;
+  args.deadline = min_connect_timeout_ + ExecCtx::Get()->Now();
+  args.channel_args = args_;
+  connector_->Connect(args, &connecting_result_, &on_connecting_finished_);
+}
+
 void Subchannel::OnConnectingFinished(void* arg, grpc_error_handle error) {
   WeakRefCountedPtr<Subchannel> c(static_cast<Subchannel*>(arg));
   const grpc_channel_args* delete_channel_args =
@@ -941,9 +1152,23 @@ void Subchannel::OnConnectingFinished(void* arg, grpc_error_handle error) {
   {
     MutexLock lock(&c->mu_);
     c->connecting_ = false;
+    const bool pooled = c->connecting_pooled_;
+    c->connecting_pooled_ = false;
     if (c->connecting_result_.transport != nullptr &&
         c->PublishTransportLocked()) {
       // Do nothing, transport was published.
+    } else if (pooled) {
+      // The subchannel is still connected; just hold off on growing the pool
+      // for a while.
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+        gpr_log(GPR_INFO,
+                "subchannel %p %s: failed to add pooled connection: %s",
+                c.get(), c->key_.ToString().c_str(),
+                grpc_error_std_string(error).c_str());
+      }
+      c->next_pool_attempt_ =
+          ExecCtx::Get()->Now() +
+          Duration::Seconds(GRPC_SUBCHANNEL_INITIAL_CONNECT_BACKOFF_SECONDS);
     } else if (!c->disconnected_) {
       gpr_log(GPR_INFO, "subchannel %p %s: connect failed: %s", c.get(),
               c->key_.ToString().c_str(), grpc_error_std_string(error).c_str());
@@ -992,9 +1217,30 @@ bool Subchannel::PublishTransportLocked() {
     gpr_free(stk);
     return false;
   }
+  const uint64_t connection_id = next_connection_id_++;
+  if (connected_subchannel_ != nullptr) {
+    // An additional connection for the pool.  The subchannel is already
+    // READY, so there is no state to report.
+    PooledConnection connection;
+    connection.id = connection_id;
+    connection.connected_subchannel =
+        MakeRefCounted<ConnectedSubchannel>(stk, args_, channelz_node_);
+    connection.socket = std::move(socket);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
+      gpr_log(GPR_INFO, "subchannel %p %s: new pooled connection at %p", this,
+              key_.ToString().c_str(), connection.connected_subchannel.get());
+    }
+    connection.connected_subchannel->StartWatch(
+        pollset_set_,
+        MakeOrphanable<ConnectedSubchannelStateWatcher>(
+            WeakRef(DEBUG_LOCATION, "state_watcher"), connection_id));
+    pooled_connections_.push_back(std::move(connection));
+    return true;
+  }
   // Publish.
   connected_subchannel_.reset(
       new ConnectedSubchannel(stk, args_, channelz_node_));
+  connected_subchannel_id_ = connection_id;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_trace_subchannel)) {
     gpr_log(GPR_INFO, "subchannel %p %s: new connected subchannel at %p", this,
             key_.ToString().c_str(), connected_subchannel_.get());
@@ -1004,8 +1250,9 @@ bool Subchannel::PublishTransportLocked() {
   }
   // Start watching connected subchannel.
   connected_subchannel_->StartWatch(
-      pollset_set_, MakeOrphanable<ConnectedSubchannelStateWatcher>(
-                        WeakRef(DEBUG_LOCATION, "state_watcher")));
+      pollset_set_,
+      MakeOrphanable<ConnectedSubchannelStateWatcher>(
+          WeakRef(DEBUG_LOCATION, "state_watcher"), connection_id));
   // Report initial state.
   SetConnectivityStateLocked(GRPC_CHANNEL_READY, absl::Status());
   return true;
@@ -19,18 +19,27 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
 
 #include "src/core/ext/filters/client_channel/client_channel_channelz.h"
 #include "src/core/ext/filters/client_channel/connector.h"
+#include "src/core/ext/filters/client_channel/subchannel_interface.h"
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
 #include "src/core/lib/backoff/backoff.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/gpr/time_precise.h"
 #include "src/core/lib/gprpp/dual_ref_counted.h"
+#include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/polling_entity.h"
 #include "src/core/lib/iomgr/timer.h"
 #include "src/core/lib/resource_quota/arena.h"
@@ -39,6 +48,7 @@
 namespace grpc_core {
 
 class SubchannelCall;
+class SubchannelStreamClient;
 
 class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
  public:
@@ -60,12 +70,20 @@ class ConnectedSubchannel : public RefCounted<ConnectedSubchannel> {
 
   size_t GetInitialCallSizeEstimate() const;
 
+  // Number of SubchannelCalls currently using this connection.
+  size_t active_calls() const {
+    return active_calls_.load(std::memory_order_relaxed);
+  }
+
  private:
+  friend class SubchannelCall;
+
   grpc_channel_stack* channel_stack_;
   grpc_channel_args* args_;
   // ref counted pointer to the channelz node in this connected subchannel's
   // owning subchannel.
   RefCountedPtr<channelz::SubchannelNode> channelz_subchannel_;
+  std::atomic<size_t> active_calls_{0};
 };
 
 // Implements the interface of RefCounted<>.
@@ -230,11 +248,29 @@ class Subchannel : public DualRefCounted<Subchannel> {
       const absl::optional<std::string>& health_check_service_name,
       ConnectivityStateWatcherInterface* watcher) ABSL_LOCKS_EXCLUDED(mu_);
 
+  // Starts watching out-of-band backend metric reports.  While there are
+  // watchers and the subchannel is READY, an ORCA stream is kept open on
+  // the subchannel's connection, asking for reports at the shortest
+  // interval that any watcher wants.
+  // The watcher will be destroyed either when the subchannel is
+  // destroyed or when CancelOobBackendMetricWatch() is called.
+  void WatchOobBackendMetrics(
+      Duration report_interval,
+      std::unique_ptr<SubchannelInterface::OobBackendMetricWatcherInterface>
+          watcher) ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Cancels an out-of-band backend metric watch.  Once this returns, the
+  // watcher will not be called again.
+  void CancelOobBackendMetricWatch(
+      SubchannelInterface::OobBackendMetricWatcherInterface* watcher)
+      ABSL_LOCKS_EXCLUDED(mu_);
+
+  // Returns the connection a new call should use, or null if the subchannel
+  // is not connected. When connection pooling is enabled, this is the least
+  // loaded connection, and another connection is started if all of them are
+  // saturated.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel()
-      ABSL_LOCKS_EXCLUDED(mu_) {
-    MutexLock lock(&mu_);
-    return connected_subchannel_;
-  }
+      ABSL_LOCKS_EXCLUDED(mu_);
 
   // Attempt to connect to the backend.  Has no effect if already connected.
   void AttemptToConnect() ABSL_LOCKS_EXCLUDED(mu_);
@@ -299,6 +335,10 @@ class Subchannel : public DualRefCounted<Subchannel> {
         Subchannel* subchannel, const std::string& health_check_service_name)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Subchannel::mu_);
 
+    // Restarts health checks on a new connected_subchannel_.
+    void RestartHealthCheckingLocked()
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&Subchannel::mu_);
+
     void ShutdownLocked();
 
    private:
@@ -307,6 +347,38 @@ class Subchannel : public DualRefCounted<Subchannel> {
     std::map<std::string, OrphanablePtr<HealthWatcher>> map_;
   };
 
+  // Out-of-band backend metric watchers.  Reports arrive on the ORCA
+  // stream and are delivered under this list's own lock rather than mu_,
+  // so that they never wait on (or deadlock with) the subchannel.
+  class OobBackendMetricWatcherList
+      : public RefCounted<OobBackendMetricWatcherList> {
+   public:
+    void Add(Duration report_interval,
+             std::unique_ptr<
+                 SubchannelInterface::OobBackendMetricWatcherInterface>
+                 watcher) ABSL_LOCKS_EXCLUDED(mu_);
+    void Remove(SubchannelInterface::OobBackendMetricWatcherInterface* watcher)
+        ABSL_LOCKS_EXCLUDED(mu_);
+    void Clear() ABSL_LOCKS_EXCLUDED(mu_);
+
+    // Returns the shortest report interval asked for, or nullopt if there
+    // are no watchers.
+    absl::optional<Duration> MinReportInterval() ABSL_LOCKS_EXCLUDED(mu_);
+
+    void Notify(const BackendMetricData& data) ABSL_LOCKS_EXCLUDED(mu_);
+
+   private:
+    struct Watcher {
+      Duration report_interval;
+      std::unique_ptr<SubchannelInterface::OobBackendMetricWatcherInterface>
+          watcher;
+    };
+
+    Mutex mu_;
+    std::map<SubchannelInterface::OobBackendMetricWatcherInterface*, Watcher>
+        watchers_ ABSL_GUARDED_BY(mu_);
+  };
+
   class ConnectedSubchannelStateWatcher;
 
   class AsyncWatcherNotifierLocked;
@@ -316,6 +388,12 @@ class Subchannel : public DualRefCounted<Subchannel> {
                                   const absl::Status& status)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Starts, stops or restarts the ORCA stream to match the subchannel's
+  // state and oob_backend_metric_watchers_.  If restart is true, an
+  // existing stream is restarted even if nothing else changed, to move it
+  // to a new connected_subchannel_.
+  void UpdateOrcaClientLocked(bool restart) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Methods for connection.
   void MaybeStartConnectingLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
   static void OnRetryAlarm(void* arg, grpc_error_handle error)
@@ -324,6 +402,8 @@ class Subchannel : public DualRefCounted<Subchannel> {
   static void OnConnectingFinished(void* arg, grpc_error_handle error)
       ABSL_LOCKS_EXCLUDED(mu_);
   bool PublishTransportLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Starts an additional connection for the pool, if allowed.
+  void MaybeGrowConnectionPoolLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // The subchannel pool this subchannel is in.
   RefCountedPtr<SubchannelPoolInterface> subchannel_pool_;
@@ -347,9 +427,30 @@ class Subchannel : public DualRefCounted<Subchannel> {
   // Protects the other members.
   Mutex mu_;
 
-  // Active connection, or null.
+  // Active connection, or null.  Its state drives the subchannel's state.
   RefCountedPtr<ConnectedSubchannel> connected_subchannel_ ABSL_GUARDED_BY(mu_);
+  // Identifies connected_subchannel_ to its ConnectedSubchannelStateWatcher.
+  uint64_t connected_subchannel_id_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t next_connection_id_ ABSL_GUARDED_BY(mu_) = 1;
   bool connecting_ ABSL_GUARDED_BY(mu_) = false;
+  // Whether the current connection attempt is for an additional connection
+  // rather than for connected_subchannel_.
+  bool connecting_pooled_ ABSL_GUARDED_BY(mu_) = false;
+
+  // Connection pooling.  Additional connections only exist while
+  // connected_subchannel_ does; if it fails, one of them takes its place.
+  struct PooledConnection {
+    uint64_t id;
+    RefCountedPtr<ConnectedSubchannel> connected_subchannel;
+    RefCountedPtr<channelz::SocketNode> socket;
+  };
+  std::vector<PooledConnection> pooled_connections_ ABSL_GUARDED_BY(mu_);
+  // Cap on connections, including connected_subchannel_.
+  const size_t max_connections_;
+  // Calls on a connection at which it is considered saturated.
+  const size_t max_streams_per_connection_;
+  // Earliest time to retry growing the pool after a failed attempt.
+  Timestamp next_pool_attempt_ ABSL_GUARDED_BY(mu_);
   bool disconnected_ ABSL_GUARDED_BY(mu_) = false;
 
   // Connectivity state tracking.
@@ -359,6 +460,12 @@ class Subchannel : public DualRefCounted<Subchannel> {
   ConnectivityStateWatcherList watcher_list_ ABSL_GUARDED_BY(mu_);
   // The map of watchers with health check service names.
   HealthWatcherMap health_watcher_map_ ABSL_GUARDED_BY(mu_);
+  // Out-of-band backend metric watchers, and the ORCA stream that feeds
+  // them while the subchannel is READY.
+  const RefCountedPtr<OobBackendMetricWatcherList>
+      oob_backend_metric_watchers_;
+  OrphanablePtr<SubchannelStreamClient> orca_client_ ABSL_GUARDED_BY(mu_);
+  Duration orca_report_interval_ ABSL_GUARDED_BY(mu_);
 
   // Minimum connect timeout - must be located before backoff_.
   Duration min_connect_timeout_ ABSL_GUARDED_BY(mu_);
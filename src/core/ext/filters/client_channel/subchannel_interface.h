@@ -24,7 +24,9 @@
 #include <grpc/impl/codegen/connectivity_state.h>
 #include <grpc/impl/codegen/grpc_types.h>
 
+#include "src/core/ext/filters/client_channel/backend_metric_data.h"
 #include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/iomgr/pollset_set.h"
 
 namespace grpc_core {
@@ -47,6 +49,17 @@ class SubchannelInterface : public RefCounted<SubchannelInterface> {
     virtual grpc_pollset_set* interested_parties() = 0;
   };
 
+  class OobBackendMetricWatcherInterface {
+   public:
+    virtual ~OobBackendMetricWatcherInterface() = default;
+
+    // Will be invoked for each out-of-band backend metric report.  This
+    // is called from whatever thread received the report, not from the
+    // WorkSerializer, and must not call back into the subchannel.  The
+    // data is valid only for the duration of the call.
+    virtual void OnBackendMetricReport(const BackendMetricData& data) = 0;
+  };
+
   explicit SubchannelInterface(const char* trace = nullptr)
       : RefCounted<SubchannelInterface>(trace) {}
 
@@ -75,6 +88,21 @@ class SubchannelInterface : public RefCounted<SubchannelInterface> {
   virtual void CancelConnectivityStateWatch(
       ConnectivityStateWatcherInterface* watcher) = 0;
 
+  // Starts watching out-of-band backend metric reports, which the backend
+  // is asked to send every report_interval while the subchannel is
+  // connected.  All watchers of a subchannel share one stream, at the
+  // shortest interval any of them asks for.
+  // The watcher will be destroyed either when the subchannel is
+  // destroyed or when CancelOobBackendMetricWatch() is called.
+  virtual void WatchOobBackendMetrics(
+      Duration report_interval,
+      std::unique_ptr<OobBackendMetricWatcherInterface> watcher) = 0;
+
+  // Cancels an out-of-band backend metric watch.  Once this returns, the
+  // watcher will not be called again.
+  virtual void CancelOobBackendMetricWatch(
+      OobBackendMetricWatcherInterface* watcher) = 0;
+
   // Attempt to connect to the backend.  Has no effect if already connected.
   // If the subchannel is currently in backoff delay due to a previously
   // failed attempt, the new connection attempt will not start until the
@@ -115,6 +143,16 @@ class DelegatingSubchannel : public SubchannelInterface {
       ConnectivityStateWatcherInterface* watcher) override {
     return wrapped_subchannel_->CancelConnectivityStateWatch(watcher);
   }
+  void WatchOobBackendMetrics(
+      Duration report_interval,
+      std::unique_ptr<OobBackendMetricWatcherInterface> watcher) override {
+    wrapped_subchannel_->WatchOobBackendMetrics(report_interval,
+                                                std::move(watcher));
+  }
+  void CancelOobBackendMetricWatch(
+      OobBackendMetricWatcherInterface* watcher) override {
+    wrapped_subchannel_->CancelOobBackendMetricWatch(watcher);
+  }
   void AttemptToConnect() override { wrapped_subchannel_->AttemptToConnect(); }
   void ResetBackoff() override { wrapped_subchannel_->ResetBackoff(); }
   const grpc_channel_args* channel_args() override {
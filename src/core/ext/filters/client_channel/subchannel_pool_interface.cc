@@ -20,6 +20,13 @@
 
 #include "src/core/ext/filters/client_channel/subchannel_pool_interface.h"
 
+#include <string.h>
+
+#include <tuple>
+
+#include "absl/hash/hash.h"
+#include "absl/strings/string_view.h"
+
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/gpr/useful.h"
 
@@ -57,17 +64,20 @@ SubchannelKey& SubchannelKey::operator=(const SubchannelKey& other) {
 SubchannelKey::SubchannelKey(SubchannelKey&& other) noexcept {
   address_ = other.address_;
   args_ = other.args_;
+  hash_ = other.hash_;
   other.args_ = nullptr;
 }
 
 SubchannelKey& SubchannelKey::operator=(SubchannelKey&& other) noexcept {
   address_ = other.address_;
   args_ = other.args_;
+  hash_ = other.hash_;
   other.args_ = nullptr;
   return *this;
 }
 
 bool SubchannelKey::operator<(const SubchannelKey& other) const {
+  if (hash_ != other.hash_) return hash_ < other.hash_;
   if (address_.len < other.address_.len) return true;
   if (address_.len > other.address_.len) return false;
   int r = memcmp(address_.addr, other.address_.addr, address_.len);
@@ -81,6 +91,32 @@ void SubchannelKey::Init(
     grpc_channel_args* (*copy_channel_args)(const grpc_channel_args* args)) {
   address_ = address;
   args_ = copy_channel_args(args);
+  hash_ = absl::Hash<absl::string_view>()(
+      absl::string_view(address_.addr, address_.len));
+  if (args_ == nullptr) return;
+  // Must agree with grpc_channel_args_compare(), which args_ are compared
+  // with: pointer args are compared through their vtable, so only their key
+  // goes into the hash.
+  for (size_t i = 0; i < args_->num_args; i++) {
+    const grpc_arg& arg = args_->args[i];
+    switch (arg.type) {
+      case GRPC_ARG_STRING:
+        hash_ = absl::Hash<
+            std::tuple<size_t, absl::string_view, absl::string_view>>()(
+            std::make_tuple(hash_, absl::string_view(arg.key),
+                            absl::string_view(arg.value.string)));
+        break;
+      case GRPC_ARG_INTEGER:
+        hash_ = absl::Hash<std::tuple<size_t, absl::string_view, int>>()(
+            std::make_tuple(hash_, absl::string_view(arg.key),
+                            arg.value.integer));
+        break;
+      case GRPC_ARG_POINTER:
+        hash_ = absl::Hash<std::tuple<size_t, absl::string_view>>()(
+            std::make_tuple(hash_, absl::string_view(arg.key)));
+        break;
+    }
+  }
 }
 
 std::string SubchannelKey::ToString() const {
@@ -21,6 +21,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include "src/core/lib/avl/avl.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/debug/trace.h"
@@ -47,10 +49,15 @@ class SubchannelKey {
   SubchannelKey(SubchannelKey&&) noexcept;
   SubchannelKey& operator=(SubchannelKey&&) noexcept;
 
+  // Orders keys by hash first, so that full channel args only get compared
+  // when the hashes match.
   bool operator<(const SubchannelKey& other) const;
 
   const grpc_resolved_address& address() const { return address_; }
   const grpc_channel_args* args() const { return args_; }
+  // Hash of the address and channel args, computed once at construction.
+  // Equal keys have equal hashes.
+  size_t hash() const { return hash_; }
 
   // Human-readable string suitable for logging.
   std::string ToString() const;
@@ -64,6 +71,7 @@ class SubchannelKey {
 
   grpc_resolved_address address_;
   const grpc_channel_args* args_;
+  size_t hash_;
 };
 
 // Interface for subchannel pool.
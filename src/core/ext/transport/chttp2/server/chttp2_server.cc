@@ -41,6 +41,7 @@
 #include "src/core/ext/filters/http/server/http_server_filter.h"
 #include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
 #include "src/core/ext/transport/chttp2/transport/internal.h"
+#include "src/core/ext/transport/shm/shm_transport.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/handshaker.h"
@@ -48,6 +49,7 @@
 #include "src/core/lib/gprpp/ref_counted.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/resolve_address.h"
 #include "src/core/lib/iomgr/tcp_server.h"
 #include "src/core/lib/iomgr/unix_sockets_posix.h"
@@ -904,11 +906,23 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
   std::vector<grpc_error_handle> error_list;
   std::string parsed_addr = URI::PercentDecode(addr);
   absl::string_view parsed_addr_unprefixed{parsed_addr};
+  // Set for shared-memory addresses: connections accepted on them are moved
+  // over to shared memory by the shm handshaker.
+  bool shm = false;
   // Using lambda to avoid use of goto.
   grpc_error_handle error = [&]() {
     grpc_error_handle error = GRPC_ERROR_NONE;
     if (absl::ConsumePrefix(&parsed_addr_unprefixed, kUnixUriPrefix)) {
       resolved_or = grpc_resolve_unix_domain_address(parsed_addr_unprefixed);
+    } else if (absl::ConsumePrefix(&parsed_addr_unprefixed,
+                                   GRPC_SHM_URI_PREFIX)) {
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+      shm = true;
+      resolved_or = grpc_resolve_unix_domain_address(parsed_addr_unprefixed);
+#else
+      return GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+          "shm: addresses are not supported on this platform");
+#endif
     } else if (absl::ConsumePrefix(&parsed_addr_unprefixed,
                                    kUnixAbstractUriPrefix)) {
       resolved_or =
@@ -927,8 +941,15 @@ grpc_error_handle Chttp2ServerAddPort(Server* server, const char* addr,
         grpc_sockaddr_set_port(&addr, *port_num);
       }
       int port_temp = -1;
-      error = Chttp2ServerListener::Create(server, &addr,
-                                           grpc_channel_args_copy(args),
+      grpc_channel_args* listener_args;
+      if (shm) {
+        grpc_arg arg = grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_SHM_TRANSPORT), 1);
+        listener_args = grpc_channel_args_copy_and_add(args, &arg, 1);
+      } else {
+        listener_args = grpc_channel_args_copy(args);
+      }
+      error = Chttp2ServerListener::Create(server, &addr, listener_args,
                                            args_modifier, &port_temp);
       if (error != GRPC_ERROR_NONE) {
         error_list.push_back(error);
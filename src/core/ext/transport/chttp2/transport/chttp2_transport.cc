@@ -64,6 +64,12 @@ GPR_GLOBAL_CONFIG_DEFINE_BOOL(
     "assume the remote peer does the same. Thus we can ignore any flow control "
     "bookkeeping, error checking, and decision making");
 
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_experimental_bbr_flow_control, false,
+    "If set, the target window of a transport is sized by a BBR-style "
+    "estimator (max bandwidth times min RTT, with startup and probing phases) "
+    "instead of the PID controller.");
+
 #define DEFAULT_CONNECTION_WINDOW_TARGET (1024 * 1024)
 #define MAX_WINDOW 0x7fffffffu
 #define MAX_WRITE_BUFFER_SIZE (64 * 1024 * 1024)
@@ -82,6 +88,11 @@ GPR_GLOBAL_CONFIG_DEFINE_BOOL(
 
 #define DEFAULT_MAX_PENDING_INDUCED_FRAMES 10000
 
+#define MAX_WRITE_COALESCE_DELAY_MS 1000
+// After this many held back writes in a row that nothing else joined, stop
+// holding writes back for 2^MAX_WRITE_COALESCE_MISSES writes.
+#define MAX_WRITE_COALESCE_MISSES 10
+
 static int g_default_client_keepalive_time_ms =
     DEFAULT_CLIENT_KEEPALIVE_TIME_MS;
 static int g_default_client_keepalive_timeout_ms =
@@ -111,6 +122,9 @@ static void write_action_begin_locked(void* t, grpc_error_handle error);
 static void write_action(void* t, grpc_error_handle error);
 static void write_action_end(void* t, grpc_error_handle error);
 static void write_action_end_locked(void* t, grpc_error_handle error);
+static void write_coalesce_timer_expired(void* t, grpc_error_handle error);
+static void write_coalesce_timer_expired_locked(void* t,
+                                                grpc_error_handle error);
 
 static void read_action(void* t, grpc_error_handle error);
 static void read_action_locked(void* t, grpc_error_handle error);
@@ -310,6 +324,18 @@ static bool read_channel_args(grpc_chttp2_transport* t,
                            GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE)) {
       t->write_buffer_size = static_cast<uint32_t>(grpc_channel_arg_get_integer(
           &channel_args->args[i], {0, 0, MAX_WRITE_BUFFER_SIZE}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCE_DELAY_MS)) {
+      t->write_coalesce_delay =
+          grpc_core::Duration::Milliseconds(grpc_channel_arg_get_integer(
+              &channel_args->args[i], {0, 0, MAX_WRITE_COALESCE_DELAY_MS}));
+    } else if (0 == strcmp(channel_args->args[i].key,
+                           GRPC_ARG_HTTP2_WRITE_COALESCE_BYTES)) {
+      t->write_coalesce_bytes =
+          static_cast<uint32_t>(grpc_channel_arg_get_integer(
+              &channel_args->args[i],
+              {static_cast<int>(t->write_coalesce_bytes), 0,
+               MAX_WRITE_BUFFER_SIZE}));
     } else if (0 ==
                strcmp(channel_args->args[i].key, GRPC_ARG_HTTP2_BDP_PROBE)) {
       enable_bdp = grpc_channel_arg_get_bool(&channel_args->args[i], true);
@@ -523,9 +549,14 @@ grpc_chttp2_transport::grpc_chttp2_transport(
 
   static const bool kEnableFlowControl =
       !GPR_GLOBAL_CONFIG_GET(grpc_experimental_disable_flow_control);
+  static const bool kBbrFlowControl =
+      GPR_GLOBAL_CONFIG_GET(grpc_experimental_bbr_flow_control);
   if (kEnableFlowControl) {
-    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(this,
-                                                               enable_bdp);
+    flow_control.Init<grpc_core::chttp2::TransportFlowControl>(
+        this, enable_bdp,
+        kBbrFlowControl
+            ? grpc_core::chttp2::TransportFlowControl::WindowSizing::kBbr
+            : grpc_core::chttp2::TransportFlowControl::WindowSizing::kPid);
   } else {
     flow_control.Init<grpc_core::chttp2::TransportFlowControlDisabled>(this);
     enable_bdp = false;
@@ -581,6 +612,10 @@ static void close_transport_locked(grpc_chttp2_transport* t,
       error = grpc_error_set_int(error, GRPC_ERROR_INT_GRPC_STATUS,
                                  GRPC_STATUS_UNAVAILABLE);
     }
+    if (t->write_coalesce_timer_pending) {
+      // Don't make the close wait out the coalescing delay.
+      grpc_timer_cancel(&t->write_coalesce_timer);
+    }
     if (t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE) {
       if (t->close_transport_on_writes_finished == GRPC_ERROR_NONE) {
         t->close_transport_on_writes_finished =
@@ -882,16 +917,78 @@ static void inc_initiate_write_reason(
   }
 }
 
+// Returns true if a write initiated for this reason only carries stream
+// frames, which can tolerate waiting a little to share a syscall with frames
+// from other streams. Everything else either unblocks the peer (acks, window
+// updates) or tears something down, and goes out immediately.
+static bool write_reason_may_coalesce(
+    grpc_chttp2_initiate_write_reason reason) {
+  switch (reason) {
+    case GRPC_CHTTP2_INITIATE_WRITE_START_NEW_STREAM:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_MESSAGE:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_INITIAL_METADATA:
+    case GRPC_CHTTP2_INITIATE_WRITE_SEND_TRAILING_METADATA:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Decide whether a write starting now should be held back for
+// t->write_coalesce_delay. Holding back only pays off when frames from other
+// streams turn up in the meantime, so we require several open streams and a
+// write that finished within that window; on a quiet connection, or one that
+// runs a single call at a time, waiting would only add latency. Holds that
+// nothing joined make us back off exponentially, which keeps the cost low
+// for traffic that looks busy but is really ping-pong.
+static bool should_coalesce_write(grpc_chttp2_transport* t,
+                                  grpc_chttp2_initiate_write_reason reason) {
+  if (t->write_coalesce_delay == grpc_core::Duration::Zero() ||
+      !write_reason_may_coalesce(reason) ||
+      t->closed_with_error != GRPC_ERROR_NONE ||
+      grpc_chttp2_stream_map_size(&t->stream_map) < 2) {
+    return false;
+  }
+  if (t->write_coalesce_skip > 0) {
+    t->write_coalesce_skip--;
+    return false;
+  }
+  return grpc_core::ExecCtx::Get()->Now() - t->last_write_end <
+         t->write_coalesce_delay;
+}
+
 void grpc_chttp2_initiate_write(grpc_chttp2_transport* t,
                                 grpc_chttp2_initiate_write_reason reason) {
   GPR_TIMER_SCOPE("grpc_chttp2_initiate_write", 0);
 
+  if (t->write_coalesce_timer_pending) {
+    t->write_coalesce_absorbed = true;
+    if (!write_reason_may_coalesce(reason) ||
+        t->write_coalesce_pending_bytes >= t->write_coalesce_bytes) {
+      // Cancelling the timer runs its callback, which begins the held back
+      // write (now including whatever prompted this call).
+      grpc_timer_cancel(&t->write_coalesce_timer);
+    }
+  }
+
   switch (t->write_state) {
     case GRPC_CHTTP2_WRITE_STATE_IDLE:
       inc_initiate_write_reason(reason);
       set_write_state(t, GRPC_CHTTP2_WRITE_STATE_WRITING,
                       grpc_chttp2_initiate_write_reason_string(reason));
       GRPC_CHTTP2_REF_TRANSPORT(t, "writing");
+      if (should_coalesce_write(t, reason)) {
+        GRPC_STATS_INC_HTTP2_WRITES_COALESCED();
+        t->write_coalesce_timer_pending = true;
+        t->write_coalesce_absorbed = false;
+        GRPC_CLOSURE_INIT(&t->write_coalesce_timer_expired_locked,
+                          write_coalesce_timer_expired, t, nullptr);
+        grpc_timer_init(&t->write_coalesce_timer,
+                        grpc_core::ExecCtx::Get()->Now() +
+                            t->write_coalesce_delay,
+                        &t->write_coalesce_timer_expired_locked);
+        break;
+      }
       // Note that the 'write_action_begin_locked' closure is being scheduled
       // on the 'finally_scheduler' of t->combiner. This means that
       // 'write_action_begin_locked' is called only *after* all the other
@@ -930,6 +1027,34 @@ void grpc_chttp2_mark_stream_writable(grpc_chttp2_transport* t,
   }
 }
 
+static void write_coalesce_timer_expired(void* tp, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->combiner->Run(
+      GRPC_CLOSURE_INIT(&t->write_coalesce_timer_expired_locked,
+                        write_coalesce_timer_expired_locked, t, nullptr),
+      GRPC_ERROR_REF(error));
+}
+
+// The timer is cancelled when something needs the held back write to go out
+// sooner, so both expiry and cancellation begin the write. The "writing" ref
+// taken by grpc_chttp2_initiate_write is handed on to
+// write_action_begin_locked.
+static void write_coalesce_timer_expired_locked(
+    void* tp, grpc_error_handle /*error*/) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  GPR_ASSERT(t->write_coalesce_timer_pending);
+  t->write_coalesce_timer_pending = false;
+  if (t->write_coalesce_absorbed) {
+    t->write_coalesce_misses = 0;
+  } else {
+    if (t->write_coalesce_misses < MAX_WRITE_COALESCE_MISSES) {
+      t->write_coalesce_misses++;
+    }
+    t->write_coalesce_skip = 1u << t->write_coalesce_misses;
+  }
+  write_action_begin_locked(t, GRPC_ERROR_NONE);
+}
+
 static const char* begin_writing_desc(bool partial) {
   if (partial) {
     return "begin partial write in background";
@@ -943,6 +1068,7 @@ static void write_action_begin_locked(void* gt,
   GPR_TIMER_SCOPE("write_action_begin_locked", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(gt);
   GPR_ASSERT(t->write_state != GRPC_CHTTP2_WRITE_STATE_IDLE);
+  t->write_coalesce_pending_bytes = 0;
   grpc_chttp2_begin_write_result r;
   if (t->closed_with_error != GRPC_ERROR_NONE) {
     r.writing = false;
@@ -1002,6 +1128,7 @@ static void write_action_end(void* tp, grpc_error_handle error) {
 static void write_action_end_locked(void* tp, grpc_error_handle error) {
   GPR_TIMER_SCOPE("terminate_writing_with_lock", 0);
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(tp);
+  t->last_write_end = grpc_core::ExecCtx::Get()->Now();
 
   bool closed = false;
   if (error != GRPC_ERROR_NONE) {
@@ -1534,6 +1661,7 @@ static void perform_stream_op_locked(void* stream_op,
       } else {
         s->write_buffering = false;
       }
+      t->write_coalesce_pending_bytes += len;
       continue_fetching_send_locked(t, s);
       maybe_become_writable_due_to_send_msg(t, s);
     }
@@ -2654,7 +2782,8 @@ static void continue_read_action_locked(grpc_chttp2_transport* t) {
   const bool urgent = t->goaway_error != GRPC_ERROR_NONE;
   GRPC_CLOSURE_INIT(&t->read_action_locked, read_action, t,
                     grpc_schedule_on_exec_ctx);
-  grpc_endpoint_read(t->ep, &t->read_buffer, &t->read_action_locked, urgent);
+  grpc_endpoint_read(t->ep, &t->read_buffer, &t->read_action_locked, urgent,
+                     grpc_chttp2_min_read_progress_size(t));
   grpc_chttp2_act_on_flowctl_action(t->flow_control->MakeAction(), t, nullptr);
 }
 
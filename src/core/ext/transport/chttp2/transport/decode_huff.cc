@@ -0,0 +1,95 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/chttp2/transport/decode_huff.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
+
+namespace grpc_core {
+
+constexpr int HuffDecoder::kLookupBits;
+
+HuffDecoder::Tables::Tables() {
+  memset(lookup, 0, sizeof(lookup));
+  memset(first_code, 0, sizeof(first_code));
+  memset(count, 0, sizeof(count));
+  memset(offset, 0, sizeof(offset));
+  // Order symbols by (length, code): the HPACK code is canonical, so codes of
+  // the same length are consecutive integers.
+  for (uint16_t i = 0; i < GRPC_CHTTP2_NUM_HUFFSYMS; i++) symbols[i] = i;
+  std::sort(symbols, symbols + GRPC_CHTTP2_NUM_HUFFSYMS,
+            [](uint16_t a, uint16_t b) {
+              const grpc_chttp2_huffsym& x = grpc_chttp2_huffsyms[a];
+              const grpc_chttp2_huffsym& y = grpc_chttp2_huffsyms[b];
+              if (x.length != y.length) return x.length < y.length;
+              return x.bits < y.bits;
+            });
+  for (int i = GRPC_CHTTP2_NUM_HUFFSYMS - 1; i >= 0; i--) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[symbols[i]];
+    GPR_ASSERT(sym.length < 31);
+    first_code[sym.length] = sym.bits;
+    offset[sym.length] = static_cast<uint16_t>(i);
+    count[sym.length]++;
+  }
+  // Single symbol entries.
+  for (int i = 0; i < 256; i++) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[i];
+    if (sym.length > kLookupBits) continue;
+    const int shift = kLookupBits - sym.length;
+    for (uint32_t j = 0; j < (1u << shift); j++) {
+      Entry& entry = lookup[(sym.bits << shift) | j];
+      entry.first_length = static_cast<uint8_t>(sym.length);
+      entry.total_length = static_cast<uint8_t>(sym.length);
+      entry.first = static_cast<uint8_t>(i);
+    }
+  }
+  // Pair up with a second symbol whenever the remaining bits complete one.
+  for (uint32_t i = 0; i < (1u << kLookupBits); i++) {
+    Entry& entry = lookup[i];
+    if (entry.first_length == 0) continue;
+    const int rest = kLookupBits - entry.first_length;
+    const Entry& next =
+        lookup[(i << entry.first_length) & ((1u << kLookupBits) - 1)];
+    if (next.first_length == 0 || next.first_length > rest) continue;
+    entry.total_length = static_cast<uint8_t>(entry.first_length +
+                                              next.first_length);
+    entry.second = next.first;
+  }
+}
+
+int HuffDecoder::Tables::DecodeLong(uint64_t bits, int* length) const {
+  for (int len = kLookupBits + 1; len < 31; len++) {
+    const uint32_t code = static_cast<uint32_t>(bits >> (64 - len));
+    if (code - first_code[len] < count[len]) {
+      *length = len;
+      return symbols[offset[len] + code - first_code[len]];
+    }
+  }
+  return -1;
+}
+
+const HuffDecoder::Tables& HuffDecoder::GetTables() {
+  static const Tables* const tables = new Tables();
+  return *tables;
+}
+
+}  // namespace grpc_core
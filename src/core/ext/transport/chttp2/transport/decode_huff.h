@@ -0,0 +1,117 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_DECODE_HUFF_H
+#define GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_DECODE_HUFF_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace grpc_core {
+
+// Table driven decoder for the HPACK static huffman code (RFC 7541 appendix
+// B).
+// Instead of walking the code tree a few bits at a time, the decoder keeps up
+// to 64 bits of input in a register and looks the next kLookupBits bits up in
+// a table that yields the next one or two complete symbols, so the common
+// characters in header values (which have codes of 5 to 8 bits) are decoded
+// two at a time. Codes longer than kLookupBits are rare and are resolved by
+// a canonical code search.
+class HuffDecoder {
+ public:
+  // Number of bits resolved by a single table lookup.
+  static constexpr int kLookupBits = 12;
+
+  // Upper bound on the number of bytes decoded from \a length bytes of huffman
+  // coded input: the shortest code is 5 bits long.
+  static constexpr size_t MaxDecodedLength(size_t length) {
+    return length * 8 / 5;
+  }
+
+  // Decode [begin, end), calling sink(uint8_t) for each decoded byte.
+  // As with the previous state machine decoder, an EOS symbol in the input is
+  // skipped and trailing bits that do not form a complete code are ignored.
+  template <typename Sink>
+  static void Decode(const uint8_t* begin, const uint8_t* end, Sink sink) {
+    const Tables& tables = GetTables();
+    // Pending input bits, most significant bit first. Bits past buffer_len
+    // are always zero.
+    uint64_t buffer = 0;
+    int buffer_len = 0;
+    while (true) {
+      while (buffer_len <= 56 && begin != end) {
+        buffer |= static_cast<uint64_t>(*begin++) << (56 - buffer_len);
+        buffer_len += 8;
+      }
+      if (buffer_len == 0) return;
+      const Entry entry = tables.lookup[buffer >> (64 - kLookupBits)];
+      if (entry.first_length != 0) {
+        if (entry.total_length <= buffer_len) {
+          sink(entry.first);
+          if (entry.total_length != entry.first_length) sink(entry.second);
+          buffer <<= entry.total_length;
+          buffer_len -= entry.total_length;
+          continue;
+        }
+        if (entry.first_length > buffer_len) return;
+        sink(entry.first);
+        buffer <<= entry.first_length;
+        buffer_len -= entry.first_length;
+        continue;
+      }
+      int length;
+      const int symbol = tables.DecodeLong(buffer, &length);
+      if (symbol < 0 || length > buffer_len) return;
+      if (symbol < 256) sink(static_cast<uint8_t>(symbol));
+      buffer <<= length;
+      buffer_len -= length;
+    }
+  }
+
+ private:
+  // Result of looking up kLookupBits bits of input: the first symbol (if its
+  // code fits, otherwise first_length is zero) and, if the rest of the bits
+  // hold another complete code, a second symbol.
+  struct Entry {
+    uint8_t first_length;
+    // first_length plus the length of the second code, if there is one.
+    uint8_t total_length;
+    uint8_t first;
+    uint8_t second;
+  };
+
+  struct Tables {
+    Tables();
+    // Decode a code longer than kLookupBits from the top bits of \a bits.
+    // Returns the symbol (256 for EOS) and sets *length, or returns -1.
+    int DecodeLong(uint64_t bits, int* length) const;
+
+    Entry lookup[1 << kLookupBits];
+    // Canonical code description for each code length: codes of length L
+    // are the range [first_code[L], first_code[L] + count[L]), mapping to
+    // symbols[offset[L]...].
+    uint32_t first_code[31];
+    uint16_t count[31];
+    uint16_t offset[31];
+    uint16_t symbols[257];
+  };
+
+  static const Tables& GetTables();
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_DECODE_HUFF_H
@@ -27,6 +27,7 @@
 
 #include <string>
 
+#include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
 
 #include <grpc/support/alloc.h>
@@ -177,19 +178,22 @@ TransportFlowControlDisabled::TransportFlowControlDisabled(
 }
 
 TransportFlowControl::TransportFlowControl(const grpc_chttp2_transport* t,
-                                           bool enable_bdp_probe)
+                                           bool enable_bdp_probe,
+                                           WindowSizing window_sizing)
     : t_(t),
       enable_bdp_probe_(enable_bdp_probe),
-      bdp_estimator_(t->peer_string.c_str()),
-      pid_controller_(PidController::Args()
-                          .set_gain_p(4)
-                          .set_gain_i(8)
-                          .set_gain_d(0)
-                          .set_initial_control_value(TargetLogBdp())
-                          .set_min_control_value(-1)
-                          .set_max_control_value(25)
-                          .set_integral_range(10)),
-      last_pid_update_(ExecCtx::Get()->Now()) {}
+      bdp_estimator_(t->peer_string.c_str()) {
+  switch (window_sizing) {
+    case WindowSizing::kPid:
+      window_sizing_policy_ = absl::make_unique<PidWindowSizingPolicy>(
+          &bdp_estimator_, MemoryPressure(), ExecCtx::Get()->Now());
+      break;
+    case WindowSizing::kBbr:
+      window_sizing_policy_ =
+          absl::make_unique<BbrWindowSizingPolicy>(&bdp_estimator_);
+      break;
+  }
+}
 
 uint32_t TransportFlowControl::MaybeSendUpdate(bool writing_anyway) {
   FlowControlTrace trace("t updt sent", this, nullptr);
@@ -323,13 +327,17 @@ void StreamFlowControl::IncomingByteStreamUpdate(size_t max_size_hint,
   }
 }
 
+namespace {
+
+// Above kHighMemPressure, windows shrink, until they close at kMaxMemPressure.
+constexpr double kHighMemPressure = 0.8;
+constexpr double kMaxMemPressure = 0.9;
+
 // Take in a target and modifies it based on the memory pressure of the system
-static double AdjustForMemoryPressure(double memory_pressure, double target) {
+double AdjustForMemoryPressure(double memory_pressure, double target) {
   // do not increase window under heavy memory pressure.
   static const double kLowMemPressure = 0.1;
   static const double kZeroTarget = 22;
-  static const double kHighMemPressure = 0.8;
-  static const double kMaxMemPressure = 0.9;
   if (memory_pressure < kLowMemPressure && target < kZeroTarget) {
     target = (target - kZeroTarget) * memory_pressure / kLowMemPressure +
              kZeroTarget;
@@ -340,21 +348,56 @@ static double AdjustForMemoryPressure(double memory_pressure, double target) {
   return target;
 }
 
-double TransportFlowControl::TargetLogBdp() {
-  return AdjustForMemoryPressure(t_->memory_owner.is_valid()
-                                     ? t_->memory_owner.InstantaneousPressure()
-                                     : 0.0,
-                                 1 + log2(bdp_estimator_.EstimateBdp()));
+}  // namespace
+
+PidWindowSizingPolicy::PidWindowSizingPolicy(const BdpEstimator* bdp_estimator,
+                                             double memory_pressure,
+                                             Timestamp now)
+    : bdp_estimator_(bdp_estimator),
+      pid_controller_(PidController::Args()
+                          .set_gain_p(4)
+                          .set_gain_i(8)
+                          .set_gain_d(0)
+                          .set_initial_control_value(
+                              TargetLogBdp(memory_pressure))
+                          .set_min_control_value(-1)
+                          .set_max_control_value(25)
+                          .set_integral_range(10)),
+      last_pid_update_(now) {}
+
+double PidWindowSizingPolicy::TargetLogBdp(double memory_pressure) const {
+  return AdjustForMemoryPressure(memory_pressure,
+                                 1 + log2(bdp_estimator_->EstimateBdp()));
 }
 
-double TransportFlowControl::SmoothLogBdp(double value) {
-  Timestamp now = ExecCtx::Get()->Now();
-  double bdp_error = value - pid_controller_.last_control_value();
+double PidWindowSizingPolicy::Update(double memory_pressure, Timestamp now) {
+  double bdp_error =
+      TargetLogBdp(memory_pressure) - pid_controller_.last_control_value();
   const double dt = (now - last_pid_update_).seconds();
   last_pid_update_ = now;
   // Limit dt to 100ms
   const double kMaxDt = 0.1;
-  return pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt);
+  return pow(2, pid_controller_.Update(bdp_error, dt > kMaxDt ? kMaxDt : dt));
+}
+
+double BbrWindowSizingPolicy::Update(double memory_pressure, Timestamp now) {
+  if (bdp_estimator_->completed_pings() != completed_pings_) {
+    completed_pings_ = bdp_estimator_->completed_pings();
+    bbr_.AddSample(bdp_estimator_->last_ping_bytes(),
+                   bdp_estimator_->last_ping_rtt(),
+                   static_cast<int64_t>(window_), now);
+  }
+  window_ = bbr_.TargetWindow();
+  if (memory_pressure > kHighMemPressure) {
+    window_ *= 1 - std::min(1.0, (memory_pressure - kHighMemPressure) /
+                                     (kMaxMemPressure - kHighMemPressure));
+  }
+  return window_;
+}
+
+double TransportFlowControl::MemoryPressure() const {
+  return t_->memory_owner.is_valid() ? t_->memory_owner.InstantaneousPressure()
+                                     : 0.0;
 }
 
 FlowControlAction::Urgency TransportFlowControl::DeltaUrgency(
@@ -376,7 +419,8 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
     // target might change based on how much memory pressure we are under
     // TODO(ncteisen): experiment with setting target to be huge under low
     // memory pressure.
-    double target = pow(2, SmoothLogBdp(TargetLogBdp()));
+    double target =
+        window_sizing_policy_->Update(MemoryPressure(), ExecCtx::Get()->Now());
     if (g_test_only_transport_target_window_estimates_mocker != nullptr) {
       // Hook for simulating unusual flow control situations in tests.
       target = g_test_only_transport_target_window_estimates_mocker
@@ -393,7 +437,7 @@ FlowControlAction TransportFlowControl::PeriodicUpdate() {
         static_cast<uint32_t>(target_initial_window_size_));
 
     // get bandwidth estimate and update max_frame accordingly.
-    double bw_dbl = bdp_estimator_.EstimateBandwidth();
+    double bw_dbl = window_sizing_policy_->EstimateBandwidth();
     // we target the max of BDP or bandwidth in microseconds.
     int32_t frame_size = static_cast<int32_t>(Clamp(
         std::max(
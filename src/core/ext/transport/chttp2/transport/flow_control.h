@@ -23,9 +23,12 @@
 
 #include <stdint.h>
 
+#include <memory>
+
 #include "src/core/ext/transport/chttp2/transport/http2_settings.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
+#include "src/core/lib/transport/bbr_estimator.h"
 #include "src/core/lib/transport/bdp_estimator.h"
 #include "src/core/lib/transport/pid_controller.h"
 
@@ -222,11 +225,71 @@ class TransportFlowControlDisabled final : public TransportFlowControlBase {
   void RecvUpdate(uint32_t /* size */) override {}
 };
 
+// Decides the target initial window of a transport from the pings of its
+// BdpEstimator. Kept apart from TransportFlowControl so that it can be driven
+// without a transport, as the flow control simulation test does.
+class WindowSizingPolicy {
+ public:
+  virtual ~WindowSizingPolicy() {}
+
+  // Called before the first BDP ping and after each one completes, with the
+  // memory pressure of the transport (between 0 and 1). Returns the new
+  // target initial window, in bytes.
+  virtual double Update(double memory_pressure, Timestamp now) = 0;
+
+  // Estimated bandwidth, in bytes per second.
+  virtual double EstimateBandwidth() const = 0;
+};
+
+// Smooths log2 of twice the BdpEstimator estimate with a PID controller.
+class PidWindowSizingPolicy final : public WindowSizingPolicy {
+ public:
+  PidWindowSizingPolicy(const BdpEstimator* bdp_estimator,
+                        double memory_pressure, Timestamp now);
+
+  double Update(double memory_pressure, Timestamp now) override;
+  double EstimateBandwidth() const override {
+    return bdp_estimator_->EstimateBandwidth();
+  }
+
+ private:
+  double TargetLogBdp(double memory_pressure) const;
+
+  const BdpEstimator* const bdp_estimator_;
+  PidController pid_controller_;
+  Timestamp last_pid_update_;
+};
+
+// Feeds the samples of the BdpEstimator (which still decides when to ping) to
+// a BbrEstimator, and uses its target window. Under high memory pressure the
+// window shrinks linearly, rather than exponentially as it does in the log
+// domain of the PID policy.
+class BbrWindowSizingPolicy final : public WindowSizingPolicy {
+ public:
+  explicit BbrWindowSizingPolicy(const BdpEstimator* bdp_estimator)
+      : bdp_estimator_(bdp_estimator) {}
+
+  double Update(double memory_pressure, Timestamp now) override;
+  double EstimateBandwidth() const override { return bbr_.bandwidth(); }
+
+  const BbrEstimator& bbr_estimator() const { return bbr_; }
+
+ private:
+  const BdpEstimator* const bdp_estimator_;
+  BbrEstimator bbr_;
+  int64_t completed_pings_ = 0;
+  // Last window returned by Update(), which the samples are taken under.
+  double window_ = BbrEstimator::kInitialWindow;
+};
+
 // Implementation of flow control that abides to HTTP/2 spec and attempts
 // to be as performant as possible.
 class TransportFlowControl final : public TransportFlowControlBase {
  public:
-  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe);
+  enum class WindowSizing { kPid, kBbr };
+
+  TransportFlowControl(const grpc_chttp2_transport* t, bool enable_bdp_probe,
+                       WindowSizing window_sizing = WindowSizing::kPid);
   ~TransportFlowControl() override {}
 
   bool flow_control_enabled() const override { return true; }
@@ -302,8 +365,7 @@ class TransportFlowControl final : public TransportFlowControlBase {
   }
 
  private:
-  double TargetLogBdp();
-  double SmoothLogBdp(double value);
+  double MemoryPressure() const;
   FlowControlAction::Urgency DeltaUrgency(int64_t value,
                                           grpc_chttp2_setting_id setting_id);
 
@@ -333,9 +395,8 @@ class TransportFlowControl final : public TransportFlowControlBase {
   /* bdp estimation */
   BdpEstimator bdp_estimator_;
 
-  /* pid controller */
-  PidController pid_controller_;
-  Timestamp last_pid_update_;
+  /* turns bdp estimates into a target window */
+  std::unique_ptr<WindowSizingPolicy> window_sizing_policy_;
 };
 
 // Fat interface with all methods a stream flow control implementation needs
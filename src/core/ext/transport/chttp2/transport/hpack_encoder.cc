@@ -23,7 +23,12 @@
 #include <assert.h>
 #include <string.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <utility>
+
+#include "absl/hash/hash.h"
+#include "absl/memory/memory.h"
 
 #include "src/core/ext/transport/chttp2/transport/hpack_constants.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder_table.h"
@@ -382,14 +387,89 @@ void HPackCompressor::SliceIndex::EmitTo(absl::string_view key,
   values_.emplace_back(value.Ref(), index);
 }
 
-void HPackCompressor::Framer::Encode(const Slice& key, const Slice& value) {
-  if (absl::EndsWith(key.as_string_view(), "-bin")) {
-    EmitLitHdrWithBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+uint8_t HPackCompressor::FrequencySketch::Add(size_t hash) {
+  uint8_t* cells[kDepth];
+  uint8_t estimate = 255;
+  for (size_t i = 0; i < kDepth; i++) {
+    cells[i] = &counters_[i][(hash >> (8 * i)) % kWidth];
+    estimate = std::min(estimate, *cells[i]);
+  }
+  // Conservative update: only bump the counters that hold the minimum, which
+  // keeps collisions from inflating the estimate of rarely seen elements.
+  if (estimate != 255) {
+    for (uint8_t* cell : cells) {
+      if (*cell == estimate) ++*cell;
+    }
+    ++estimate;
+  }
+  if (++adds_since_decay_ == kDecayInterval) {
+    adds_since_decay_ = 0;
+    for (auto& row : counters_) {
+      for (uint8_t& counter : row) counter >>= 1;
+    }
+  }
+  return estimate;
+}
+
+void HPackCompressor::CustomMetadataIndex::EmitTo(const Slice& key,
+                                                  const Slice& value,
+                                                  Framer* framer) {
+  const bool is_binary = absl::EndsWith(key.as_string_view(), "-bin");
+  const uint32_t transport_length =
+      key.length() + value.length() + hpack_constants::kEntryOverhead;
+  auto emit_literal = [&]() {
+    GRPC_STATS_INC_HPACK_SEND_CUSTOM_LITERAL();
+    if (is_binary) {
+      framer->EmitLitHdrWithBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+    } else {
+      framer->EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+    }
+  };
+  if (transport_length > HPackEncoderTable::MaxEntrySize()) {
+    emit_literal();
+    return;
+  }
+  auto& table = framer->compressor_->table_;
+  const size_t hash =
+      absl::Hash<std::pair<absl::string_view, absl::string_view>>()(
+          std::make_pair(key.as_string_view(), value.as_string_view()));
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->hash != hash || it->key != key || it->value != value) continue;
+    if (table.ConvertableToDynamicIndex(it->index)) {
+      GRPC_STATS_INC_HPACK_SEND_CUSTOM_INDEXED();
+      framer->EmitIndexed(table.DynamicIndex(it->index));
+      return;
+    }
+    // Evicted since: let the sketch decide whether it is still worth adding.
+    entries_.erase(it);
+    break;
+  }
+  if (sketch_ == nullptr) sketch_ = absl::make_unique<FrequencySketch>();
+  if (sketch_->Add(hash) < kIndexThreshold) {
+    emit_literal();
+    return;
+  }
+  GRPC_STATS_INC_HPACK_SEND_CUSTOM_ADDED();
+  // Drop whatever has been evicted from the table in the meantime.
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [&table](const Entry& entry) {
+                                  return !table.ConvertableToDynamicIndex(
+                                      entry.index);
+                                }),
+                 entries_.end());
+  entries_.push_back(Entry{hash, key.Ref(), value.Ref(),
+                           table.AllocateIndex(transport_length)});
+  if (is_binary) {
+    framer->EmitLitHdrWithBinaryStringKeyIncIdx(key.Ref(), value.Ref());
   } else {
-    EmitLitHdrWithNonBinaryStringKeyNotIdx(key.Ref(), value.Ref());
+    framer->EmitLitHdrWithNonBinaryStringKeyIncIdx(key.Ref(), value.Ref());
   }
 }
 
+void HPackCompressor::Framer::Encode(const Slice& key, const Slice& value) {
+  compressor_->custom_index_.EmitTo(key, value, this);
+}
+
 void HPackCompressor::Framer::Encode(HttpPathMetadata, const Slice& value) {
   compressor_->path_index_.EmitTo(HttpPathMetadata::key(), value, this);
 }
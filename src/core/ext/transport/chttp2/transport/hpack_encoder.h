@@ -22,6 +22,8 @@
 #include <grpc/support/port_platform.h>
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include <grpc/slice.h>
 #include <grpc/slice_buffer.h>
@@ -37,6 +39,7 @@ namespace grpc_core {
 
 class HPackCompressor {
   class SliceIndex;
+  class CustomMetadataIndex;
 
  public:
   HPackCompressor() = default;
@@ -110,6 +113,7 @@ class HPackCompressor {
 
    private:
     friend class SliceIndex;
+    friend class CustomMetadataIndex;
 
     struct FramePrefix {
       // index (in output_) of the header for the frame
@@ -184,6 +188,47 @@ class HPackCompressor {
     std::vector<ValueIndex> values_;
   };
 
+  // Count-min sketch estimating how often each custom metadata element was
+  // sent on this connection recently. Counters are halved every kDecayInterval
+  // additions so that elements that stop repeating are forgotten.
+  class FrequencySketch {
+   public:
+    // Record one more occurrence of the element with the given hash, and
+    // return the estimated number of recent occurrences (including this one).
+    uint8_t Add(size_t hash);
+
+   private:
+    static constexpr size_t kDepth = 4;
+    static constexpr size_t kWidth = 256;
+    static constexpr uint32_t kDecayInterval = kWidth;
+    uint8_t counters_[kDepth][kWidth] = {};
+    uint32_t adds_since_decay_ = 0;
+  };
+
+  // Indexing policy for metadata that has no dedicated encoder: elements are
+  // only added to the dynamic table once they have been seen repeating, so
+  // that high cardinality values (request ids and the like) go out as
+  // literals without evicting the entries that do get reused.
+  class CustomMetadataIndex {
+   public:
+    void EmitTo(const Slice& key, const Slice& value, Framer* framer);
+
+   private:
+    // Occurrences after which an element is added to the table.
+    static constexpr uint8_t kIndexThreshold = 2;
+
+    struct Entry {
+      size_t hash;
+      Slice key;
+      Slice value;
+      uint32_t index;
+    };
+    // Allocated on first use: most connections never send custom metadata.
+    std::unique_ptr<FrequencySketch> sketch_;
+    // Elements that were added to the table.
+    std::vector<Entry> entries_;
+  };
+
   struct PreviousTimeout {
     Timeout timeout;
     uint32_t index;
@@ -211,6 +256,7 @@ class HPackCompressor {
   Slice user_agent_;
   SliceIndex path_index_;
   SliceIndex authority_index_;
+  CustomMetadataIndex custom_index_;
   std::vector<PreviousTimeout> previous_timeouts_;
 };
 
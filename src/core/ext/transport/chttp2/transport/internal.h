@@ -357,6 +357,26 @@ struct grpc_chttp2_transport {
    */
   uint32_t write_buffer_size = grpc_core::chttp2::kDefaultWindow;
 
+  /** write coalescing: latency tolerant writes may be held back for up to
+      this long while the connection is busy; zero disables coalescing */
+  grpc_core::Duration write_coalesce_delay;
+  /** flush a held back write early once this many message bytes are queued */
+  uint32_t write_coalesce_bytes = 64 * 1024;
+  /** message bytes queued since the held back write was started */
+  size_t write_coalesce_pending_bytes = 0;
+  /** is a write being held back by write_coalesce_timer? */
+  bool write_coalesce_timer_pending = false;
+  /** did another write join the one being held back? */
+  bool write_coalesce_absorbed = false;
+  /** consecutive held back writes that nothing joined */
+  uint8_t write_coalesce_misses = 0;
+  /** writes to send straight away before trying to hold one back again */
+  uint32_t write_coalesce_skip = 0;
+  grpc_timer write_coalesce_timer;
+  grpc_closure write_coalesce_timer_expired_locked;
+  /** when the last write to the endpoint finished */
+  grpc_core::Timestamp last_write_end;
+
   /** Set to a grpc_error object if a goaway frame is received. By default, set
    * to GRPC_ERROR_NONE */
   grpc_error_handle goaway_error = GRPC_ERROR_NONE;
@@ -678,6 +698,11 @@ void grpc_chttp2_end_write(grpc_chttp2_transport* t, grpc_error_handle error);
     viable after reading, or 0 if the connection should be torn down */
 grpc_error_handle grpc_chttp2_perform_read(grpc_chttp2_transport* t,
                                            const grpc_slice& slice);
+/** The number of bytes the deframer needs before it can make progress: the
+    rest of the connection preface, frame header or frame currently being
+    read. The peer has already committed to sending all of them, so it is
+    safe to hold reads back until they have arrived. */
+int grpc_chttp2_min_read_progress_size(grpc_chttp2_transport* t);
 
 bool grpc_chttp2_list_add_writable_stream(grpc_chttp2_transport* t,
                                           grpc_chttp2_stream* s);
@@ -20,158 +20,151 @@
 
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 
-#include <string.h>
+#include <stdlib.h>
+
+#include <vector>
 
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+/* Fibonacci hashing: stream ids on a connection are sequential (and of the
+   same parity), the multiplication spreads them over the whole table */
+static size_t home_slot(const grpc_chttp2_stream_map* map, uint32_t key) {
+  return static_cast<size_t>((key * 2654435769u) >>
+                             (32 - map->capacity_log2)) &
+         (map->capacity - 1);
+}
+
+static void alloc_slots(grpc_chttp2_stream_map* map, uint32_t capacity_log2) {
+  map->capacity_log2 = capacity_log2;
+  map->capacity = static_cast<size_t>(1) << capacity_log2;
+  map->slots = static_cast<grpc_chttp2_stream_map_slot*>(
+      gpr_zalloc(sizeof(grpc_chttp2_stream_map_slot) * map->capacity));
+}
+
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity) {
   GPR_DEBUG_ASSERT(initial_capacity > 1);
-  map->keys =
-      static_cast<uint32_t*>(gpr_malloc(sizeof(uint32_t) * initial_capacity));
-  map->values =
-      static_cast<void**>(gpr_malloc(sizeof(void*) * initial_capacity));
+  uint32_t capacity_log2 = 1;
+  while ((static_cast<size_t>(1) << capacity_log2) < initial_capacity) {
+    capacity_log2++;
+  }
+  alloc_slots(map, capacity_log2);
   map->count = 0;
-  map->free = 0;
-  map->capacity = initial_capacity;
+  map->last_key = 0;
 }
 
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map) {
-  gpr_free(map->keys);
-  gpr_free(map->values);
+  gpr_free(map->slots);
 }
 
-static size_t compact(uint32_t* keys, void** values, size_t count) {
-  size_t i, out;
+/* insert a key known not to be in the map, without growing it */
+static void insert(grpc_chttp2_stream_map* map, uint32_t key, void* value) {
+  const size_t mask = map->capacity - 1;
+  size_t i = home_slot(map, key);
+  while (map->slots[i].value != nullptr) i = (i + 1) & mask;
+  map->slots[i].key = key;
+  map->slots[i].value = value;
+}
 
-  for (i = 0, out = 0; i < count; i++) {
-    if (values[i]) {
-      keys[out] = keys[i];
-      values[out] = values[i];
-      out++;
+static void grow(grpc_chttp2_stream_map* map) {
+  grpc_chttp2_stream_map_slot* old_slots = map->slots;
+  const size_t old_capacity = map->capacity;
+  alloc_slots(map, map->capacity_log2 + 1);
+  for (size_t i = 0; i < old_capacity; i++) {
+    if (old_slots[i].value != nullptr) {
+      insert(map, old_slots[i].key, old_slots[i].value);
     }
   }
-
-  return out;
+  gpr_free(old_slots);
 }
 
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
-  size_t count = map->count;
-  size_t capacity = map->capacity;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-
-  // The first assertion ensures that the table is monotonically increasing.
-  GPR_ASSERT(count == 0 || keys[count - 1] < key);
+  // The first assertion ensures that keys are monotonically increasing.
+  GPR_ASSERT(map->count == 0 || map->last_key < key);
   GPR_DEBUG_ASSERT(value);
   // Asserting that the key is not already in the map can be a debug assertion.
-  // Why: we're already checking that the map elements are monotonically
-  // increasing. If we re-add a key, i.e. if the key is already present, then
-  // either it is the most recently added key in the map (in which case the
-  // first assertion fails due to key == last_key) or there is a more recently
-  // added (larger) key at the end of the map: in which case the first assertion
-  // still fails due to key < last_key.
+  // Why: we're already checking that keys are monotonically increasing, so
+  // re-adding a key would fail the first assertion.
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
 
-  if (count == capacity) {
-    if (map->free > capacity / 4) {
-      count = compact(keys, values, count);
-      map->free = 0;
-    } else {
-      /* resize when less than 25% of the table is free, because compaction
-         won't help much */
-      map->capacity = capacity = 2 * capacity;
-      map->keys = keys = static_cast<uint32_t*>(
-          gpr_realloc(keys, capacity * sizeof(uint32_t)));
-      map->values = values =
-          static_cast<void**>(gpr_realloc(values, capacity * sizeof(void*)));
-    }
-  }
-
-  keys[count] = key;
-  values[count] = value;
-  map->count = count + 1;
+  /* keep the load factor under 3/4 */
+  if ((map->count + 1) * 4 > map->capacity * 3) grow(map);
+  insert(map, key, value);
+  map->count++;
+  map->last_key = key;
 }
 
-template <bool strict_find>
-static void** find(grpc_chttp2_stream_map* map, uint32_t key) {
-  size_t min_idx = 0;
-  size_t max_idx = map->count;
-  size_t mid_idx;
-  uint32_t* keys = map->keys;
-  void** values = map->values;
-  uint32_t mid_key;
-
-  GPR_DEBUG_ASSERT(!strict_find || max_idx > 0);
-  if (!strict_find && max_idx == 0) return nullptr;
-
-  while (min_idx < max_idx) {
-    /* find the midpoint, avoiding overflow */
-    mid_idx = min_idx + ((max_idx - min_idx) / 2);
-    mid_key = keys[mid_idx];
-
-    if (mid_key < key) {
-      min_idx = mid_idx + 1;
-    } else if (mid_key > key) {
-      max_idx = mid_idx;
-    } else /* mid_key == key */
-    {
-      return &values[mid_idx];
-    }
+static grpc_chttp2_stream_map_slot* find(grpc_chttp2_stream_map* map,
+                                         uint32_t key) {
+  const size_t mask = map->capacity - 1;
+  for (size_t i = home_slot(map, key);; i = (i + 1) & mask) {
+    grpc_chttp2_stream_map_slot* slot = &map->slots[i];
+    if (slot->value == nullptr) return nullptr;
+    if (slot->key == key) return slot;
   }
-
-  GPR_DEBUG_ASSERT(!strict_find);
-  return nullptr;
 }
 
 void* grpc_chttp2_stream_map_delete(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<true>(map, key);
-  GPR_DEBUG_ASSERT(pvalue != nullptr);
-  void* out = *pvalue;
-  GPR_DEBUG_ASSERT(out != nullptr);
-  *pvalue = nullptr;
-  map->free++;
-  /* recognize complete emptyness and ensure we can skip
-     defragmentation later */
-  if (map->free == map->count) {
-    map->free = map->count = 0;
+  grpc_chttp2_stream_map_slot* slot = find(map, key);
+  GPR_DEBUG_ASSERT(slot != nullptr);
+  if (slot == nullptr) return nullptr;
+  void* out = slot->value;
+  /* backward shift deletion: move later members of the probe sequence into
+     the hole, unless that would place them before their home slot */
+  const size_t mask = map->capacity - 1;
+  size_t hole = static_cast<size_t>(slot - map->slots);
+  for (size_t i = (hole + 1) & mask; map->slots[i].value != nullptr;
+       i = (i + 1) & mask) {
+    const size_t home = home_slot(map, map->slots[i].key);
+    /* can the entry at i stay? only if its home is cyclically in (hole, i] */
+    const bool stays =
+        hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+    if (stays) continue;
+    map->slots[hole] = map->slots[i];
+    hole = i;
   }
+  map->slots[hole].key = 0;
+  map->slots[hole].value = nullptr;
+  map->count--;
   GPR_DEBUG_ASSERT(grpc_chttp2_stream_map_find(map, key) == nullptr);
   return out;
 }
 
 void* grpc_chttp2_stream_map_find(grpc_chttp2_stream_map* map, uint32_t key) {
-  void** pvalue = find<false>(map, key);
-  return pvalue != nullptr ? *pvalue : nullptr;
+  grpc_chttp2_stream_map_slot* slot = find(map, key);
+  return slot != nullptr ? slot->value : nullptr;
 }
 
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map) {
-  return map->count - map->free;
+  return map->count;
 }
 
 void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map) {
-  if (map->count == map->free) {
+  if (map->count == 0) {
     return nullptr;
   }
-  if (map->free != 0) {
-    map->count = compact(map->keys, map->values, map->count);
-    map->free = 0;
-    GPR_ASSERT(map->count > 0);
-  }
-  return map->values[(static_cast<size_t>(rand())) % map->count];
+  const size_t mask = map->capacity - 1;
+  size_t i = static_cast<size_t>(rand()) & mask;
+  while (map->slots[i].value == nullptr) i = (i + 1) & mask;
+  return map->slots[i].value;
 }
 
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
                                      void* user_data) {
-  size_t i;
-
-  for (i = 0; i < map->count; i++) {
-    if (map->values[i]) {
-      f(user_data, map->keys[i], map->values[i]);
-    }
+  /* callbacks may delete entries (and so move others around): iterate over a
+     snapshot, taken in slot order so that the lookups below walk the table
+     front to back */
+  std::vector<uint32_t> keys;
+  keys.reserve(map->count);
+  for (size_t i = 0; i < map->capacity; i++) {
+    if (map->slots[i].value != nullptr) keys.push_back(map->slots[i].key);
+  }
+  for (uint32_t key : keys) {
+    void* value = grpc_chttp2_stream_map_find(map, key);
+    if (value != nullptr) f(user_data, key, value);
   }
 }
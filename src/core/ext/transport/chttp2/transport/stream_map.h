@@ -25,16 +25,27 @@
 
 /* Data structure to map a uint32_t to a data object (represented by a void*)
 
-   Represented as a sorted array of keys, and a corresponding array of values.
-   Lookups are performed with binary search.
+   Represented as an open addressed hash table with linear probing, so that
+   lookups and deletes are O(1) regardless of how many streams are open.
+   Deleted entries are removed by shifting the rest of their probe sequence
+   back, so there are no tombstones and nothing to compact.
    Adds are restricted to strictly higher keys than previously seen (this is
    guaranteed by http2). */
+struct grpc_chttp2_stream_map_slot {
+  uint32_t key;
+  /* NULL if the slot is empty */
+  void* value;
+};
 struct grpc_chttp2_stream_map {
-  uint32_t* keys;
-  void** values;
+  grpc_chttp2_stream_map_slot* slots;
+  /* number of populated slots */
   size_t count;
-  size_t free;
+  /* number of slots: always a power of two */
   size_t capacity;
+  /* log2(capacity) */
+  uint32_t capacity_log2;
+  /* most recently added key */
+  uint32_t last_key;
 };
 void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
@@ -58,7 +69,8 @@ void* grpc_chttp2_stream_map_rand(grpc_chttp2_stream_map* map);
 /* How many (populated) entries are in the stream map? */
 size_t grpc_chttp2_stream_map_size(grpc_chttp2_stream_map* map);
 
-/* Callback on each stream */
+/* Callback on each stream, in no particular order. The callback may delete
+   entries from the map. */
 void grpc_chttp2_stream_map_for_each(grpc_chttp2_stream_map* map,
                                      void (*f)(void* user_data, uint32_t key,
                                                void* value),
@@ -331,6 +331,25 @@ void fill_in_metadata(inproc_stream* s, const grpc_metadata_batch* metadata,
   metadata->Encode(&sink);
 }
 
+// Hands metadata already staged on this stream (to_read_initial_md or
+// to_read_trailing_md) to the recv op that asked for it. Staged metadata was
+// copied into this stream's arena when the other side sent it, and the recv
+// op's batch lives on the same call arena, so it can be moved rather than
+// copied a second time.
+void deliver_metadata(inproc_stream* s, grpc_metadata_batch* staged,
+                      uint32_t flags, grpc_metadata_batch* out_md,
+                      uint32_t* outflags) {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_inproc_trace)) {
+    log_metadata(staged, s->t->is_client, outflags != nullptr);
+  }
+
+  if (outflags != nullptr) {
+    *outflags = flags;
+  }
+  *out_md = std::move(*staged);
+  staged->Clear();
+}
+
 int init_stream(grpc_transport* gt, grpc_stream* gs,
                 grpc_stream_refcount* refcount, const void* server_data,
                 grpc_core::Arena* arena) {
@@ -700,12 +719,11 @@ void op_state_machine_locked(inproc_stream* s, grpc_error_handle error) {
 
     if (s->to_read_initial_md_filled) {
       s->initial_md_recvd = true;
-      fill_in_metadata(
+      deliver_metadata(
           s, &s->to_read_initial_md, s->to_read_initial_md_flags,
           s->recv_initial_md_op->payload->recv_initial_metadata
               .recv_initial_metadata,
-          s->recv_initial_md_op->payload->recv_initial_metadata.recv_flags,
-          nullptr);
+          s->recv_initial_md_op->payload->recv_initial_metadata.recv_flags);
       if (s->deadline != grpc_core::Timestamp::InfFuture()) {
         s->recv_initial_md_op->payload->recv_initial_metadata
             .recv_initial_metadata->Set(grpc_core::GrpcTimeoutMetadata(),
@@ -717,7 +735,6 @@ void op_state_machine_locked(inproc_stream* s, grpc_error_handle error) {
              .trailing_metadata_available =
             (other != nullptr && other->send_trailing_md_op != nullptr);
       }
-      s->to_read_initial_md.Clear();
       s->to_read_initial_md_filled = false;
       grpc_core::ExecCtx::Run(
           DEBUG_LOCATION,
@@ -785,11 +802,10 @@ void op_state_machine_locked(inproc_stream* s, grpc_error_handle error) {
     if (s->recv_trailing_md_op != nullptr) {
       // We wanted trailing metadata and we got it
       s->trailing_md_recvd = true;
-      fill_in_metadata(s, &s->to_read_trailing_md, 0,
+      deliver_metadata(s, &s->to_read_trailing_md, 0,
                        s->recv_trailing_md_op->payload->recv_trailing_metadata
                            .recv_trailing_metadata,
-                       nullptr, nullptr);
-      s->to_read_trailing_md.Clear();
+                       nullptr);
       s->to_read_trailing_md_filled = false;
 
       // We should schedule the recv_trailing_md_op completion if
@@ -0,0 +1,386 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+grpc_core::TraceFlag grpc_shm_trace(false, "shm");
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Largest slice handed to a single read callback.
+constexpr size_t kMaxReadSize = 256 * 1024;
+
+class ShmEndpoint {
+ public:
+  explicit ShmEndpoint(ShmEndpointArgs args);
+
+  void Read(grpc_slice_buffer* slices, grpc_closure* cb);
+  void Write(grpc_slice_buffer* slices, grpc_closure* cb);
+  void AddToPollset(grpc_pollset* pollset);
+  void AddToPollsetSet(grpc_pollset_set* pollset_set);
+  void DeleteFromPollsetSet(grpc_pollset_set* pollset_set);
+  void Shutdown(grpc_error_handle why);
+  void Destroy();
+  absl::string_view peer() const { return peer_address_; }
+  absl::string_view local_address() const { return local_address_; }
+
+  static const grpc_endpoint_vtable kVtable;
+
+ private:
+  ~ShmEndpoint();
+
+  void Ref() { refs_.Ref(); }
+  void Unref() {
+    if (refs_.Unref()) delete this;
+  }
+
+  static void OnWakeup(void* arg, grpc_error_handle error);
+  static void OnSocketReadable(void* arg, grpc_error_handle error);
+
+  // Each returns true once the pending operation completed (successfully or
+  // not) and its callback has been scheduled.
+  bool TryReadLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  bool TryWriteLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ArmWakeupLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void ShutdownLocked(grpc_error_handle why) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void WakePeer();
+
+ public:
+  // Must be the first member: the vtable functions cast back from it.
+  grpc_endpoint base_;
+
+ private:
+  RefCount refs_;
+  void* const region_;
+  const size_t region_size_;
+  ShmRing tx_;
+  ShmRing rx_;
+  grpc_fd* const socket_;
+  grpc_fd* const wakeup_fd_;
+  const int peer_wakeup_fd_;
+  const std::string peer_address_;
+  const std::string local_address_;
+  grpc_closure on_wakeup_;
+  grpc_closure on_socket_readable_;
+
+  Mutex mu_;
+  grpc_error_handle shutdown_error_ ABSL_GUARDED_BY(mu_) = GRPC_ERROR_NONE;
+  bool wakeup_armed_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_closure* read_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* read_slices_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure* write_cb_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_slice_buffer* write_slices_ ABSL_GUARDED_BY(mu_) = nullptr;
+  // Bytes of write_slices_->slices[0] already copied into tx_.
+  size_t write_offset_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+ShmEndpoint::ShmEndpoint(ShmEndpointArgs args)
+    : region_(args.region),
+      region_size_(args.region_size),
+      tx_(static_cast<uint8_t*>(args.region) +
+              (args.is_client ? 0 : ShmRing::RegionSize(args.ring_capacity)),
+          args.ring_capacity),
+      rx_(static_cast<uint8_t*>(args.region) +
+              (args.is_client ? ShmRing::RegionSize(args.ring_capacity) : 0),
+          args.ring_capacity),
+      socket_(args.socket),
+      wakeup_fd_(grpc_fd_create(args.wakeup_fd, "shm-wakeup", false)),
+      peer_wakeup_fd_(args.peer_wakeup_fd),
+      peer_address_(std::move(args.peer_address)),
+      local_address_(std::move(args.local_address)) {
+  base_.vtable = &kVtable;
+  GRPC_CLOSURE_INIT(&on_wakeup_, OnWakeup, this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_socket_readable_, OnSocketReadable, this,
+                    grpc_schedule_on_exec_ctx);
+  // Held by the socket watch.
+  Ref();
+  grpc_fd_notify_on_read(socket_, &on_socket_readable_);
+}
+
+ShmEndpoint::~ShmEndpoint() {
+  GRPC_ERROR_UNREF(shutdown_error_);
+  close(peer_wakeup_fd_);
+  munmap(region_, region_size_);
+}
+
+void ShmEndpoint::WakePeer() {
+  uint64_t one = 1;
+  ssize_t r;
+  do {
+    r = write(peer_wakeup_fd_, &one, sizeof(one));
+  } while (r < 0 && errno == EINTR);
+}
+
+void ShmEndpoint::ArmWakeupLocked() {
+  if (wakeup_armed_) return;
+  wakeup_armed_ = true;
+  Ref();  // Held by on_wakeup_.
+  grpc_fd_notify_on_read(wakeup_fd_, &on_wakeup_);
+}
+
+bool ShmEndpoint::TryReadLocked() {
+  while (true) {
+    int64_t available = rx_.Readable();
+    if (available < 0) {
+      ShutdownLocked(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("shm: corrupt receive ring"));
+      return true;
+    }
+    if (available == 0) {
+      if (rx_.WaitForData()) return false;
+      continue;
+    }
+    grpc_slice slice = GRPC_SLICE_MALLOC(
+        std::min(static_cast<size_t>(available), kMaxReadSize));
+    int64_t n = rx_.Read(GRPC_SLICE_START_PTR(slice), GRPC_SLICE_LENGTH(slice));
+    GPR_ASSERT(n == static_cast<int64_t>(GRPC_SLICE_LENGTH(slice)));
+    if (rx_.TakeProducerWaiting()) WakePeer();
+    grpc_slice_buffer_add(read_slices_, slice);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_shm_trace)) {
+      gpr_log(GPR_INFO, "SHM:%p read %" PRId64 " bytes", this, n);
+    }
+    grpc_closure* cb = read_cb_;
+    read_cb_ = nullptr;
+    read_slices_ = nullptr;
+    ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_NONE);
+    return true;
+  }
+}
+
+bool ShmEndpoint::TryWriteLocked() {
+  bool wrote = false;
+  while (write_slices_->count > 0) {
+    const grpc_slice& slice = write_slices_->slices[0];
+    const size_t length = GRPC_SLICE_LENGTH(slice);
+    int64_t n = tx_.Write(GRPC_SLICE_START_PTR(slice) + write_offset_,
+                          length - write_offset_);
+    if (n < 0) {
+      ShutdownLocked(
+          GRPC_ERROR_CREATE_FROM_STATIC_STRING("shm: corrupt send ring"));
+      return true;
+    }
+    if (n > 0) {
+      wrote = true;
+      write_offset_ += static_cast<size_t>(n);
+      if (write_offset_ == length) {
+        grpc_slice_unref_internal(grpc_slice_buffer_take_first(write_slices_));
+        write_offset_ = 0;
+      }
+      continue;
+    }
+    // The ring is full: make sure the peer is draining it before waiting.
+    if (wrote && tx_.TakeConsumerWaiting()) WakePeer();
+    wrote = false;
+    if (tx_.WaitForSpace()) return false;
+  }
+  if (wrote && tx_.TakeConsumerWaiting()) WakePeer();
+  grpc_closure* cb = write_cb_;
+  write_cb_ = nullptr;
+  write_slices_ = nullptr;
+  ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_NONE);
+  return true;
+}
+
+void ShmEndpoint::Read(grpc_slice_buffer* slices, grpc_closure* cb) {
+  MutexLock lock(&mu_);
+  GPR_ASSERT(read_cb_ == nullptr);
+  grpc_slice_buffer_reset_and_unref_internal(slices);
+  if (shutdown_error_ != GRPC_ERROR_NONE) {
+    ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_REF(shutdown_error_));
+    return;
+  }
+  read_cb_ = cb;
+  read_slices_ = slices;
+  if (!TryReadLocked()) ArmWakeupLocked();
+}
+
+void ShmEndpoint::Write(grpc_slice_buffer* slices, grpc_closure* cb) {
+  MutexLock lock(&mu_);
+  GPR_ASSERT(write_cb_ == nullptr);
+  if (shutdown_error_ != GRPC_ERROR_NONE) {
+    ExecCtx::Run(DEBUG_LOCATION, cb, GRPC_ERROR_REF(shutdown_error_));
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_shm_trace)) {
+    gpr_log(GPR_INFO, "SHM:%p write %" PRIuPTR " bytes", this,
+            slices->length);
+  }
+  write_cb_ = cb;
+  write_slices_ = slices;
+  write_offset_ = 0;
+  if (!TryWriteLocked()) ArmWakeupLocked();
+}
+
+void ShmEndpoint::OnWakeup(void* arg, grpc_error_handle error) {
+  ShmEndpoint* self = static_cast<ShmEndpoint*>(arg);
+  {
+    MutexLock lock(&self->mu_);
+    self->wakeup_armed_ = false;
+    if (error != GRPC_ERROR_NONE) {
+      self->ShutdownLocked(GRPC_ERROR_REF(error));
+    } else if (self->shutdown_error_ == GRPC_ERROR_NONE) {
+      uint64_t count;
+      ssize_t r;
+      do {
+        r = read(grpc_fd_wrapped_fd(self->wakeup_fd_), &count, sizeof(count));
+      } while (r < 0 && errno == EINTR);
+      bool blocked = false;
+      if (self->read_cb_ != nullptr && !self->TryReadLocked()) blocked = true;
+      if (self->write_cb_ != nullptr && !self->TryWriteLocked()) {
+        blocked = true;
+      }
+      if (blocked && self->shutdown_error_ == GRPC_ERROR_NONE) {
+        self->ArmWakeupLocked();
+      }
+    }
+  }
+  self->Unref();
+}
+
+void ShmEndpoint::OnSocketReadable(void* arg, grpc_error_handle error) {
+  ShmEndpoint* self = static_cast<ShmEndpoint*>(arg);
+  if (error == GRPC_ERROR_NONE) {
+    // Nothing is sent on the socket after the handshake, so it only becomes
+    // readable when the peer closes it.
+    MutexLock lock(&self->mu_);
+    self->ShutdownLocked(grpc_error_set_int(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("shm: peer closed connection"),
+        GRPC_ERROR_INT_GRPC_STATUS, GRPC_STATUS_UNAVAILABLE));
+  }
+  self->Unref();
+}
+
+void ShmEndpoint::ShutdownLocked(grpc_error_handle why) {
+  if (shutdown_error_ != GRPC_ERROR_NONE) {
+    GRPC_ERROR_UNREF(why);
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_shm_trace)) {
+    gpr_log(GPR_INFO, "SHM:%p shutdown: %s", this,
+            grpc_error_std_string(why).c_str());
+  }
+  shutdown_error_ = why;
+  if (read_cb_ != nullptr) {
+    ExecCtx::Run(DEBUG_LOCATION, read_cb_, GRPC_ERROR_REF(why));
+    read_cb_ = nullptr;
+    read_slices_ = nullptr;
+  }
+  if (write_cb_ != nullptr) {
+    ExecCtx::Run(DEBUG_LOCATION, write_cb_, GRPC_ERROR_REF(why));
+    write_cb_ = nullptr;
+    write_slices_ = nullptr;
+  }
+  grpc_fd_shutdown(wakeup_fd_, GRPC_ERROR_REF(why));
+  grpc_fd_shutdown(socket_, GRPC_ERROR_REF(why));
+}
+
+void ShmEndpoint::Shutdown(grpc_error_handle why) {
+  MutexLock lock(&mu_);
+  ShutdownLocked(why);
+}
+
+void ShmEndpoint::Destroy() {
+  {
+    MutexLock lock(&mu_);
+    ShutdownLocked(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("shm: endpoint destroyed"));
+  }
+  grpc_fd_orphan(wakeup_fd_, nullptr, nullptr, "shm_endpoint");
+  grpc_fd_orphan(socket_, nullptr, nullptr, "shm_endpoint");
+  Unref();
+}
+
+void ShmEndpoint::AddToPollset(grpc_pollset* pollset) {
+  grpc_pollset_add_fd(pollset, wakeup_fd_);
+  grpc_pollset_add_fd(pollset, socket_);
+}
+
+void ShmEndpoint::AddToPollsetSet(grpc_pollset_set* pollset_set) {
+  grpc_pollset_set_add_fd(pollset_set, wakeup_fd_);
+  grpc_pollset_set_add_fd(pollset_set, socket_);
+}
+
+void ShmEndpoint::DeleteFromPollsetSet(grpc_pollset_set* pollset_set) {
+  grpc_pollset_set_del_fd(pollset_set, wakeup_fd_);
+  grpc_pollset_set_del_fd(pollset_set, socket_);
+}
+
+ShmEndpoint* FromBase(grpc_endpoint* ep) {
+  return reinterpret_cast<ShmEndpoint*>(ep);
+}
+
+const grpc_endpoint_vtable ShmEndpoint::kVtable = {
+    [](grpc_endpoint* ep, grpc_slice_buffer* slices, grpc_closure* cb,
+       bool /*urgent*/, int /*min_progress_size*/) {
+      FromBase(ep)->Read(slices, cb);
+    },
+    [](grpc_endpoint* ep, grpc_slice_buffer* slices, grpc_closure* cb,
+       void* /*arg*/) { FromBase(ep)->Write(slices, cb); },
+    [](grpc_endpoint* ep, grpc_pollset* pollset) {
+      FromBase(ep)->AddToPollset(pollset);
+    },
+    [](grpc_endpoint* ep, grpc_pollset_set* pollset_set) {
+      FromBase(ep)->AddToPollsetSet(pollset_set);
+    },
+    [](grpc_endpoint* ep, grpc_pollset_set* pollset_set) {
+      FromBase(ep)->DeleteFromPollsetSet(pollset_set);
+    },
+    [](grpc_endpoint* ep, grpc_error_handle why) {
+      FromBase(ep)->Shutdown(why);
+    },
+    [](grpc_endpoint* ep) { FromBase(ep)->Destroy(); },
+    [](grpc_endpoint* ep) { return FromBase(ep)->peer(); },
+    [](grpc_endpoint* ep) { return FromBase(ep)->local_address(); },
+    [](grpc_endpoint* /*ep*/) { return -1; },
+    [](grpc_endpoint* /*ep*/) { return false; },
+};
+
+}  // namespace
+
+grpc_endpoint* CreateShmEndpoint(ShmEndpointArgs args) {
+  ShmEndpoint* ep = new ShmEndpoint(std::move(args));
+  return &ep->base_;
+}
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
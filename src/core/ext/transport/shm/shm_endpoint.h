@@ -0,0 +1,65 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <string>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include "src/core/lib/iomgr/ev_posix.h"
+
+extern grpc_core::TraceFlag grpc_shm_trace;
+
+namespace grpc_core {
+
+// Everything a ShmEndpoint is built from. The endpoint takes ownership of all
+// of it.
+struct ShmEndpointArgs {
+  // Shared mapping holding two ShmRings of ring_capacity bytes each: the
+  // client writes to the first one and the server to the second one.
+  void* region = nullptr;
+  size_t region_size = 0;
+  size_t ring_capacity = 0;
+  bool is_client = false;
+  // The unix socket the connection was set up over. Nothing is sent on it
+  // any more; it is only watched to notice when the peer goes away.
+  grpc_fd* socket = nullptr;
+  // eventfd the peer signals to wake this side up, and the one this side
+  // signals to wake the peer up.
+  int wakeup_fd = -1;
+  int peer_wakeup_fd = -1;
+  std::string peer_address;
+  std::string local_address;
+};
+
+// Creates an endpoint that moves bytes through shared memory rather than
+// through a socket. Reads and writes are each a single memcpy; the kernel is
+// only involved to wake up a side that is waiting for data or for room.
+grpc_endpoint* CreateShmEndpoint(ShmEndpointArgs args);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_ENDPOINT_H
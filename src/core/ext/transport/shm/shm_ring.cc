@@ -0,0 +1,135 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+
+#include <grpc/support/log.h>
+
+namespace grpc_core {
+
+// Lives at the start of the shared region. Both processes map it, so it only
+// holds lock-free atomics, which are address-free. head and tail count bytes
+// since the ring was created and never wrap in practice.
+struct ShmRing::Header {
+  alignas(GPR_CACHELINE_SIZE) std::atomic<uint64_t> head;
+  alignas(GPR_CACHELINE_SIZE) std::atomic<uint64_t> tail;
+  alignas(GPR_CACHELINE_SIZE) std::atomic<uint32_t> consumer_waiting;
+  std::atomic<uint32_t> producer_waiting;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "shared memory rings need lock-free atomics");
+
+size_t ShmRing::HeaderSize() {
+  return (sizeof(Header) + GPR_CACHELINE_SIZE - 1) / GPR_CACHELINE_SIZE *
+         GPR_CACHELINE_SIZE;
+}
+
+size_t ShmRing::RegionSize(size_t capacity) { return HeaderSize() + capacity; }
+
+void ShmRing::Init(void* region, size_t capacity) {
+  GPR_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  Header* header = new (region) Header;
+  header->head.store(0, std::memory_order_relaxed);
+  header->tail.store(0, std::memory_order_relaxed);
+  header->consumer_waiting.store(0, std::memory_order_relaxed);
+  header->producer_waiting.store(0, std::memory_order_relaxed);
+}
+
+ShmRing::ShmRing(void* region, size_t capacity)
+    : header_(static_cast<Header*>(region)),
+      data_(static_cast<uint8_t*>(region) + HeaderSize()),
+      capacity_(capacity) {
+  GPR_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+}
+
+int64_t ShmRing::Write(const uint8_t* data, size_t len) {
+  const uint64_t head = header_->head.load(std::memory_order_relaxed);
+  const uint64_t used = head - header_->tail.load(std::memory_order_acquire);
+  if (used > capacity_) return -1;
+  const size_t n = std::min(len, static_cast<size_t>(capacity_ - used));
+  if (n == 0) return 0;
+  const size_t offset = static_cast<size_t>(head & (capacity_ - 1));
+  const size_t first = std::min(n, capacity_ - offset);
+  memcpy(data_ + offset, data, first);
+  memcpy(data_, data + first, n - first);
+  header_->head.store(head + n, std::memory_order_release);
+  return static_cast<int64_t>(n);
+}
+
+bool ShmRing::WaitForSpace() {
+  header_->producer_waiting.store(1, std::memory_order_seq_cst);
+  // Pairs with the fence in TakeProducerWaiting(): either the consumer sees
+  // the request, or we see what it read.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const uint64_t used = header_->head.load(std::memory_order_relaxed) -
+                        header_->tail.load(std::memory_order_acquire);
+  return used >= capacity_;
+}
+
+bool ShmRing::TakeConsumerWaiting() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header_->consumer_waiting.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  return header_->consumer_waiting.exchange(0, std::memory_order_acq_rel) != 0;
+}
+
+int64_t ShmRing::Readable() const {
+  const uint64_t available = header_->head.load(std::memory_order_acquire) -
+                             header_->tail.load(std::memory_order_relaxed);
+  if (available > capacity_) return -1;
+  return static_cast<int64_t>(available);
+}
+
+int64_t ShmRing::Read(uint8_t* dst, size_t len) {
+  const uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+  const uint64_t available =
+      header_->head.load(std::memory_order_acquire) - tail;
+  if (available > capacity_) return -1;
+  const size_t n = std::min(len, static_cast<size_t>(available));
+  if (n == 0) return 0;
+  const size_t offset = static_cast<size_t>(tail & (capacity_ - 1));
+  const size_t first = std::min(n, capacity_ - offset);
+  memcpy(dst, data_ + offset, first);
+  memcpy(dst + first, data_, n - first);
+  header_->tail.store(tail + n, std::memory_order_release);
+  return static_cast<int64_t>(n);
+}
+
+bool ShmRing::WaitForData() {
+  header_->consumer_waiting.store(1, std::memory_order_seq_cst);
+  // Pairs with the fence in TakeConsumerWaiting().
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return header_->head.load(std::memory_order_acquire) ==
+         header_->tail.load(std::memory_order_relaxed);
+}
+
+bool ShmRing::TakeProducerWaiting() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (header_->producer_waiting.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  return header_->producer_waiting.exchange(0, std::memory_order_acq_rel) != 0;
+}
+
+}  // namespace grpc_core
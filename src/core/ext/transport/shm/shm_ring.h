@@ -0,0 +1,90 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace grpc_core {
+
+// A single-producer single-consumer byte ring in memory shared by two
+// processes. The producer and the consumer each run in one process; neither
+// trusts what the other wrote to the shared header, so indices read from it
+// are sanity checked before use.
+//
+// Either side can ask to be woken up: the consumer when the ring is empty, the
+// producer when it is full. The ring only records the request; delivering the
+// wakeup (ShmEndpoint uses an eventfd) is up to the caller, which must check
+// TakeConsumerWaiting() after each Write() and TakeProducerWaiting() after each
+// Read().
+class ShmRing {
+ public:
+  // Size of the shared memory for a ring of \a capacity bytes, which must be a
+  // power of two.
+  static size_t RegionSize(size_t capacity);
+  // Initializes the shared header. Called once, by whoever creates the shared
+  // memory, before the peer maps it.
+  static void Init(void* region, size_t capacity);
+
+  // \a region must stay mapped for the lifetime of the ring.
+  ShmRing(void* region, size_t capacity);
+
+  ShmRing(const ShmRing&) = delete;
+  ShmRing& operator=(const ShmRing&) = delete;
+
+  size_t capacity() const { return capacity_; }
+
+  // Producer side.
+
+  // Copies up to \a len bytes into the ring. Returns how many fit, or -1 if
+  // the shared indices are corrupt.
+  int64_t Write(const uint8_t* data, size_t len);
+  // Asks the consumer to wake the producer up once it has read something.
+  // Returns false if there is already room, in which case the caller should
+  // retry the write rather than wait.
+  bool WaitForSpace();
+  // Whether the consumer asked to be woken up. Clears the request.
+  bool TakeConsumerWaiting();
+
+  // Consumer side.
+
+  // Bytes ready to be read, or -1 if the shared indices are corrupt.
+  int64_t Readable() const;
+  // Copies up to \a len bytes out of the ring. Returns how many were read, or
+  // -1 if the shared indices are corrupt.
+  int64_t Read(uint8_t* dst, size_t len);
+  // Asks the producer to wake the consumer up once it has written something.
+  // Returns false if there is already data, in which case the caller should
+  // retry the read rather than wait.
+  bool WaitForData();
+  // Whether the producer asked to be woken up. Clears the request.
+  bool TakeProducerWaiting();
+
+ private:
+  struct Header;
+
+  static size_t HeaderSize();
+
+  Header* const header_;
+  uint8_t* const data_;
+  const size_t capacity_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_RING_H
@@ -0,0 +1,591 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/transport/shm/shm_transport.h"
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/ext/transport/shm/shm_endpoint.h"
+#include "src/core/ext/transport/shm/shm_ring.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/handshaker.h"
+#include "src/core/lib/channel/handshaker_factory.h"
+#include "src/core/lib/channel/handshaker_registry.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/tcp_posix.h"
+#include "src/core/lib/resolver/resolver_registry.h"
+#include "src/core/lib/resolver/server_address.h"
+#include "src/core/lib/slice/slice_internal.h"
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
+
+namespace grpc_core {
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+namespace {
+
+// Sent by the client, together with the memfd holding the rings and the two
+// eventfds, as the first (and only) message on the socket. Both sides run on
+// the same host, so the struct is sent as is.
+struct ShmHello {
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t ring_capacity;
+};
+
+constexpr char kShmMagic[sizeof(ShmHello::magic)] = {'G', 'R', 'P', 'C',
+                                                     'S', 'H', 'M', '1'};
+constexpr uint32_t kShmVersion = 1;
+// Passed along with the hello: memfd, client eventfd, server eventfd.
+constexpr size_t kNumPassedFds = 3;
+// Sent back by the server once it mapped the rings.
+constexpr char kShmAck = 1;
+
+constexpr size_t kRingCapacity = 1024 * 1024;
+constexpr size_t kMinRingCapacity = 64 * 1024;
+constexpr size_t kMaxRingCapacity = 64 * 1024 * 1024;
+
+grpc_error_handle ShmError(const char* msg) {
+  return GRPC_ERROR_CREATE_FROM_COPIED_STRING(
+      absl::StrCat("shm handshake: ", msg).c_str());
+}
+
+void CloseIfOpen(int* fd) {
+  if (*fd >= 0) close(*fd);
+  *fd = -1;
+}
+
+//
+// ShmHandshaker
+//
+
+// Moves a freshly connected unix socket over to shared memory. The socket
+// endpoint is torn down (keeping the fd), the client sends the shared memory
+// and the eventfds to the server, the server acks, and both sides replace the
+// endpoint with a ShmEndpoint. Runs before any other handshaker, so security
+// handshakes go through shared memory as well.
+class ShmHandshaker : public Handshaker {
+ public:
+  ShmHandshaker(bool is_client, grpc_pollset_set* interested_parties)
+      : is_client_(is_client), interested_parties_(interested_parties) {
+    GRPC_CLOSURE_INIT(&on_socket_readable_, OnSocketReadable, this,
+                      grpc_schedule_on_exec_ctx);
+  }
+  void Shutdown(grpc_error_handle why) override;
+  void DoHandshake(grpc_tcp_server_acceptor* acceptor,
+                   grpc_closure* on_handshake_done,
+                   HandshakerArgs* args) override;
+  const char* name() const override { return "shm"; }
+
+ private:
+  static void OnFdReleased(void* arg, grpc_error_handle error);
+  static void OnSocketReadable(void* arg, grpc_error_handle error);
+
+  // Each step sets *done once it completed, or leaves it unset if it needs
+  // the socket to become readable first.
+  grpc_error_handle SendHelloLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  grpc_error_handle ReceiveHelloLocked(bool* done)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  grpc_error_handle ReceiveAckLocked(bool* done)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Makes progress after the socket became readable; returns true once the
+  // handshake is over either way.
+  bool ContinueLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void FinishLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void FailLocked(grpc_error_handle error) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const bool is_client_;
+  grpc_pollset_set* const interested_parties_;
+  grpc_closure on_fd_released_;
+  grpc_closure on_socket_readable_;
+
+  Mutex mu_;
+  bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  HandshakerArgs* args_ ABSL_GUARDED_BY(mu_) = nullptr;
+  grpc_closure* on_handshake_done_ ABSL_GUARDED_BY(mu_) = nullptr;
+  std::string peer_address_ ABSL_GUARDED_BY(mu_);
+  std::string local_address_ ABSL_GUARDED_BY(mu_);
+  // Set by the tcp endpoint once it released the socket, which socket_ then
+  // wraps.
+  int released_fd_ = -1;
+  grpc_fd* socket_ ABSL_GUARDED_BY(mu_) = nullptr;
+  size_t ring_capacity_ ABSL_GUARDED_BY(mu_) = kRingCapacity;
+  void* region_ ABSL_GUARDED_BY(mu_) = nullptr;
+  size_t region_size_ ABSL_GUARDED_BY(mu_) = 0;
+  int memfd_ ABSL_GUARDED_BY(mu_) = -1;
+  int client_wakeup_fd_ ABSL_GUARDED_BY(mu_) = -1;
+  int server_wakeup_fd_ ABSL_GUARDED_BY(mu_) = -1;
+};
+
+void ShmHandshaker::Shutdown(grpc_error_handle why) {
+  {
+    MutexLock lock(&mu_);
+    if (!is_shutdown_) {
+      is_shutdown_ = true;
+      // Fails the pending read, if any. Otherwise the handshake fails as soon
+      // as the socket is released.
+      if (socket_ != nullptr) grpc_fd_shutdown(socket_, GRPC_ERROR_REF(why));
+    }
+  }
+  GRPC_ERROR_UNREF(why);
+}
+
+void ShmHandshaker::DoHandshake(grpc_tcp_server_acceptor* /*acceptor*/,
+                                grpc_closure* on_handshake_done,
+                                HandshakerArgs* args) {
+  MutexLock lock(&mu_);
+  args_ = args;
+  on_handshake_done_ = on_handshake_done;
+  if (grpc_endpoint_get_fd(args->endpoint) < 0) {
+    grpc_error_handle error = ShmError("connection is not a unix socket");
+    grpc_endpoint_shutdown(args->endpoint, GRPC_ERROR_REF(error));
+    grpc_endpoint_destroy(args->endpoint);
+    args->endpoint = nullptr;
+    FailLocked(error);
+    return;
+  }
+  peer_address_ = std::string(grpc_endpoint_get_peer(args->endpoint));
+  local_address_ =
+      std::string(grpc_endpoint_get_local_address(args->endpoint));
+  // Held until the handshake is over.
+  Ref().release();
+  grpc_tcp_destroy_and_release_fd(
+      args->endpoint, &released_fd_,
+      GRPC_CLOSURE_INIT(&on_fd_released_, OnFdReleased, this,
+                        grpc_schedule_on_exec_ctx));
+  args->endpoint = nullptr;
+}
+
+void ShmHandshaker::OnFdReleased(void* arg, grpc_error_handle /*error*/) {
+  ShmHandshaker* self = static_cast<ShmHandshaker*>(arg);
+  bool done;
+  {
+    MutexLock lock(&self->mu_);
+    self->socket_ = grpc_fd_create(self->released_fd_, "shm-socket", false);
+    self->released_fd_ = -1;
+    grpc_pollset_set_add_fd(self->interested_parties_, self->socket_);
+    if (self->is_shutdown_) {
+      self->FailLocked(GRPC_ERROR_NONE);
+      done = true;
+    } else if (self->is_client_) {
+      grpc_error_handle error = self->SendHelloLocked();
+      if (error != GRPC_ERROR_NONE) {
+        self->FailLocked(error);
+        done = true;
+      } else {
+        grpc_fd_notify_on_read(self->socket_, &self->on_socket_readable_);
+        done = false;
+      }
+    } else {
+      // The hello may well be there already.
+      done = self->ContinueLocked();
+    }
+  }
+  if (done) self->Unref();
+}
+
+void ShmHandshaker::OnSocketReadable(void* arg, grpc_error_handle error) {
+  ShmHandshaker* self = static_cast<ShmHandshaker*>(arg);
+  bool done;
+  {
+    MutexLock lock(&self->mu_);
+    if (error != GRPC_ERROR_NONE || self->is_shutdown_) {
+      self->FailLocked(GRPC_ERROR_REF(error));
+      done = true;
+    } else {
+      done = self->ContinueLocked();
+    }
+  }
+  if (done) self->Unref();
+}
+
+bool ShmHandshaker::ContinueLocked() {
+  bool done = false;
+  grpc_error_handle error =
+      is_client_ ? ReceiveAckLocked(&done) : ReceiveHelloLocked(&done);
+  if (error != GRPC_ERROR_NONE) {
+    FailLocked(error);
+    return true;
+  }
+  if (!done) {
+    grpc_fd_notify_on_read(socket_, &on_socket_readable_);
+    return false;
+  }
+  FinishLocked();
+  return true;
+}
+
+grpc_error_handle ShmHandshaker::SendHelloLocked() {
+  memfd_ = memfd_create("grpc-shm", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (memfd_ < 0) return GRPC_OS_ERROR(errno, "memfd_create");
+  region_size_ = 2 * ShmRing::RegionSize(ring_capacity_);
+  if (ftruncate(memfd_, static_cast<off_t>(region_size_)) != 0) {
+    return GRPC_OS_ERROR(errno, "ftruncate");
+  }
+  // The server maps the same memory: make sure nobody can shrink it under it.
+  if (fcntl(memfd_, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) !=
+      0) {
+    return GRPC_OS_ERROR(errno, "fcntl(F_ADD_SEALS)");
+  }
+  void* region = mmap(nullptr, region_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, memfd_, 0);
+  if (region == MAP_FAILED) return GRPC_OS_ERROR(errno, "mmap");
+  region_ = region;
+  ShmRing::Init(region_, ring_capacity_);
+  ShmRing::Init(
+      static_cast<uint8_t*>(region_) + ShmRing::RegionSize(ring_capacity_),
+      ring_capacity_);
+  client_wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (client_wakeup_fd_ < 0) return GRPC_OS_ERROR(errno, "eventfd");
+  server_wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (server_wakeup_fd_ < 0) return GRPC_OS_ERROR(errno, "eventfd");
+  ShmHello hello;
+  memcpy(hello.magic, kShmMagic, sizeof(hello.magic));
+  hello.version = kShmVersion;
+  hello.reserved = 0;
+  hello.ring_capacity = ring_capacity_;
+  struct iovec iov;
+  iov.iov_base = &hello;
+  iov.iov_len = sizeof(hello);
+  union {
+    char buf[CMSG_SPACE(sizeof(int) * kNumPassedFds)];
+    struct cmsghdr align;
+  } control;
+  memset(&control, 0, sizeof(control));
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int) * kNumPassedFds);
+  const int fds[kNumPassedFds] = {memfd_, client_wakeup_fd_,
+                                  server_wakeup_fd_};
+  memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+  ssize_t sent;
+  do {
+    sent = sendmsg(grpc_fd_wrapped_fd(socket_), &msg, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  if (sent < 0) return GRPC_OS_ERROR(errno, "sendmsg");
+  // The socket is fresh, so its send buffer has room for the whole hello.
+  if (sent != static_cast<ssize_t>(sizeof(hello))) {
+    return ShmError("short write");
+  }
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error_handle ShmHandshaker::ReceiveHelloLocked(bool* done) {
+  ShmHello hello;
+  struct iovec iov;
+  iov.iov_base = &hello;
+  iov.iov_len = sizeof(hello);
+  union {
+    char buf[CMSG_SPACE(sizeof(int) * kNumPassedFds)];
+    struct cmsghdr align;
+  } control;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  ssize_t received;
+  do {
+    received = recvmsg(grpc_fd_wrapped_fd(socket_), &msg, MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0) {
+    if (errno == EAGAIN) return GRPC_ERROR_NONE;
+    return GRPC_OS_ERROR(errno, "recvmsg");
+  }
+  // Take ownership of whatever fds came along first, so that none of them
+  // leaks whatever else is wrong with the message.
+  std::vector<int> fds;
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+      continue;
+    }
+    const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    for (size_t i = 0; i < count; ++i) {
+      int fd;
+      memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+      fds.push_back(fd);
+    }
+  }
+  if (fds.size() != kNumPassedFds) {
+    for (int fd : fds) close(fd);
+    return ShmError("expected a shared memory fd and two eventfds");
+  }
+  memfd_ = fds[0];
+  client_wakeup_fd_ = fds[1];
+  server_wakeup_fd_ = fds[2];
+  if (received != static_cast<ssize_t>(sizeof(hello)) ||
+      memcmp(hello.magic, kShmMagic, sizeof(hello.magic)) != 0) {
+    return ShmError("peer is not a shm client");
+  }
+  if (hello.version != kShmVersion) {
+    return ShmError("unsupported protocol version");
+  }
+  if (hello.ring_capacity < kMinRingCapacity ||
+      hello.ring_capacity > kMaxRingCapacity ||
+      (hello.ring_capacity & (hello.ring_capacity - 1)) != 0) {
+    return ShmError("invalid ring capacity");
+  }
+  ring_capacity_ = static_cast<size_t>(hello.ring_capacity);
+  region_size_ = 2 * ShmRing::RegionSize(ring_capacity_);
+  // Mapping past the end of the memfd, or letting the client shrink it later,
+  // would turn our reads and writes into SIGBUS.
+  struct stat st;
+  if (fstat(memfd_, &st) != 0) return GRPC_OS_ERROR(errno, "fstat");
+  if (st.st_size != static_cast<off_t>(region_size_)) {
+    return ShmError("shared memory has the wrong size");
+  }
+  int seals = fcntl(memfd_, F_GET_SEALS);
+  if (seals < 0) return GRPC_OS_ERROR(errno, "fcntl(F_GET_SEALS)");
+  if ((seals & F_SEAL_SHRINK) == 0) {
+    return ShmError("shared memory is not sealed against shrinking");
+  }
+  // grpc_fd needs the eventfd we poll to be non-blocking.
+  int flags = fcntl(server_wakeup_fd_, F_GETFL);
+  if (flags < 0 || fcntl(server_wakeup_fd_, F_SETFL, flags | O_NONBLOCK) != 0) {
+    return GRPC_OS_ERROR(errno, "fcntl(O_NONBLOCK)");
+  }
+  void* region = mmap(nullptr, region_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, memfd_, 0);
+  if (region == MAP_FAILED) return GRPC_OS_ERROR(errno, "mmap");
+  region_ = region;
+  ssize_t sent;
+  do {
+    sent = send(grpc_fd_wrapped_fd(socket_), &kShmAck, 1, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  if (sent < 0) return GRPC_OS_ERROR(errno, "send");
+  if (sent != 1) return ShmError("short write");
+  *done = true;
+  return GRPC_ERROR_NONE;
+}
+
+grpc_error_handle ShmHandshaker::ReceiveAckLocked(bool* done) {
+  char ack;
+  ssize_t received;
+  do {
+    received = recv(grpc_fd_wrapped_fd(socket_), &ack, 1, 0);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0) {
+    if (errno == EAGAIN) return GRPC_ERROR_NONE;
+    return GRPC_OS_ERROR(errno, "recv");
+  }
+  if (received == 0) return ShmError("server closed the connection");
+  if (ack != kShmAck) return ShmError("peer is not a shm server");
+  *done = true;
+  return GRPC_ERROR_NONE;
+}
+
+void ShmHandshaker::FinishLocked() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_shm_trace)) {
+    gpr_log(GPR_INFO,
+            "SHM:%p %s handshake done with %s, rings of %" PRIuPTR " bytes",
+            this, is_client_ ? "client" : "server", peer_address_.c_str(),
+            ring_capacity_);
+  }
+  // The endpoint is added to the pollsets it needs by its users.
+  grpc_pollset_set_del_fd(interested_parties_, socket_);
+  // The mapping keeps the memory alive.
+  CloseIfOpen(&memfd_);
+  ShmEndpointArgs endpoint_args;
+  endpoint_args.region = region_;
+  endpoint_args.region_size = region_size_;
+  endpoint_args.ring_capacity = ring_capacity_;
+  endpoint_args.is_client = is_client_;
+  endpoint_args.socket = socket_;
+  endpoint_args.wakeup_fd = is_client_ ? client_wakeup_fd_ : server_wakeup_fd_;
+  endpoint_args.peer_wakeup_fd =
+      is_client_ ? server_wakeup_fd_ : client_wakeup_fd_;
+  endpoint_args.peer_address = std::move(peer_address_);
+  endpoint_args.local_address = std::move(local_address_);
+  region_ = nullptr;
+  socket_ = nullptr;
+  client_wakeup_fd_ = -1;
+  server_wakeup_fd_ = -1;
+  args_->endpoint = CreateShmEndpoint(std::move(endpoint_args));
+  // Nothing left for Shutdown() to do.
+  is_shutdown_ = true;
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, GRPC_ERROR_NONE);
+}
+
+void ShmHandshaker::FailLocked(grpc_error_handle error) {
+  if (error == GRPC_ERROR_NONE) {
+    error = GRPC_ERROR_CREATE_FROM_STATIC_STRING("Handshaker shutdown");
+  }
+  if (socket_ != nullptr) {
+    grpc_pollset_set_del_fd(interested_parties_, socket_);
+    grpc_fd_orphan(socket_, nullptr, nullptr, "shm handshake failed");
+    socket_ = nullptr;
+  }
+  if (region_ != nullptr) {
+    munmap(region_, region_size_);
+    region_ = nullptr;
+  }
+  CloseIfOpen(&memfd_);
+  CloseIfOpen(&client_wakeup_fd_);
+  CloseIfOpen(&server_wakeup_fd_);
+  if (args_->read_buffer != nullptr) {
+    grpc_slice_buffer_destroy_internal(args_->read_buffer);
+    gpr_free(args_->read_buffer);
+    args_->read_buffer = nullptr;
+  }
+  grpc_channel_args_destroy(args_->args);
+  args_->args = nullptr;
+  is_shutdown_ = true;
+  ExecCtx::Run(DEBUG_LOCATION, on_handshake_done_, error);
+}
+
+class ShmHandshakerFactory : public HandshakerFactory {
+ public:
+  explicit ShmHandshakerFactory(bool is_client) : is_client_(is_client) {}
+
+  void AddHandshakers(const grpc_channel_args* args,
+                      grpc_pollset_set* interested_parties,
+                      HandshakeManager* handshake_mgr) override {
+    if (!grpc_channel_args_find_bool(args, GRPC_ARG_SHM_TRANSPORT, false)) {
+      return;
+    }
+    handshake_mgr->Add(
+        MakeRefCounted<ShmHandshaker>(is_client_, interested_parties));
+  }
+
+ private:
+  const bool is_client_;
+};
+
+//
+// Resolver
+//
+
+// Resolves "shm:/path" to the unix socket at /path, marked to be moved over
+// to shared memory once connected.
+class ShmResolver : public Resolver {
+ public:
+  ShmResolver(const grpc_resolved_address& address, ResolverArgs args)
+      : result_handler_(std::move(args.result_handler)),
+        address_(address),
+        channel_args_(grpc_channel_args_copy(args.args)) {}
+  ~ShmResolver() override { grpc_channel_args_destroy(channel_args_); }
+
+  void StartLocked() override {
+    grpc_arg arg = grpc_channel_arg_integer_create(
+        const_cast<char*>(GRPC_ARG_SHM_TRANSPORT), 1);
+    ServerAddressList addresses;
+    addresses.emplace_back(address_,
+                           grpc_channel_args_copy_and_add(nullptr, &arg, 1));
+    Result result;
+    result.addresses = std::move(addresses);
+    result.args = channel_args_;
+    channel_args_ = nullptr;
+    result_handler_->ReportResult(std::move(result));
+  }
+
+  void ShutdownLocked() override {}
+
+ private:
+  std::unique_ptr<ResultHandler> result_handler_;
+  const grpc_resolved_address address_;
+  const grpc_channel_args* channel_args_ = nullptr;
+};
+
+bool ParseShmUri(const URI& uri, grpc_resolved_address* address) {
+  if (!uri.authority().empty()) {
+    gpr_log(GPR_ERROR, "authority-based URIs not supported by the shm scheme");
+    return false;
+  }
+  grpc_error_handle error = UnixSockaddrPopulate(uri.path(), address);
+  if (error != GRPC_ERROR_NONE) {
+    gpr_log(GPR_ERROR, "%s", grpc_error_std_string(error).c_str());
+    GRPC_ERROR_UNREF(error);
+    return false;
+  }
+  return true;
+}
+
+class ShmResolverFactory : public ResolverFactory {
+ public:
+  absl::string_view scheme() const override { return "shm"; }
+
+  bool IsValidUri(const URI& uri) const override {
+    grpc_resolved_address address;
+    return ParseShmUri(uri, &address);
+  }
+
+  OrphanablePtr<Resolver> CreateResolver(ResolverArgs args) const override {
+    grpc_resolved_address address;
+    if (!ParseShmUri(args.uri, &address)) return nullptr;
+    return MakeOrphanable<ShmResolver>(address, std::move(args));
+  }
+
+  std::string GetDefaultAuthority(const URI& /*uri*/) const override {
+    return "localhost";
+  }
+};
+
+}  // namespace
+
+void RegisterShmTransport(CoreConfiguration::Builder* builder) {
+  builder->resolver_registry()->RegisterResolverFactory(
+      absl::make_unique<ShmResolverFactory>());
+  // Registered at the start so that every other handshaker, security included,
+  // runs over shared memory.
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      true /* at_start */, HANDSHAKER_CLIENT,
+      absl::make_unique<ShmHandshakerFactory>(true /* is_client */));
+  builder->handshaker_registry()->RegisterHandshakerFactory(
+      true /* at_start */, HANDSHAKER_SERVER,
+      absl::make_unique<ShmHandshakerFactory>(false /* is_client */));
+}
+
+#else  // GRPC_HAVE_SHM_TRANSPORT
+
+void RegisterShmTransport(CoreConfiguration::Builder* /*builder*/) {}
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
+
+}  // namespace grpc_core
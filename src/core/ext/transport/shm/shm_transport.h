@@ -0,0 +1,49 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+#define GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/config/core_configuration.h"
+
+// Shared-memory connections between processes on the same host.
+//
+// "shm:/path" targets and listening addresses name a unix domain socket, which
+// is only used to set the connection up: the client creates a memfd holding
+// one ring per direction plus an eventfd per side, and passes them to the
+// server over the socket. From then on HTTP/2 frames go through the rings
+// (see ShmEndpoint), and the socket is only watched to notice when the peer
+// goes away. The rest of the stack (chttp2, security, filters) is unchanged.
+//
+// Only available where GRPC_HAVE_SHM_TRANSPORT is defined (Linux); elsewhere
+// "shm:" targets fail to resolve and "shm:" ports fail to bind.
+
+// Channel arg set (by the "shm" resolver on the client, and by
+// grpc_server_add_http2_port() for "shm:" addresses on the server) on
+// connections that should move to shared memory once connected.
+#define GRPC_ARG_SHM_TRANSPORT "grpc.internal.shm_transport"
+
+// Prefix of shared-memory target URIs and listening addresses.
+#define GRPC_SHM_URI_PREFIX "shm:"
+
+namespace grpc_core {
+
+// Registers the "shm" resolver and the client and server shm handshakers.
+void RegisterShmTransport(CoreConfiguration::Builder* builder);
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_TRANSPORT_SHM_SHM_TRANSPORT_H
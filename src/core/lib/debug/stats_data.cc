@@ -29,6 +29,7 @@
 const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "client_calls_created",
     "server_calls_created",
+    "call_arena_zone_spills",
     "cqs_created",
     "client_channels_created",
     "client_subchannels_created",
@@ -46,6 +47,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "syscall_read",
     "tcp_backup_pollers_created",
     "tcp_backup_poller_polls",
+    "tcp_write_more",
     "http2_op_batches",
     "http2_op_cancel",
     "http2_op_send_initial_metadata",
@@ -60,6 +62,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "http2_writes_offloaded",
     "http2_writes_continued",
     "http2_partial_writes",
+    "http2_writes_coalesced",
     "http2_initiate_write_due_to_initial_write",
     "http2_initiate_write_due_to_start_new_stream",
     "http2_initiate_write_due_to_send_message",
@@ -105,14 +108,19 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
     "hpack_send_huffman",
     "hpack_send_binary",
     "hpack_send_binary_base64",
+    "hpack_send_custom_indexed",
+    "hpack_send_custom_added",
+    "hpack_send_custom_literal",
     "combiner_locks_initiated",
     "combiner_locks_scheduled_items",
     "combiner_locks_scheduled_final_items",
     "combiner_locks_offloaded",
+    "combiner_locks_offloaded_over_budget",
     "call_combiner_locks_initiated",
     "call_combiner_locks_scheduled_items",
     "call_combiner_set_notify_on_cancel",
     "call_combiner_cancelled",
+    "work_serializer_offloaded",
     "executor_scheduled_short_items",
     "executor_scheduled_long_items",
     "executor_scheduled_to_self",
@@ -128,6 +136,7 @@ const char* grpc_stats_counter_name[GRPC_STATS_COUNTER_COUNT] = {
 const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of client side calls created by this process",
     "Number of server side calls created by this process",
+    "Number of calls whose arena outgrew its initial allocation",
     "Number of completion queues created",
     "Number of client channels created",
     "Number of client subchannels created",
@@ -153,6 +162,7 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
     "Number of times a backup poller has been created (this can be expensive)",
     "Number of polls performed on the backup poller",
+    "Number of sendmsg calls made with more of the write to follow",
     "Number of batches received by HTTP2 transport",
     "Number of cancelations received by HTTP2 transport",
     "Number of batches containing send initial metadata",
@@ -169,6 +179,7 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "written",
     "Number of HTTP2 writes that were made knowing there was still more data "
     "to be written (we cap maximum write size to syscall_write)",
+    "Number of http2 writes held back to coalesce frames from more streams",
     "Number of HTTP2 writes initiated due to 'initial_write'",
     "Number of HTTP2 writes initiated due to 'start_new_stream'",
     "Number of HTTP2 writes initiated due to 'send_message'",
@@ -221,16 +232,23 @@ const char* grpc_stats_counter_doc[GRPC_STATS_COUNTER_COUNT] = {
     "Number of huffman encoded strings sent in metadata",
     "Number of binary strings received in metadata",
     "Number of binary strings received encoded in base64 in metadata",
+    "Number of custom metadata elements sent as a dynamic table index",
+    "Number of repeating custom metadata elements added to the dynamic table",
+    "Number of custom metadata elements sent as literals without indexing",
     "Number of combiner lock entries by process (first items queued to a "
     "combiner)",
     "Number of items scheduled against combiner locks",
     "Number of final items scheduled against combiner locks",
     "Number of combiner locks offloaded to different threads",
+    "Number of combiner locks offloaded because the thread holding them used "
+    "up its time budget",
     "Number of call combiner lock entries by process (first items queued to a "
     "call combiner)",
     "Number of items scheduled against call combiner locks",
     "Number of times a cancellation callback was set on a call combiner",
     "Number of times a call combiner was cancelled",
+    "Number of work serializer queues offloaded to the executor because the "
+    "thread draining them used up its time budget",
     "Number of finite runtime closures scheduled against the executor (gRPC "
     "thread pool)",
     "Number of potentially infinite runtime closures scheduled against the "
@@ -263,6 +281,10 @@ const char* grpc_stats_histogram_name[GRPC_STATS_HISTOGRAM_COUNT] = {
     "http2_send_message_per_write",
     "http2_send_trailing_metadata_per_write",
     "http2_send_flowctl_per_write",
+    "combiner_locks_items_per_hold",
+    "combiner_locks_hold_micros",
+    "work_serializer_items_per_drain",
+    "work_serializer_drain_micros",
     "server_cqs_checked",
 };
 const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
@@ -278,6 +300,14 @@ const char* grpc_stats_histogram_doc[GRPC_STATS_HISTOGRAM_COUNT] = {
     "Number of streams whose payload was written per TCP write",
     "Number of streams terminated per TCP write",
     "Number of flow control updates written per TCP write",
+    "Number of closures a thread ran on a combiner lock before releasing or "
+    "offloading it",
+    "Time in microseconds a thread held a combiner lock before releasing or "
+    "offloading it",
+    "Number of callbacks a thread ran on a work serializer before releasing "
+    "or offloading it",
+    "Time in microseconds a thread spent draining a work serializer before "
+    "releasing or offloading it",
     "How many completion queues were checked looking for a CQ that had "
     "requested the incoming call",
 };
@@ -346,8 +376,26 @@ const uint8_t grpc_stats_table_7[102] = {
     23, 24, 24, 24, 25, 26, 27, 27, 28, 28, 29, 29, 30, 30, 31, 31, 32,
     32, 33, 33, 34, 35, 35, 36, 37, 37, 38, 38, 39, 39, 40, 40, 41, 41,
     42, 42, 43, 44, 44, 45, 46, 46, 47, 48, 48, 49, 49, 50, 50, 51, 51};
-const int grpc_stats_table_8[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
-const uint8_t grpc_stats_table_9[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
+const int grpc_stats_table_8[65] = {
+    0,      1,       2,      3,      4,      5,      7,      9,      12,
+    15,     19,      24,     30,     37,     46,     57,     70,     86,
+    105,    129,     158,    193,    236,    288,    352,    430,    525,
+    641,    782,     954,    1164,   1420,   1733,   2114,   2579,   3146,
+    3838,   4682,    5711,   6967,   8499,   10367,  12646,  15426,  18816,
+    22951,  27995,   34148,  41653,  50807,  61972,  75591,  92203,  112465,
+    137180, 167326,  204096, 248947, 303653, 370381, 451772, 551049, 672141,
+    819843, 1000000};
+const uint8_t grpc_stats_table_9[139] = {
+    0,  0,  0,  1,  1,  1,  2,  2,  2,  3,  3,  3,  4,  4,  5,  5,  5,  6,  6,
+    6,  7,  7,  8,  8,  9,  9,  9,  10, 10, 11, 11, 12, 12, 12, 13, 13, 13, 14,
+    15, 15, 15, 16, 16, 17, 17, 17, 18, 18, 19, 19, 20, 20, 20, 21, 21, 22, 22,
+    23, 23, 24, 24, 24, 25, 25, 26, 26, 27, 27, 27, 28, 28, 29, 29, 30, 30, 31,
+    31, 31, 32, 32, 33, 33, 34, 34, 34, 35, 35, 36, 36, 37, 37, 37, 38, 38, 39,
+    39, 40, 40, 41, 41, 41, 42, 42, 43, 43, 44, 44, 44, 45, 45, 46, 46, 47, 47,
+    48, 48, 48, 49, 49, 50, 50, 51, 51, 51, 52, 52, 53, 53, 54, 54, 55, 55, 55,
+    56, 56, 57, 57, 58, 58};
+const int grpc_stats_table_10[9] = {0, 1, 2, 4, 7, 13, 23, 39, 64};
+const uint8_t grpc_stats_table_11[9] = {0, 0, 1, 2, 2, 3, 4, 4, 5};
 void grpc_stats_inc_call_initial_size(int value) {
   value = grpc_core::Clamp(value, 0, 262144);
   if (value < 6) {
@@ -636,6 +684,106 @@ void grpc_stats_inc_http2_send_flowctl_per_write(int value) {
       GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
       grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
 }
+void grpc_stats_inc_combiner_locks_items_per_hold(int value) {
+  value = grpc_core::Clamp(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_ITEMS_PER_HOLD,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_ITEMS_PER_HOLD,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_ITEMS_PER_HOLD,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
+}
+void grpc_stats_inc_combiner_locks_hold_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_HOLD_MICROS,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_HOLD_MICROS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_HOLD_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 64));
+}
+void grpc_stats_inc_work_serializer_items_per_drain(int value) {
+  value = grpc_core::Clamp(value, 0, 1024);
+  if (value < 13) {
+    GRPC_STATS_INC_HISTOGRAM(
+        GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_ITEMS_PER_DRAIN, value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4637863191261478912ull) {
+    int bucket =
+        grpc_stats_table_7[((_val.uint - 4623507967449235456ull) >> 48)] + 13;
+    _bkt.dbl = grpc_stats_table_6[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(
+        GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_ITEMS_PER_DRAIN, bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_ITEMS_PER_DRAIN,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_6, 64));
+}
+void grpc_stats_inc_work_serializer_drain_micros(int value) {
+  value = grpc_core::Clamp(value, 0, 1000000);
+  if (value < 6) {
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_DRAIN_MICROS,
+                             value);
+    return;
+  }
+  union {
+    double dbl;
+    uint64_t uint;
+  } _val, _bkt;
+  _val.dbl = value;
+  if (_val.uint < 4651092515166879744ull) {
+    int bucket =
+        grpc_stats_table_9[((_val.uint - 4618441417868443648ull) >> 49)] + 6;
+    _bkt.dbl = grpc_stats_table_8[bucket];
+    bucket -= (_val.uint < _bkt.uint);
+    GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_DRAIN_MICROS,
+                             bucket);
+    return;
+  }
+  GRPC_STATS_INC_HISTOGRAM(
+      GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_DRAIN_MICROS,
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 64));
+}
 void grpc_stats_inc_server_cqs_checked(int value) {
   value = grpc_core::Clamp(value, 0, 64);
   if (value < 3) {
@@ -649,27 +797,29 @@ void grpc_stats_inc_server_cqs_checked(int value) {
   _val.dbl = value;
   if (_val.uint < 4625196817309499392ull) {
     int bucket =
-        grpc_stats_table_9[((_val.uint - 4613937818241073152ull) >> 51)] + 3;
-    _bkt.dbl = grpc_stats_table_8[bucket];
+        grpc_stats_table_11[((_val.uint - 4613937818241073152ull) >> 51)] + 3;
+    _bkt.dbl = grpc_stats_table_10[bucket];
     bucket -= (_val.uint < _bkt.uint);
     GRPC_STATS_INC_HISTOGRAM(GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED, bucket);
     return;
   }
   GRPC_STATS_INC_HISTOGRAM(
       GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
-      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_8, 8));
+      grpc_stats_histo_find_bucket_slow(value, grpc_stats_table_10, 8));
 }
-const int grpc_stats_histo_buckets[13] = {64, 128, 64, 64, 64, 64, 64,
-                                          64, 64,  64, 64, 64, 8};
-const int grpc_stats_histo_start[13] = {0,   64,  192, 256, 320, 384, 448,
-                                        512, 576, 640, 704, 768, 832};
-const int* const grpc_stats_histo_bucket_boundaries[13] = {
-    grpc_stats_table_0, grpc_stats_table_2, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_4,
-    grpc_stats_table_6, grpc_stats_table_4, grpc_stats_table_6,
-    grpc_stats_table_6, grpc_stats_table_6, grpc_stats_table_6,
-    grpc_stats_table_8};
-void (*const grpc_stats_inc_histogram[13])(int x) = {
+const int grpc_stats_histo_buckets[17] = {64, 128, 64, 64, 64, 64, 64, 64, 64,
+                                          64, 64,  64, 64, 64, 64, 64, 8};
+const int grpc_stats_histo_start[17] = {
+    0,   64,  192, 256, 320, 384, 448, 512,  576,
+    640, 704, 768, 832, 896, 960, 1024, 1088};
+const int* const grpc_stats_histo_bucket_boundaries[17] = {
+    grpc_stats_table_0, grpc_stats_table_2,  grpc_stats_table_4,
+    grpc_stats_table_6, grpc_stats_table_4,  grpc_stats_table_4,
+    grpc_stats_table_6, grpc_stats_table_4,  grpc_stats_table_6,
+    grpc_stats_table_6, grpc_stats_table_6,  grpc_stats_table_6,
+    grpc_stats_table_6, grpc_stats_table_8,  grpc_stats_table_6,
+    grpc_stats_table_8, grpc_stats_table_10};
+void (*const grpc_stats_inc_histogram[17])(int x) = {
     grpc_stats_inc_call_initial_size,
     grpc_stats_inc_poll_events_returned,
     grpc_stats_inc_tcp_write_size,
@@ -682,4 +832,8 @@ void (*const grpc_stats_inc_histogram[13])(int x) = {
     grpc_stats_inc_http2_send_message_per_write,
     grpc_stats_inc_http2_send_trailing_metadata_per_write,
     grpc_stats_inc_http2_send_flowctl_per_write,
+    grpc_stats_inc_combiner_locks_items_per_hold,
+    grpc_stats_inc_combiner_locks_hold_micros,
+    grpc_stats_inc_work_serializer_items_per_drain,
+    grpc_stats_inc_work_serializer_drain_micros,
     grpc_stats_inc_server_cqs_checked};
@@ -30,6 +30,7 @@
 typedef enum {
   GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED,
   GRPC_STATS_COUNTER_SERVER_CALLS_CREATED,
+  GRPC_STATS_COUNTER_CALL_ARENA_ZONE_SPILLS,
   GRPC_STATS_COUNTER_CQS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_CHANNELS_CREATED,
   GRPC_STATS_COUNTER_CLIENT_SUBCHANNELS_CREATED,
@@ -47,6 +48,7 @@ typedef enum {
   GRPC_STATS_COUNTER_SYSCALL_READ,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED,
   GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS,
+  GRPC_STATS_COUNTER_TCP_WRITE_MORE,
   GRPC_STATS_COUNTER_HTTP2_OP_BATCHES,
   GRPC_STATS_COUNTER_HTTP2_OP_CANCEL,
   GRPC_STATS_COUNTER_HTTP2_OP_SEND_INITIAL_METADATA,
@@ -61,6 +63,7 @@ typedef enum {
   GRPC_STATS_COUNTER_HTTP2_WRITES_OFFLOADED,
   GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED,
   GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES,
+  GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM,
   GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE,
@@ -106,14 +109,19 @@ typedef enum {
   GRPC_STATS_COUNTER_HPACK_SEND_HUFFMAN,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY,
   GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64,
+  GRPC_STATS_COUNTER_HPACK_SEND_CUSTOM_INDEXED,
+  GRPC_STATS_COUNTER_HPACK_SEND_CUSTOM_ADDED,
+  GRPC_STATS_COUNTER_HPACK_SEND_CUSTOM_LITERAL,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS,
   GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED,
+  GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED_OVER_BUDGET,
   GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_INITIATED,
   GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS,
   GRPC_STATS_COUNTER_CALL_COMBINER_SET_NOTIFY_ON_CANCEL,
   GRPC_STATS_COUNTER_CALL_COMBINER_CANCELLED,
+  GRPC_STATS_COUNTER_WORK_SERIALIZER_OFFLOADED,
   GRPC_STATS_COUNTER_EXECUTOR_SCHEDULED_SHORT_ITEMS,
   GRPC_STATS_COUNTER_EXECUTOR_SCHEDULED_LONG_ITEMS,
   GRPC_STATS_COUNTER_EXECUTOR_SCHEDULED_TO_SELF,
@@ -142,6 +150,10 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_MESSAGE_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE,
+  GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_ITEMS_PER_HOLD,
+  GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_HOLD_MICROS,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_ITEMS_PER_DRAIN,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_DRAIN_MICROS,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED,
   GRPC_STATS_HISTOGRAM_COUNT
 } grpc_stats_histograms;
@@ -172,15 +184,25 @@ typedef enum {
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_TRAILING_METADATA_PER_WRITE_BUCKETS = 64,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_FIRST_SLOT = 768,
   GRPC_STATS_HISTOGRAM_HTTP2_SEND_FLOWCTL_PER_WRITE_BUCKETS = 64,
-  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_ITEMS_PER_HOLD_FIRST_SLOT = 832,
+  GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_ITEMS_PER_HOLD_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_HOLD_MICROS_FIRST_SLOT = 896,
+  GRPC_STATS_HISTOGRAM_COMBINER_LOCKS_HOLD_MICROS_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_ITEMS_PER_DRAIN_FIRST_SLOT = 960,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_ITEMS_PER_DRAIN_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_DRAIN_MICROS_FIRST_SLOT = 1024,
+  GRPC_STATS_HISTOGRAM_WORK_SERIALIZER_DRAIN_MICROS_BUCKETS = 64,
+  GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_FIRST_SLOT = 1088,
   GRPC_STATS_HISTOGRAM_SERVER_CQS_CHECKED_BUCKETS = 8,
-  GRPC_STATS_HISTOGRAM_BUCKETS = 840
+  GRPC_STATS_HISTOGRAM_BUCKETS = 1096
 } grpc_stats_histogram_constants;
 #if defined(GRPC_COLLECT_STATS) || !defined(NDEBUG)
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CLIENT_CALLS_CREATED)
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_SERVER_CALLS_CREATED)
+#define GRPC_STATS_INC_CALL_ARENA_ZONE_SPILLS() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_ARENA_ZONE_SPILLS)
 #define GRPC_STATS_INC_CQS_CREATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CQS_CREATED)
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED() \
@@ -215,6 +237,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLERS_CREATED)
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_BACKUP_POLLER_POLLS)
+#define GRPC_STATS_INC_TCP_WRITE_MORE() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_TCP_WRITE_MORE)
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_OP_BATCHES)
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL() \
@@ -243,6 +267,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_CONTINUED)
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_PARTIAL_WRITES)
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HTTP2_WRITES_COALESCED)
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE() \
   GRPC_STATS_INC_COUNTER(                                          \
       GRPC_STATS_COUNTER_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE)
@@ -355,6 +381,12 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY)
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_BINARY_BASE64)
+#define GRPC_STATS_INC_HPACK_SEND_CUSTOM_INDEXED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_CUSTOM_INDEXED)
+#define GRPC_STATS_INC_HPACK_SEND_CUSTOM_ADDED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_CUSTOM_ADDED)
+#define GRPC_STATS_INC_HPACK_SEND_CUSTOM_LITERAL() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_HPACK_SEND_CUSTOM_LITERAL)
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS_INITIATED)
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS() \
@@ -364,6 +396,9 @@ typedef enum {
       GRPC_STATS_COUNTER_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS)
 #define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED)
+#define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED_OVER_BUDGET() \
+  GRPC_STATS_INC_COUNTER(                                     \
+      GRPC_STATS_COUNTER_COMBINER_LOCKS_OFFLOADED_OVER_BUDGET)
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_COMBINER_LOCKS_INITIATED)
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS() \
@@ -372,6 +407,8 @@ typedef enum {
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_COMBINER_SET_NOTIFY_ON_CANCEL)
 #define GRPC_STATS_INC_CALL_COMBINER_CANCELLED() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_CALL_COMBINER_CANCELLED)
+#define GRPC_STATS_INC_WORK_SERIALIZER_OFFLOADED() \
+  GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_WORK_SERIALIZER_OFFLOADED)
 #define GRPC_STATS_INC_EXECUTOR_SCHEDULED_SHORT_ITEMS() \
   GRPC_STATS_INC_COUNTER(GRPC_STATS_COUNTER_EXECUTOR_SCHEDULED_SHORT_ITEMS)
 #define GRPC_STATS_INC_EXECUTOR_SCHEDULED_LONG_ITEMS() \
@@ -430,12 +467,25 @@ void grpc_stats_inc_http2_send_trailing_metadata_per_write(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value) \
   grpc_stats_inc_http2_send_flowctl_per_write((int)(value))
 void grpc_stats_inc_http2_send_flowctl_per_write(int x);
+#define GRPC_STATS_INC_COMBINER_LOCKS_ITEMS_PER_HOLD(value) \
+  grpc_stats_inc_combiner_locks_items_per_hold((int)(value))
+void grpc_stats_inc_combiner_locks_items_per_hold(int x);
+#define GRPC_STATS_INC_COMBINER_LOCKS_HOLD_MICROS(value) \
+  grpc_stats_inc_combiner_locks_hold_micros((int)(value))
+void grpc_stats_inc_combiner_locks_hold_micros(int x);
+#define GRPC_STATS_INC_WORK_SERIALIZER_ITEMS_PER_DRAIN(value) \
+  grpc_stats_inc_work_serializer_items_per_drain((int)(value))
+void grpc_stats_inc_work_serializer_items_per_drain(int x);
+#define GRPC_STATS_INC_WORK_SERIALIZER_DRAIN_MICROS(value) \
+  grpc_stats_inc_work_serializer_drain_micros((int)(value))
+void grpc_stats_inc_work_serializer_drain_micros(int x);
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value) \
   grpc_stats_inc_server_cqs_checked((int)(value))
 void grpc_stats_inc_server_cqs_checked(int x);
 #else
 #define GRPC_STATS_INC_CLIENT_CALLS_CREATED()
 #define GRPC_STATS_INC_SERVER_CALLS_CREATED()
+#define GRPC_STATS_INC_CALL_ARENA_ZONE_SPILLS()
 #define GRPC_STATS_INC_CQS_CREATED()
 #define GRPC_STATS_INC_CLIENT_CHANNELS_CREATED()
 #define GRPC_STATS_INC_CLIENT_SUBCHANNELS_CREATED()
@@ -453,6 +503,7 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_SYSCALL_READ()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLERS_CREATED()
 #define GRPC_STATS_INC_TCP_BACKUP_POLLER_POLLS()
+#define GRPC_STATS_INC_TCP_WRITE_MORE()
 #define GRPC_STATS_INC_HTTP2_OP_BATCHES()
 #define GRPC_STATS_INC_HTTP2_OP_CANCEL()
 #define GRPC_STATS_INC_HTTP2_OP_SEND_INITIAL_METADATA()
@@ -467,6 +518,7 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_WRITES_OFFLOADED()
 #define GRPC_STATS_INC_HTTP2_WRITES_CONTINUED()
 #define GRPC_STATS_INC_HTTP2_PARTIAL_WRITES()
+#define GRPC_STATS_INC_HTTP2_WRITES_COALESCED()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_INITIAL_WRITE()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_START_NEW_STREAM()
 #define GRPC_STATS_INC_HTTP2_INITIATE_WRITE_DUE_TO_SEND_MESSAGE()
@@ -512,14 +564,19 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HPACK_SEND_HUFFMAN()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY()
 #define GRPC_STATS_INC_HPACK_SEND_BINARY_BASE64()
+#define GRPC_STATS_INC_HPACK_SEND_CUSTOM_INDEXED()
+#define GRPC_STATS_INC_HPACK_SEND_CUSTOM_ADDED()
+#define GRPC_STATS_INC_HPACK_SEND_CUSTOM_LITERAL()
 #define GRPC_STATS_INC_COMBINER_LOCKS_INITIATED()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS()
 #define GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS()
 #define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED()
+#define GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED_OVER_BUDGET()
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_INITIATED()
 #define GRPC_STATS_INC_CALL_COMBINER_LOCKS_SCHEDULED_ITEMS()
 #define GRPC_STATS_INC_CALL_COMBINER_SET_NOTIFY_ON_CANCEL()
 #define GRPC_STATS_INC_CALL_COMBINER_CANCELLED()
+#define GRPC_STATS_INC_WORK_SERIALIZER_OFFLOADED()
 #define GRPC_STATS_INC_EXECUTOR_SCHEDULED_SHORT_ITEMS()
 #define GRPC_STATS_INC_EXECUTOR_SCHEDULED_LONG_ITEMS()
 #define GRPC_STATS_INC_EXECUTOR_SCHEDULED_TO_SELF()
@@ -543,11 +600,15 @@ void grpc_stats_inc_server_cqs_checked(int x);
 #define GRPC_STATS_INC_HTTP2_SEND_MESSAGE_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_TRAILING_METADATA_PER_WRITE(value)
 #define GRPC_STATS_INC_HTTP2_SEND_FLOWCTL_PER_WRITE(value)
+#define GRPC_STATS_INC_COMBINER_LOCKS_ITEMS_PER_HOLD(value)
+#define GRPC_STATS_INC_COMBINER_LOCKS_HOLD_MICROS(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_ITEMS_PER_DRAIN(value)
+#define GRPC_STATS_INC_WORK_SERIALIZER_DRAIN_MICROS(value)
 #define GRPC_STATS_INC_SERVER_CQS_CHECKED(value)
 #endif /* defined(GRPC_COLLECT_STATS) || !defined(NDEBUG) */
-extern const int grpc_stats_histo_buckets[13];
-extern const int grpc_stats_histo_start[13];
-extern const int* const grpc_stats_histo_bucket_boundaries[13];
-extern void (*const grpc_stats_inc_histogram[13])(int x);
+extern const int grpc_stats_histo_buckets[17];
+extern const int grpc_stats_histo_start[17];
+extern const int* const grpc_stats_histo_bucket_boundaries[17];
+extern void (*const grpc_stats_inc_histogram[17])(int x);
 
 #endif /* GRPC_CORE_LIB_DEBUG_STATS_DATA_H */
@@ -1,5 +1,6 @@
 client_calls_created_per_iteration:FLOAT,
 server_calls_created_per_iteration:FLOAT,
+call_arena_zone_spills_per_iteration:FLOAT,
 cqs_created_per_iteration:FLOAT,
 client_channels_created_per_iteration:FLOAT,
 client_subchannels_created_per_iteration:FLOAT,
@@ -17,6 +18,7 @@ syscall_write_per_iteration:FLOAT,
 syscall_read_per_iteration:FLOAT,
 tcp_backup_pollers_created_per_iteration:FLOAT,
 tcp_backup_poller_polls_per_iteration:FLOAT,
+tcp_write_more_per_iteration:FLOAT,
 http2_op_batches_per_iteration:FLOAT,
 http2_op_cancel_per_iteration:FLOAT,
 http2_op_send_initial_metadata_per_iteration:FLOAT,
@@ -31,6 +33,7 @@ http2_writes_begun_per_iteration:FLOAT,
 http2_writes_offloaded_per_iteration:FLOAT,
 http2_writes_continued_per_iteration:FLOAT,
 http2_partial_writes_per_iteration:FLOAT,
+http2_writes_coalesced_per_iteration:FLOAT,
 http2_initiate_write_due_to_initial_write_per_iteration:FLOAT,
 http2_initiate_write_due_to_start_new_stream_per_iteration:FLOAT,
 http2_initiate_write_due_to_send_message_per_iteration:FLOAT,
@@ -76,14 +79,19 @@ hpack_send_uncompressed_per_iteration:FLOAT,
 hpack_send_huffman_per_iteration:FLOAT,
 hpack_send_binary_per_iteration:FLOAT,
 hpack_send_binary_base64_per_iteration:FLOAT,
+hpack_send_custom_indexed_per_iteration:FLOAT,
+hpack_send_custom_added_per_iteration:FLOAT,
+hpack_send_custom_literal_per_iteration:FLOAT,
 combiner_locks_initiated_per_iteration:FLOAT,
 combiner_locks_scheduled_items_per_iteration:FLOAT,
 combiner_locks_scheduled_final_items_per_iteration:FLOAT,
 combiner_locks_offloaded_per_iteration:FLOAT,
+combiner_locks_offloaded_over_budget_per_iteration:FLOAT,
 call_combiner_locks_initiated_per_iteration:FLOAT,
 call_combiner_locks_scheduled_items_per_iteration:FLOAT,
 call_combiner_set_notify_on_cancel_per_iteration:FLOAT,
 call_combiner_cancelled_per_iteration:FLOAT,
+work_serializer_offloaded_per_iteration:FLOAT,
 executor_scheduled_short_items_per_iteration:FLOAT,
 executor_scheduled_long_items_per_iteration:FLOAT,
 executor_scheduled_to_self_per_iteration:FLOAT,
@@ -13,14 +13,22 @@
 // limitations under the License.
 #include <grpc/support/port_platform.h>
 
+#include "absl/memory/memory.h"
+
 #include "src/core/lib/event_engine/event_engine_factory.h"
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/iomgr/port.h"
 
 namespace grpc_event_engine {
 namespace experimental {
 
 std::unique_ptr<EventEngine> DefaultEventEngineFactory() {
+#ifdef GRPC_POSIX_SOCKET
+  return absl::make_unique<PosixEventEngine>();
+#else
   // TODO(hork): call LibuvEventEngineFactory
   return nullptr;
+#endif
 }
 
 }  // namespace experimental
@@ -0,0 +1,258 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET
+
+#include <netdb.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/gprpp/host_port.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+struct PosixEventEngine::ClosureData final : public EventEngine::Closure {
+  std::function<void()> cb;
+  posix_engine::Timer timer;
+  PosixEventEngine* engine;
+  TaskHandle handle;
+
+  void Run() override {
+    {
+      grpc_core::MutexLock lock(&engine->mu_);
+      engine->known_handles_.erase({handle.keys[0], handle.keys[1]});
+    }
+    cb();
+    delete this;
+  }
+};
+
+PosixEventEngine::PosixEventEngine() : timer_manager_(&thread_pool_) {}
+
+PosixEventEngine::~PosixEventEngine() {
+  grpc_core::MutexLock lock(&mu_);
+  // Per the EventEngine API, all timers must have run or been cancelled, and
+  // all DNS lookups must have completed, before the engine is destroyed.
+  GPR_ASSERT(GPR_LIKELY(known_handles_.empty()));
+  GPR_ASSERT(GPR_LIKELY(pending_lookups_.empty()));
+}
+
+bool PosixEventEngine::Cancel(TaskHandle handle) {
+  grpc_core::MutexLock lock(&mu_);
+  if (!known_handles_.contains({handle.keys[0], handle.keys[1]})) return false;
+  auto* cd = reinterpret_cast<ClosureData*>(handle.keys[0]);
+  // The timer may have expired already and be queued on the thread pool. In
+  // that case it is too late to cancel, and ClosureData::Run will clean up.
+  if (!timer_manager_.TimerCancel(&cd->timer)) return false;
+  known_handles_.erase({handle.keys[0], handle.keys[1]});
+  delete cd;
+  return true;
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(absl::Time when,
+                                                std::function<void()> closure) {
+  return RunAtInternal(when, std::move(closure));
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAt(absl::Time when,
+                                                EventEngine::Closure* closure) {
+  return RunAtInternal(when, [closure]() { closure->Run(); });
+}
+
+void PosixEventEngine::Run(std::function<void()> closure) {
+  thread_pool_.Add(std::move(closure));
+}
+
+void PosixEventEngine::Run(EventEngine::Closure* closure) {
+  thread_pool_.Add([closure]() { closure->Run(); });
+}
+
+EventEngine::TaskHandle PosixEventEngine::RunAtInternal(
+    absl::Time when, std::function<void()> cb) {
+  auto* cd = new ClosureData;
+  cd->cb = std::move(cb);
+  cd->engine = this;
+  EventEngine::TaskHandle handle{reinterpret_cast<intptr_t>(cd),
+                                 aba_token_.fetch_add(1)};
+  cd->handle = handle;
+  {
+    grpc_core::MutexLock lock(&mu_);
+    known_handles_.insert({handle.keys[0], handle.keys[1]});
+  }
+  timer_manager_.TimerInit(&cd->timer, when, cd);
+  return handle;
+}
+
+absl::StatusOr<std::unique_ptr<EventEngine::Listener>>
+PosixEventEngine::CreateListener(
+    Listener::AcceptCallback /*on_accept*/,
+    std::function<void(absl::Status)> /*on_shutdown*/,
+    const EndpointConfig& /*config*/,
+    std::unique_ptr<MemoryAllocatorFactory> /*memory_allocator_factory*/) {
+  return absl::UnimplementedError(
+      "PosixEventEngine does not support listeners yet");
+}
+
+EventEngine::ConnectionHandle PosixEventEngine::Connect(
+    OnConnectCallback on_connect, const ResolvedAddress& /*addr*/,
+    const EndpointConfig& /*args*/, MemoryAllocator /*memory_allocator*/,
+    absl::Time /*deadline*/) {
+  // The callback must always be run asynchronously, even on failure.
+  thread_pool_.Add([on_connect]() {
+    on_connect(absl::UnimplementedError(
+        "PosixEventEngine does not support outgoing connections yet"));
+  });
+  return {0, 0};
+}
+
+bool PosixEventEngine::CancelConnect(ConnectionHandle /*handle*/) {
+  return false;
+}
+
+bool PosixEventEngine::IsWorkerThread() {
+  return thread_pool_.IsThreadPoolThread();
+}
+
+std::unique_ptr<EventEngine::DNSResolver> PosixEventEngine::GetDNSResolver() {
+  return absl::make_unique<PosixDNSResolver>(this);
+}
+
+EventEngine::DNSResolver::LookupTaskHandle PosixEventEngine::StartLookup() {
+  // Lookup handles only need to be unique, they never point at anything.
+  intptr_t token = aba_token_.fetch_add(1);
+  DNSResolver::LookupTaskHandle handle{
+      {token, reinterpret_cast<intptr_t>(this)}};
+  grpc_core::MutexLock lock(&mu_);
+  pending_lookups_.insert({handle.key[0], handle.key[1]});
+  return handle;
+}
+
+bool PosixEventEngine::FinishLookup(DNSResolver::LookupTaskHandle handle) {
+  grpc_core::MutexLock lock(&mu_);
+  return pending_lookups_.erase({handle.key[0], handle.key[1]}) == 1;
+}
+
+namespace {
+
+absl::StatusOr<std::vector<EventEngine::ResolvedAddress>>
+ResolveHostnameBlocking(absl::string_view address,
+                        absl::string_view default_port) {
+  std::string host;
+  std::string port;
+  grpc_core::SplitHostPort(address, &host, &port);
+  if (host.empty()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Unparseable host:port: ", address));
+  }
+  if (port.empty()) {
+    if (default_port.empty()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("No port in name: ", address));
+    }
+    port = std::string(default_port);
+  }
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;  // ipv4 or ipv6
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;  // for wildcard IP address
+  struct addrinfo* result = nullptr;
+  int s = getaddrinfo(host.c_str(), port.c_str(), &hints, &result);
+  if (s != 0) {
+    return absl::NotFoundError(absl::StrCat("getaddrinfo(", address,
+                                            ") failed: ", gai_strerror(s)));
+  }
+  std::vector<EventEngine::ResolvedAddress> addresses;
+  for (struct addrinfo* resp = result; resp != nullptr; resp = resp->ai_next) {
+    addresses.emplace_back(resp->ai_addr, resp->ai_addrlen);
+  }
+  freeaddrinfo(result);
+  return addresses;
+}
+
+}  // namespace
+
+EventEngine::DNSResolver::LookupTaskHandle
+PosixEventEngine::PosixDNSResolver::LookupHostname(
+    LookupHostnameCallback on_resolve, absl::string_view address,
+    absl::string_view default_port, absl::Time deadline) {
+  LookupTaskHandle handle = engine_->StartLookup();
+  PosixEventEngine* engine = engine_;
+  engine->thread_pool_.Add([engine, handle, on_resolve,
+                            address = std::string(address),
+                            default_port = std::string(default_port),
+                            deadline]() {
+    auto result = ResolveHostnameBlocking(address, default_port);
+    if (absl::Now() > deadline) {
+      result = absl::DeadlineExceededError(
+          absl::StrCat("Resolving ", address, " exceeded its deadline"));
+    }
+    if (engine->FinishLookup(handle)) on_resolve(std::move(result));
+  });
+  return handle;
+}
+
+EventEngine::DNSResolver::LookupTaskHandle
+PosixEventEngine::PosixDNSResolver::LookupSRV(LookupSRVCallback on_resolve,
+                                              absl::string_view /*name*/,
+                                              absl::Time /*deadline*/) {
+  LookupTaskHandle handle = engine_->StartLookup();
+  PosixEventEngine* engine = engine_;
+  engine->thread_pool_.Add([engine, handle, on_resolve]() {
+    if (engine->FinishLookup(handle)) {
+      on_resolve(absl::UnimplementedError(
+          "The native resolver does not support SRV records"));
+    }
+  });
+  return handle;
+}
+
+EventEngine::DNSResolver::LookupTaskHandle
+PosixEventEngine::PosixDNSResolver::LookupTXT(LookupTXTCallback on_resolve,
+                                              absl::string_view /*name*/,
+                                              absl::Time /*deadline*/) {
+  LookupTaskHandle handle = engine_->StartLookup();
+  PosixEventEngine* engine = engine_;
+  engine->thread_pool_.Add([engine, handle, on_resolve]() {
+    if (engine->FinishLookup(handle)) {
+      on_resolve(absl::UnimplementedError(
+          "The native resolver does not support TXT records"));
+    }
+  });
+  return handle;
+}
+
+bool PosixEventEngine::PosixDNSResolver::CancelLookup(
+    LookupTaskHandle handle) {
+  return engine_->FinishLookup(handle);
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_POSIX_SOCKET
@@ -0,0 +1,116 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer_manager.h"
+#include "src/core/lib/event_engine/thread_pool.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// An EventEngine implementation for posix platforms.
+//
+// Each instance owns its own work-stealing ThreadPool for callbacks and a
+// dedicated timer thread, so that engines do not share polling or callback
+// threads with each other or with iomgr.
+class PosixEventEngine final : public EventEngine {
+ public:
+  class PosixDNSResolver : public EventEngine::DNSResolver {
+   public:
+    explicit PosixDNSResolver(PosixEventEngine* engine) : engine_(engine) {}
+    ~PosixDNSResolver() override = default;
+    LookupTaskHandle LookupHostname(LookupHostnameCallback on_resolve,
+                                    absl::string_view address,
+                                    absl::string_view default_port,
+                                    absl::Time deadline) override;
+    LookupTaskHandle LookupSRV(LookupSRVCallback on_resolve,
+                               absl::string_view name,
+                               absl::Time deadline) override;
+    LookupTaskHandle LookupTXT(LookupTXTCallback on_resolve,
+                               absl::string_view name,
+                               absl::Time deadline) override;
+    bool CancelLookup(LookupTaskHandle handle) override;
+
+   private:
+    PosixEventEngine* const engine_;
+  };
+
+  PosixEventEngine();
+  ~PosixEventEngine() override;
+
+  absl::StatusOr<std::unique_ptr<Listener>> CreateListener(
+      Listener::AcceptCallback on_accept,
+      std::function<void(absl::Status)> on_shutdown,
+      const EndpointConfig& config,
+      std::unique_ptr<MemoryAllocatorFactory> memory_allocator_factory)
+      override;
+
+  ConnectionHandle Connect(OnConnectCallback on_connect,
+                           const ResolvedAddress& addr,
+                           const EndpointConfig& args,
+                           MemoryAllocator memory_allocator,
+                           absl::Time deadline) override;
+
+  bool CancelConnect(ConnectionHandle handle) override;
+  bool IsWorkerThread() override;
+  std::unique_ptr<DNSResolver> GetDNSResolver() override;
+  void Run(Closure* closure) override;
+  void Run(std::function<void()> closure) override;
+  TaskHandle RunAt(absl::Time when, Closure* closure) override;
+  TaskHandle RunAt(absl::Time when, std::function<void()> closure) override;
+  bool Cancel(TaskHandle handle) override;
+
+ private:
+  struct ClosureData;
+  using HandleKey = std::pair<intptr_t, intptr_t>;
+
+  TaskHandle RunAtInternal(absl::Time when, std::function<void()> cb);
+  // Registers a new DNS lookup and returns its handle.
+  DNSResolver::LookupTaskHandle StartLookup();
+  // Returns true if the lookup was still pending, in which case the caller is
+  // responsible for running its callback.
+  bool FinishLookup(DNSResolver::LookupTaskHandle handle);
+
+  grpc_core::Mutex mu_;
+  absl::flat_hash_set<HandleKey> known_handles_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_set<HandleKey> pending_lookups_ ABSL_GUARDED_BY(mu_);
+  std::atomic<intptr_t> aba_token_{0};
+  // Destroyed after the timer manager, which hands expired timers to it.
+  ThreadPool thread_pool_;
+  posix_engine::TimerManager timer_manager_;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_POSIX_ENGINE_H
@@ -0,0 +1,151 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/posix_engine/timer_manager.h"
+
+#include <utility>
+
+#include <grpc/support/log.h>
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::ThreadPool;
+
+TimerManager::TimerManager(ThreadPool* thread_pool)
+    : thread_pool_(thread_pool) {
+  thread_ = grpc_core::Thread(
+      "timer_manager",
+      [](void* arg) { static_cast<TimerManager*>(arg)->MainLoop(); }, this);
+  thread_.Start();
+}
+
+TimerManager::~TimerManager() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.Signal();
+  }
+  thread_.Join();
+  grpc_core::MutexLock lock(&mu_);
+  for (Timer* timer : heap_) {
+    timer->heap_index = kNotInHeap;
+  }
+  heap_.clear();
+}
+
+void TimerManager::TimerInit(Timer* timer, absl::Time deadline,
+                             EventEngine::Closure* closure) {
+  timer->deadline = deadline;
+  timer->closure = closure;
+  grpc_core::MutexLock lock(&mu_);
+  HeapAdd(timer);
+  // Only a new earliest deadline changes how long the timer thread sleeps.
+  if (timer->heap_index == 0) cv_.Signal();
+}
+
+bool TimerManager::TimerCancel(Timer* timer) {
+  grpc_core::MutexLock lock(&mu_);
+  if (timer->heap_index == kNotInHeap) return false;
+  HeapRemove(timer);
+  return true;
+}
+
+void TimerManager::MainLoop() {
+  std::vector<EventEngine::Closure*> expired;
+  while (true) {
+    {
+      grpc_core::MutexLock lock(&mu_);
+      while (!shutdown_) {
+        if (heap_.empty()) {
+          cv_.Wait(&mu_);
+          continue;
+        }
+        absl::Time now = absl::Now();
+        while (!heap_.empty() && heap_[0]->deadline <= now) {
+          expired.push_back(heap_[0]->closure);
+          HeapRemove(heap_[0]);
+        }
+        if (!expired.empty()) break;
+        cv_.WaitWithDeadline(&mu_, heap_[0]->deadline);
+      }
+      if (shutdown_) return;
+    }
+    // Run closures outside the lock so that they may schedule new timers.
+    for (EventEngine::Closure* closure : expired) {
+      thread_pool_->Add([closure]() { closure->Run(); });
+    }
+    expired.clear();
+  }
+}
+
+void TimerManager::HeapAdd(Timer* timer) {
+  timer->heap_index = heap_.size();
+  heap_.push_back(timer);
+  SiftUp(timer->heap_index);
+}
+
+void TimerManager::HeapRemove(Timer* timer) {
+  size_t i = timer->heap_index;
+  GPR_DEBUG_ASSERT(i < heap_.size() && heap_[i] == timer);
+  size_t last = heap_.size() - 1;
+  if (i != last) {
+    HeapSwap(i, last);
+  }
+  heap_.pop_back();
+  timer->heap_index = kNotInHeap;
+  if (i < heap_.size()) {
+    SiftUp(i);
+    SiftDown(i);
+  }
+}
+
+void TimerManager::HeapSwap(size_t i, size_t j) {
+  std::swap(heap_[i], heap_[j]);
+  heap_[i]->heap_index = i;
+  heap_[j]->heap_index = j;
+}
+
+void TimerManager::SiftUp(size_t i) {
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (heap_[parent]->deadline <= heap_[i]->deadline) break;
+    HeapSwap(i, parent);
+    i = parent;
+  }
+}
+
+void TimerManager::SiftDown(size_t i) {
+  while (true) {
+    size_t smallest = i;
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    if (left < heap_.size() &&
+        heap_[left]->deadline < heap_[smallest]->deadline) {
+      smallest = left;
+    }
+    if (right < heap_.size() &&
+        heap_[right]->deadline < heap_[smallest]->deadline) {
+      smallest = right;
+    }
+    if (smallest == i) return;
+    HeapSwap(i, smallest);
+    i = smallest;
+  }
+}
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
@@ -0,0 +1,86 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/time/time.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/thread_pool.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace posix_engine {
+
+// A pending timer. The storage is owned by the caller and must remain valid
+// until the timer has fired or has been successfully cancelled.
+struct Timer {
+  absl::Time deadline;
+  // Position in the TimerManager heap, or kNotInHeap.
+  size_t heap_index;
+  experimental::EventEngine::Closure* closure;
+};
+
+// Owns a single timer thread that sleeps until the earliest deadline, then
+// hands every expired closure to a ThreadPool. Timers are kept in an intrusive
+// binary min-heap, so both insertion and cancellation are O(log n).
+class TimerManager final {
+ public:
+  static constexpr size_t kNotInHeap = static_cast<size_t>(-1);
+
+  explicit TimerManager(experimental::ThreadPool* thread_pool);
+  // Stops the timer thread. Timers that have not fired by then are dropped
+  // without running their closures.
+  ~TimerManager();
+
+  TimerManager(const TimerManager&) = delete;
+  TimerManager& operator=(const TimerManager&) = delete;
+
+  // Schedules \a closure to run on the thread pool at \a deadline.
+  void TimerInit(Timer* timer, absl::Time deadline,
+                 experimental::EventEngine::Closure* closure);
+  // Removes \a timer if it has not fired yet. Returns true if the timer was
+  // removed, in which case its closure will never be run.
+  bool TimerCancel(Timer* timer);
+
+ private:
+  void MainLoop();
+
+  void HeapAdd(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void HeapRemove(Timer* timer) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void HeapSwap(size_t i, size_t j) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void SiftUp(size_t i) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void SiftDown(size_t i) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  experimental::ThreadPool* const thread_pool_;
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  std::vector<Timer*> heap_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_core::Thread thread_;
+};
+
+}  // namespace posix_engine
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_POSIX_ENGINE_TIMER_MANAGER_H
@@ -0,0 +1,168 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/event_engine/thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+namespace grpc_event_engine {
+namespace experimental {
+
+class ThreadPool::Worker {
+ public:
+  Worker(ThreadPool* pool, size_t index) : pool_(pool), index_(index) {
+    thd_ = grpc_core::Thread(
+        "event_engine_worker",
+        [](void* arg) { static_cast<Worker*>(arg)->Run(); }, this);
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+  ThreadPool* pool() const { return pool_; }
+  size_t index() const { return index_; }
+
+  // Pushes to the back of the local queue. Only called by the owning thread.
+  void PushLocal(std::function<void()> callback) {
+    grpc_core::MutexLock lock(&mu_);
+    queue_.push_back(std::move(callback));
+  }
+
+  // Pops the most recently added callback. Only called by the owning thread.
+  std::function<void()> PopLocal() {
+    grpc_core::MutexLock lock(&mu_);
+    if (queue_.empty()) return nullptr;
+    std::function<void()> callback = std::move(queue_.back());
+    queue_.pop_back();
+    return callback;
+  }
+
+  // Takes the oldest callback on behalf of another worker.
+  std::function<void()> Steal() {
+    grpc_core::MutexLock lock(&mu_);
+    if (queue_.empty()) return nullptr;
+    std::function<void()> callback = std::move(queue_.front());
+    queue_.pop_front();
+    return callback;
+  }
+
+ private:
+  void Run();
+
+  ThreadPool* const pool_;
+  const size_t index_;
+  grpc_core::Thread thd_;
+  grpc_core::Mutex mu_;
+  std::deque<std::function<void()>> queue_ ABSL_GUARDED_BY(mu_);
+};
+
+GPR_THREAD_LOCAL(ThreadPool::Worker*) ThreadPool::g_current_worker_;
+
+void ThreadPool::Worker::Run() {
+  g_current_worker_ = this;
+  while (true) {
+    std::function<void()> callback = pool_->TakeWork(this);
+    if (callback != nullptr) {
+      callback();
+      continue;
+    }
+    if (!pool_->Park()) break;
+  }
+  g_current_worker_ = nullptr;
+}
+
+ThreadPool::ThreadPool(int num_threads) {
+  if (num_threads <= 0) {
+    num_threads = std::max(2u, gpr_cpu_num_cores());
+  }
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(absl::make_unique<Worker>(this, i));
+  }
+  for (auto& worker : workers_) {
+    worker->Start();
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  GPR_ASSERT(!IsThreadPoolThread());
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+  }
+  for (auto& worker : workers_) {
+    worker->Join();
+  }
+}
+
+void ThreadPool::Add(std::function<void()> callback) {
+  Worker* worker = g_current_worker_;
+  if (worker != nullptr && worker->pool() == this) {
+    worker->PushLocal(std::move(callback));
+  } else {
+    grpc_core::MutexLock lock(&mu_);
+    GPR_DEBUG_ASSERT(!shutdown_);
+    global_queue_.push_back(std::move(callback));
+  }
+  // Publish the new work before checking for idle workers. Park() does the
+  // mirror image (announce idleness, then check for work), so at least one
+  // side always observes the other and no wakeup is lost.
+  pending_.fetch_add(1);
+  if (idle_workers_.load() > 0) {
+    grpc_core::MutexLock lock(&mu_);
+    cv_.Signal();
+  }
+}
+
+bool ThreadPool::IsThreadPoolThread() const {
+  Worker* worker = g_current_worker_;
+  return worker != nullptr && worker->pool() == this;
+}
+
+std::function<void()> ThreadPool::TakeWork(Worker* worker) {
+  std::function<void()> callback = worker->PopLocal();
+  if (callback == nullptr) {
+    grpc_core::MutexLock lock(&mu_);
+    if (!global_queue_.empty()) {
+      callback = std::move(global_queue_.front());
+      global_queue_.pop_front();
+    }
+  }
+  for (size_t i = 1; callback == nullptr && i < workers_.size(); ++i) {
+    callback = workers_[(worker->index() + i) % workers_.size()]->Steal();
+  }
+  if (callback != nullptr) pending_.fetch_sub(1);
+  return callback;
+}
+
+bool ThreadPool::Park() {
+  grpc_core::MutexLock lock(&mu_);
+  idle_workers_.fetch_add(1);
+  while (!shutdown_ && pending_.load() <= 0) {
+    cv_.Wait(&mu_);
+  }
+  idle_workers_.fetch_sub(1);
+  return !shutdown_ || pending_.load() > 0;
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
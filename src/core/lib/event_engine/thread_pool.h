@@ -0,0 +1,90 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_EVENT_ENGINE_THREAD_POOL_H
+#define GRPC_CORE_LIB_EVENT_ENGINE_THREAD_POOL_H
+
+#include <grpc/support/port_platform.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+// A fixed-size work-stealing thread pool.
+//
+// Every worker owns a local run queue. Callbacks added from a worker thread
+// are pushed onto that worker's queue and popped LIFO, so that a callback
+// scheduled by another callback tends to run on the same (warm) thread.
+// Callbacks added from any other thread go to a shared FIFO queue. A worker
+// that runs out of local work drains the shared queue, then steals the oldest
+// entries from its siblings, and only parks once there is no work left
+// anywhere in the pool.
+class ThreadPool final {
+ public:
+  // Creates a pool of \a num_threads workers. If \a num_threads is 0 or less,
+  // a size derived from the number of cores is used.
+  explicit ThreadPool(int num_threads = 0);
+  // Runs all callbacks that were added before destruction began, then joins
+  // all workers.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Schedules \a callback for execution on some worker thread.
+  void Add(std::function<void()> callback);
+
+  // Returns true if the calling thread is a worker of this pool.
+  bool IsThreadPoolThread() const;
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+
+ private:
+  class Worker;
+
+  // Finds the next callback for \a worker, looking at its own queue, the
+  // shared queue, and finally the other workers' queues. Returns an empty
+  // function if no work was found.
+  std::function<void()> TakeWork(Worker* worker);
+  // Blocks until work may be available. Returns false once the pool is shut
+  // down and drained.
+  bool Park();
+
+  static GPR_THREAD_LOCAL(Worker*) g_current_worker_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Number of callbacks added but not yet taken by a worker.
+  std::atomic<intptr_t> pending_{0};
+  // Number of workers currently parked (or about to park) on cv_.
+  std::atomic<int> idle_workers_{0};
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  std::deque<std::function<void()>> global_queue_ ABSL_GUARDED_BY(mu_);
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+#endif  // GRPC_CORE_LIB_EVENT_ENGINE_THREAD_POOL_H
@@ -23,6 +23,9 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <utility>
+#include <vector>
+
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd_id.h>
@@ -70,10 +73,20 @@ class Thread {
     }
     size_t stack_size() const { return stack_size_; }
 
+    /// Restricts the thread to run on the given CPUs. Empty (the default)
+    /// leaves the thread free to run anywhere. Only supported on Linux; CPUs
+    /// that do not exist are ignored.
+    Options& set_cpus(std::vector<unsigned> cpus) {
+      cpus_ = std::move(cpus);
+      return *this;
+    }
+    const std::vector<unsigned>& cpus() const { return cpus_; }
+
    private:
     bool joinable_;
     bool tracked_;
     size_t stack_size_;
+    std::vector<unsigned> cpus_;
   };
   /// Default constructor only to allow use in structs that lack constructors
   /// Does not produce a validly-constructed thread; must later
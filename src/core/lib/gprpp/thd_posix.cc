@@ -23,11 +23,15 @@
 #ifdef GPR_POSIX_SYNC
 
 #include <pthread.h>
+#if defined(GPR_LINUX) && !defined(GPR_MUSL_LIBC_COMPAT)
+#include <sched.h>
+#endif
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/thd_id.h>
@@ -105,6 +109,20 @@ class ThreadInternalsPosix : public internal::ThreadInternalsInterface {
       GPR_ASSERT(pthread_attr_setstacksize(&attr, stack_size) == 0);
     }
 
+#if defined(GPR_LINUX) && !defined(GPR_MUSL_LIBC_COMPAT)
+    if (!options.cpus().empty()) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for (unsigned cpu : options.cpus()) {
+        if (cpu < CPU_SETSIZE && cpu < gpr_cpu_num_cores()) CPU_SET(cpu, &cpus);
+      }
+      if (CPU_COUNT(&cpus) != 0) {
+        GPR_ASSERT(pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus) ==
+                   0);
+      }
+    }
+#endif
+
     *success = (pthread_create(
                     &pthread_id_, &attr,
                     [](void* v) -> void* {
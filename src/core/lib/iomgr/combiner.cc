@@ -24,15 +24,32 @@
 #include <inttypes.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/gprpp/global_config.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 
 grpc_core::DebugOnlyTraceFlag grpc_combiner_trace(false, "combiner");
 
+GPR_GLOBAL_CONFIG_DEFINE_INT32(
+    grpc_combiner_time_budget_us, 1000,
+    "Time in microseconds a thread may spend executing closures on a combiner "
+    "lock or callbacks on a work serializer before the remaining work is "
+    "offloaded to the executor. Set to 0 to disable.");
+
+int64_t grpc_combiner_time_budget_micros() {
+  static const int64_t budget =
+      std::max(0, GPR_GLOBAL_CONFIG_GET(grpc_combiner_time_budget_us));
+  return budget;
+}
+
 #define GRPC_COMBINER_TRACE(fn)          \
   do {                                   \
     if (grpc_combiner_trace.enabled()) { \
@@ -62,7 +79,12 @@ grpc_core::Combiner* grpc_combiner_create(void) {
 }
 
 static void really_destroy(grpc_core::Combiner* lock) {
-  GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p really_destroy", lock));
+  GRPC_COMBINER_TRACE(gpr_log(
+      GPR_INFO,
+      "C:%p really_destroy holds=%" PRIuPTR " items=%" PRIuPTR
+      " micros=%" PRId64 " offloads=%" PRIuPTR,
+      lock, lock->total_holds, lock->total_items, lock->total_micros,
+      lock->total_offloads));
   GPR_ASSERT(gpr_atm_no_barrier_load(&lock->state) == 0);
   delete lock;
 }
@@ -130,7 +152,9 @@ static void combiner_exec(grpc_core::Combiner* lock, grpc_closure* cl,
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO,
                               "C:%p grpc_combiner_execute c=%p last=%" PRIdPTR,
                               lock, cl, last));
+  GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_ITEMS();
   if (last == 1) {
+    GRPC_STATS_INC_COMBINER_LOCKS_INITIATED();
     gpr_atm_no_barrier_store(
         &lock->initiating_exec_ctx_or_null,
         reinterpret_cast<gpr_atm>(grpc_core::ExecCtx::Get()));
@@ -167,6 +191,29 @@ static void move_next() {
   }
 }
 
+// Accounts for \a items closures that the current thread started running on
+// the combiner at \a start.
+static void add_to_hold(grpc_core::Combiner* lock, gpr_cycle_counter start,
+                        size_t items) {
+  gpr_timespec elapsed =
+      gpr_cycle_counter_sub(gpr_get_cycle_counter(), start);
+  int64_t micros =
+      elapsed.tv_sec * GPR_US_PER_SEC + elapsed.tv_nsec / GPR_NS_PER_US;
+  if (lock->hold_items == 0) ++lock->total_holds;
+  lock->hold_items += items;
+  lock->hold_micros += micros;
+  lock->total_items += items;
+  lock->total_micros += micros;
+}
+
+// Records a hold that ended, either because the thread ran out of work or
+// because the rest of it was offloaded.
+static void record_hold(size_t items, int64_t micros) {
+  if (items == 0) return;
+  GRPC_STATS_INC_COMBINER_LOCKS_ITEMS_PER_HOLD(items);
+  GRPC_STATS_INC_COMBINER_LOCKS_HOLD_MICROS(micros);
+}
+
 static void offload(void* arg, grpc_error_handle /*error*/) {
   grpc_core::Combiner* lock = static_cast<grpc_core::Combiner*>(arg);
   push_last_on_exec_ctx(lock);
@@ -174,6 +221,11 @@ static void offload(void* arg, grpc_error_handle /*error*/) {
 
 static void queue_offload(grpc_core::Combiner* lock) {
   move_next();
+  record_hold(lock->hold_items, lock->hold_micros);
+  lock->hold_items = 0;
+  lock->hold_micros = 0;
+  ++lock->total_offloads;
+  GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED();
   GRPC_COMBINER_TRACE(gpr_log(GPR_INFO, "C:%p queue_offload", lock));
   grpc_core::Executor::Run(&lock->offload, GRPC_ERROR_NONE);
 }
@@ -198,17 +250,34 @@ bool grpc_combiner_continue_exec_ctx() {
                               lock->time_to_execute_final_list));
 
   // offload only if all the following conditions are true:
-  // 1. the combiner is contended and has more than one closure to execute
-  // 2. the current execution context needs to finish as soon as possible
-  // 3. the current thread is not a worker for any background poller
-  // 4. the DEFAULT executor is threaded
-  if (contended && grpc_core::ExecCtx::Get()->IsReadyToFinish() &&
-      !grpc_iomgr_platform_is_any_background_poller_thread() &&
+  // 1. either:
+  //    a. the combiner is contended and has more than one closure to execute,
+  //       and the current execution context needs to finish as soon as
+  //       possible, or
+  //    b. the current thread has spent longer than its time budget executing
+  //       closures on the combiner
+  // 2. the current thread is not a worker for any background poller
+  // 3. the DEFAULT executor is threaded
+  if (!grpc_iomgr_platform_is_any_background_poller_thread() &&
       grpc_core::Executor::IsThreadedDefault()) {
-    // this execution context wants to move on: schedule remaining work to be
-    // picked up on the executor
-    queue_offload(lock);
-    return true;
+    if (contended && grpc_core::ExecCtx::Get()->IsReadyToFinish()) {
+      // this execution context wants to move on: schedule remaining work to
+      // be picked up on the executor
+      queue_offload(lock);
+      return true;
+    }
+    const int64_t budget = grpc_combiner_time_budget_micros();
+    if (budget > 0 && lock->hold_micros >= budget) {
+      // don't let one busy combiner monopolize this thread: let the executor
+      // pick up the remaining work, so that this thread can get back to
+      // whatever else it has to do (e.g. polling)
+      GRPC_COMBINER_TRACE(gpr_log(GPR_INFO,
+                                  "C:%p over budget after %" PRIuPTR " items",
+                                  lock, lock->hold_items));
+      GRPC_STATS_INC_COMBINER_LOCKS_OFFLOADED_OVER_BUDGET();
+      queue_offload(lock);
+      return true;
+    }
   }
 
   if (!lock->time_to_execute_final_list ||
@@ -228,6 +297,7 @@ bool grpc_combiner_continue_exec_ctx() {
 #ifndef NDEBUG
     cl->scheduled = false;
 #endif
+    gpr_cycle_counter start = gpr_get_cycle_counter();
 #ifdef GRPC_ERROR_IS_ABSEIL_STATUS
     grpc_error_handle cl_err =
         grpc_core::internal::StatusMoveFromHeapPtr(cl->error_data.error);
@@ -240,10 +310,13 @@ bool grpc_combiner_continue_exec_ctx() {
     cl->cb(cl->cb_arg, cl_err);
     GRPC_ERROR_UNREF(cl_err);
 #endif
+    add_to_hold(lock, start, 1);
   } else {
     grpc_closure* c = lock->final_list.head;
     GPR_ASSERT(c != nullptr);
     grpc_closure_list_init(&lock->final_list);
+    gpr_cycle_counter start = gpr_get_cycle_counter();
+    size_t items = 0;
     int loops = 0;
     while (c != nullptr) {
       GRPC_COMBINER_TRACE(
@@ -264,12 +337,20 @@ bool grpc_combiner_continue_exec_ctx() {
       c->cb(c->cb_arg, error);
       GRPC_ERROR_UNREF(error);
 #endif
+      ++items;
       c = next;
     }
+    add_to_hold(lock, start, items);
   }
 
   move_next();
   lock->time_to_execute_final_list = false;
+  // Once the state is updated below, another thread may take over the lock
+  // (or destroy it), so take this thread's hold out of it first.
+  const size_t hold_items = lock->hold_items;
+  const int64_t hold_micros = lock->hold_micros;
+  lock->hold_items = 0;
+  lock->hold_micros = 0;
   gpr_atm old_state =
       gpr_atm_full_fetch_add(&lock->state, -STATE_ELEM_COUNT_LOW_BIT);
   GRPC_COMBINER_TRACE(
@@ -293,9 +374,11 @@ bool grpc_combiner_continue_exec_ctx() {
       break;
     case OLD_STATE_WAS(false, 1):
       // had one count, one unorphaned --> unlocked unorphaned
+      record_hold(hold_items, hold_micros);
       return true;
     case OLD_STATE_WAS(true, 1):
       // and one count, one orphaned --> unlocked and orphaned
+      record_hold(hold_items, hold_micros);
       really_destroy(lock);
       return true;
     case OLD_STATE_WAS(false, 0):
@@ -304,6 +387,9 @@ bool grpc_combiner_continue_exec_ctx() {
       // deleted lock
       GPR_UNREACHABLE_CODE(return true);
   }
+  // still locked: this thread's hold goes on
+  lock->hold_items = hold_items;
+  lock->hold_micros = hold_micros;
   push_first_on_exec_ctx(lock);
   return true;
 }
@@ -325,6 +411,7 @@ static void combiner_finally_exec(grpc_core::Combiner* lock,
     return;
   }
 
+  GRPC_STATS_INC_COMBINER_LOCKS_SCHEDULED_FINAL_ITEMS();
   if (grpc_closure_list_empty(lock->final_list)) {
     gpr_atm_full_fetch_add(&lock->state, STATE_ELEM_COUNT_LOW_BIT);
   }
@@ -51,6 +51,16 @@ class Combiner {
   grpc_closure_list final_list;
   grpc_closure offload;
   gpr_refcount refs;
+  // How many closures the thread currently executing the combiner has run
+  // since it started doing so, and how long they took.
+  size_t hold_items = 0;
+  int64_t hold_micros = 0;
+  // Totals over the lifetime of the combiner, logged on destruction when
+  // tracing.
+  size_t total_holds = 0;
+  size_t total_items = 0;
+  int64_t total_micros = 0;
+  size_t total_offloads = 0;
 };
 }  // namespace grpc_core
 
@@ -84,6 +94,12 @@ void grpc_combiner_unref(grpc_core::Combiner* lock GRPC_COMBINER_DEBUG_ARGS);
 
 bool grpc_combiner_continue_exec_ctx();
 
+// How long, in microseconds, a thread may keep executing closures on a
+// combiner (or callbacks on a WorkSerializer) before the remaining work is
+// offloaded to the executor. 0 means no limit. Configured with
+// GRPC_COMBINER_TIME_BUDGET_US.
+int64_t grpc_combiner_time_budget_micros();
+
 extern grpc_core::DebugOnlyTraceFlag grpc_combiner_trace;
 
 #endif /* GRPC_CORE_LIB_IOMGR_COMBINER_H */
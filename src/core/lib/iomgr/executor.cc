@@ -22,15 +22,15 @@
 
 #include <string.h>
 
-#include <grpc/support/alloc.h>
+#include <algorithm>
+
 #include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 
-#include "src/core/lib/gpr/tls.h"
-#include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/memory.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor/work_stealing_queue.h"
 #include "src/core/lib/iomgr/iomgr_internal.h"
 
 #define MAX_DEPTH 2
@@ -52,7 +52,20 @@
 namespace grpc_core {
 namespace {
 
-GPR_THREAD_LOCAL(ThreadState*) g_this_thread_state;
+// Long jobs are queued with the low bit of the closure pointer set, so that
+// the thread that runs one knows it is tied up for a while.
+constexpr uintptr_t kLongJobTag = 1;
+
+void* TagClosure(grpc_closure* closure, bool is_short) {
+  return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(closure) |
+                                 (is_short ? 0 : kLongJobTag));
+}
+
+grpc_closure* UntagClosure(void* elem, bool* is_short) {
+  uintptr_t bits = reinterpret_cast<uintptr_t>(elem);
+  *is_short = (bits & kLongJobTag) == 0;
+  return reinterpret_cast<grpc_closure*>(bits & ~kLongJobTag);
+}
 
 Executor* executors[static_cast<size_t>(ExecutorType::NUM_EXECUTORS)];
 
@@ -96,49 +109,37 @@ Executor::Executor(const char* name) : name_(name) {
 
 void Executor::Init() { SetThreading(true); }
 
-size_t Executor::RunClosures(const char* executor_name,
-                             grpc_closure_list list) {
-  size_t n = 0;
-
+void Executor::RunClosure(const char* executor_name, grpc_closure* closure) {
   // In the executor, the ExecCtx for the thread is declared in the executor
   // thread itself, but this is the point where we could start seeing
   // application-level callbacks. No need to create a new ExecCtx, though,
   // since there already is one and it is flushed (but not destructed) in this
   // function itself. The ApplicationCallbackExecCtx will have its callbacks
-  // invoked on its destruction, which will be after completing any closures in
-  // the executor's closure list (which were explicitly scheduled onto the
-  // executor).
+  // invoked on its destruction, which will be after completing the closure.
   ApplicationCallbackExecCtx callback_exec_ctx(
       GRPC_APP_CALLBACK_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
 
-  grpc_closure* c = list.head;
-  while (c != nullptr) {
-    grpc_closure* next = c->next_data.next;
+  grpc_closure* c = closure;
 #ifndef NDEBUG
-    EXECUTOR_TRACE("(%s) run %p [created by %s:%d]", executor_name, c,
-                   c->file_created, c->line_created);
-    c->scheduled = false;
+  EXECUTOR_TRACE("(%s) run %p [created by %s:%d]", executor_name, c,
+                 c->file_created, c->line_created);
+  c->scheduled = false;
 #else
-    EXECUTOR_TRACE("(%s) run %p", executor_name, c);
+  EXECUTOR_TRACE("(%s) run %p", executor_name, c);
 #endif
 #ifdef GRPC_ERROR_IS_ABSEIL_STATUS
-    grpc_error_handle error =
-        internal::StatusMoveFromHeapPtr(c->error_data.error);
-    c->error_data.error = 0;
-    c->cb(c->cb_arg, std::move(error));
+  grpc_error_handle error =
+      internal::StatusMoveFromHeapPtr(c->error_data.error);
+  c->error_data.error = 0;
+  c->cb(c->cb_arg, std::move(error));
 #else
-    grpc_error_handle error =
-        reinterpret_cast<grpc_error_handle>(c->error_data.error);
-    c->error_data.error = 0;
-    c->cb(c->cb_arg, error);
-    GRPC_ERROR_UNREF(error);
+  grpc_error_handle error =
+      reinterpret_cast<grpc_error_handle>(c->error_data.error);
+  c->error_data.error = 0;
+  c->cb(c->cb_arg, error);
+  GRPC_ERROR_UNREF(error);
 #endif
-    c = next;
-    n++;
-    ExecCtx::Get()->Flush();
-  }
-
-  return n;
+  ExecCtx::Get()->Flush();
 }
 
 bool Executor::IsThreaded() const {
@@ -156,54 +157,47 @@ void Executor::SetThreading(bool threading) {
     }
 
     GPR_ASSERT(num_threads_ == 0);
+    queue_ = new WorkStealingQueue(static_cast<int>(max_threads_));
+    threads_ = new Thread[max_threads_];
+    shutdown_ = false;
     gpr_atm_rel_store(&num_threads_, 1);
-    thd_state_ = static_cast<ThreadState*>(
-        gpr_zalloc(sizeof(ThreadState) * max_threads_));
-
-    for (size_t i = 0; i < max_threads_; i++) {
-      gpr_mu_init(&thd_state_[i].mu);
-      gpr_cv_init(&thd_state_[i].cv);
-      thd_state_[i].id = i;
-      thd_state_[i].name = name_;
-      thd_state_[i].thd = Thread();
-      thd_state_[i].elems = GRPC_CLOSURE_LIST_INIT;
-    }
-
-    thd_state_[0].thd = Thread(name_, &Executor::ThreadMain, &thd_state_[0]);
-    thd_state_[0].thd.Start();
+    threads_[0] = Thread(name_, &Executor::ThreadMain, this);
+    threads_[0].Start();
   } else {  // !threading
     if (curr_num_threads == 0) {
       EXECUTOR_TRACE("(%s) SetThreading(false). curr_num_threads == 0", name_);
       return;
     }
 
-    for (size_t i = 0; i < max_threads_; i++) {
-      gpr_mu_lock(&thd_state_[i].mu);
-      thd_state_[i].shutdown = true;
-      gpr_cv_signal(&thd_state_[i].cv);
-      gpr_mu_unlock(&thd_state_[i].mu);
-    }
-
-    /* Ensure no thread is adding a new thread. Once this is past, then no
-     * thread will try to add a new one either (since shutdown is true) */
+    /* Once this is past, no thread will try to add a new one */
     gpr_spinlock_lock(&adding_thread_lock_);
+    shutdown_ = true;
     gpr_spinlock_unlock(&adding_thread_lock_);
 
+    /* Each thread exits when it takes a null closure, which it only does once
+     * it has run everything that was queued ahead of it */
     curr_num_threads = gpr_atm_no_barrier_load(&num_threads_);
     for (gpr_atm i = 0; i < curr_num_threads; i++) {
-      thd_state_[i].thd.Join();
+      queue_->Put(nullptr);
+    }
+    for (gpr_atm i = 0; i < curr_num_threads; i++) {
+      threads_[i].Join();
       EXECUTOR_TRACE("(%s) Thread %" PRIdPTR " of %" PRIdPTR " joined", name_,
                      i + 1, curr_num_threads);
     }
 
     gpr_atm_rel_store(&num_threads_, 0);
-    for (size_t i = 0; i < max_threads_; i++) {
-      gpr_mu_destroy(&thd_state_[i].mu);
-      gpr_cv_destroy(&thd_state_[i].cv);
-      RunClosures(thd_state_[i].name, thd_state_[i].elems);
+    /* Run whatever got queued while the threads were exiting */
+    void* elem;
+    while (queue_->TryGet(&elem)) {
+      bool is_short;
+      if (elem != nullptr) RunClosure(name_, UntagClosure(elem, &is_short));
     }
 
-    gpr_free(thd_state_);
+    delete queue_;
+    queue_ = nullptr;
+    delete[] threads_;
+    threads_ = nullptr;
 
     // grpc_iomgr_shutdown_background_closure() will close all the registered
     // fds in the background poller, and wait for all pending closures to
@@ -220,155 +214,103 @@ void Executor::SetThreading(bool threading) {
 void Executor::Shutdown() { SetThreading(false); }
 
 void Executor::ThreadMain(void* arg) {
-  ThreadState* ts = static_cast<ThreadState*>(arg);
-  g_this_thread_state = ts;
+  Executor* executor = static_cast<Executor*>(arg);
 
   ExecCtx exec_ctx(GRPC_EXEC_CTX_FLAG_IS_INTERNAL_THREAD);
 
-  size_t subtract_depth = 0;
   for (;;) {
-    EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: step (sub_depth=%" PRIdPTR ")",
-                   ts->name, ts->id, subtract_depth);
-
-    gpr_mu_lock(&ts->mu);
-    ts->depth -= subtract_depth;
-    // Wait for closures to be enqueued or for the executor to be shutdown
-    while (grpc_closure_list_empty(ts->elems) && !ts->shutdown) {
-      ts->queued_long_job = false;
-      gpr_cv_wait(&ts->cv, &ts->mu, gpr_inf_future(GPR_CLOCK_MONOTONIC));
-    }
-
-    if (ts->shutdown) {
-      EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: shutdown", ts->name, ts->id);
-      gpr_mu_unlock(&ts->mu);
+    // Wait for a closure to be enqueued, or for the executor to be shutdown
+    void* elem = executor->queue_->Get(nullptr);
+    if (elem == nullptr) {
+      EXECUTOR_TRACE("(%s) thread shutdown", executor->name_);
       break;
     }
 
-    grpc_closure_list closures = ts->elems;
-    ts->elems = GRPC_CLOSURE_LIST_INIT;
-    gpr_mu_unlock(&ts->mu);
-
-    EXECUTOR_TRACE("(%s) [%" PRIdPTR "]: execute", ts->name, ts->id);
-
+    bool is_short;
+    grpc_closure* closure = UntagClosure(elem, &is_short);
     ExecCtx::Get()->InvalidateNow();
-    subtract_depth = RunClosures(ts->name, closures);
+    if (is_short) {
+      RunClosure(executor->name_, closure);
+    } else {
+      executor->long_jobs_running_.fetch_add(1, std::memory_order_relaxed);
+      RunClosure(executor->name_, closure);
+      executor->long_jobs_running_.fetch_sub(1, std::memory_order_relaxed);
+    }
   }
+}
 
-  g_this_thread_state = nullptr;
+void Executor::AddThread() {
+  if (!gpr_spinlock_trylock(&adding_thread_lock_)) return;
+  size_t cur_thread_count =
+      static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
+  if (cur_thread_count < max_threads_ && !shutdown_) {
+    // Increment num_threads (safe to do a store instead of a cas because we
+    // always increment num_threads under the 'adding_thread_lock')
+    gpr_atm_rel_store(&num_threads_, cur_thread_count + 1);
+
+    threads_[cur_thread_count] = Thread(name_, &Executor::ThreadMain, this);
+    threads_[cur_thread_count].Start();
+  }
+  gpr_spinlock_unlock(&adding_thread_lock_);
 }
 
 void Executor::Enqueue(grpc_closure* closure, grpc_error_handle error,
                        bool is_short) {
-  bool retry_push;
+  size_t cur_thread_count =
+      static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
 
-  do {
-    retry_push = false;
-    size_t cur_thread_count =
-        static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
-
-    // If the number of threads is zero(i.e either the executor is not threaded
-    // or already shutdown), then queue the closure on the exec context itself
-    if (cur_thread_count == 0) {
+  // If the number of threads is zero(i.e either the executor is not threaded
+  // or already shutdown), then queue the closure on the exec context itself
+  if (cur_thread_count == 0) {
 #ifndef NDEBUG
-      EXECUTOR_TRACE("(%s) schedule %p (created %s:%d) inline", name_, closure,
-                     closure->file_created, closure->line_created);
+    EXECUTOR_TRACE("(%s) schedule %p (created %s:%d) inline", name_, closure,
+                   closure->file_created, closure->line_created);
 #else
-      EXECUTOR_TRACE("(%s) schedule %p inline", name_, closure);
+    EXECUTOR_TRACE("(%s) schedule %p inline", name_, closure);
 #endif
-      grpc_closure_list_append(ExecCtx::Get()->closure_list(), closure, error);
-      return;
-    }
-
-    if (grpc_iomgr_platform_add_closure_to_background_poller(closure, error)) {
-      return;
-    }
-
-    ThreadState* ts = g_this_thread_state;
-    if (ts == nullptr) {
-      ts = &thd_state_[HashPointer(ExecCtx::Get(), cur_thread_count)];
-    }
+    grpc_closure_list_append(ExecCtx::Get()->closure_list(), closure, error);
+    return;
+  }
 
-    ThreadState* orig_ts = ts;
-    bool try_new_thread = false;
+  if (grpc_iomgr_platform_add_closure_to_background_poller(closure, error)) {
+    return;
+  }
 
-    for (;;) {
 #ifndef NDEBUG
-      EXECUTOR_TRACE(
-          "(%s) try to schedule %p (%s) (created %s:%d) to thread "
-          "%" PRIdPTR,
-          name_, closure, is_short ? "short" : "long", closure->file_created,
-          closure->line_created, ts->id);
+  EXECUTOR_TRACE("(%s) schedule %p (%s) (created %s:%d)", name_, closure,
+                 is_short ? "short" : "long", closure->file_created,
+                 closure->line_created);
 #else
-      EXECUTOR_TRACE("(%s) try to schedule %p (%s) to thread %" PRIdPTR, name_,
-                     closure, is_short ? "short" : "long", ts->id);
+  EXECUTOR_TRACE("(%s) schedule %p (%s)", name_, closure,
+                 is_short ? "short" : "long");
 #endif
 
-      gpr_mu_lock(&ts->mu);
-      if (ts->queued_long_job) {
-        // if there's a long job queued, we never queue anything else to this
-        // queue (since long jobs can take 'infinite' time and we need to
-        // guarantee no starvation). Spin through queues and try again
-        gpr_mu_unlock(&ts->mu);
-        size_t idx = ts->id;
-        ts = &thd_state_[(idx + 1) % cur_thread_count];
-        if (ts == orig_ts) {
-          // We cycled through all the threads. Retry enqueue again by creating
-          // a new thread
-          //
-          // TODO (sreek): There is a potential issue here. We are
-          // unconditionally setting try_new_thread to true here. What if the
-          // executor is shutdown OR if cur_thread_count is already equal to
-          // max_threads ?
-          // (Fortunately, this is not an issue yet (as of july 2018) because
-          // there is only one instance of long job in gRPC and hence we will
-          // not hit this code path)
-          retry_push = true;
-          try_new_thread = true;
-          break;
-        }
-
-        continue;  // Try the next thread-state
-      }
-
-      // == Found the thread state (i.e thread) to enqueue this closure! ==
-
-      // Also, if this thread has been waiting for closures, wake it up.
-      // - If grpc_closure_list_empty() is true and the Executor is not
-      //   shutdown, it means that the thread must be waiting in ThreadMain()
-      // - Note that gpr_cv_signal() won't immediately wakeup the thread. That
-      //   happens after we release the mutex &ts->mu a few lines below
-      if (grpc_closure_list_empty(ts->elems) && !ts->shutdown) {
-        gpr_cv_signal(&ts->cv);
-      }
-
-      grpc_closure_list_append(&ts->elems, closure, error);
-
-      // If we already queued more than MAX_DEPTH number of closures on this
-      // thread, use this as a hint to create more threads
-      ts->depth++;
-      try_new_thread = ts->depth > MAX_DEPTH &&
-                       cur_thread_count < max_threads_ && !ts->shutdown;
-
-      ts->queued_long_job = !is_short;
-
-      gpr_mu_unlock(&ts->mu);
-      break;
-    }
+#ifdef GRPC_ERROR_IS_ABSEIL_STATUS
+  closure->error_data.error = internal::StatusAllocHeapPtr(error);
+#else
+  closure->error_data.error = reinterpret_cast<intptr_t>(error);
+#endif
 
-    if (try_new_thread && gpr_spinlock_trylock(&adding_thread_lock_)) {
-      cur_thread_count = static_cast<size_t>(gpr_atm_acq_load(&num_threads_));
-      if (cur_thread_count < max_threads_) {
-        // Increment num_threads (safe to do a store instead of a cas because we
-        // always increment num_threads under the 'adding_thread_lock')
-        gpr_atm_rel_store(&num_threads_, cur_thread_count + 1);
-
-        thd_state_[cur_thread_count].thd =
-            Thread(name_, &Executor::ThreadMain, &thd_state_[cur_thread_count]);
-        thd_state_[cur_thread_count].thd.Start();
-      }
-      gpr_spinlock_unlock(&adding_thread_lock_);
-    }
-  } while (retry_push);
+  if (is_short) {
+    // From an executor thread, this lands on the thread's own deque.
+    queue_->Put(TagClosure(closure, true));
+  } else {
+    // A long job can take 'infinite' time and reschedule itself; keep it off
+    // the calling thread's deque so it never gets ahead of the short jobs
+    // there.
+    queue_->PutShared(TagClosure(closure, false));
+  }
+
+  // If no thread is free to pick up work, start another one when work is
+  // piling up (more than MAX_DEPTH closures per thread) or when every thread
+  // might be tied up in a long job.
+  size_t long_jobs = long_jobs_running_.load(std::memory_order_relaxed);
+  if (!is_short) long_jobs++;
+  if (cur_thread_count < max_threads_ && queue_->idle_workers() == 0 &&
+      (static_cast<size_t>(queue_->count()) > MAX_DEPTH * cur_thread_count ||
+       long_jobs >= cur_thread_count)) {
+    AddThread();
+  }
 }
 
 // Executor::InitAll() and Executor::ShutdownAll() functions are called in the
@@ -21,23 +21,15 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
+
 #include "src/core/lib/gpr/spinlock.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/closure.h"
 
 namespace grpc_core {
 
-struct ThreadState {
-  gpr_mu mu;
-  size_t id;         // For debugging purposes
-  const char* name;  // Thread state name
-  gpr_cv cv;
-  grpc_closure_list elems;
-  size_t depth;  // Number of closures in the closure list
-  bool shutdown;
-  bool queued_long_job;
-  Thread thd;
-};
+class WorkStealingQueue;
 
 enum class ExecutorType {
   DEFAULT = 0,
@@ -104,14 +96,23 @@ class Executor {
   static bool IsThreadedDefault();
 
  private:
-  static size_t RunClosures(const char* executor_name, grpc_closure_list list);
+  static void RunClosure(const char* executor_name, grpc_closure* closure);
   static void ThreadMain(void* arg);
+  // Starts one more thread, unless there are max_threads_ already or the
+  // executor is shutting down.
+  void AddThread();
 
   const char* name_;
-  ThreadState* thd_state_;
+  // Closures waiting for a thread. Each thread has its own deque in there,
+  // and idle threads steal from the busy ones.
+  WorkStealingQueue* queue_ = nullptr;
+  Thread* threads_ = nullptr;  // max_threads_ of them
   size_t max_threads_;
   gpr_atm num_threads_;
+  // Number of threads running a long job.
+  std::atomic<size_t> long_jobs_running_{0};
   gpr_spinlock adding_thread_lock_;
+  bool shutdown_ = false;  // guarded by adding_thread_lock_
 };
 
 // Global initializer for executor
@@ -20,8 +20,27 @@
 
 #include "src/core/lib/iomgr/executor/threadpool.h"
 
+#include "src/core/lib/iomgr/executor/work_stealing_queue.h"
+
 namespace grpc_core {
 
+namespace {
+
+// Lets ThreadPoolWorker drain a WorkStealingQueue.
+class WorkStealingMPMCQueue : public MPMCQueueInterface {
+ public:
+  explicit WorkStealingMPMCQueue(int max_workers) : queue_(max_workers) {}
+
+  void Put(void* elem) override { queue_.Put(elem); }
+  void* Get(gpr_timespec* wait_time) override { return queue_.Get(wait_time); }
+  int count() const override { return queue_.count(); }
+
+ private:
+  WorkStealingQueue queue_;
+};
+
+}  // namespace
+
 void ThreadPoolWorker::Run() {
   while (true) {
     void* elem;
@@ -53,7 +72,11 @@ void ThreadPool::SharedThreadPoolConstructor() {
   // Create at least 1 worker thread.
   if (num_threads_ <= 0) num_threads_ = 1;
 
-  queue_ = new InfLenFIFOQueue();
+  if (queue_type_ == QueueType::kFifo) {
+    queue_ = new InfLenFIFOQueue();
+  } else {
+    queue_ = new WorkStealingMPMCQueue(num_threads_);
+  }
   threads_ = static_cast<ThreadPoolWorker**>(
       gpr_zalloc(num_threads_ * sizeof(ThreadPoolWorker*)));
   for (int i = 0; i < num_threads_; ++i) {
@@ -90,10 +113,12 @@ ThreadPool::ThreadPool(int num_threads, const char* thd_name)
 }
 
 ThreadPool::ThreadPool(int num_threads, const char* thd_name,
-                       const Thread::Options& thread_options)
+                       const Thread::Options& thread_options,
+                       QueueType queue_type)
     : num_threads_(num_threads),
       thd_name_(thd_name),
-      thread_options_(thread_options) {
+      thread_options_(thread_options),
+      queue_type_(queue_type) {
   if (thread_options_.stack_size() == 0) {
     thread_options_.set_stack_size(DefaultStackSize());
   }
@@ -96,6 +96,15 @@ class ThreadPoolWorker {
 // capacity of closure queue is unlimited.
 class ThreadPool : public ThreadPoolInterface {
  public:
+  // How pending closures are queued.
+  enum class QueueType {
+    // One FIFO queue shared by all the workers, under a mutex.
+    kFifo,
+    // A WorkStealingQueue: closures added by a worker thread are queued on
+    // that worker and run there unless an idle worker steals them.
+    kWorkStealing,
+  };
+
   // Creates a thread pool with size of "num_threads", with default thread name
   // "ThreadPoolWorker" and all thread options set to default. If the given size
   // is 0 or less, there will be 1 worker thread created inside pool.
@@ -112,8 +121,10 @@ class ThreadPool : public ThreadPoolInterface {
   // value 0, default ThreadPool stack size will be used. The current default
   // stack size of this implementation is 1952K for mobile platform and 64K for
   // all others.
+  // By default, pending closures are kept in a WorkStealingQueue.
   ThreadPool(int num_threads, const char* thd_name,
-             const Thread::Options& thread_options);
+             const Thread::Options& thread_options,
+             QueueType queue_type = QueueType::kWorkStealing);
 
   // Waits for all pending closures to complete, then shuts down thread pool.
   ~ThreadPool() override;
@@ -131,6 +142,7 @@ class ThreadPool : public ThreadPoolInterface {
   int num_threads_ = 0;
   const char* thd_name_ = nullptr;
   Thread::Options thread_options_;
+  QueueType queue_type_ = QueueType::kWorkStealing;
   ThreadPoolWorker** threads_ = nullptr;  // Array of worker threads
   MPMCQueueInterface* queue_ = nullptr;   // Closure queue
 
@@ -0,0 +1,380 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/executor/work_stealing_queue.h"
+
+#include <algorithm>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+namespace grpc_core {
+
+namespace {
+
+// Initial number of slots in a WorkStealingDeque.
+constexpr size_t kInitialDequeCapacity = 64;
+// Number of shared elements the lock-free injector holds before they spill
+// over to a locked list.
+constexpr size_t kInjectorCapacity = 1024;
+// Number of times an idle worker checks for new work before it parks. On a
+// single core, spinning only delays the thread that would produce the work.
+constexpr int kSpinRounds = 1000;
+
+}  // namespace
+
+//
+// WorkStealingDeque
+//
+
+class WorkStealingDeque::Buffer {
+ public:
+  explicit Buffer(size_t capacity)
+      : mask_(capacity - 1), elems_(new std::atomic<void*>[capacity]) {}
+
+  size_t capacity() const { return mask_ + 1; }
+  void* Get(int64_t i) const {
+    return elems_[static_cast<size_t>(i) & mask_].load(
+        std::memory_order_relaxed);
+  }
+  void Put(int64_t i, void* elem) {
+    elems_[static_cast<size_t>(i) & mask_].store(elem,
+                                                 std::memory_order_relaxed);
+  }
+
+ private:
+  const size_t mask_;
+  std::unique_ptr<std::atomic<void*>[]> elems_;
+};
+
+WorkStealingDeque::WorkStealingDeque() {
+  buffers_.push_back(absl::make_unique<Buffer>(kInitialDequeCapacity));
+  buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() {}
+
+WorkStealingDeque::Buffer* WorkStealingDeque::Grow(Buffer* old, int64_t top,
+                                                   int64_t bottom) {
+  buffers_.push_back(absl::make_unique<Buffer>(old->capacity() * 2));
+  Buffer* buffer = buffers_.back().get();
+  for (int64_t i = top; i < bottom; ++i) {
+    buffer->Put(i, old->Get(i));
+  }
+  buffer_.store(buffer, std::memory_order_release);
+  return buffer;
+}
+
+void WorkStealingDeque::Push(void* elem) {
+  GPR_DEBUG_ASSERT(elem != nullptr);
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_acquire);
+  Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+  if (bottom - top > static_cast<int64_t>(buffer->capacity()) - 1) {
+    buffer = Grow(buffer, top, bottom);
+  }
+  buffer->Put(bottom, elem);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+void* WorkStealingDeque::Pop() {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    // Empty.
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  void* elem = buffer->Get(bottom);
+  if (top == bottom) {
+    // Last element: thieves may be after it too.
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      elem = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return elem;
+}
+
+void* WorkStealingDeque::Steal() {
+  int64_t top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) return nullptr;
+  Buffer* buffer = buffer_.load(std::memory_order_acquire);
+  void* elem = buffer->Get(top);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return elem;
+}
+
+size_t WorkStealingDeque::size() const {
+  int64_t bottom = bottom_.load(std::memory_order_relaxed);
+  int64_t top = top_.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+//
+// BoundedMPMCQueue
+//
+
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t n) {
+  size_t result = 1;
+  while (result < n) result <<= 1;
+  return result;
+}
+
+}  // namespace
+
+BoundedMPMCQueue::BoundedMPMCQueue(size_t capacity)
+    : cells_(new Cell[RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2))]),
+      mask_(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2)) - 1) {
+  for (size_t i = 0; i <= mask_; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+BoundedMPMCQueue::~BoundedMPMCQueue() { delete[] cells_; }
+
+// A cell's sequence number says whose turn it is: it equals the position of
+// the producer that may fill it next, and that position plus one once it has
+// been filled, for the consumer at that position.
+bool BoundedMPMCQueue::TryPush(void* elem) {
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell* cell = &cells_[pos & mask_];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    intptr_t diff =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        cell->elem = elem;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // Full.
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool BoundedMPMCQueue::TryPop(void** elem) {
+  size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    Cell* cell = &cells_[pos & mask_];
+    size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    intptr_t diff =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        *elem = cell->elem;
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      // Empty.
+      return false;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+//
+// WorkStealingQueue
+//
+
+GPR_THREAD_LOCAL(WorkStealingQueue::Worker*)
+WorkStealingQueue::g_current_worker_;
+
+WorkStealingQueue::WorkStealingQueue(int max_workers)
+    : spin_rounds_(gpr_cpu_num_cores() > 1 ? kSpinRounds : 0),
+      injector_(kInjectorCapacity) {
+  if (max_workers < 1) max_workers = 1;
+  workers_.reserve(max_workers);
+  for (int i = 0; i < max_workers; ++i) {
+    workers_.push_back(absl::make_unique<Worker>());
+    workers_.back()->queue = this;
+    workers_.back()->index = i;
+  }
+}
+
+WorkStealingQueue::~WorkStealingQueue() {
+  GPR_ASSERT(pending_.load(std::memory_order_relaxed) == 0);
+}
+
+WorkStealingQueue::Worker* WorkStealingQueue::CurrentWorker() const {
+  Worker* worker = g_current_worker_;
+  return worker != nullptr && worker->queue == this ? worker : nullptr;
+}
+
+WorkStealingQueue::Worker* WorkStealingQueue::RegisterWorker() {
+  if (num_workers_.load(std::memory_order_relaxed) >= workers_.size()) {
+    return nullptr;
+  }
+  size_t index = num_workers_.fetch_add(1, std::memory_order_acq_rel);
+  if (index >= workers_.size()) return nullptr;
+  g_current_worker_ = workers_[index].get();
+  return workers_[index].get();
+}
+
+void WorkStealingQueue::Put(void* elem) {
+  Worker* worker = elem == nullptr ? nullptr : CurrentWorker();
+  if (worker != nullptr) {
+    worker->deque.Push(elem);
+  } else {
+    PushShared(elem);
+  }
+  // Publish the new element before checking for idle workers. Park() does the
+  // mirror image (announce idleness, then check for work), so at least one
+  // side always observes the other and no wakeup is lost.
+  pending_.fetch_add(1);
+  MaybeWakeWorker();
+}
+
+void WorkStealingQueue::PutShared(void* elem) {
+  PushShared(elem);
+  pending_.fetch_add(1);
+  MaybeWakeWorker();
+}
+
+void WorkStealingQueue::PushShared(void* elem) {
+  if (overflow_size_.load(std::memory_order_acquire) == 0 &&
+      injector_.TryPush(elem)) {
+    return;
+  }
+  MutexLock lock(&overflow_mu_);
+  overflow_.push_back(elem);
+  overflow_size_.fetch_add(1, std::memory_order_release);
+}
+
+bool WorkStealingQueue::TakeShared(void** elem) {
+  // Whatever is in the injector went in before the current overflow did.
+  if (injector_.TryPop(elem)) return true;
+  if (overflow_size_.load(std::memory_order_acquire) == 0) return false;
+  MutexLock lock(&overflow_mu_);
+  if (overflow_.empty()) return false;
+  *elem = overflow_.front();
+  overflow_.pop_front();
+  overflow_size_.fetch_sub(1, std::memory_order_release);
+  return true;
+}
+
+bool WorkStealingQueue::TakeWork(Worker* worker, void** elem) {
+  bool found = false;
+  if (worker != nullptr) {
+    *elem = worker->deque.Pop();
+    found = *elem != nullptr;
+  }
+  if (!found) found = TakeShared(elem);
+  if (!found) {
+    size_t num_workers = std::min(num_workers_.load(std::memory_order_acquire),
+                                  workers_.size());
+    size_t start = worker != nullptr ? worker->index + 1 : 0;
+    for (size_t i = 0; !found && i < num_workers; ++i) {
+      Worker* victim = workers_[(start + i) % num_workers].get();
+      if (victim == worker) continue;
+      *elem = victim->deque.Steal();
+      found = *elem != nullptr;
+    }
+  }
+  if (found) pending_.fetch_sub(1);
+  return found;
+}
+
+bool WorkStealingQueue::Spin(Worker* worker, void** elem) {
+  if (spin_rounds_ == 0) return false;
+  spinning_workers_.fetch_add(1);
+  bool found = false;
+  for (int i = 0; !found && i < spin_rounds_; ++i) {
+    if (pending_.load(std::memory_order_relaxed) > 0) {
+      found = TakeWork(worker, elem);
+    }
+  }
+  spinning_workers_.fetch_sub(1);
+  return found;
+}
+
+void WorkStealingQueue::MaybeWakeWorker() {
+  // A spinning worker will find the work on its own, and a worker that was
+  // just woken up wakes the next one if it finds more work than it can take.
+  if (spinning_workers_.load() > 0 || idle_workers_.load() == 0 ||
+      waking_.load()) {
+    return;
+  }
+  MutexLock lock(&park_mu_);
+  // Workers only count themselves idle under park_mu_, while they wait on
+  // park_cv_, so the signal below is sure to reach one of them and the flag
+  // to be cleared.
+  if (idle_workers_.load() == 0 || waking_.exchange(true)) return;
+  park_cv_.Signal();
+}
+
+void WorkStealingQueue::Park() {
+  MutexLock lock(&park_mu_);
+  idle_workers_.fetch_add(1);
+  while (pending_.load() <= 0) {
+    park_cv_.Wait(&park_mu_);
+    // Whether or not this worker goes back to sleep, the next Put() needs to
+    // wake somebody up.
+    waking_.store(false);
+  }
+  idle_workers_.fetch_sub(1);
+}
+
+void* WorkStealingQueue::Get(gpr_timespec* wait_time) {
+  Worker* worker = CurrentWorker();
+  if (worker == nullptr) worker = RegisterWorker();
+  void* elem;
+  while (!TakeWork(worker, &elem) && !Spin(worker, &elem)) {
+    if (wait_time != nullptr) {
+      gpr_timespec start_time = gpr_now(GPR_CLOCK_MONOTONIC);
+      Park();
+      *wait_time =
+          gpr_time_add(*wait_time, gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC),
+                                                start_time));
+    } else {
+      Park();
+    }
+  }
+  // If there is more work than this thread can take, get help.
+  if (pending_.load(std::memory_order_relaxed) > 0) MaybeWakeWorker();
+  if (elem == nullptr && worker != nullptr) g_current_worker_ = nullptr;
+  return elem;
+}
+
+bool WorkStealingQueue::TryGet(void** elem) {
+  return TakeWork(CurrentWorker(), elem);
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,214 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_QUEUE_H
+#define GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_QUEUE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+
+#include <grpc/support/time.h>
+
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// A Chase-Lev work-stealing deque of non-null pointers ("Dynamic Circular
+// Work-Stealing Deque", Chase and Lev, SPAA 2005, with the memory orderings
+// of Lê et al., PPoPP 2013).
+//
+// Only the owning thread may call Push() and Pop(), which work on the bottom
+// end of the deque without any read-modify-write in the common case. Any
+// thread may call Steal(), which takes from the top end. The buffer grows as
+// needed; retired buffers are kept until the deque is destroyed, since a
+// thief may still be reading from one.
+class WorkStealingDeque {
+ public:
+  WorkStealingDeque();
+  ~WorkStealingDeque();
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+  // Owner only: pushes \a elem onto the bottom.
+  void Push(void* elem);
+  // Owner only: pops the most recently pushed element, or returns nullptr.
+  void* Pop();
+  // Any thread: takes the oldest element, or returns nullptr if the deque is
+  // empty or another thread won the race for the element.
+  void* Steal();
+
+  // Approximate number of elements.
+  size_t size() const;
+
+ private:
+  class Buffer;
+
+  Buffer* Grow(Buffer* old, int64_t top, int64_t bottom);
+
+  std::atomic<int64_t> top_{0};
+  std::atomic<int64_t> bottom_{0};
+  std::atomic<Buffer*> buffer_;
+  // Every buffer the deque has used, the current one last. Old ones are kept
+  // because a thief may still be reading from them. Owner only.
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+
+// A bounded lock-free multi-producer multi-consumer FIFO queue (Vyukov's
+// array-based queue). Elements may be null.
+class BoundedMPMCQueue {
+ public:
+  // \a capacity is rounded up to a power of two.
+  explicit BoundedMPMCQueue(size_t capacity);
+  ~BoundedMPMCQueue();
+
+  BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+  BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+
+  // Returns false if the queue is full.
+  bool TryPush(void* elem);
+  // Returns false if the queue is empty.
+  bool TryPop(void** elem);
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    void* elem;
+  };
+
+  Cell* const cells_;
+  const size_t mask_;
+  // Producers and consumers each get their own cache line.
+  union {
+    char enqueue_padding_[GPR_CACHELINE_SIZE];
+    std::atomic<size_t> enqueue_pos_{0};
+  };
+  union {
+    char dequeue_padding_[GPR_CACHELINE_SIZE];
+    std::atomic<size_t> dequeue_pos_{0};
+  };
+};
+
+// A multi-producer multi-consumer queue with the same interface as
+// MPMCQueueInterface, meant to be drained by a set of dedicated worker
+// threads.
+//
+// Each thread that calls Get() becomes a worker and gets its own
+// WorkStealingDeque (up to \a max_workers of them). Put() from a worker pushes
+// onto that worker's deque; Put() from any other thread goes through a shared
+// injector queue, which is lock-free until it overflows. Get() looks at the
+// caller's own deque (newest first), then at the injector, then steals the
+// oldest element of another worker's deque. A worker that finds nothing spins
+// briefly before parking on a condition variable.
+//
+// Elements put from outside the workers are taken in FIFO order with respect
+// to each other, and a worker only stops taking work from its own deque once
+// it is empty, so a Put(nullptr) per worker from outside (as ThreadPool does)
+// is still a correct shutdown signal: every element put before it is taken
+// first.
+class WorkStealingQueue {
+ public:
+  explicit WorkStealingQueue(int max_workers);
+  // The queue must be empty, and no worker may still be inside Get().
+  ~WorkStealingQueue();
+
+  WorkStealingQueue(const WorkStealingQueue&) = delete;
+  WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+  // Puts \a elem onto the calling worker's deque, or onto the injector if the
+  // caller is not a worker of this queue or \a elem is null. Never blocks.
+  void Put(void* elem);
+
+  // Puts \a elem onto the injector even when called from a worker, so that
+  // the caller's own deque does not get ahead of it.
+  void PutShared(void* elem);
+
+  // Takes the next element for the calling thread, blocking while there is
+  // none. The first call from a thread registers it as a worker, until Get()
+  // returns a null element.
+  void* Get(gpr_timespec* wait_time);
+
+  // Takes an element if there is one, without blocking. Does not register the
+  // calling thread as a worker; from a non-worker it only looks at the
+  // injector and steals from the workers' deques.
+  bool TryGet(void** elem);
+
+  int count() const {
+    return static_cast<int>(pending_.load(std::memory_order_relaxed));
+  }
+
+  // Number of workers that are looking for work (spinning or parked).
+  int idle_workers() const {
+    return idle_workers_.load(std::memory_order_relaxed) +
+           spinning_workers_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Worker {
+    WorkStealingQueue* queue;
+    size_t index;
+    WorkStealingDeque deque;
+  };
+
+  // Returns the calling thread's worker slot in this queue, or nullptr.
+  Worker* CurrentWorker() const;
+  // Claims a worker slot for the calling thread, if one is left.
+  Worker* RegisterWorker();
+
+  void PushShared(void* elem);
+  bool TakeShared(void** elem);
+  bool TakeWork(Worker* worker, void** elem);
+  // Polls for work for a little while before the caller parks.
+  bool Spin(Worker* worker, void** elem);
+  // Wakes a parked worker if nobody else is already looking for work.
+  void MaybeWakeWorker();
+  // Blocks until pending_ is positive.
+  void Park();
+
+  static GPR_THREAD_LOCAL(Worker*) g_current_worker_;
+
+  const int spin_rounds_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> num_workers_{0};
+
+  BoundedMPMCQueue injector_;
+  // Shared elements that did not fit in injector_. While it is not empty, all
+  // shared elements go here, so that they stay in FIFO order.
+  std::atomic<size_t> overflow_size_{0};
+  Mutex overflow_mu_;
+  std::deque<void*> overflow_ ABSL_GUARDED_BY(overflow_mu_);
+
+  // Number of elements put but not yet taken.
+  std::atomic<intptr_t> pending_{0};
+  std::atomic<int> spinning_workers_{0};
+  std::atomic<int> idle_workers_{0};
+  // Whether a parked worker has been signalled and has not woken up yet.
+  std::atomic<bool> waking_{false};
+  Mutex park_mu_;
+  CondVar park_cv_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_IOMGR_EXECUTOR_WORK_STEALING_QUEUE_H
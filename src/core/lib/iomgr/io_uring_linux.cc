@@ -0,0 +1,311 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET_TCP
+
+#include "src/core/lib/iomgr/io_uring_linux.h"
+
+#include <grpc/support/log.h>
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_experimental_tcp_io_uring, false,
+    "If set, TCP endpoints submit their reads and writes through a shared "
+    "io_uring instead of waiting for readiness notifications. Only takes "
+    "effect on Linux with the epoll1 polling engine.");
+
+#ifdef GRPC_LINUX_IO_URING
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+namespace grpc_core {
+
+namespace {
+
+// Size of the submission ring. The completion ring is twice as large, and the
+// kernel buffers any completion that does not fit (IORING_FEAT_NODROP), so
+// this only bounds how many operations are submitted per io_uring_enter().
+constexpr unsigned kRingEntries = 4096;
+
+Mutex* g_mu = nullptr;
+IoUring* g_ring ABSL_GUARDED_BY(g_mu) = nullptr;
+// Set once setting up a ring has failed, so that it is not retried for every
+// endpoint.
+bool g_unsupported ABSL_GUARDED_BY(g_mu) = false;
+bool g_enabled = false;
+
+int io_uring_setup(unsigned entries, struct io_uring_params* p) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                   unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+}  // namespace
+
+void IoUring::GlobalInit() {
+  g_mu = new Mutex;
+  const char* poll_strategy = grpc_get_poll_strategy_name();
+  g_enabled = GPR_GLOBAL_CONFIG_GET(grpc_experimental_tcp_io_uring) &&
+              poll_strategy != nullptr && strcmp(poll_strategy, "epoll1") == 0;
+}
+
+void IoUring::GlobalShutdown() {
+  {
+    MutexLock lock(g_mu);
+    GPR_ASSERT(g_ring == nullptr);
+  }
+  delete g_mu;
+  g_mu = nullptr;
+}
+
+IoUring* IoUring::Ref() {
+  if (!g_enabled) return nullptr;
+  MutexLock lock(g_mu);
+  if (g_ring == nullptr) {
+    if (g_unsupported) return nullptr;
+    IoUring* ring = new IoUring();
+    if (!ring->Init()) {
+      gpr_log(GPR_ERROR,
+              "io_uring is not usable on this kernel, falling back to "
+              "readiness-based TCP I/O");
+      delete ring;
+      g_unsupported = true;
+      return nullptr;
+    }
+    g_ring = ring;
+  }
+  ++g_ring->refs_;
+  return g_ring;
+}
+
+void IoUring::Unref() {
+  {
+    MutexLock lock(g_mu);
+    if (--refs_ > 0) return;
+    if (g_ring == this) g_ring = nullptr;
+  }
+  // The reaper notices the shutdown the next time it is armed and destroys
+  // the ring from there, so that it never races with a reap in progress.
+  grpc_fd_shutdown(em_fd_,
+                   GRPC_ERROR_CREATE_FROM_STATIC_STRING("io_uring released"));
+}
+
+bool IoUring::Init() {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = io_uring_setup(kRingEntries, &params);
+  if (ring_fd_ < 0) {
+    gpr_log(GPR_DEBUG, "io_uring_setup failed: %s", strerror(errno));
+    return false;
+  }
+  // Without NODROP completions may be lost when the completion ring
+  // overflows, and without FAST_POLL every read on an idle socket would
+  // bounce back with EAGAIN.
+  const uint32_t kRequiredFeatures =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    return false;
+  }
+  // With IORING_FEAT_SINGLE_MMAP both rings share a single mapping.
+  ring_size_ = std::max(
+      params.sq_off.array + params.sq_entries * sizeof(unsigned),
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+  ring_ptr_ = mmap(nullptr, ring_size_, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (ring_ptr_ == MAP_FAILED) {
+    ring_ptr_ = nullptr;
+    return false;
+  }
+  sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) return false;
+  sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+  char* sq = static_cast<char*>(ring_ptr_);
+  sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sq_flags_ = reinterpret_cast<unsigned*>(sq + params.sq_off.flags);
+  sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  char* cq = sq;
+  cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+
+  GRPC_CLOSURE_INIT(&on_flush_, OnFlush, this, grpc_schedule_on_exec_ctx);
+  GRPC_CLOSURE_INIT(&on_readable_, OnReadable, this,
+                    grpc_schedule_on_exec_ctx);
+  em_fd_ = grpc_fd_create(ring_fd_, "io_uring", false);
+  grpc_fd_notify_on_read(em_fd_, &on_readable_);
+  return true;
+}
+
+IoUring::~IoUring() {
+  if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+  if (ring_ptr_ != nullptr) munmap(ring_ptr_, ring_size_);
+  // Once registered with the poller, the ring fd is closed by
+  // grpc_fd_orphan().
+  if (em_fd_ == nullptr && ring_fd_ >= 0) close(ring_fd_);
+}
+
+void IoUring::RecvMsg(int fd, struct msghdr* msg, Operation* op) {
+  Queue(IORING_OP_RECVMSG, fd, msg, 0, op);
+}
+
+void IoUring::SendMsg(int fd, const struct msghdr* msg, int flags,
+                      Operation* op) {
+  Queue(IORING_OP_SENDMSG, fd, msg, flags, op);
+}
+
+void IoUring::Queue(uint8_t opcode, int fd, const struct msghdr* msg,
+                    int flags, Operation* op) {
+  MutexLock lock(&mu_);
+  unsigned tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_) {
+    // The submission ring is full: hand what we have to the kernel now
+    // rather than waiting for the end of the ExecCtx.
+    SubmitLocked();
+    GPR_ASSERT(tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) <
+               sq_entries_);
+  }
+  unsigned index = tail & sq_mask_;
+  struct io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(msg);
+  sqe->len = 1;
+  sqe->msg_flags = static_cast<uint32_t>(flags);
+  sqe->user_data = reinterpret_cast<uint64_t>(op);
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++unsubmitted_;
+  if (!flush_scheduled_) {
+    flush_scheduled_ = true;
+    ExecCtx::Run(DEBUG_LOCATION, &on_flush_, GRPC_ERROR_NONE);
+  }
+}
+
+void IoUring::SubmitLocked() {
+  while (unsubmitted_ > 0) {
+    int submitted = io_uring_enter(ring_fd_, unsubmitted_, 0, 0);
+    if (submitted < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EBUSY) {
+        // The kernel wants completions to be reaped first. Reap() submits
+        // whatever is left once it has made room.
+        return;
+      }
+      gpr_log(GPR_ERROR, "io_uring_enter failed: %s", strerror(errno));
+      GPR_ASSERT(false);
+    }
+    unsubmitted_ -= static_cast<unsigned>(submitted);
+  }
+}
+
+void IoUring::OnFlush(void* arg, grpc_error_handle /*error*/) {
+  IoUring* ring = static_cast<IoUring*>(arg);
+  MutexLock lock(&ring->mu_);
+  ring->flush_scheduled_ = false;
+  ring->SubmitLocked();
+}
+
+void IoUring::Reap() {
+  while (true) {
+    unsigned head = *cq_head_;
+    unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      struct io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+      Operation* op = reinterpret_cast<Operation*>(cqe->user_data);
+      op->result = cqe->res;
+      ExecCtx::Run(DEBUG_LOCATION, op->on_done, GRPC_ERROR_NONE);
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    if ((__atomic_load_n(sq_flags_, __ATOMIC_ACQUIRE) &
+         IORING_SQ_CQ_OVERFLOW) == 0) {
+      break;
+    }
+    // Completions that did not fit into the ring were buffered by the kernel;
+    // ask for them to be flushed into the ring now that there is room.
+    io_uring_enter(ring_fd_, 0, 0, IORING_ENTER_GETEVENTS);
+  }
+  MutexLock lock(&mu_);
+  if (!flush_scheduled_) SubmitLocked();
+}
+
+void IoUring::OnReadable(void* arg, grpc_error_handle error) {
+  IoUring* ring = static_cast<IoUring*>(arg);
+  if (error != GRPC_ERROR_NONE) {
+    // Released by the last Unref().
+    grpc_fd_orphan(ring->em_fd_, nullptr, nullptr, "io_uring");
+    delete ring;
+    return;
+  }
+  ring->Reap();
+  grpc_fd_notify_on_read(ring->em_fd_, &ring->on_readable_);
+}
+
+}  // namespace grpc_core
+
+#else /* GRPC_LINUX_IO_URING */
+
+namespace grpc_core {
+
+void IoUring::GlobalInit() {}
+
+void IoUring::GlobalShutdown() {}
+
+IoUring* IoUring::Ref() { return nullptr; }
+
+void IoUring::Unref() { GPR_ASSERT(false); }
+
+void IoUring::RecvMsg(int /*fd*/, struct msghdr* /*msg*/, Operation* /*op*/) {
+  GPR_ASSERT(false);
+}
+
+void IoUring::SendMsg(int /*fd*/, const struct msghdr* /*msg*/, int /*flags*/,
+                      Operation* /*op*/) {
+  GPR_ASSERT(false);
+}
+
+}  // namespace grpc_core
+
+#endif /* GRPC_LINUX_IO_URING */
+
+#endif /* GRPC_POSIX_SOCKET_TCP */
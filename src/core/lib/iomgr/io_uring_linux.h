@@ -0,0 +1,125 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GRPC_CORE_LIB_IOMGR_IO_URING_LINUX_H
+#define GRPC_CORE_LIB_IOMGR_IO_URING_LINUX_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_POSIX_SOCKET_TCP
+
+#include <stdint.h>
+#include <sys/socket.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/ev_posix.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_experimental_tcp_io_uring);
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace grpc_core {
+
+// A process-wide io_uring instance shared by all TCP endpoints that run in
+// io_uring mode (see GRPC_EXPERIMENTAL_TCP_IO_URING).
+//
+// Operations are queued into the submission ring and handed to the kernel in
+// a single io_uring_enter() at the end of the current ExecCtx, so all the
+// reads and writes issued while processing one batch of events share one
+// syscall. The ring fd itself is registered with the epoll1 polling engine:
+// when it becomes readable every available completion is reaped at once and
+// the corresponding closures are scheduled, which replaces one
+// readiness notification plus one recvmsg/sendmsg per socket.
+class IoUring {
+ public:
+  // An operation submitted to the ring. Once the kernel completes it,
+  // \a result is set to the operation's return value (a byte count, or a
+  // negated errno) and \a on_done is scheduled on the ExecCtx.
+  struct Operation {
+    grpc_closure* on_done = nullptr;
+    int result = 0;
+  };
+
+  // Must be called from grpc_tcp_posix_init()/grpc_tcp_posix_shutdown().
+  static void GlobalInit();
+  static void GlobalShutdown();
+
+  // Returns a ref to the shared ring, creating it if required. Returns
+  // nullptr if io_uring mode is disabled or unsupported, in which case the
+  // caller should use regular readiness-based I/O.
+  static IoUring* Ref();
+  // Releases a ref returned by Ref(). The ring is torn down once the last
+  // ref is gone; there must not be any operation in flight at that point.
+  void Unref();
+
+  // Queue a recvmsg()/sendmsg() on \a fd. \a msg, and every buffer it points
+  // to, must stay valid until \a op completes.
+  void RecvMsg(int fd, struct msghdr* msg, Operation* op);
+  void SendMsg(int fd, const struct msghdr* msg, int flags, Operation* op);
+
+ private:
+  IoUring() = default;
+  ~IoUring();
+
+  // Sets up the ring. Returns false if the kernel lacks the required
+  // features.
+  bool Init();
+  void Queue(uint8_t opcode, int fd, const struct msghdr* msg, int flags,
+             Operation* op);
+  void SubmitLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void Reap();
+
+  static void OnFlush(void* arg, grpc_error_handle error);
+  static void OnReadable(void* arg, grpc_error_handle error);
+
+  int ring_fd_ = -1;
+  grpc_fd* em_fd_ = nullptr;
+  // Number of refs, guarded by the global ring mutex.
+  int refs_ = 0;
+
+  // Both the submission and the completion ring live in this mapping.
+  void* ring_ptr_ = nullptr;
+  size_t ring_size_ = 0;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_flags_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  struct io_uring_cqe* cqes_ = nullptr;
+
+  grpc_closure on_flush_;
+  grpc_closure on_readable_;
+
+  Mutex mu_;
+  // Entries written to the submission ring but not yet handed to the kernel.
+  unsigned unsubmitted_ ABSL_GUARDED_BY(mu_) = 0;
+  bool flush_scheduled_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+}  // namespace grpc_core
+
+#endif /* GRPC_POSIX_SOCKET_TCP */
+
+#endif  // GRPC_CORE_LIB_IOMGR_IO_URING_LINUX_H
@@ -54,6 +54,11 @@
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0)
 #define GRPC_LINUX_ERRQUEUE 1
 #endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(4, 0, 0) */
+/* io_uring with IORING_FEAT_FAST_POLL. The running kernel is checked again
+   when the ring is set up. */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5, 7, 0)
+#define GRPC_LINUX_IO_URING 1
+#endif /* LINUX_VERSION_CODE >= KERNEL_VERSION(5, 7, 0) */
 #endif /* LINUX_VERSION_CODE */
 #define GRPC_LINUX_MULTIPOLL_WITH_EPOLL 1
 #define GRPC_POSIX_FORK 1
@@ -71,6 +76,9 @@
 #if __GLIBC_PREREQ(2, 10)
 #define GRPC_LINUX_SOCKETUTILS 1
 #endif
+#if __GLIBC_PREREQ(2, 27)
+#define GRPC_LINUX_MEMFD 1
+#endif
 #if !(__GLIBC_PREREQ(2, 18))
 /*
  * TCP_USER_TIMEOUT wasn't imported to glibc until 2.18. Use Linux system
@@ -204,6 +212,10 @@
 #define GRPC_POSIX_SOCKET_TCP_SERVER_UTILS_COMMON 1
 #define GRPC_POSIX_SOCKET_UDP_SERVER 1
 #define GRPC_POSIX_SOCKET_UTILS_COMMON 1
+#if defined(GRPC_LINUX_MEMFD) && defined(GRPC_LINUX_EVENTFD) && \
+    defined(GRPC_HAVE_UNIX_SOCKET)
+#define GRPC_HAVE_SHM_TRANSPORT 1
+#endif
 #endif
 
 #if defined(GRPC_POSIX_HOST_NAME_MAX) && defined(GRPC_POSIX_SYSCONF)
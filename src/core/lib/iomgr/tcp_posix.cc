@@ -56,6 +56,7 @@
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
 #include "src/core/lib/iomgr/executor.h"
+#include "src/core/lib/iomgr/io_uring_linux.h"
 #include "src/core/lib/iomgr/socket_utils_posix.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/profiling/timers.h"
@@ -88,6 +89,15 @@
 #define MSG_ZEROCOPY 0x4000000
 #endif
 
+// Passed to sendmsg when the rest of the write follows in another sendmsg
+// straight away (more slices than fit in one iovec array), so the kernel can
+// fill segments across the two calls instead of pushing a runt segment.
+#ifdef MSG_MORE
+#define SENDMSG_MORE_FLAG MSG_MORE
+#else
+#define SENDMSG_MORE_FLAG 0
+#endif
+
 #ifdef GRPC_MSG_IOVLEN_TYPE
 typedef GRPC_MSG_IOVLEN_TYPE msg_iovlen_type;
 #else
@@ -356,6 +366,8 @@ using grpc_core::TcpZerocopySendCtx;
 using grpc_core::TcpZerocopySendRecord;
 
 namespace {
+struct TcpIoUringState;
+
 struct grpc_tcp {
   grpc_tcp(int max_sends, size_t send_bytes_threshold)
       : tcp_zerocopy_send_ctx(max_sends, send_bytes_threshold) {}
@@ -375,6 +387,11 @@ struct grpc_tcp {
 
   /* garbage after the last read */
   grpc_slice_buffer last_read_buffer;
+  /* The reader can't make progress until this many bytes have been read (see
+   * grpc_endpoint_read). Bytes read short of that are held in
+   * read_staging_buffer rather than handed up. */
+  int min_progress_size;
+  grpc_slice_buffer read_staging_buffer;
 
   grpc_slice_buffer* incoming_buffer;
   int inq;          /* bytes pending on the socket from the last read. */
@@ -423,6 +440,11 @@ struct grpc_tcp {
                                       on errors anymore */
   TcpZerocopySendCtx tcp_zerocopy_send_ctx;
   TcpZerocopySendRecord* current_zerocopy_send = nullptr;
+
+  /* Set if reads (and writes that would block) are submitted through
+   * io_uring instead of being issued when the fd becomes ready. */
+  grpc_core::IoUring* io_uring = nullptr;
+  TcpIoUringState* io_uring_state = nullptr;
 };
 
 struct backup_poller {
@@ -443,6 +465,8 @@ static backup_poller* g_backup_poller ABSL_GUARDED_BY(g_backup_poller_mu);
 
 static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error_handle error);
 static void tcp_handle_write(void* arg /* grpc_tcp */, grpc_error_handle error);
+static void tcp_io_uring_read(grpc_tcp* tcp);
+static void tcp_io_uring_release(grpc_tcp* tcp);
 static void tcp_drop_uncovered_then_handle_write(void* arg /* grpc_tcp */,
                                                  grpc_error_handle error);
 
@@ -613,6 +637,7 @@ static void tcp_free(grpc_tcp* tcp) {
   grpc_fd_orphan(tcp->em_fd, tcp->release_fd_cb, tcp->release_fd,
                  "tcp_unref_orphan");
   grpc_slice_buffer_destroy_internal(&tcp->last_read_buffer);
+  grpc_slice_buffer_destroy_internal(&tcp->read_staging_buffer);
   /* The lock is not really necessary here, since all refs have been released */
   gpr_mu_lock(&tcp->tb_mu);
   grpc_core::TracedBuffer::Shutdown(
@@ -621,6 +646,9 @@ static void tcp_free(grpc_tcp* tcp) {
   gpr_mu_unlock(&tcp->tb_mu);
   tcp->outgoing_buffer_arg = nullptr;
   gpr_mu_destroy(&tcp->tb_mu);
+  if (tcp->io_uring != nullptr) {
+    tcp_io_uring_release(tcp);
+  }
   delete tcp;
 }
 
@@ -679,6 +707,26 @@ static void tcp_trace_read(grpc_tcp* tcp, grpc_error_handle error) {
   }
 }
 
+/* Updates tcp->inq from the TCP_INQ control message of a recvmsg(). */
+static void tcp_update_inq(grpc_tcp* tcp, struct msghdr* msg) {
+#ifdef GRPC_HAVE_TCP_INQ
+  if (tcp->inq_capable) {
+    GPR_DEBUG_ASSERT(!(msg->msg_flags & MSG_CTRUNC));
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg);
+    for (; cmsg != nullptr; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+      if (cmsg->cmsg_level == SOL_TCP && cmsg->cmsg_type == TCP_CM_INQ &&
+          cmsg->cmsg_len == CMSG_LEN(sizeof(int))) {
+        tcp->inq = *reinterpret_cast<int*>(CMSG_DATA(cmsg));
+        break;
+      }
+    }
+  }
+#else
+  (void)tcp;
+  (void)msg;
+#endif /* GRPC_HAVE_TCP_INQ */
+}
+
 /* Returns true if data available to read or error other than EAGAIN. */
 #define MAX_READ_IOVEC 4
 static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error) {
@@ -768,19 +816,7 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error) {
     GPR_DEBUG_ASSERT((size_t)read_bytes <=
                      tcp->incoming_buffer->length - total_read_bytes);
 
-#ifdef GRPC_HAVE_TCP_INQ
-    if (tcp->inq_capable) {
-      GPR_DEBUG_ASSERT(!(msg.msg_flags & MSG_CTRUNC));
-      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
-      for (; cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (cmsg->cmsg_level == SOL_TCP && cmsg->cmsg_type == TCP_CM_INQ &&
-            cmsg->cmsg_len == CMSG_LEN(sizeof(int))) {
-          tcp->inq = *reinterpret_cast<int*>(CMSG_DATA(cmsg));
-          break;
-        }
-      }
-    }
-#endif /* GRPC_HAVE_TCP_INQ */
+    tcp_update_inq(tcp, &msg);
 
     total_read_bytes += read_bytes;
     if (tcp->inq == 0 || total_read_bytes == tcp->incoming_buffer->length) {
@@ -824,16 +860,24 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error) {
 }
 
 static void maybe_make_read_slices(grpc_tcp* tcp) {
-  if (tcp->incoming_buffer->length == 0 &&
+  /* Bytes still needed before the reader can make progress: if the space left
+   * over from the last read won't hold them, add a slice that will, so that
+   * the rest of a large frame lands in a single read. */
+  const int min_progress =
+      tcp->min_progress_size -
+      static_cast<int>(tcp->read_staging_buffer.length);
+  if ((tcp->incoming_buffer->length == 0 ||
+       static_cast<int>(tcp->incoming_buffer->length) < min_progress) &&
       tcp->incoming_buffer->count < MAX_READ_IOVEC) {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO,
               "TCP:%p alloc_slices; min_chunk=%d max_chunk=%d target=%lf "
-              "buf_len=%" PRIdPTR,
+              "min_progress=%d buf_len=%" PRIdPTR,
               tcp, tcp->min_read_chunk_size, tcp->max_read_chunk_size,
-              tcp->target_length, tcp->incoming_buffer->length);
+              tcp->target_length, min_progress, tcp->incoming_buffer->length);
     }
-    int target_length = static_cast<int>(tcp->target_length);
+    int target_length =
+        std::max(static_cast<int>(tcp->target_length), min_progress);
     int extra_wanted =
         target_length - static_cast<int>(tcp->incoming_buffer->length);
     grpc_slice_buffer_add_indexed(
@@ -848,6 +892,28 @@ static void maybe_make_read_slices(grpc_tcp* tcp) {
   }
 }
 
+/* Called after a successful read. If, together with anything set aside
+ * earlier, the bytes now in incoming_buffer let the reader make progress,
+ * puts them back together in incoming_buffer and returns true. Otherwise
+ * sets the new bytes aside too and returns false: the caller should read
+ * again (into the unfilled space left over from this read, when there is
+ * any). */
+static bool tcp_read_made_progress(grpc_tcp* tcp) {
+  if (tcp->read_staging_buffer.length + tcp->incoming_buffer->length <
+      static_cast<size_t>(tcp->min_progress_size)) {
+    grpc_slice_buffer_move_into(tcp->incoming_buffer,
+                                &tcp->read_staging_buffer);
+    grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->last_read_buffer);
+    return false;
+  }
+  if (tcp->read_staging_buffer.length > 0) {
+    grpc_slice_buffer_move_into(tcp->incoming_buffer,
+                                &tcp->read_staging_buffer);
+    grpc_slice_buffer_swap(tcp->incoming_buffer, &tcp->read_staging_buffer);
+  }
+  return true;
+}
+
 static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error_handle error) {
   grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
   if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
@@ -856,17 +922,30 @@ static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error_handle error) {
   }
   grpc_error_handle tcp_read_error;
   if (GPR_LIKELY(error == GRPC_ERROR_NONE)) {
-    maybe_make_read_slices(tcp);
-    if (!tcp_do_read(tcp, &tcp_read_error)) {
-      /* We've consumed the edge, request a new one */
-      notify_on_read(tcp);
-      return;
+    while (true) {
+      maybe_make_read_slices(tcp);
+      if (!tcp_do_read(tcp, &tcp_read_error)) {
+        /* We've consumed the edge, request a new one */
+        notify_on_read(tcp);
+        return;
+      }
+      if (tcp_read_error != GRPC_ERROR_NONE) {
+        grpc_slice_buffer_reset_and_unref_internal(&tcp->read_staging_buffer);
+        break;
+      }
+      if (tcp_read_made_progress(tcp)) break;
+      if (tcp->inq == 0) {
+        /* Nothing more is queued: wait for the rest to arrive */
+        notify_on_read(tcp);
+        return;
+      }
     }
     tcp_trace_read(tcp, tcp_read_error);
   } else {
     tcp_read_error = GRPC_ERROR_REF(error);
     grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
     grpc_slice_buffer_reset_and_unref_internal(&tcp->last_read_buffer);
+    grpc_slice_buffer_reset_and_unref_internal(&tcp->read_staging_buffer);
   }
   grpc_closure* cb = tcp->read_cb;
   tcp->read_cb = nullptr;
@@ -876,15 +955,18 @@ static void tcp_handle_read(void* arg /* grpc_tcp */, grpc_error_handle error) {
 }
 
 static void tcp_read(grpc_endpoint* ep, grpc_slice_buffer* incoming_buffer,
-                     grpc_closure* cb, bool urgent) {
+                     grpc_closure* cb, bool urgent, int min_progress_size) {
   grpc_tcp* tcp = reinterpret_cast<grpc_tcp*>(ep);
   GPR_ASSERT(tcp->read_cb == nullptr);
   tcp->read_cb = cb;
+  tcp->min_progress_size = std::max(min_progress_size, 1);
   tcp->incoming_buffer = incoming_buffer;
   grpc_slice_buffer_reset_and_unref_internal(incoming_buffer);
   grpc_slice_buffer_swap(incoming_buffer, &tcp->last_read_buffer);
   TCP_REF(tcp, "read");
-  if (tcp->is_first_read) {
+  if (tcp->io_uring != nullptr) {
+    tcp_io_uring_read(tcp);
+  } else if (tcp->is_first_read) {
     /* Endpoint read called for the very first time. Register read callback with
      * the polling engine */
     tcp->is_first_read = false;
@@ -911,7 +993,6 @@ ssize_t tcp_send(int fd, const struct msghdr* msg, int additional_flags = 0) {
   GPR_TIMER_SCOPE("sendmsg", 1);
   ssize_t sent_length;
   do {
-    /* TODO(klempner): Cork if this is a partial write */
     GRPC_STATS_INC_SYSCALL_WRITE();
     sent_length = sendmsg(fd, msg, SENDMSG_FLAGS | additional_flags);
   } while (sent_length < 0 && errno == EINTR);
@@ -1339,7 +1420,12 @@ static bool do_tcp_flush_zerocopy(grpc_tcp* tcp, TcpZerocopySendRecord* record,
       msg.msg_controllen = 0;
       GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
       GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
-      sent_length = tcp_send(tcp->fd, &msg, MSG_ZEROCOPY);
+      int flags = MSG_ZEROCOPY;
+      if (!record->AllSlicesSent()) {
+        GRPC_STATS_INC_TCP_WRITE_MORE();
+        flags |= SENDMSG_MORE_FLAG;
+      }
+      sent_length = tcp_send(tcp->fd, &msg, flags);
     }
     if (sent_length < 0) {
       // If this particular send failed, drop ref taken earlier in this method.
@@ -1445,7 +1531,12 @@ static bool tcp_flush(grpc_tcp* tcp, grpc_error_handle* error) {
       GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
       GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
 
-      sent_length = tcp_send(tcp->fd, &msg);
+      int flags = 0;
+      if (outgoing_slice_idx != tcp->outgoing_buffer->count) {
+        GRPC_STATS_INC_TCP_WRITE_MORE();
+        flags = SENDMSG_MORE_FLAG;
+      }
+      sent_length = tcp_send(tcp->fd, &msg, flags);
     }
 
     if (sent_length < 0) {
@@ -1536,6 +1627,217 @@ static void tcp_handle_write(void* arg /* grpc_tcp */,
   }
 }
 
+/* io_uring mode: rather than waiting for the fd to become readable, each
+ * read is queued on the shared ring as a recvmsg and finishes when its
+ * completion is reaped. Writes are still attempted inline first; only what
+ * does not fit into the socket buffer is queued as a sendmsg. */
+
+#define IO_URING_MAX_WRITE_IOVEC 64
+
+namespace {
+struct TcpIoUringState {
+  grpc_core::IoUring::Operation read_op;
+  struct msghdr read_msg;
+  struct iovec read_iov[MAX_READ_IOVEC];
+  alignas(struct cmsghdr) char read_cmsgbuf[24 /* CMSG_SPACE(sizeof(int)) */];
+  grpc_closure read_done;
+
+  grpc_core::IoUring::Operation write_op;
+  struct msghdr write_msg;
+  struct iovec write_iov[IO_URING_MAX_WRITE_IOVEC];
+  grpc_closure write_done;
+  /* Resubmits the write once the fd is writable, for the rare case where the
+   * kernel hands back EAGAIN instead of polling internally. */
+  grpc_closure write_retry;
+};
+}  // namespace
+
+static void tcp_io_uring_release(grpc_tcp* tcp) {
+  tcp->io_uring->Unref();
+  tcp->io_uring = nullptr;
+  delete tcp->io_uring_state;
+  tcp->io_uring_state = nullptr;
+}
+
+static void tcp_io_uring_read(grpc_tcp* tcp) {
+  TcpIoUringState* state = tcp->io_uring_state;
+  maybe_make_read_slices(tcp);
+  GPR_ASSERT(tcp->incoming_buffer->length != 0);
+  size_t iov_len =
+      std::min<size_t>(MAX_READ_IOVEC, tcp->incoming_buffer->count);
+  for (size_t i = 0; i < iov_len; i++) {
+    state->read_iov[i].iov_base =
+        GRPC_SLICE_START_PTR(tcp->incoming_buffer->slices[i]);
+    state->read_iov[i].iov_len =
+        GRPC_SLICE_LENGTH(tcp->incoming_buffer->slices[i]);
+  }
+  struct msghdr* msg = &state->read_msg;
+  msg->msg_name = nullptr;
+  msg->msg_namelen = 0;
+  msg->msg_iov = state->read_iov;
+  msg->msg_iovlen = static_cast<msg_iovlen_type>(iov_len);
+  if (tcp->inq_capable) {
+    msg->msg_control = state->read_cmsgbuf;
+    msg->msg_controllen = sizeof(state->read_cmsgbuf);
+  } else {
+    msg->msg_control = nullptr;
+    msg->msg_controllen = 0;
+  }
+  msg->msg_flags = 0;
+  GRPC_STATS_INC_TCP_READ_OFFER(tcp->incoming_buffer->length);
+  GRPC_STATS_INC_TCP_READ_OFFER_IOV_SIZE(tcp->incoming_buffer->count);
+  tcp->io_uring->RecvMsg(tcp->fd, msg, &state->read_op);
+}
+
+static void tcp_handle_io_uring_read(void* arg /* grpc_tcp */,
+                                     grpc_error_handle /*error*/) {
+  grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
+  int result = tcp->io_uring_state->read_op.result;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+    gpr_log(GPR_INFO, "TCP:%p io_uring read result=%d", tcp, result);
+  }
+  if (result == -EAGAIN || result == -EINTR) {
+    /* Finish this read the regular way: tcp_handle_read() runs once the fd
+     * is readable and delivers the data. */
+    notify_on_read(tcp);
+    return;
+  }
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  if (result < 0) {
+    grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+    grpc_slice_buffer_reset_and_unref_internal(&tcp->read_staging_buffer);
+    error = tcp_annotate_error(GRPC_OS_ERROR(-result, "recvmsg"), tcp);
+  } else if (result == 0) {
+    grpc_slice_buffer_reset_and_unref_internal(tcp->incoming_buffer);
+    grpc_slice_buffer_reset_and_unref_internal(&tcp->read_staging_buffer);
+    error = tcp_annotate_error(
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING("Socket closed"), tcp);
+  } else {
+    size_t read_bytes = static_cast<size_t>(result);
+    GRPC_STATS_INC_TCP_READ_SIZE(read_bytes);
+    add_to_estimate(tcp, read_bytes);
+    tcp->inq = 1;
+    tcp_update_inq(tcp, &tcp->io_uring_state->read_msg);
+    if (tcp->inq == 0 || read_bytes == tcp->incoming_buffer->length) {
+      finish_estimate(tcp);
+    }
+    if (read_bytes < tcp->incoming_buffer->length) {
+      grpc_slice_buffer_trim_end(tcp->incoming_buffer,
+                                 tcp->incoming_buffer->length - read_bytes,
+                                 &tcp->last_read_buffer);
+    }
+    if (!tcp_read_made_progress(tcp)) {
+      tcp_io_uring_read(tcp);
+      return;
+    }
+  }
+  tcp_trace_read(tcp, error);
+  grpc_closure* cb = tcp->read_cb;
+  tcp->read_cb = nullptr;
+  tcp->incoming_buffer = nullptr;
+  grpc_core::Closure::Run(DEBUG_LOCATION, cb, error);
+  TCP_UNREF(tcp, "read");
+}
+
+static void tcp_io_uring_write(grpc_tcp* tcp) {
+  TcpIoUringState* state = tcp->io_uring_state;
+  size_t sending_length = 0;
+  size_t byte_idx = tcp->outgoing_byte_idx;
+  size_t iov_size = 0;
+  for (; iov_size != tcp->outgoing_buffer->count &&
+         iov_size != IO_URING_MAX_WRITE_IOVEC;
+       iov_size++) {
+    grpc_slice& slice = tcp->outgoing_buffer->slices[iov_size];
+    state->write_iov[iov_size].iov_base =
+        GRPC_SLICE_START_PTR(slice) + byte_idx;
+    state->write_iov[iov_size].iov_len = GRPC_SLICE_LENGTH(slice) - byte_idx;
+    sending_length += state->write_iov[iov_size].iov_len;
+    byte_idx = 0;
+  }
+  GPR_ASSERT(iov_size > 0);
+  struct msghdr* msg = &state->write_msg;
+  msg->msg_name = nullptr;
+  msg->msg_namelen = 0;
+  msg->msg_iov = state->write_iov;
+  msg->msg_iovlen = static_cast<msg_iovlen_type>(iov_size);
+  msg->msg_control = nullptr;
+  msg->msg_controllen = 0;
+  msg->msg_flags = 0;
+  GRPC_STATS_INC_TCP_WRITE_SIZE(sending_length);
+  GRPC_STATS_INC_TCP_WRITE_IOV_SIZE(iov_size);
+  int flags = SENDMSG_FLAGS;
+  if (iov_size != tcp->outgoing_buffer->count) {
+    GRPC_STATS_INC_TCP_WRITE_MORE();
+    flags |= SENDMSG_MORE_FLAG;
+  }
+  tcp->io_uring->SendMsg(tcp->fd, msg, flags, &state->write_op);
+}
+
+static void tcp_io_uring_write_done(grpc_tcp* tcp, grpc_error_handle error) {
+  if (!grpc_event_engine_run_in_background()) {
+    drop_uncovered(tcp);
+  }
+  grpc_closure* cb = tcp->write_cb;
+  tcp->write_cb = nullptr;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
+    gpr_log(GPR_INFO, "write: %s", grpc_error_std_string(error).c_str());
+  }
+  grpc_core::Closure::Run(DEBUG_LOCATION, cb, error);
+  TCP_UNREF(tcp, "write");
+}
+
+static void tcp_handle_io_uring_write(void* arg /* grpc_tcp */,
+                                      grpc_error_handle /*error*/) {
+  grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
+  int result = tcp->io_uring_state->write_op.result;
+  if (result == -EAGAIN) {
+    grpc_fd_notify_on_write(tcp->em_fd, &tcp->io_uring_state->write_retry);
+    return;
+  }
+  if (result == -EINTR) {
+    tcp_io_uring_write(tcp);
+    return;
+  }
+  if (result < 0) {
+    grpc_slice_buffer_reset_and_unref_internal(tcp->outgoing_buffer);
+    tcp_io_uring_write_done(
+        tcp, tcp_annotate_error(GRPC_OS_ERROR(-result, "sendmsg"), tcp));
+    return;
+  }
+  /* Drop everything that has been sent, and send the rest if this was a
+   * partial write. */
+  size_t sent_length = static_cast<size_t>(result);
+  while (sent_length > 0) {
+    size_t slice_remaining =
+        GRPC_SLICE_LENGTH(tcp->outgoing_buffer->slices[0]) -
+        tcp->outgoing_byte_idx;
+    if (sent_length < slice_remaining) {
+      tcp->outgoing_byte_idx += sent_length;
+      break;
+    }
+    sent_length -= slice_remaining;
+    tcp->outgoing_byte_idx = 0;
+    grpc_slice_buffer_remove_first(tcp->outgoing_buffer);
+  }
+  if (tcp->outgoing_buffer->count > 0) {
+    tcp_io_uring_write(tcp);
+    return;
+  }
+  grpc_slice_buffer_reset_and_unref_internal(tcp->outgoing_buffer);
+  tcp_io_uring_write_done(tcp, GRPC_ERROR_NONE);
+}
+
+static void tcp_handle_io_uring_write_retry(void* arg /* grpc_tcp */,
+                                            grpc_error_handle error) {
+  grpc_tcp* tcp = static_cast<grpc_tcp*>(arg);
+  if (error != GRPC_ERROR_NONE) {
+    grpc_slice_buffer_reset_and_unref_internal(tcp->outgoing_buffer);
+    tcp_io_uring_write_done(tcp, GRPC_ERROR_REF(error));
+    return;
+  }
+  tcp_io_uring_write(tcp);
+}
+
 static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
                       grpc_closure* cb, void* arg) {
   GPR_TIMER_SCOPE("tcp_write", 0);
@@ -1593,7 +1895,18 @@ static void tcp_write(grpc_endpoint* ep, grpc_slice_buffer* buf,
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "write: delayed");
     }
-    notify_on_write(tcp);
+    if (tcp->io_uring != nullptr && zerocopy_send_record == nullptr &&
+        arg == nullptr) {
+      /* Rather than waiting for the socket to become writable, queue the
+       * rest of the data on the ring. Writes that collect timestamps need
+       * control messages and stay on the regular path. */
+      if (!grpc_event_engine_run_in_background()) {
+        cover_self(tcp);
+      }
+      tcp_io_uring_write(tcp);
+    } else {
+      notify_on_write(tcp);
+    }
   } else {
     if (GRPC_TRACE_FLAG_ENABLED(grpc_tcp_trace)) {
       gpr_log(GPR_INFO, "write: %s", grpc_error_std_string(error).c_str());
@@ -1752,6 +2065,21 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   tcp->socket_ts_enabled = false;
   tcp->ts_capable = true;
   tcp->outgoing_buffer_arg = nullptr;
+  tcp->io_uring = grpc_core::IoUring::Ref();
+  if (tcp->io_uring != nullptr) {
+    tcp->io_uring_state = new TcpIoUringState;
+    tcp->io_uring_state->read_op.on_done =
+        GRPC_CLOSURE_INIT(&tcp->io_uring_state->read_done,
+                          tcp_handle_io_uring_read, tcp,
+                          grpc_schedule_on_exec_ctx);
+    tcp->io_uring_state->write_op.on_done =
+        GRPC_CLOSURE_INIT(&tcp->io_uring_state->write_done,
+                          tcp_handle_io_uring_write, tcp,
+                          grpc_schedule_on_exec_ctx);
+    GRPC_CLOSURE_INIT(&tcp->io_uring_state->write_retry,
+                      tcp_handle_io_uring_write_retry, tcp,
+                      grpc_schedule_on_exec_ctx);
+  }
   if (tcp_tx_zerocopy_enabled && !tcp->tcp_zerocopy_send_ctx.memory_limited()) {
 #ifdef GRPC_LINUX_ERRQUEUE
     const int enable = 1;
@@ -1770,6 +2098,8 @@ grpc_endpoint* grpc_tcp_create(grpc_fd* em_fd,
   gpr_atm_no_barrier_store(&tcp->shutdown_count, 0);
   tcp->em_fd = em_fd;
   grpc_slice_buffer_init(&tcp->last_read_buffer);
+  tcp->min_progress_size = 1;
+  grpc_slice_buffer_init(&tcp->read_staging_buffer);
   gpr_mu_init(&tcp->tb_mu);
   tcp->tb_head = nullptr;
   GRPC_CLOSURE_INIT(&tcp->read_done_closure, tcp_handle_read, tcp,
@@ -1834,9 +2164,13 @@ void grpc_tcp_destroy_and_release_fd(grpc_endpoint* ep, int* fd,
   TCP_UNREF(tcp, "destroy");
 }
 
-void grpc_tcp_posix_init() { g_backup_poller_mu = new grpc_core::Mutex; }
+void grpc_tcp_posix_init() {
+  g_backup_poller_mu = new grpc_core::Mutex;
+  grpc_core::IoUring::GlobalInit();
+}
 
 void grpc_tcp_posix_shutdown() {
+  grpc_core::IoUring::GlobalShutdown();
   delete g_backup_poller_mu;
   g_backup_poller_mu = nullptr;
 }
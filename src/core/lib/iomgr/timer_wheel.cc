@@ -0,0 +1,494 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/timer_wheel.h"
+
+#include <inttypes.h>
+
+#include <atomic>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+#include <grpc/support/sync.h>
+
+#include "src/core/lib/debug/trace.h"
+#include "src/core/lib/gpr/spinlock.h"
+#include "src/core/lib/gpr/tls.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/time.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+
+GPR_GLOBAL_CONFIG_DEFINE_BOOL(
+    grpc_experimental_timer_wheel, false,
+    "If set, iomgr keeps timers in hierarchical timing wheels, making timer "
+    "insertion and cancellation constant time instead of logarithmic in the "
+    "number of outstanding timers.");
+
+extern grpc_core::TraceFlag grpc_timer_trace;
+extern grpc_core::TraceFlag grpc_timer_check_trace;
+extern grpc_timer_vtable grpc_generic_timer_vtable;
+
+namespace {
+
+// Each level of the wheel resolves one 6-bit digit of a deadline (in
+// milliseconds after the process epoch): level 0 slots are 1ms wide, level 1
+// slots 64ms, ..., level 5 slots ~18 minutes, so the wheel covers 2^36ms (a
+// little over two years) past the current wheel time. Anything further out
+// waits in an unordered overflow list.
+constexpr int kBitsPerLevel = 6;
+constexpr int kSlotsPerLevel = 1 << kBitsPerLevel;
+constexpr int kLevels = 6;
+constexpr int kWheelBits = kBitsPerLevel * kLevels;
+// grpc_timer::heap_index for timers on the overflow list; wheel timers store
+// level * kSlotsPerLevel + slot.
+constexpr uint32_t kOverflowIndex = kLevels * kSlotsPerLevel;
+
+// A timer with deadline d lives at the level of the most significant digit in
+// which d differs from the wheel time, in the slot named by d's digit at that
+// level. Since d is later than the wheel time, that digit is always ahead of
+// the wheel time's digit, so every slot of a level is either entirely in the
+// future or (once the wheel time reaches it) due to be fired or cascaded
+// into a finer level.
+struct wheel_shard {
+  gpr_mu mu;
+  // All timers with deadlines at or before this have been fired.
+  int64_t now;
+  // Doubly linked (nullptr-terminated) lists of timers, one per slot.
+  grpc_timer* slots[kLevels][kSlotsPerLevel];
+  // Bit s of occupied[l] is set iff slots[l][s] is non-empty.
+  uint64_t occupied[kLevels];
+  grpc_timer* overflow;
+  // A lower bound for the earliest deadline in this shard. Written under mu.
+  std::atomic<int64_t> min_deadline;
+};
+
+size_t g_num_shards;
+wheel_shard* g_shards;
+bool g_initialized;
+// A lower bound for the earliest deadline across all shards.
+std::atomic<int64_t> g_min_timer;
+// Allow only one run_some_expired_timers at once.
+gpr_spinlock g_checker_mu = GPR_SPINLOCK_STATIC_INITIALIZER;
+
+// The global minimum this thread last saw, so that most checks can skip
+// reading g_min_timer's (contended) cacheline.
+GPR_THREAD_LOCAL(int64_t) g_last_seen_min_timer;
+
+int CountLeadingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(x);
+#else
+  int n = 0;
+  while ((x & (uint64_t{1} << 63)) == 0) {
+    x <<= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+int CountTrailingZeros(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while ((x & 1) == 0) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+int64_t InfFutureMillis() {
+  return grpc_core::Timestamp::InfFuture().milliseconds_after_process_epoch();
+}
+
+// Lowers *target to value if value is smaller. Returns true if it did.
+bool AtomicLowerTo(std::atomic<int64_t>* target, int64_t value) {
+  int64_t cur = target->load(std::memory_order_relaxed);
+  while (value < cur) {
+    if (target->compare_exchange_weak(cur, value)) return true;
+  }
+  return false;
+}
+
+void list_push(grpc_timer** head, grpc_timer* timer) {
+  timer->prev = nullptr;
+  timer->next = *head;
+  if (*head != nullptr) (*head)->prev = timer;
+  *head = timer;
+}
+
+void list_remove(grpc_timer** head, grpc_timer* timer) {
+  if (timer->prev != nullptr) {
+    timer->prev->next = timer->next;
+  } else {
+    *head = timer->next;
+  }
+  if (timer->next != nullptr) timer->next->prev = timer->prev;
+}
+
+// Places a timer due strictly after shard->now.
+// REQUIRES: shard->mu locked
+void add_to_wheel(wheel_shard* shard, grpc_timer* timer) {
+  uint64_t deadline = static_cast<uint64_t>(timer->deadline);
+  uint64_t diff = deadline ^ static_cast<uint64_t>(shard->now);
+  int level = (63 - CountLeadingZeros(diff)) / kBitsPerLevel;
+  if (level >= kLevels) {
+    timer->heap_index = kOverflowIndex;
+    list_push(&shard->overflow, timer);
+    return;
+  }
+  int slot = static_cast<int>((deadline >> (kBitsPerLevel * level)) &
+                              (kSlotsPerLevel - 1));
+  timer->heap_index = level * kSlotsPerLevel + slot;
+  list_push(&shard->slots[level][slot], timer);
+  shard->occupied[level] |= uint64_t{1} << slot;
+}
+
+// REQUIRES: shard->mu locked
+void remove_from_wheel(wheel_shard* shard, grpc_timer* timer) {
+  if (timer->heap_index == kOverflowIndex) {
+    list_remove(&shard->overflow, timer);
+    return;
+  }
+  int level = timer->heap_index / kSlotsPerLevel;
+  int slot = timer->heap_index % kSlotsPerLevel;
+  list_remove(&shard->slots[level][slot], timer);
+  if (shard->slots[level][slot] == nullptr) {
+    shard->occupied[level] &= ~(uint64_t{1} << slot);
+  }
+}
+
+// Moves every timer of slots[level][slot] onto the singly linked *out.
+// REQUIRES: shard->mu locked
+void take_slot(wheel_shard* shard, int level, int slot, grpc_timer** out) {
+  grpc_timer* timer = shard->slots[level][slot];
+  while (timer != nullptr) {
+    grpc_timer* next = timer->next;
+    timer->next = *out;
+    *out = timer;
+    timer = next;
+  }
+  shard->slots[level][slot] = nullptr;
+}
+
+// Advances the shard's wheel time to now, firing every timer that is due with
+// error and cascading the rest into finer levels. Returns the number of
+// timers fired.
+// REQUIRES: shard->mu locked
+size_t advance_wheel(wheel_shard* shard, int64_t now,
+                     grpc_error_handle error) {
+  if (now <= shard->now) return 0;
+  uint64_t old_now = static_cast<uint64_t>(shard->now);
+  uint64_t new_now = static_cast<uint64_t>(now);
+  grpc_timer* expired = nullptr;
+  for (int level = 0; level < kLevels; level++) {
+    int shift = kBitsPerLevel * level;
+    uint64_t ticks = (new_now >> shift) - (old_now >> shift);
+    // If this level's digit did not move, no coarser one did either.
+    if (ticks == 0) break;
+    uint64_t pending;
+    if (ticks >= kSlotsPerLevel) {
+      pending = ~uint64_t{0};
+    } else {
+      // The slots after the old digit up to and including the new one.
+      int first = static_cast<int>(((old_now >> shift) + 1) &
+                                   (kSlotsPerLevel - 1));
+      uint64_t span = (uint64_t{1} << ticks) - 1;
+      pending = first == 0 ? span : (span << first) | (span >> (64 - first));
+    }
+    pending &= shard->occupied[level];
+    shard->occupied[level] &= ~pending;
+    while (pending != 0) {
+      take_slot(shard, level, CountTrailingZeros(pending), &expired);
+      pending &= pending - 1;
+    }
+  }
+  if ((old_now >> kWheelBits) != (new_now >> kWheelBits)) {
+    grpc_timer* timer = shard->overflow;
+    while (timer != nullptr) {
+      grpc_timer* next = timer->next;
+      timer->next = expired;
+      expired = timer;
+      timer = next;
+    }
+    shard->overflow = nullptr;
+  }
+  shard->now = now;
+  size_t n = 0;
+  while (expired != nullptr) {
+    grpc_timer* timer = expired;
+    expired = timer->next;
+    if (timer->deadline > now) {
+      add_to_wheel(shard, timer);
+      continue;
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "TIMER %p: FIRE %" PRId64 "ms late", timer,
+              now - timer->deadline);
+    }
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_REF(error));
+    n++;
+  }
+  return n;
+}
+
+// Returns a lower bound for the earliest deadline in the shard: exact if the
+// next timer is in level 0, otherwise the start of the slot holding it.
+// REQUIRES: shard->mu locked
+int64_t compute_min_deadline(wheel_shard* shard) {
+  uint64_t now = static_cast<uint64_t>(shard->now);
+  for (int level = 0; level < kLevels; level++) {
+    if (shard->occupied[level] == 0) continue;
+    int shift = kBitsPerLevel * level;
+    // Every occupied slot is ahead of the wheel time's digit at this level,
+    // so the lowest occupied slot is the next one the wheel will reach.
+    uint64_t slot = CountTrailingZeros(shard->occupied[level]);
+    uint64_t base = (now >> (shift + kBitsPerLevel)) << (shift + kBitsPerLevel);
+    return static_cast<int64_t>(base | (slot << shift));
+  }
+  int64_t min_deadline = InfFutureMillis();
+  for (grpc_timer* timer = shard->overflow; timer != nullptr;
+       timer = timer->next) {
+    min_deadline = std::min(min_deadline, timer->deadline);
+  }
+  return min_deadline;
+}
+
+void timer_list_init() {
+  g_num_shards = grpc_core::Clamp(2 * gpr_cpu_num_cores(), 1u, 32u);
+  g_shards = new wheel_shard[g_num_shards];
+  int64_t now =
+      grpc_core::ExecCtx::Get()->Now().milliseconds_after_process_epoch();
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_init(&shard->mu);
+    shard->now = now;
+    for (int level = 0; level < kLevels; level++) {
+      for (int slot = 0; slot < kSlotsPerLevel; slot++) {
+        shard->slots[level][slot] = nullptr;
+      }
+      shard->occupied[level] = 0;
+    }
+    shard->overflow = nullptr;
+    shard->min_deadline.store(InfFutureMillis());
+  }
+  g_min_timer.store(InfFutureMillis());
+  g_last_seen_min_timer = 0;
+  g_initialized = true;
+}
+
+void timer_list_shutdown() {
+  grpc_error_handle error =
+      GRPC_ERROR_CREATE_FROM_STATIC_STRING("Timer list shutdown");
+  for (size_t i = 0; i < g_num_shards; i++) {
+    wheel_shard* shard = &g_shards[i];
+    gpr_mu_lock(&shard->mu);
+    advance_wheel(shard, InfFutureMillis(), error);
+    gpr_mu_unlock(&shard->mu);
+    gpr_mu_destroy(&shard->mu);
+  }
+  GRPC_ERROR_UNREF(error);
+  delete[] g_shards;
+  g_shards = nullptr;
+  g_initialized = false;
+}
+
+void timer_init(grpc_timer* timer, grpc_core::Timestamp deadline,
+                grpc_closure* closure) {
+  timer->closure = closure;
+  timer->deadline = deadline.milliseconds_after_process_epoch();
+
+#ifndef NDEBUG
+  timer->hash_table_next = nullptr;
+#endif
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: SET %" PRId64 " now %" PRId64 " call %p[%p]",
+            timer, deadline.milliseconds_after_process_epoch(),
+            grpc_core::ExecCtx::Get()->Now().milliseconds_after_process_epoch(),
+            closure, closure->cb);
+  }
+
+  if (!g_initialized) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION, timer->closure,
+        GRPC_ERROR_CREATE_FROM_STATIC_STRING(
+            "Attempt to create timer before initialization"));
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  // Another thread's checker may have already moved the wheel past this
+  // thread's notion of now; such a timer is just as expired.
+  if (deadline <= grpc_core::ExecCtx::Get()->Now() ||
+      timer->deadline <= shard->now) {
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure, GRPC_ERROR_NONE);
+    gpr_mu_unlock(&shard->mu);
+    return;
+  }
+  timer->pending = true;
+  add_to_wheel(shard, timer);
+  // Publish the shard minimum before the global one so that the checker,
+  // which reads them in the opposite order, cannot lose this timer.
+  bool is_first_timer = AtomicLowerTo(&shard->min_deadline, timer->deadline);
+  gpr_mu_unlock(&shard->mu);
+
+  if (is_first_timer && AtomicLowerTo(&g_min_timer, timer->deadline)) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+      gpr_log(GPR_INFO, "  .. shard %d lowered the global min to %" PRId64,
+              static_cast<int>(shard - g_shards), timer->deadline);
+    }
+    grpc_kick_poller();
+  }
+}
+
+void timer_cancel(grpc_timer* timer) {
+  if (!g_initialized) {
+    // must have already been cancelled, also the shard mutex is invalid
+    return;
+  }
+
+  wheel_shard* shard = &g_shards[grpc_core::HashPointer(timer, g_num_shards)];
+  gpr_mu_lock(&shard->mu);
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_trace)) {
+    gpr_log(GPR_INFO, "TIMER %p: CANCEL pending=%s", timer,
+            timer->pending ? "true" : "false");
+  }
+  if (timer->pending) {
+    // The shard minimum is left as is: it stays a valid lower bound and is
+    // recomputed the next time the shard is checked.
+    remove_from_wheel(shard, timer);
+    timer->pending = false;
+    grpc_core::ExecCtx::Run(DEBUG_LOCATION, timer->closure,
+                            GRPC_ERROR_CANCELLED);
+  }
+  gpr_mu_unlock(&shard->mu);
+}
+
+void timer_consume_kick() {
+  // Force re-evaluation of last seen min
+  g_last_seen_min_timer = 0;
+}
+
+grpc_timer_check_result run_some_expired_timers(int64_t now, int64_t* next,
+                                                grpc_error_handle error) {
+  grpc_timer_check_result result = GRPC_TIMERS_NOT_CHECKED;
+  int64_t min_timer = g_min_timer.load(std::memory_order_relaxed);
+  g_last_seen_min_timer = min_timer;
+  if (now < min_timer) {
+    if (next != nullptr) *next = std::min(*next, min_timer);
+    GRPC_ERROR_UNREF(error);
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  if (gpr_spinlock_trylock(&g_checker_mu)) {
+    result = GRPC_TIMERS_CHECKED_AND_EMPTY;
+    int64_t new_min = InfFutureMillis();
+    for (size_t i = 0; i < g_num_shards; i++) {
+      wheel_shard* shard = &g_shards[i];
+      if (shard->min_deadline.load() <= now) {
+        gpr_mu_lock(&shard->mu);
+        size_t n = advance_wheel(shard, now, error);
+        shard->min_deadline.store(compute_min_deadline(shard));
+        gpr_mu_unlock(&shard->mu);
+        if (n > 0) result = GRPC_TIMERS_FIRED;
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+          gpr_log(GPR_INFO, "  .. shard[%d] popped %" PRIdPTR,
+                  static_cast<int>(i), n);
+        }
+      }
+      new_min = std::min(new_min, shard->min_deadline.load());
+    }
+    g_min_timer.store(new_min);
+    // A timer_init that lowered a shard we had already visited may have
+    // lowered the global minimum before the store above overwrote it.
+    for (size_t i = 0; i < g_num_shards; i++) {
+      AtomicLowerTo(&g_min_timer, g_shards[i].min_deadline.load());
+    }
+    if (next != nullptr) *next = std::min(*next, g_min_timer.load());
+    gpr_spinlock_unlock(&g_checker_mu);
+  }
+
+  GRPC_ERROR_UNREF(error);
+  return result;
+}
+
+grpc_timer_check_result timer_check(grpc_core::Timestamp* next) {
+  int64_t now =
+      grpc_core::ExecCtx::Get()->Now().milliseconds_after_process_epoch();
+
+  // fetch from a thread-local first: this avoids contention on a globally
+  // mutable cacheline in the common case
+  int64_t min_timer = g_last_seen_min_timer;
+  if (now < min_timer) {
+    if (next != nullptr) {
+      *next = std::min(
+          *next,
+          grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(min_timer));
+    }
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+      gpr_log(GPR_INFO, "TIMER CHECK SKIP: now=%" PRId64 " min_timer=%" PRId64,
+              now, min_timer);
+    }
+    return GRPC_TIMERS_CHECKED_AND_EMPTY;
+  }
+
+  grpc_error_handle shutdown_error =
+      now != InfFutureMillis()
+          ? GRPC_ERROR_NONE
+          : GRPC_ERROR_CREATE_FROM_STATIC_STRING("Shutting down timer system");
+
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO,
+            "TIMER CHECK BEGIN: now=%" PRId64 " tls_min=%" PRId64
+            " glob_min=%" PRId64,
+            now, min_timer, g_min_timer.load(std::memory_order_relaxed));
+  }
+  int64_t next_millis = next == nullptr
+                            ? 0
+                            : next->milliseconds_after_process_epoch();
+  grpc_timer_check_result r = run_some_expired_timers(
+      now, next == nullptr ? nullptr : &next_millis, shutdown_error);
+  if (next != nullptr) {
+    *next = grpc_core::Timestamp::FromMillisecondsAfterProcessEpoch(
+        next_millis);
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_timer_check_trace)) {
+    gpr_log(GPR_INFO, "TIMER CHECK END: r=%d; next=%" PRId64, r,
+            next == nullptr ? int64_t{-1} : next_millis);
+  }
+  return r;
+}
+
+}  // namespace
+
+grpc_timer_vtable grpc_wheel_timer_vtable = {
+    timer_init,      timer_cancel,        timer_check,
+    timer_list_init, timer_list_shutdown, timer_consume_kick};
+
+grpc_timer_vtable* grpc_default_timer_vtable() {
+  return GPR_GLOBAL_CONFIG_GET(grpc_experimental_timer_wheel)
+             ? &grpc_wheel_timer_vtable
+             : &grpc_generic_timer_vtable;
+}
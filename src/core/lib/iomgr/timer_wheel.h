@@ -0,0 +1,36 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_IOMGR_TIMER_WHEEL_H
+#define GRPC_CORE_LIB_IOMGR_TIMER_WHEEL_H
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/gprpp/global_config.h"
+#include "src/core/lib/iomgr/timer.h"
+
+GPR_GLOBAL_CONFIG_DECLARE_BOOL(grpc_experimental_timer_wheel);
+
+// A timer implementation based on hierarchical timing wheels: grpc_timer_init
+// and grpc_timer_cancel are O(1) regardless of how many timers are
+// outstanding, where grpc_generic_timer_vtable pays O(log n) heap operations.
+// Timers keep millisecond resolution. Selected instead of the generic
+// implementation when GRPC_EXPERIMENTAL_TIMER_WHEEL is set.
+extern grpc_timer_vtable grpc_wheel_timer_vtable;
+
+// Returns the timer implementation iomgr platforms should install: the wheel
+// if GRPC_EXPERIMENTAL_TIMER_WHEEL is set, the generic one otherwise.
+grpc_timer_vtable* grpc_default_timer_vtable();
+
+#endif  // GRPC_CORE_LIB_IOMGR_TIMER_WHEEL_H
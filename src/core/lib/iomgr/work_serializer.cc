@@ -20,12 +20,22 @@
 
 #include "src/core/lib/iomgr/work_serializer.h"
 
+#include <inttypes.h>
+
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/iomgr/combiner.h"
+#include "src/core/lib/iomgr/executor.h"
+
 namespace grpc_core {
 
 DebugOnlyTraceFlag grpc_work_serializer_trace(false, "work_serializer");
 
 class WorkSerializer::WorkSerializerImpl : public Orphanable {
  public:
+  WorkSerializerImpl();
+  ~WorkSerializerImpl() override;
+
   void Run(std::function<void()> callback, const DebugLocation& location);
   void Schedule(std::function<void()> callback, const DebugLocation& location);
   void DrainQueue();
@@ -51,7 +61,19 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // that the queue size is also incremented as part of the fetch_add to allow
   // the callers to add a callback to the queue if another thread already holds
   // the lock to the work serializer.
-  void DrainQueueOwned();
+  //
+  // \a start is when the calling thread started running callbacks on the
+  // work serializer, and \a items how many it has run so far (i.e. 1 if
+  // Run() just ran the callback inline). Once the thread has spent longer
+  // than grpc_combiner_time_budget_micros() draining the queue, ownership is
+  // handed over to the executor, which drains the rest.
+  void DrainQueueOwned(gpr_cycle_counter start, size_t items);
+
+  // Hands ownership over to the executor, which continues draining the queue.
+  static void OffloadedDrainQueue(void* arg, grpc_error_handle error);
+
+  // Records a drain that ended. Must be called while still holding ownership.
+  void RecordDrain(gpr_cycle_counter start, size_t items);
 
   // First 16 bits indicate ownership of the WorkSerializer, next 48 bits are
   // queue size (i.e., refs).
@@ -70,8 +92,38 @@ class WorkSerializer::WorkSerializerImpl : public Orphanable {
   // orphaned.
   std::atomic<uint64_t> refs_{MakeRefPair(0, 1)};
   MultiProducerSingleConsumerQueue queue_;
+  grpc_closure offload_closure_;
+  // Totals over the lifetime of the work serializer, logged on destruction
+  // when tracing. Only accessed by the owner.
+  size_t total_drains_ = 0;
+  size_t total_callbacks_ = 0;
+  int64_t total_micros_ = 0;
+  size_t total_offloads_ = 0;
 };
 
+namespace {
+
+int64_t MicrosSince(gpr_cycle_counter start) {
+  gpr_timespec elapsed = gpr_cycle_counter_sub(gpr_get_cycle_counter(), start);
+  return elapsed.tv_sec * GPR_US_PER_SEC + elapsed.tv_nsec / GPR_NS_PER_US;
+}
+
+}  // namespace
+
+WorkSerializer::WorkSerializerImpl::WorkSerializerImpl() {
+  GRPC_CLOSURE_INIT(&offload_closure_, OffloadedDrainQueue, this, nullptr);
+}
+
+WorkSerializer::WorkSerializerImpl::~WorkSerializerImpl() {
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+    gpr_log(GPR_INFO,
+            "WorkSerializer %p: drains=%" PRIuPTR " callbacks=%" PRIuPTR
+            " micros=%" PRId64 " offloads=%" PRIuPTR,
+            this, total_drains_, total_callbacks_, total_micros_,
+            total_offloads_);
+  }
+}
+
 void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
                                              const DebugLocation& location) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
@@ -89,8 +141,9 @@ void WorkSerializer::WorkSerializerImpl::Run(std::function<void()> callback,
     if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
       gpr_log(GPR_INFO, "  Executing immediately");
     }
+    gpr_cycle_counter start = gpr_get_cycle_counter();
     callback();
-    DrainQueueOwned();
+    DrainQueueOwned(start, 1);
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue the callback.
@@ -143,7 +196,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
       refs_.fetch_add(MakeRefPair(1, 1), std::memory_order_acq_rel);
   if (GetOwners(prev_ref_pair) == 0) {
     // We took ownership of the WorkSerializer. Drain the queue.
-    DrainQueueOwned();
+    DrainQueueOwned(gpr_get_cycle_counter(), 0);
   } else {
     // Another thread is holding the WorkSerializer, so decrement the ownership
     // count we just added and queue a no-op callback.
@@ -153,11 +206,50 @@ void WorkSerializer::WorkSerializerImpl::DrainQueue() {
   }
 }
 
-void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
+void WorkSerializer::WorkSerializerImpl::OffloadedDrainQueue(
+    void* arg, grpc_error_handle /*error*/) {
+  static_cast<WorkSerializerImpl*>(arg)->DrainQueueOwned(
+      gpr_get_cycle_counter(), 0);
+}
+
+void WorkSerializer::WorkSerializerImpl::RecordDrain(gpr_cycle_counter start,
+                                                     size_t items) {
+  if (items == 0) return;
+  int64_t micros = MicrosSince(start);
+  ++total_drains_;
+  total_callbacks_ += items;
+  total_micros_ += micros;
+  // The stats are per-cpu, and need an ExecCtx to find the current one.
+  if (ExecCtx::Get() != nullptr) {
+    GRPC_STATS_INC_WORK_SERIALIZER_ITEMS_PER_DRAIN(items);
+    GRPC_STATS_INC_WORK_SERIALIZER_DRAIN_MICROS(micros);
+  }
+}
+
+void WorkSerializer::WorkSerializerImpl::DrainQueueOwned(
+    gpr_cycle_counter start, size_t items) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
     gpr_log(GPR_INFO, "WorkSerializer::DrainQueueOwned() %p", this);
   }
+  const int64_t budget = grpc_combiner_time_budget_micros();
   while (true) {
+    // If this thread has used up its time budget and there are more callbacks
+    // to run (besides the one that was just run), let the executor run them.
+    // Ownership is handed over as is: the new owner starts by accounting for
+    // the callback that was just run, like this loop does.
+    if (items > 0 && budget > 0 && ExecCtx::Get() != nullptr &&
+        GetSize(refs_.load(std::memory_order_acquire)) > 2 &&
+        Executor::IsThreadedDefault() && MicrosSince(start) >= budget) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
+        gpr_log(GPR_INFO, "  Over budget after %" PRIuPTR " items, offloading",
+                items);
+      }
+      RecordDrain(start, items);
+      ++total_offloads_;
+      GRPC_STATS_INC_WORK_SERIALIZER_OFFLOADED();
+      Executor::Run(&offload_closure_, GRPC_ERROR_NONE);
+      return;
+    }
     auto prev_ref_pair = refs_.fetch_sub(MakeRefPair(0, 1));
     // It is possible that while draining the queue, the last callback ended
     // up orphaning the work serializer. In that case, delete the object.
@@ -165,11 +257,15 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_work_serializer_trace)) {
         gpr_log(GPR_INFO, "  Queue Drained. Destroying");
       }
+      RecordDrain(start, items);
       delete this;
       return;
     }
     if (GetSize(prev_ref_pair) == 2) {
       // Queue drained. Give up ownership but only if queue remains empty.
+      // This thread may lose ownership as soon as it does, so account for
+      // the drain first.
+      RecordDrain(start, items);
       uint64_t expected = MakeRefPair(1, 1);
       if (refs_.compare_exchange_strong(expected, MakeRefPair(0, 1),
                                         std::memory_order_acq_rel)) {
@@ -184,6 +280,9 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
         delete this;
         return;
       }
+      // More callbacks showed up: keep draining, as a new drain.
+      start = gpr_get_cycle_counter();
+      items = 0;
     }
     // There is at least one callback on the queue. Pop the callback from the
     // queue and execute it.
@@ -204,6 +303,7 @@ void WorkSerializer::WorkSerializerImpl::DrainQueueOwned() {
     }
     cb_wrapper->callback();
     delete cb_wrapper;
+    ++items;
   }
 }
 
@@ -37,6 +37,20 @@ static constexpr size_t kMaxReplenishBytes = 1024 * 1024;
 // Minimum number of bytes an allocator will request from a quota in one step.
 static constexpr size_t kMinReplenishBytes = 4096;
 
+// Upper bound on the number of per-CPU shards of an allocator's free bytes.
+// Allocators are created per channel and per connection, so this bounds their
+// size on machines with many cores.
+static constexpr size_t kMaxFreeBytesShards = 16;
+
+// How much an allocator moves from its shared pool into a per-CPU shard, on
+// top of the reservation being served, when the shard runs dry. Reservations
+// and releases larger than this bypass the shards.
+static constexpr size_t kShardRefillBytes = 32 * 1024;
+
+// A shard holding more than this after a release gives everything above
+// kShardRefillBytes back to the shared pool.
+static constexpr size_t kMaxShardBytes = 2 * kShardRefillBytes;
+
 //
 // Reclaimer
 //
@@ -149,13 +163,16 @@ Poll<RefCountedPtr<ReclaimerQueue::Handle>> ReclaimerQueue::PollNext() {
 
 GrpcMemoryAllocatorImpl::GrpcMemoryAllocatorImpl(
     std::shared_ptr<BasicMemoryQuota> memory_quota, std::string name)
-    : memory_quota_(memory_quota), name_(std::move(name)) {
+    : num_shards_(Clamp(static_cast<size_t>(gpr_cpu_num_cores()), size_t(1),
+                        kMaxFreeBytesShards)),
+      shards_(new FreeBytesShard[num_shards_]),
+      memory_quota_(memory_quota),
+      name_(std::move(name)) {
   memory_quota_->Take(taken_bytes_);
 }
 
 GrpcMemoryAllocatorImpl::~GrpcMemoryAllocatorImpl() {
-  GPR_ASSERT(free_bytes_.load(std::memory_order_acquire) +
-                 sizeof(GrpcMemoryAllocatorImpl) ==
+  GPR_ASSERT(TakeAllFreeBytes() + sizeof(GrpcMemoryAllocatorImpl) ==
              taken_bytes_);
   memory_quota_->Return(taken_bytes_);
 }
@@ -223,24 +240,104 @@ absl::optional<size_t> GrpcMemoryAllocatorImpl::TryReserve(
 
   // How much do we want to reserve?
   const size_t reserve = request.min() + scaled_size_over_min;
+  // Serve from this CPU's shard if we can, then from the shared pool. Before
+  // declaring that we need more from the quota, pull back whatever other CPUs
+  // are holding on to.
+  FreeBytesShard* shard = this->shard();
+  if (TryTake(&shard->free_bytes, reserve)) return reserve;
+  if (TryReserveFromPool(shard, reserve)) return reserve;
+  CollectShards();
+  if (TryReserveFromPool(shard, reserve)) return reserve;
+  return {};
+}
+
+bool GrpcMemoryAllocatorImpl::TryTake(std::atomic<size_t>* free_bytes,
+                                      size_t reserve) {
   // See how many bytes are available.
-  size_t available = free_bytes_.load(std::memory_order_acquire);
+  size_t available = free_bytes->load(std::memory_order_acquire);
   while (true) {
     // Does the current free pool satisfy the request?
     if (available < reserve) {
-      return {};
+      return false;
     }
     // Try to reserve the requested amount.
     // If the amount of free memory changed through this loop, then available
     // will be set to the new value and we'll repeat.
-    if (free_bytes_.compare_exchange_weak(available, available - reserve,
+    if (free_bytes->compare_exchange_weak(available, available - reserve,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+      return true;
+    }
+  }
+}
+
+bool GrpcMemoryAllocatorImpl::TryReserveFromPool(FreeBytesShard* shard,
+                                                 size_t reserve) {
+  size_t available = free_bytes_.load(std::memory_order_acquire);
+  while (true) {
+    if (available < reserve) return false;
+    // Take the reservation plus a refill for the shard, if the pool has it.
+    const size_t take =
+        reserve > kShardRefillBytes
+            ? reserve
+            : std::min(available, reserve + kShardRefillBytes);
+    if (free_bytes_.compare_exchange_weak(available, available - take,
                                           std::memory_order_acq_rel,
                                           std::memory_order_acquire)) {
-      return reserve;
+      if (take != reserve) {
+        shard->free_bytes.fetch_add(take - reserve, std::memory_order_release);
+      }
+      return true;
     }
   }
 }
 
+void GrpcMemoryAllocatorImpl::CollectShards() {
+  size_t collected = 0;
+  for (size_t i = 0; i < num_shards_; i++) {
+    collected += shards_[i].free_bytes.exchange(0, std::memory_order_acq_rel);
+  }
+  if (collected != 0) {
+    free_bytes_.fetch_add(collected, std::memory_order_acq_rel);
+  }
+}
+
+size_t GrpcMemoryAllocatorImpl::TakeAllFreeBytes() {
+  size_t free_bytes = free_bytes_.exchange(0, std::memory_order_acq_rel);
+  for (size_t i = 0; i < num_shards_; i++) {
+    free_bytes += shards_[i].free_bytes.exchange(0, std::memory_order_acq_rel);
+  }
+  return free_bytes;
+}
+
+void GrpcMemoryAllocatorImpl::Release(size_t n) {
+  // Add the released memory to this CPU's share of our free bytes, or for a
+  // large release straight to the pool.
+  std::atomic<size_t>* free_bytes = n > kShardRefillBytes
+                                        ? &free_bytes_
+                                        : &this->shard()->free_bytes;
+  size_t prior = free_bytes->fetch_add(n, std::memory_order_release);
+  // If the shard has grown past its bound, give the excess back to the pool
+  // where reservations on other CPUs and the reclaimer can find it.
+  size_t held = prior + n;
+  while (free_bytes != &free_bytes_ && held > kMaxShardBytes) {
+    if (free_bytes->compare_exchange_weak(held, kShardRefillBytes,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_relaxed)) {
+      free_bytes_.fetch_add(held - kShardRefillBytes,
+                            std::memory_order_release);
+      break;
+    }
+  }
+  // If this increased our free bytes from 0 to non-zero, then make sure
+  // there's a reclaimer around to hand them back to the quota, otherwise,
+  // we're actually done.
+  if (prior != 0 || registered_reclaimer_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  MaybeRegisterReclaimer();
+}
+
 void GrpcMemoryAllocatorImpl::Replenish() {
   MutexLock lock(&memory_quota_mu_);
   GPR_ASSERT(!shutdown_);
@@ -264,21 +361,21 @@ void GrpcMemoryAllocatorImpl::MaybeRegisterReclaimer() {
 
 void GrpcMemoryAllocatorImpl::MaybeRegisterReclaimerLocked() {
   // If the reclaimer is already registered, then there's nothing to do.
-  if (registered_reclaimer_) return;
+  if (registered_reclaimer_.load(std::memory_order_relaxed)) return;
   if (shutdown_) return;
   // Grab references to the things we'll need
   auto self = shared_from_this();
   std::weak_ptr<EventEngineMemoryAllocatorImpl> self_weak{self};
-  registered_reclaimer_ = true;
+  registered_reclaimer_.store(true, std::memory_order_relaxed);
   InsertReclaimer(0, [self_weak](absl::optional<ReclamationSweep> sweep) {
     if (!sweep.has_value()) return;
     auto self = self_weak.lock();
     if (self == nullptr) return;
     auto* p = static_cast<GrpcMemoryAllocatorImpl*>(self.get());
     MutexLock lock(&p->memory_quota_mu_);
-    p->registered_reclaimer_ = false;
+    p->registered_reclaimer_.store(false, std::memory_order_relaxed);
     // Figure out how many bytes we can return to the quota.
-    size_t return_bytes = p->free_bytes_.exchange(0, std::memory_order_acq_rel);
+    size_t return_bytes = p->TakeAllFreeBytes();
     if (return_bytes == 0) return;
     // Subtract that from our outstanding balance.
     p->taken_bytes_ -= return_bytes;
@@ -305,7 +402,7 @@ void GrpcMemoryAllocatorImpl::Rebind(
   memory_quota_.swap(memory_quota);
   // Drop our freed memory down to zero, to avoid needing to ask the new
   // quota for memory we're not currently using.
-  taken_bytes_ -= free_bytes_.exchange(0, std::memory_order_acq_rel);
+  taken_bytes_ -= TakeAllFreeBytes();
   // And let the new quota know how much we're already using.
   memory_quota_->Take(taken_bytes_);
 }
@@ -27,6 +27,7 @@
 
 #include <grpc/event_engine/memory_allocator.h>
 #include <grpc/slice.h>
+#include <grpc/support/cpu.h>
 
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/sync.h"
@@ -291,13 +292,7 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
   size_t Reserve(MemoryRequest request) override;
 
   // Release some bytes that were previously reserved.
-  void Release(size_t n) override {
-    // Add the released memory to our free bytes counter... if this increases
-    // from  0 to non-zero, then we have more to do, otherwise, we're actually
-    // done.
-    if (free_bytes_.fetch_add(n, std::memory_order_release) != 0) return;
-    MaybeRegisterReclaimer();
-  }
+  void Release(size_t n) override;
 
   // Post a reclamation function.
   template <typename F>
@@ -321,8 +316,29 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
   absl::string_view name() const { return name_; }
 
  private:
+  // A slice of this allocator's free bytes, padded out to its own cache line
+  // so that threads on different CPUs do not contend on one counter.
+  struct FreeBytesShard {
+    std::atomic<size_t> free_bytes{0};
+    char padding[GPR_CACHELINE_SIZE - sizeof(std::atomic<size_t>)];
+  };
+
   // Primitive reservation function.
   absl::optional<size_t> TryReserve(MemoryRequest request) GRPC_MUST_USE_RESULT;
+  // Take exactly reserve bytes from *free_bytes if it holds that many.
+  static bool TryTake(std::atomic<size_t>* free_bytes, size_t reserve);
+  // Reserve from the shared pool, moving up to kShardRefillBytes extra into
+  // shard so that the next reservations on this CPU can be served locally.
+  bool TryReserveFromPool(FreeBytesShard* shard, size_t reserve);
+  // Move the contents of every shard back into the shared pool.
+  void CollectShards();
+  // Empty every shard and the shared pool, returning the total.
+  size_t TakeAllFreeBytes();
+  // The shard for the calling CPU.
+  FreeBytesShard* shard() {
+    if (num_shards_ == 1) return &shards_[0];
+    return &shards_[gpr_cpu_current_cpu() % num_shards_];
+  }
   // Replenish bytes from the quota, without blocking, possibly entering
   // overcommit.
   void Replenish() ABSL_LOCKS_EXCLUDED(memory_quota_mu_);
@@ -342,7 +358,12 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
   // contention, each MemoryAllocator can keep some memory in addition to what
   // it is immediately using, and the quota can pull it back under memory
   // pressure.
+  // The cache is split between a shared pool and a small per-CPU shard, which
+  // serves most reservations and releases without touching a shared cache
+  // line. Replenish and reclamation only deal with the pool, in bulk.
   std::atomic<size_t> free_bytes_{0};
+  const size_t num_shards_;
+  std::unique_ptr<FreeBytesShard[]> shards_;
   // Mutex guarding the backing resource quota.
   mutable Mutex memory_quota_mu_;
   // Backing resource quota.
@@ -352,7 +373,9 @@ class GrpcMemoryAllocatorImpl final : public EventEngineMemoryAllocatorImpl {
   size_t taken_bytes_ ABSL_GUARDED_BY(memory_quota_mu_) =
       sizeof(GrpcMemoryAllocatorImpl);
   bool shutdown_ ABSL_GUARDED_BY(memory_quota_mu_) = false;
-  bool registered_reclaimer_ ABSL_GUARDED_BY(memory_quota_mu_) = false;
+  // Written under memory_quota_mu_; Release reads it without the lock to skip
+  // MaybeRegisterReclaimer in the common case.
+  std::atomic<bool> registered_reclaimer_{false};
   // Indices into the various reclaimer queues, used so that we can cancel
   // reclamation should we shutdown or get rebound.
   OrphanablePtr<ReclaimerQueue::Handle>
@@ -294,10 +294,13 @@ class FilterStackCall final : public Call {
     void FinishBatch(grpc_error_handle error);
   };
 
-  FilterStackCall(Arena* arena, const grpc_call_create_args& args)
+  FilterStackCall(Arena* arena, size_t initial_arena_size,
+                  const grpc_call_create_args& args)
       : Call(arena, args.server_transport_data == nullptr, args.send_deadline),
         cq_(args.cq),
         channel_(args.channel),
+        size_estimator_(args.size_estimator),
+        initial_arena_size_(initial_arena_size),
         stream_op_payload_(context_) {}
 
   static void ReleaseCall(void* call, grpc_error_handle);
@@ -329,6 +332,9 @@ class FilterStackCall final : public Call {
   grpc_completion_queue* cq_;
   grpc_polling_entity pollent_;
   grpc_channel* channel_;
+  // Per-method arena sizing, if this call is to a registered method.
+  CallSizeEstimator* const size_estimator_;
+  const size_t initial_arena_size_;
   gpr_cycle_counter start_time_ = gpr_get_cycle_counter();
 
   /** has grpc_call_unref been called */
@@ -515,7 +521,15 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   grpc_error_handle error = GRPC_ERROR_NONE;
   grpc_channel_stack* channel_stack =
       grpc_channel_get_channel_stack(args->channel);
-  size_t initial_size = grpc_channel_get_call_size_estimate(args->channel);
+  // Size the arena for this method if we have seen calls to it before, and
+  // for the channel as a whole otherwise.
+  size_t initial_size = 0;
+  if (args->size_estimator != nullptr) {
+    initial_size = args->size_estimator->CallSizeEstimate();
+  }
+  if (initial_size == 0) {
+    initial_size = grpc_channel_get_call_size_estimate(args->channel);
+  }
   GRPC_STATS_INC_CALL_INITIAL_SIZE(initial_size);
   size_t call_alloc_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(FilterStackCall)) +
@@ -524,7 +538,8 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   std::pair<Arena*, void*> arena_with_call = Arena::CreateWithAlloc(
       initial_size, call_alloc_size, &*args->channel->allocator);
   arena = arena_with_call.first;
-  call = new (arena_with_call.second) FilterStackCall(arena, *args);
+  call = new (arena_with_call.second)
+      FilterStackCall(arena, initial_size, *args);
   GPR_DEBUG_ASSERT(FromC(call->c_ptr()) == call);
   GPR_DEBUG_ASSERT(FromCallStack(call->call_stack()) == call);
   *out_call = call->c_ptr();
@@ -620,9 +635,18 @@ void FilterStackCall::SetCompletionQueue(grpc_completion_queue* cq) {
 void FilterStackCall::ReleaseCall(void* call, grpc_error_handle /*error*/) {
   auto* c = static_cast<FilterStackCall*>(call);
   grpc_channel* channel = c->channel_;
+  CallSizeEstimator* size_estimator = c->size_estimator_;
+  const size_t initial_arena_size = c->initial_arena_size_;
   Arena* arena = c->arena();
   c->~FilterStackCall();
-  grpc_channel_update_call_size_estimate(channel, arena->Destroy());
+  const size_t arena_size = arena->Destroy();
+  if (arena_size > initial_arena_size) {
+    GRPC_STATS_INC_CALL_ARENA_ZONE_SPILLS();
+  }
+  if (size_estimator != nullptr) {
+    size_estimator->UpdateCallSizeEstimate(arena_size);
+  }
+  grpc_channel_update_call_size_estimate(channel, arena_size);
   GRPC_CHANNEL_INTERNAL_UNREF(channel, "call");
 }
 
@@ -28,6 +28,7 @@
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/surface/api_trace.h"
+#include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
 
 typedef void (*grpc_ioreq_completion_func)(grpc_call* call, int success,
@@ -50,6 +51,9 @@ typedef struct grpc_call_create_args {
   absl::optional<grpc_core::Slice> authority;
 
   grpc_core::Timestamp send_deadline;
+
+  /* if not NULL, sizes the call's arena in place of the channel's estimate */
+  grpc_core::CallSizeEstimator* size_estimator = nullptr;
 } grpc_call_create_args;
 
 /* Create a new call based on \a args.
@@ -92,10 +92,9 @@ grpc_channel* grpc_channel_create_with_builder(
                               ->memory_quota()
                               ->CreateMemoryOwner(name));
 
-  gpr_atm_no_barrier_store(
-      &channel->call_size_estimate,
-      (gpr_atm)CHANNEL_STACK_FROM_CHANNEL(channel)->call_stack_size +
-          grpc_call_get_initial_size_estimate());
+  channel->call_size_estimator.Init(
+      CHANNEL_STACK_FROM_CHANNEL(channel)->call_stack_size +
+      grpc_call_get_initial_size_estimate());
 
   grpc_compression_options_init(&channel->compression_options);
   for (size_t i = 0; i < args->num_args; i++) {
@@ -276,41 +275,52 @@ grpc_channel* grpc_channel_create_internal(
   return channel;
 }
 
-size_t grpc_channel_get_call_size_estimate(grpc_channel* channel) {
+namespace grpc_core {
+
+size_t CallSizeEstimator::CallSizeEstimate() const {
 #define ROUND_UP_SIZE 256
+  size_t estimate = call_size_estimate_.load(std::memory_order_relaxed);
+  if (estimate == 0) return 0;
   /* We round up our current estimate to the NEXT value of ROUND_UP_SIZE.
      This ensures:
       1. a consistent size allocation when our estimate is drifting slowly
          (which is common) - which tends to help most allocators reuse memory
       2. a small amount of allowed growth over the estimate without hitting
          the arena size doubling case, reducing overall memory usage */
-  return (static_cast<size_t>(
-              gpr_atm_no_barrier_load(&channel->call_size_estimate)) +
-          2 * ROUND_UP_SIZE) &
+  return (estimate + 2 * ROUND_UP_SIZE) &
          ~static_cast<size_t>(ROUND_UP_SIZE - 1);
+#undef ROUND_UP_SIZE
 }
 
-void grpc_channel_update_call_size_estimate(grpc_channel* channel,
-                                            size_t size) {
-  size_t cur = static_cast<size_t>(
-      gpr_atm_no_barrier_load(&channel->call_size_estimate));
+void CallSizeEstimator::UpdateCallSizeEstimate(size_t size) {
+  size_t cur = call_size_estimate_.load(std::memory_order_relaxed);
   if (cur < size) {
     /* size grew: update estimate */
-    gpr_atm_no_barrier_cas(&channel->call_size_estimate,
-                           static_cast<gpr_atm>(cur),
-                           static_cast<gpr_atm>(size));
+    call_size_estimate_.compare_exchange_weak(
+        cur, size, std::memory_order_relaxed, std::memory_order_relaxed);
     /* if we lose: never mind, something else will likely update soon enough */
   } else if (cur == size) {
     /* no change: holding pattern */
   } else if (cur > 0) {
     /* size shrank: decrease estimate */
-    gpr_atm_no_barrier_cas(
-        &channel->call_size_estimate, static_cast<gpr_atm>(cur),
-        static_cast<gpr_atm>(std::min(cur - 1, (255 * cur + size) / 256)));
+    call_size_estimate_.compare_exchange_weak(
+        cur, std::min(cur - 1, (255 * cur + size) / 256),
+        std::memory_order_relaxed, std::memory_order_relaxed);
     /* if we lose: never mind, something else will likely update soon enough */
   }
 }
 
+}  // namespace grpc_core
+
+size_t grpc_channel_get_call_size_estimate(grpc_channel* channel) {
+  return channel->call_size_estimator->CallSizeEstimate();
+}
+
+void grpc_channel_update_call_size_estimate(grpc_channel* channel,
+                                            size_t size) {
+  channel->call_size_estimator->UpdateCallSizeEstimate(size);
+}
+
 char* grpc_channel_get_target(grpc_channel* channel) {
   GRPC_API_TRACE("grpc_channel_get_target(channel=%p)", 1, (channel));
   return gpr_strdup(channel->target->c_str());
@@ -341,7 +351,8 @@ static grpc_call* grpc_channel_create_call_internal(
     grpc_channel* channel, grpc_call* parent_call, uint32_t propagation_mask,
     grpc_completion_queue* cq, grpc_pollset_set* pollset_set_alternative,
     grpc_core::Slice path, absl::optional<grpc_core::Slice> authority,
-    grpc_core::Timestamp deadline) {
+    grpc_core::Timestamp deadline,
+    grpc_core::CallSizeEstimator* size_estimator = nullptr) {
   GPR_ASSERT(channel->is_client);
   GPR_ASSERT(!(cq != nullptr && pollset_set_alternative != nullptr));
 
@@ -356,6 +367,7 @@ static grpc_call* grpc_channel_create_call_internal(
   args.path = std::move(path);
   args.authority = std::move(authority);
   args.send_deadline = deadline;
+  args.size_estimator = size_estimator;
 
   grpc_call* call;
   GRPC_LOG_IF_ERROR("call_create", grpc_call_create(&args, &call));
@@ -406,7 +418,7 @@ RegisteredCall::RegisteredCall(const char* method_arg, const char* host_arg) {
 }
 
 RegisteredCall::RegisteredCall(const RegisteredCall& other)
-    : path(other.path.Ref()) {
+    : path(other.path.Ref()), size_estimator(other.size_estimator) {
   if (other.authority.has_value()) {
     authority = other.authority->Ref();
   }
@@ -464,7 +476,7 @@ grpc_call* grpc_channel_create_registered_call(
       rc->authority.has_value()
           ? absl::optional<grpc_core::Slice>(rc->authority->Ref())
           : absl::nullopt,
-      grpc_core::Timestamp::FromTimespecRoundUp(deadline));
+      grpc_core::Timestamp::FromTimespecRoundUp(deadline), &rc->size_estimator);
 
   return call;
 }
@@ -479,6 +491,7 @@ static void destroy_channel(void* arg, grpc_error_handle /*error*/) {
   }
   grpc_channel_stack_destroy(CHANNEL_STACK_FROM_CHANNEL(channel));
   channel->registration_table.Destroy();
+  channel->call_size_estimator.Destroy();
   channel->allocator.Destroy();
   channel->target.Destroy();
   gpr_free(channel);
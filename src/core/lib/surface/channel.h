@@ -21,6 +21,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <atomic>
 #include <map>
 
 #include "src/core/lib/channel/channel_stack.h"
@@ -71,9 +72,33 @@ void grpc_channel_update_call_size_estimate(grpc_channel* channel, size_t size);
 
 namespace grpc_core {
 
+// Learns how large call arenas need to be, so that a call's arena can be
+// created with a single allocation. The estimate jumps straight to the
+// largest size seen and decays slowly after that.
+class CallSizeEstimator {
+ public:
+  explicit CallSizeEstimator(size_t initial_estimate = 0)
+      : call_size_estimate_(initial_estimate) {}
+  CallSizeEstimator(const CallSizeEstimator& other)
+      : call_size_estimate_(
+            other.call_size_estimate_.load(std::memory_order_relaxed)) {}
+  CallSizeEstimator& operator=(const CallSizeEstimator&) = delete;
+
+  // Initial arena size for the next call, or 0 if no call has been seen yet.
+  size_t CallSizeEstimate() const;
+  // Feed back the arena size a finished call actually used.
+  void UpdateCallSizeEstimate(size_t size);
+
+ private:
+  std::atomic<size_t> call_size_estimate_;
+};
+
 struct RegisteredCall {
   Slice path;
   absl::optional<Slice> authority;
+  // Arena sizing for calls to this method: methods on one channel can need
+  // very different amounts of memory.
+  CallSizeEstimator size_estimator;
 
   explicit RegisteredCall(const char* method_arg, const char* host_arg);
   RegisteredCall(const RegisteredCall& other);
@@ -98,7 +123,8 @@ struct grpc_channel {
   int is_client;
   grpc_compression_options compression_options;
 
-  gpr_atm call_size_estimate;
+  grpc_core::ManualConstructor<grpc_core::CallSizeEstimator>
+      call_size_estimator;
 
   // TODO(vjpai): Once the grpc_channel is allocated via new rather than malloc,
   //              expand the members of the CallRegistrationTable directly into
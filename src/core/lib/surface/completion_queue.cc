@@ -205,6 +205,8 @@ struct cq_vtable {
                  void* done_arg, grpc_cq_completion* storage, bool internal);
   grpc_event (*next)(grpc_completion_queue* cq, gpr_timespec deadline,
                      void* reserved);
+  int (*next_batch)(grpc_completion_queue* cq, grpc_event* events,
+                    int max_events, gpr_timespec deadline, void* reserved);
   grpc_event (*pluck)(grpc_completion_queue* cq, void* tag,
                       gpr_timespec deadline, void* reserved);
 };
@@ -228,6 +230,10 @@ class CqEventQueue {
 
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
+  /* Pops up to max_completions items into completions, taking the consumer
+   * lock once. Returns how many were popped; like Pop(), may come up short
+   * even if the queue holds more */
+  int PopMany(grpc_cq_completion** completions, int max_completions);
 
  private:
   /* Spinlock to serialize consumers i.e pop() operations */
@@ -390,6 +396,10 @@ static void cq_end_op_for_callback(
 static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
                           void* reserved);
 
+static int cq_next_batch(grpc_completion_queue* cq, grpc_event* events,
+                         int max_events, gpr_timespec deadline,
+                         void* reserved);
+
 static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
                            gpr_timespec deadline, void* reserved);
 
@@ -409,15 +419,15 @@ static const cq_vtable g_cq_vtable[] = {
     /* GRPC_CQ_NEXT */
     {GRPC_CQ_NEXT, sizeof(cq_next_data), cq_init_next, cq_shutdown_next,
      cq_destroy_next, cq_begin_op_for_next, cq_end_op_for_next, cq_next,
-     nullptr},
+     cq_next_batch, nullptr},
     /* GRPC_CQ_PLUCK */
     {GRPC_CQ_PLUCK, sizeof(cq_pluck_data), cq_init_pluck, cq_shutdown_pluck,
      cq_destroy_pluck, cq_begin_op_for_pluck, cq_end_op_for_pluck, nullptr,
-     cq_pluck},
+     nullptr, cq_pluck},
     /* GRPC_CQ_CALLBACK */
     {GRPC_CQ_CALLBACK, sizeof(cq_callback_data), cq_init_callback,
      cq_shutdown_callback, cq_destroy_callback, cq_begin_op_for_callback,
-     cq_end_op_for_callback, nullptr, nullptr},
+     cq_end_op_for_callback, nullptr, nullptr, nullptr},
 };
 
 #define DATA_FROM_CQ(cq) ((void*)((cq) + 1))
@@ -502,6 +512,37 @@ grpc_cq_completion* CqEventQueue::Pop() {
   return c;
 }
 
+int CqEventQueue::PopMany(grpc_cq_completion** completions,
+                          int max_completions) {
+  int num_popped = 0;
+
+  if (gpr_spinlock_trylock(&queue_lock_)) {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_SUCCESSES();
+
+    bool is_empty = false;
+    while (num_popped < max_completions) {
+      grpc_cq_completion* c = reinterpret_cast<grpc_cq_completion*>(
+          queue_.PopAndCheckEnd(&is_empty));
+      if (c == nullptr) {
+        if (!is_empty) {
+          GRPC_STATS_INC_CQ_EV_QUEUE_TRANSIENT_POP_FAILURES();
+        }
+        break;
+      }
+      completions[num_popped++] = c;
+    }
+    gpr_spinlock_unlock(&queue_lock_);
+  } else {
+    GRPC_STATS_INC_CQ_EV_QUEUE_TRYLOCK_FAILURES();
+  }
+
+  if (num_popped > 0) {
+    num_queue_items_.fetch_sub(num_popped, std::memory_order_relaxed);
+  }
+
+  return num_popped;
+}
+
 grpc_completion_queue* grpc_completion_queue_create_internal(
     grpc_cq_completion_type completion_type, grpc_cq_polling_type polling_type,
     grpc_completion_queue_functor* shutdown_callback) {
@@ -951,23 +992,45 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
-static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
-                          void* reserved) {
-  GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+/* Fills in *ev from a completion popped off the queue and releases the
+   completion */
+static void cq_complete_event(grpc_event* ev, grpc_cq_completion* c) {
+  ev->type = GRPC_OP_COMPLETE;
+  ev->success = c->next & 1u;
+  ev->tag = c->tag;
+  c->done(c->done_arg, c);
+}
 
-  grpc_event ret;
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+/* Maximum number of completions popped per acquisition of the queue lock by
+   cq_pop_queued_events */
+#define MAX_COMPLETIONS_PER_POP 32
+
+/* Pops up to max_events completions that are already queued into events,
+   without polling. Returns the number of events filled in */
+static int cq_pop_queued_events(cq_next_data* cqd, grpc_event* events,
+                                int max_events) {
+  grpc_cq_completion* completions[MAX_COMPLETIONS_PER_POP];
+  int num_events = 0;
+  while (num_events < max_events) {
+    int wanted = std::min(max_events - num_events, MAX_COMPLETIONS_PER_POP);
+    int popped = cqd->queue.PopMany(completions, wanted);
+    for (int i = 0; i < popped; i++) {
+      cq_complete_event(&events[num_events++], completions[i]);
+    }
+    if (popped < wanted) break;
+  }
+  return num_events;
+}
 
-  GRPC_API_TRACE(
-      "grpc_completion_queue_next("
-      "cq=%p, "
-      "deadline=gpr_timespec { tv_sec: %" PRId64
-      ", tv_nsec: %d, clock_type: %d }, "
-      "reserved=%p)",
-      5,
-      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
-       reserved));
-  GPR_ASSERT(!reserved);
+/* Blocks until an event is available, the queue is shut down or the deadline
+   passes, and stores it in events[0]. If it is a completion, also stores up
+   to max_events - 1 completions that are already queued after it. Returns
+   the number of events stored */
+static int cq_next_events(grpc_completion_queue* cq, grpc_event* events,
+                          int max_events, gpr_timespec deadline) {
+  grpc_event& ret = events[0];
+  int num_events = 1;
+  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
 
   dump_pending_tags(cq);
 
@@ -989,20 +1052,16 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     if (is_finished_arg.stolen_completion != nullptr) {
       grpc_cq_completion* c = is_finished_arg.stolen_completion;
       is_finished_arg.stolen_completion = nullptr;
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+      cq_complete_event(&ret, c);
+      num_events += cq_pop_queued_events(cqd, events + 1, max_events - 1);
       break;
     }
 
     grpc_cq_completion* c = cqd->queue.Pop();
 
     if (c != nullptr) {
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+      cq_complete_event(&ret, c);
+      num_events += cq_pop_queued_events(cqd, events + 1, max_events - 1);
       break;
     } else {
       /* If c == NULL it means either the queue is empty OR in an transient
@@ -1071,14 +1130,56 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  for (int i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
+  return num_events;
+}
+
+static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
+                          void* reserved) {
+  GPR_TIMER_SCOPE("grpc_completion_queue_next", 0);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next("
+      "cq=%p, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      5,
+      (cq, deadline.tv_sec, deadline.tv_nsec, (int)deadline.clock_type,
+       reserved));
+  GPR_ASSERT(!reserved);
+
+  grpc_event ret;
+  cq_next_events(cq, &ret, 1, deadline);
   return ret;
 }
 
+static int cq_next_batch(grpc_completion_queue* cq, grpc_event* events,
+                         int max_events, gpr_timespec deadline,
+                         void* reserved) {
+  GPR_TIMER_SCOPE("grpc_completion_queue_next_batch", 0);
+
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, events=%p, max_events=%d, "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(max_events > 0);
+
+  return cq_next_events(cq, events, max_events, deadline);
+}
+
 /* Finishes the completion queue shutdown. This means that there are no more
    completion events / tags expected from the completion queue
    - Must be called under completion queue lock
@@ -1126,6 +1227,13 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+int grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                     grpc_event* events, int max_events,
+                                     gpr_timespec deadline, void* reserved) {
+  GPR_ASSERT(cq->vtable->next_batch != nullptr);
+  return cq->vtable->next_batch(cq, events, max_events, deadline, reserved);
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
@@ -34,6 +34,7 @@
 #include "absl/types/optional.h"
 
 #include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/string_util.h>
 
@@ -566,6 +567,13 @@ void Server::Start() {
       pollsets_.push_back(grpc_cq_pollset(cq));
     }
   }
+  for (size_t cq_idx = 0; cq_idx < cq_cpus_.size(); cq_idx++) {
+    for (unsigned cpu : cq_cpus_[cq_idx]) {
+      if (cpu >= gpr_cpu_num_cores()) continue;
+      if (cpu >= cqs_for_cpu_.size()) cqs_for_cpu_.resize(cpu + 1);
+      cqs_for_cpu_[cpu].push_back(cq_idx);
+    }
+  }
   if (unregistered_request_matcher_ == nullptr) {
     unregistered_request_matcher_ = absl::make_unique<RealRequestMatcher>(this);
   }
@@ -619,6 +627,9 @@ grpc_error_handle Server::SetupTransport(
     // Completion queue not found.  Pick a random one to publish new calls to.
     cq_idx = static_cast<size_t>(rand()) % cqs_.size();
   }
+  // If completion queues are bound to CPUs, prefer one local to the poller
+  // that completed the handshake.
+  cq_idx = LocalCqIndex(cq_idx);
   // Set up channelz node.
   intptr_t channelz_socket_uuid = 0;
   if (socket_node != nullptr) {
@@ -659,6 +670,31 @@ void Server::RegisterCompletionQueue(grpc_completion_queue* cq) {
   cqs_.push_back(cq);
 }
 
+void Server::SetCompletionQueueCpus(grpc_completion_queue* cq,
+                                    std::vector<unsigned> cpus) {
+  GPR_ASSERT(!started_);
+  auto it = std::find(cqs_.begin(), cqs_.end(), cq);
+  GPR_ASSERT(it != cqs_.end());
+  cq_cpus_.resize(cqs_.size());
+  cq_cpus_[it - cqs_.begin()] = std::move(cpus);
+}
+
+size_t Server::LocalCqIndex(size_t fallback) {
+  if (cqs_for_cpu_.empty()) return fallback;
+  const unsigned cpu = gpr_cpu_current_cpu();
+  if (cpu >= cqs_for_cpu_.size()) return fallback;
+  const std::vector<size_t>& local_cqs = cqs_for_cpu_[cpu];
+  switch (local_cqs.size()) {
+    case 0:
+      return fallback;
+    case 1:
+      return local_cqs[0];
+    default:
+      return local_cqs[next_local_cq_.fetch_add(1, std::memory_order_relaxed) %
+                       local_cqs.size()];
+  }
+}
+
 namespace {
 
 bool streq(const std::string& a, const char* b) {
@@ -1260,7 +1296,9 @@ void Server::CallData::PublishNewRpc(void* arg, grpc_error_handle error) {
     calld->KillZombie();
     return;
   }
-  rm->MatchOrQueue(chand->cq_idx(), calld);
+  // The call's initial metadata was just read by a poller on this CPU: start
+  // matching from a completion queue bound to it, if there is one.
+  rm->MatchOrQueue(server->LocalCqIndex(chand->cq_idx()), calld);
 }
 
 namespace {
@@ -138,6 +138,14 @@ class Server : public InternallyRefCounted<Server>,
 
   void RegisterCompletionQueue(grpc_completion_queue* cq);
 
+  // Binds a registered completion queue to the given CPUs: new calls that
+  // arrive on a thread running on one of them are offered to this queue
+  // before any other. Without any bound queues, calls are offered first to
+  // the queue their connection was assigned when it was accepted. Must be
+  // called before Start().
+  void SetCompletionQueueCpus(grpc_completion_queue* cq,
+                              std::vector<unsigned> cpus);
+
   // Functions to specify that a specific registered method or the unregistered
   // collection should use a specific allocator for request matching.
   void SetRegisteredMethodAllocator(
@@ -399,6 +407,10 @@ class Server : public InternallyRefCounted<Server>,
     return requests_complete_.get();
   }
 
+  // Returns the index in cqs_ of a completion queue bound to the CPU this
+  // thread is running on, or \a fallback if there is none.
+  size_t LocalCqIndex(size_t fallback);
+
   bool ShutdownCalled() const {
     return (shutdown_refs_.load(std::memory_order_acquire) & 1) == 0;
   }
@@ -418,6 +430,14 @@ class Server : public InternallyRefCounted<Server>,
   std::vector<grpc_pollset*> pollsets_;
   bool started_ = false;
 
+  // CPUs each completion queue is bound to, indexed like cqs_; and, built from
+  // that in Start(), the indexes of the queues bound to each CPU. Both are
+  // empty unless SetCompletionQueueCpus() was used.
+  std::vector<std::vector<unsigned>> cq_cpus_;
+  std::vector<std::vector<size_t>> cqs_for_cpu_;
+  // Spreads calls across queues that are bound to the same CPU.
+  std::atomic<size_t> next_local_cq_{0};
+
   // The two following mutexes control access to server-state.
   // mu_global_ controls access to non-call-related state (e.g., channel state).
   // mu_call_ controls access to call-related state (e.g., the call lists).
@@ -0,0 +1,88 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/transport/bbr_estimator.h"
+
+#include <algorithm>
+
+#include "src/core/lib/gpr/useful.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Startup doubles the window every sample, like BBR's startup doubles the
+// sending rate every round trip.
+constexpr double kStartupGain = 2;
+// Startup ends after this many samples without 25% bandwidth growth.
+constexpr int kFullBandwidthCount = 3;
+constexpr double kFullBandwidthGrowth = 1.25;
+// Once the pipe is full, one sample in eight probes for more bandwidth with a
+// larger window. The others size the window to the estimate: the sender is
+// limited by the window, so that drains whatever queue the probe built up and
+// keeps the round-trip time samples (and so min_rtt) free of queueing delay.
+constexpr double kCycleGains[] = {1.25, 1, 1, 1, 1, 1, 1, 1};
+
+}  // namespace
+
+constexpr int64_t BbrEstimator::kInitialWindow;
+constexpr size_t BbrEstimator::kBandwidthSamples;
+constexpr Duration BbrEstimator::kMinRttExpiry;
+
+void BbrEstimator::AddSample(int64_t bytes, double rtt_seconds, int64_t window,
+                             Timestamp now) {
+  if (rtt_seconds <= 0) return;
+  if (min_rtt_ == 0 || rtt_seconds <= min_rtt_ ||
+      now - min_rtt_stamp_ > kMinRttExpiry) {
+    min_rtt_ = rtt_seconds;
+    min_rtt_stamp_ = now;
+  }
+  const double sample = static_cast<double>(bytes) / rtt_seconds;
+  // If the peer did not come close to filling the window, the sample tells
+  // how much it had to send rather than how fast the link is ("application
+  // limited", in BBR terms): only use it if it raises the estimate.
+  if (bytes < window / 2 && sample <= bandwidth()) return;
+  bandwidth_samples_[next_bandwidth_sample_] = sample;
+  next_bandwidth_sample_ = (next_bandwidth_sample_ + 1) % kBandwidthSamples;
+  switch (phase_) {
+    case Phase::kStartup:
+      if (bandwidth() >= full_bandwidth_ * kFullBandwidthGrowth) {
+        full_bandwidth_ = bandwidth();
+        full_bandwidth_count_ = 0;
+      } else if (++full_bandwidth_count_ >= kFullBandwidthCount) {
+        phase_ = Phase::kProbeBandwidth;
+        cycle_index_ = 0;
+      }
+      break;
+    case Phase::kProbeBandwidth:
+      cycle_index_ = (cycle_index_ + 1) % GPR_ARRAY_SIZE(kCycleGains);
+      break;
+  }
+}
+
+double BbrEstimator::bandwidth() const {
+  return *std::max_element(bandwidth_samples_,
+                           bandwidth_samples_ + kBandwidthSamples);
+}
+
+double BbrEstimator::TargetWindow() const {
+  if (min_rtt_ == 0) return kInitialWindow;
+  const double gain =
+      phase_ == Phase::kStartup ? kStartupGain : kCycleGains[cycle_index_];
+  return std::max(static_cast<double>(kInitialWindow), gain * EstimateBdp());
+}
+
+}  // namespace grpc_core
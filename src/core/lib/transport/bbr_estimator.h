@@ -0,0 +1,82 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_TRANSPORT_BBR_ESTIMATOR_H
+#define GRPC_CORE_LIB_TRANSPORT_BBR_ESTIMATOR_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src/core/lib/gprpp/time.h"
+
+namespace grpc_core {
+
+// Estimates the bandwidth-delay product of a connection the way BBR does
+// ("BBR: Congestion-Based Congestion Control", Cardwell et al., 2016): the
+// bottleneck bandwidth is the maximum of recent delivery rate samples, the
+// round-trip propagation time is the minimum of recent round-trip time
+// samples, and the BDP is their product.
+//
+// Samples come from BDP pings: the bytes received while a ping was
+// outstanding, and the ping's round-trip time. The receive window derived
+// from the estimate goes through BBR's phases: in startup it doubles with
+// every sample until the bandwidth stops growing; after that it cycles
+// through gains that periodically probe for more bandwidth and otherwise keep
+// the window at the estimate, which lets the bottleneck queue drain.
+class BbrEstimator {
+ public:
+  enum class Phase { kStartup, kProbeBandwidth };
+
+  // Window to use before there is any sample.
+  static constexpr int64_t kInitialWindow = 128 * 1024;
+
+  // Adds a sample of \a bytes received over \a rtt_seconds, while the
+  // advertised window was \a window bytes, taken at \a now.
+  void AddSample(int64_t bytes, double rtt_seconds, int64_t window,
+                 Timestamp now);
+
+  // Bottleneck bandwidth, in bytes per second. 0 before the first sample.
+  double bandwidth() const;
+  // Round-trip propagation time, in seconds. 0 before the first sample.
+  double min_rtt() const { return min_rtt_; }
+  // Estimated bandwidth-delay product, in bytes.
+  double EstimateBdp() const { return bandwidth() * min_rtt_; }
+
+  // Receive window to advertise in the current phase, in bytes.
+  double TargetWindow() const;
+
+  Phase phase() const { return phase_; }
+
+ private:
+  // Number of samples the bandwidth maximum is taken over.
+  static constexpr size_t kBandwidthSamples = 10;
+  // How long a round-trip time minimum is trusted without being refreshed.
+  static constexpr Duration kMinRttExpiry = Duration::Seconds(10);
+
+  Phase phase_ = Phase::kStartup;
+  double bandwidth_samples_[kBandwidthSamples] = {};
+  size_t next_bandwidth_sample_ = 0;
+  double min_rtt_ = 0;
+  Timestamp min_rtt_stamp_;
+  // Startup ends once the bandwidth has not grown by 25% for a few samples.
+  double full_bandwidth_ = 0;
+  int full_bandwidth_count_ = 0;
+  size_t cycle_index_ = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_TRANSPORT_BBR_ESTIMATOR_H
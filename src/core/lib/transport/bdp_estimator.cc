@@ -54,6 +54,9 @@ Timestamp BdpEstimator::CompletePing() {
             bw_est_ / 125000.0);
   }
   GPR_ASSERT(ping_state_ == PingState::STARTED);
+  ++completed_pings_;
+  last_ping_bytes_ = accumulator_;
+  last_ping_rtt_ = dt;
   if (accumulator_ > 2 * estimate_ / 3 && bw > bw_est_) {
     estimate_ = std::max(accumulator_, estimate_ * 2);
     bw_est_ = bw;
@@ -76,6 +76,12 @@ class BdpEstimator {
 
   int64_t accumulator() { return accumulator_; }
 
+  // How many pings have completed, and for the last one, the bytes received
+  // while it was outstanding and its round-trip time in seconds.
+  int64_t completed_pings() const { return completed_pings_; }
+  int64_t last_ping_bytes() const { return last_ping_bytes_; }
+  double last_ping_rtt() const { return last_ping_rtt_; }
+
  private:
   enum class PingState { UNSCHEDULED, SCHEDULED, STARTED };
 
@@ -87,6 +93,9 @@ class BdpEstimator {
   Duration inter_ping_delay_;
   int stable_estimate_count_;
   double bw_est_;
+  int64_t completed_pings_ = 0;
+  int64_t last_ping_bytes_ = 0;
+  double last_ping_rtt_ = 0;
   const char* name_;
 };
 
@@ -44,6 +44,10 @@ void grpc_resolver_dns_ares_shutdown(void);
 namespace grpc_core {
 void GrpcLbPolicyRingHashInit(void);
 void GrpcLbPolicyRingHashShutdown(void);
+void GrpcLbPolicyLeastRequestInit(void);
+void GrpcLbPolicyLeastRequestShutdown(void);
+void GrpcLbPolicyWeightedRoundRobinInit(void);
+void GrpcLbPolicyWeightedRoundRobinShutdown(void);
 #ifndef GRPC_NO_RLS
 void RlsLbPluginInit();
 void RlsLbPluginShutdown();
@@ -68,6 +72,10 @@ void grpc_register_built_in_plugins(void) {
                        grpc_lb_policy_round_robin_shutdown);
   grpc_register_plugin(grpc_core::GrpcLbPolicyRingHashInit,
                        grpc_core::GrpcLbPolicyRingHashShutdown);
+  grpc_register_plugin(grpc_core::GrpcLbPolicyLeastRequestInit,
+                       grpc_core::GrpcLbPolicyLeastRequestShutdown);
+  grpc_register_plugin(grpc_core::GrpcLbPolicyWeightedRoundRobinInit,
+                       grpc_core::GrpcLbPolicyWeightedRoundRobinShutdown);
   grpc_register_plugin(grpc_resolver_dns_ares_init,
                        grpc_resolver_dns_ares_shutdown);
   grpc_register_extra_plugins();
@@ -96,6 +104,7 @@ extern void RegisterNativeDnsResolver(CoreConfiguration::Builder* builder);
 extern void RegisterAresDnsResolver(CoreConfiguration::Builder* builder);
 extern void RegisterSockaddrResolver(CoreConfiguration::Builder* builder);
 extern void RegisterFakeResolver(CoreConfiguration::Builder* builder);
+extern void RegisterShmTransport(CoreConfiguration::Builder* builder);
 #ifdef GPR_SUPPORT_BINDER_TRANSPORT
 extern void RegisterBinderResolver(CoreConfiguration::Builder* builder);
 #endif
@@ -116,6 +125,7 @@ void BuildCoreConfiguration(CoreConfiguration::Builder* builder) {
   RegisterNativeDnsResolver(builder);
   RegisterSockaddrResolver(builder);
   RegisterFakeResolver(builder);
+  RegisterShmTransport(builder);
 #ifdef GPR_SUPPORT_BINDER_TRANSPORT
   RegisterBinderResolver(builder);
 #endif
@@ -15,6 +15,7 @@
  *
  */
 
+#include <algorithm>
 #include <memory>
 
 #include <grpc/grpc.h>
@@ -162,6 +163,35 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+int CompletionQueue::NextBatch(void** tags, bool* oks, int max_events) {
+  GPR_ASSERT(max_events > 0);
+  // Core events are buffered on the stack, so a single call returns at most
+  // kMaxEventsPerBatch of them.
+  constexpr int kMaxEventsPerBatch = 64;
+  grpc_event events[kMaxEventsPerBatch];
+  for (;;) {
+    int num_events = grpc_completion_queue_next_batch(
+        cq_, events, std::min(max_events, kMaxEventsPerBatch),
+        gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    int num_tags = 0;
+    for (int i = 0; i < num_events; i++) {
+      // With an infinite deadline, anything but a completion (which can only
+      // be the first and only event) means the queue is drained and shut down.
+      if (events[i].type != GRPC_OP_COMPLETE) return 0;
+      auto core_cq_tag =
+          static_cast<grpc::internal::CompletionQueueTag*>(events[i].tag);
+      void* tag = core_cq_tag;
+      bool ok = events[i].success != 0;
+      if (core_cq_tag->FinalizeResult(&tag, &ok)) {
+        tags[num_tags] = tag;
+        oks[num_tags] = ok;
+        num_tags++;
+      }
+    }
+    if (num_tags > 0) return num_tags;
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
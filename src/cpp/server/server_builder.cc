@@ -160,6 +160,9 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case WORKER_THREADS:
+      sync_server_settings_.worker_threads = val;
+      break;
   }
   return *this;
 }
@@ -326,10 +329,11 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
     // This is a Sync server
     gpr_log(GPR_INFO,
             "Synchronous server. Num CQs: %d, Min pollers: %d, Max Pollers: "
-            "%d, CQ timeout (msec): %d",
+            "%d, CQ timeout (msec): %d, Worker threads: %d",
             sync_server_settings_.num_cqs, sync_server_settings_.min_pollers,
             sync_server_settings_.max_pollers,
-            sync_server_settings_.cq_timeout_msec);
+            sync_server_settings_.cq_timeout_msec,
+            sync_server_settings_.worker_threads);
   }
 
   if (has_callback_methods) {
@@ -378,6 +382,8 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
   }
 
   server->RegisterContextAllocator(std::move(context_allocator_));
+  server->BindCompletionQueuesToCpus(cq_cpu_sets_, cqs_);
+  server->SetSyncServerWorkerThreads(sync_server_settings_.worker_threads);
 
   for (const auto& value : services_) {
     if (!server->RegisterService(value->host.get(), value->service)) {
@@ -54,6 +54,7 @@
 #include "src/cpp/client/create_channel_internal.h"
 #include "src/cpp/server/external_connection_acceptor_impl.h"
 #include "src/cpp/server/health/default_health_check_service.h"
+#include "src/cpp/server/work_stealing_thread_pool.h"
 #include "src/cpp/thread_manager/thread_manager.h"
 
 namespace grpc {
@@ -745,7 +746,9 @@ const char* Server::CallbackRequest<
 
 // Implementation of ThreadManager. Each instance of SyncRequestThreadManager
 // manages a pool of threads that poll for incoming Sync RPCs and call the
-// appropriate RPC handlers
+// appropriate RPC handlers. If it is given worker threads, the pollers hand
+// the RPCs over to a WorkStealingThreadPool instead of running the handlers
+// themselves.
 class Server::SyncRequestThreadManager : public grpc::ThreadManager {
  public:
   SyncRequestThreadManager(Server* server, grpc::CompletionQueue* server_cq,
@@ -787,10 +790,25 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
     GPR_DEBUG_ASSERT(sync_req != nullptr);
     GPR_DEBUG_ASSERT(ok);
 
+    if (pool_ != nullptr) {
+      pool_->Add([this, sync_req, resources] {
+        GPR_TIMER_SCOPE("sync_req->Run()", 0);
+        sync_req->Run(global_callbacks_, resources);
+      });
+      return;
+    }
     GPR_TIMER_SCOPE("sync_req->Run()", 0);
     sync_req->Run(global_callbacks_, resources);
   }
 
+  bool HandsOffWork() const override { return worker_threads_ > 0; }
+
+  // Runs the RPC handlers on \a worker_threads threads of their own. Must be
+  // called before Start().
+  void SetWorkerThreads(int worker_threads) {
+    worker_threads_ = worker_threads;
+  }
+
   void AddSyncMethod(grpc::internal::RpcServiceMethod* method, void* tag) {
     grpc_core::Server::FromC(server_->server())
         ->SetRegisteredMethodAllocator(server_cq_->cq(), tag, [this, method] {
@@ -822,6 +840,8 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
 
   void Wait() override {
     ThreadManager::Wait();
+    // Run whatever the pollers handed over before they exited
+    pool_.reset();
     // Drain any pending items from the queue
     void* tag;
     bool ok;
@@ -834,6 +854,10 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
 
   void Start() {
     if (has_sync_method_) {
+      if (worker_threads_ > 0) {
+        pool_ = absl::make_unique<grpc::WorkStealingThreadPool>(worker_threads_,
+                                                                 cpus());
+      }
       Initialize();  // ThreadManager's Initialize()
     }
   }
@@ -845,6 +869,8 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
   bool has_sync_method_ = false;
   std::unique_ptr<grpc::internal::RpcServiceMethod> unknown_method_;
   std::shared_ptr<Server::GlobalCallbacks> global_callbacks_;
+  int worker_threads_ = 0;
+  std::unique_ptr<grpc::WorkStealingThreadPool> pool_;
 };
 
 static grpc::internal::GrpcLibraryInitializer g_gli_initializer;
@@ -1062,6 +1088,33 @@ void Server::RegisterAsyncGenericService(grpc::AsyncGenericService* service) {
   has_async_generic_service_ = true;
 }
 
+void Server::BindCompletionQueuesToCpus(
+    const std::vector<std::vector<int>>& cpu_sets,
+    const std::vector<grpc::ServerCompletionQueue*>& cqs) {
+  if (cpu_sets.empty()) return;
+  size_t next = 0;
+  auto bind = [this, &cpu_sets, &next](grpc_completion_queue* cq) {
+    std::vector<unsigned> cpus;
+    for (int cpu : cpu_sets[next++ % cpu_sets.size()]) {
+      if (cpu >= 0) cpus.push_back(static_cast<unsigned>(cpu));
+    }
+    grpc_core::Server::FromC(server_)->SetCompletionQueueCpus(cq, cpus);
+    return cpus;
+  };
+  if (sync_server_cqs_ != nullptr) {
+    for (size_t i = 0; i < sync_server_cqs_->size(); i++) {
+      sync_req_mgrs_[i]->SetCpus(bind((*sync_server_cqs_)[i]->cq()));
+    }
+  }
+  for (grpc::ServerCompletionQueue* cq : cqs) bind(cq->cq());
+}
+
+void Server::SetSyncServerWorkerThreads(int worker_threads) {
+  for (const auto& mgr : sync_req_mgrs_) {
+    mgr->SetWorkerThreads(worker_threads);
+  }
+}
+
 void Server::RegisterCallbackGenericService(
     grpc::CallbackGenericService* service) {
   GPR_ASSERT(
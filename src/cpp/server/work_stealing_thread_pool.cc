@@ -0,0 +1,133 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/cpp/server/work_stealing_thread_pool.h"
+
+#include <deque>
+#include <utility>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc {
+
+class WorkStealingThreadPool::Worker {
+ public:
+  Worker(WorkStealingThreadPool* pool, size_t index,
+         const std::vector<unsigned>& cpus)
+      : pool_(pool), index_(index) {
+    thd_ = grpc_core::Thread(
+        "grpcpp_work_stealing_pool",
+        [](void* arg) { static_cast<Worker*>(arg)->Run(); }, this, nullptr,
+        grpc_core::Thread::Options().set_cpus(cpus));
+  }
+
+  void Start() { thd_.Start(); }
+  void Join() { thd_.Join(); }
+
+  size_t index() const { return index_; }
+
+  void Push(const std::function<void()>& callback) {
+    grpc_core::MutexLock lock(&mu_);
+    queue_.push_back(callback);
+  }
+
+  // Takes the oldest callback, on behalf of the owner or of a sibling.
+  std::function<void()> Pop() {
+    grpc_core::MutexLock lock(&mu_);
+    if (queue_.empty()) return nullptr;
+    std::function<void()> callback = std::move(queue_.front());
+    queue_.pop_front();
+    return callback;
+  }
+
+ private:
+  void Run() {
+    while (true) {
+      std::function<void()> callback = pool_->TakeWork(this);
+      if (callback != nullptr) {
+        callback();
+        continue;
+      }
+      if (!pool_->Park()) break;
+    }
+  }
+
+  WorkStealingThreadPool* const pool_;
+  const size_t index_;
+  grpc_core::Thread thd_;
+  grpc_core::Mutex mu_;
+  std::deque<std::function<void()>> queue_ ABSL_GUARDED_BY(mu_);
+};
+
+WorkStealingThreadPool::WorkStealingThreadPool(int num_threads,
+                                               std::vector<unsigned> cpus) {
+  if (num_threads < 1) num_threads = 1;
+  workers_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(absl::make_unique<Worker>(this, i, cpus));
+  }
+  for (auto& worker : workers_) {
+    worker->Start();
+  }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+  }
+  for (auto& worker : workers_) {
+    worker->Join();
+  }
+}
+
+void WorkStealingThreadPool::Add(const std::function<void()>& callback) {
+  workers_[next_worker_.fetch_add(1, std::memory_order_relaxed) %
+           workers_.size()]
+      ->Push(callback);
+  // Publish the new work before checking for idle workers. Park() does the
+  // mirror image (announce idleness, then check for work), so at least one
+  // side always observes the other and no wakeup is lost.
+  pending_.fetch_add(1);
+  if (idle_workers_.load() > 0) {
+    grpc_core::MutexLock lock(&mu_);
+    cv_.Signal();
+  }
+}
+
+std::function<void()> WorkStealingThreadPool::TakeWork(Worker* worker) {
+  std::function<void()> callback;
+  for (size_t i = 0; callback == nullptr && i < workers_.size(); ++i) {
+    callback = workers_[(worker->index() + i) % workers_.size()]->Pop();
+  }
+  if (callback != nullptr) pending_.fetch_sub(1);
+  return callback;
+}
+
+bool WorkStealingThreadPool::Park() {
+  grpc_core::MutexLock lock(&mu_);
+  idle_workers_.fetch_add(1);
+  while (!shutdown_ && pending_.load() <= 0) {
+    cv_.Wait(&mu_);
+  }
+  idle_workers_.fetch_sub(1);
+  return !shutdown_ || pending_.load() > 0;
+}
+
+}  // namespace grpc
@@ -0,0 +1,79 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_INTERNAL_CPP_SERVER_WORK_STEALING_THREAD_POOL_H
+#define GRPC_INTERNAL_CPP_SERVER_WORK_STEALING_THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/cpp/server/thread_pool_interface.h"
+
+namespace grpc {
+
+// A fixed-size thread pool in which every worker has its own FIFO queue.
+//
+// Add() spreads callbacks round-robin across the workers' queues, so threads
+// handing work to the pool (e.g. sync server pollers) rarely contend with one
+// another. A worker runs its own callbacks oldest first and, once its queue
+// is empty, takes the oldest callback from a sibling's queue before parking.
+// Parked workers are woken one at a time, as work arrives. Unlike
+// DynamicThreadPool, no thread is created or destroyed after construction.
+class WorkStealingThreadPool final : public ThreadPoolInterface {
+ public:
+  // Starts \a num_threads workers (at least one). If \a cpus is not empty,
+  // the workers only run on those CPUs.
+  explicit WorkStealingThreadPool(int num_threads,
+                                  std::vector<unsigned> cpus = {});
+  // Runs every callback that was added before destruction began, then joins
+  // the workers.
+  ~WorkStealingThreadPool() override;
+
+  WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+  WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+  void Add(const std::function<void()>& callback) override;
+
+ private:
+  class Worker;
+
+  // Takes the oldest callback from \a worker's queue or, failing that, from
+  // a sibling's. Returns an empty function if there is no work anywhere.
+  std::function<void()> TakeWork(Worker* worker);
+  // Blocks until work may be available. Returns false once the pool is shut
+  // down and drained.
+  bool Park();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> next_worker_{0};
+  // Number of callbacks added but not yet taken by a worker.
+  std::atomic<intptr_t> pending_{0};
+  // Number of workers currently parked (or about to park) on cv_.
+  std::atomic<int> idle_workers_{0};
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_SERVER_WORK_STEALING_THREAD_POOL_H
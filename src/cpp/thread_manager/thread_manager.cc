@@ -34,7 +34,7 @@ ThreadManager::WorkerThread::WorkerThread(ThreadManager* thd_mgr)
   thd_ = grpc_core::Thread(
       "grpcpp_sync_server",
       [](void* th) { static_cast<ThreadManager::WorkerThread*>(th)->Run(); },
-      this, &created_);
+      this, &created_, grpc_core::Thread::Options().set_cpus(thd_mgr->cpus_));
   if (!created_) {
     gpr_log(GPR_ERROR, "Could not create grpc_sync_server worker-thread");
   }
@@ -167,8 +167,9 @@ void ThreadManager::MainWorkLoop() {
       case WORK_FOUND:
         // If we got work and there are now insufficient pollers and there is
         // quota available to create a new thread, start a new poller thread
+        // (unless this one will be back to polling shortly)
         bool resource_exhausted = false;
-        if (!shutdown_ && num_pollers_ < min_pollers_) {
+        if (!shutdown_ && num_pollers_ < min_pollers_ && !HandsOffWork()) {
           if (thread_quota_->Reserve(1)) {
             // We can allocate a new poller thread
             num_pollers_++;
@@ -21,6 +21,8 @@
 
 #include <list>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpcpp/support/config.h>
@@ -40,6 +42,11 @@ class ThreadManager {
   // Initializes and Starts the Rpc Manager threads
   void Initialize();
 
+  // Restricts the threads to run on the given CPUs. Must be called before
+  // Initialize().
+  void SetCpus(std::vector<unsigned> cpus) { cpus_ = std::move(cpus); }
+  const std::vector<unsigned>& cpus() const { return cpus_; }
+
   // The return type of PollForWork() function
   enum WorkStatus { WORK_FOUND, SHUTDOWN, TIMEOUT };
 
@@ -76,6 +83,11 @@ class ThreadManager {
   // actually finds some work
   virtual void DoWork(void* tag, bool ok, bool resources) = 0;
 
+  // Whether DoWork() merely hands the work over to threads of its own and
+  // returns promptly. A poller that finds work then goes straight back to
+  // polling, so no replacement poller is started in the meantime.
+  virtual bool HandsOffWork() const { return false; }
+
   // Mark the ThreadManager as shutdown and begin draining the work. This is a
   // non-blocking call and the caller should call Wait(), a blocking call which
   // returns only once the shutdown is complete
@@ -175,6 +187,9 @@ class ThreadManager {
 
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
+
+  // CPUs the threads run on; any CPU if empty.
+  std::vector<unsigned> cpus_;
 };
 
 }  // namespace grpc
@@ -39,11 +39,14 @@ CORE_SOURCE_FILES = [
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_balancer_addresses.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/grpclb_client_stats.cc',
     'src/core/ext/filters/client_channel/lb_policy/grpclb/load_balancer_api.cc',
+    'src/core/ext/filters/client_channel/lb_policy/least_request/least_request.cc',
     'src/core/ext/filters/client_channel/lb_policy/pick_first/pick_first.cc',
     'src/core/ext/filters/client_channel/lb_policy/priority/priority.cc',
+    'src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash.cc',
     'src/core/ext/filters/client_channel/lb_policy/ring_hash/ring_hash.cc',
     'src/core/ext/filters/client_channel/lb_policy/rls/rls.cc',
     'src/core/ext/filters/client_channel/lb_policy/round_robin/round_robin.cc',
+    'src/core/ext/filters/client_channel/lb_policy/weighted_round_robin/weighted_round_robin.cc',
     'src/core/ext/filters/client_channel/lb_policy/weighted_target/weighted_target.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/cds.cc',
     'src/core/ext/filters/client_channel/lb_policy/xds/xds_cluster_impl.cc',
@@ -97,6 +100,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/bin_encoder.cc',
     'src/core/ext/transport/chttp2/transport/chttp2_transport.cc',
     'src/core/ext/transport/chttp2/transport/context_list.cc',
+    'src/core/ext/transport/chttp2/transport/decode_huff.cc',
     'src/core/ext/transport/chttp2/transport/flow_control.cc',
     'src/core/ext/transport/chttp2/transport/frame_data.cc',
     'src/core/ext/transport/chttp2/transport/frame_goaway.cc',
@@ -117,6 +121,9 @@ CORE_SOURCE_FILES = [
     'src/core/ext/transport/chttp2/transport/writing.cc',
     'src/core/ext/transport/inproc/inproc_plugin.cc',
     'src/core/ext/transport/inproc/inproc_transport.cc',
+    'src/core/ext/transport/shm/shm_endpoint.cc',
+    'src/core/ext/transport/shm/shm_ring.cc',
+    'src/core/ext/transport/shm/shm_transport.cc',
     'src/core/ext/upb-generated/envoy/admin/v3/certs.upb.c',
     'src/core/ext/upb-generated/envoy/admin/v3/clusters.upb.c',
     'src/core/ext/upb-generated/envoy/admin/v3/config_dump.upb.c',
@@ -440,8 +447,11 @@ CORE_SOURCE_FILES = [
     'src/core/lib/event_engine/default_event_engine_factory.cc',
     'src/core/lib/event_engine/event_engine.cc',
     'src/core/lib/event_engine/memory_allocator.cc',
+    'src/core/lib/event_engine/posix_engine/posix_engine.cc',
+    'src/core/lib/event_engine/posix_engine/timer_manager.cc',
     'src/core/lib/event_engine/resolved_address.cc',
     'src/core/lib/event_engine/sockaddr.cc',
+    'src/core/lib/event_engine/thread_pool.cc',
     'src/core/lib/gpr/alloc.cc',
     'src/core/lib/gpr/atm.cc',
     'src/core/lib/gpr/cpu_iphone.cc',
@@ -518,6 +528,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/executor.cc',
     'src/core/lib/iomgr/executor/mpmcqueue.cc',
     'src/core/lib/iomgr/executor/threadpool.cc',
+    'src/core/lib/iomgr/executor/work_stealing_queue.cc',
     'src/core/lib/iomgr/fork_posix.cc',
     'src/core/lib/iomgr/fork_windows.cc',
     'src/core/lib/iomgr/gethostname_fallback.cc',
@@ -526,6 +537,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/grpc_if_nametoindex_posix.cc',
     'src/core/lib/iomgr/grpc_if_nametoindex_unsupported.cc',
     'src/core/lib/iomgr/internal_errqueue.cc',
+    'src/core/lib/iomgr/io_uring_linux.cc',
     'src/core/lib/iomgr/iocp_windows.cc',
     'src/core/lib/iomgr/iomgr.cc',
     'src/core/lib/iomgr/iomgr_internal.cc',
@@ -567,6 +579,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/iomgr/timer_generic.cc',
     'src/core/lib/iomgr/timer_heap.cc',
     'src/core/lib/iomgr/timer_manager.cc',
+    'src/core/lib/iomgr/timer_wheel.cc',
     'src/core/lib/iomgr/unix_sockets_posix.cc',
     'src/core/lib/iomgr/unix_sockets_posix_noop.cc',
     'src/core/lib/iomgr/wakeup_fd_eventfd.cc',
@@ -681,6 +694,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/surface/server.cc',
     'src/core/lib/surface/validate_metadata.cc',
     'src/core/lib/surface/version.cc',
+    'src/core/lib/transport/bbr_estimator.cc',
     'src/core/lib/transport/bdp_estimator.cc',
     'src/core/lib/transport/byte_stream.cc',
     'src/core/lib/transport/connectivity_state.cc',
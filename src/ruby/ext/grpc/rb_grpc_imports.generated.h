@@ -119,6 +119,9 @@ extern grpc_completion_queue_create_type grpc_completion_queue_create_import;
 typedef grpc_event(*grpc_completion_queue_next_type)(grpc_completion_queue* cq, gpr_timespec deadline, void* reserved);
 extern grpc_completion_queue_next_type grpc_completion_queue_next_import;
 #define grpc_completion_queue_next grpc_completion_queue_next_import
+typedef int(*grpc_completion_queue_next_batch_type)(grpc_completion_queue* cq, grpc_event* events, int max_events, gpr_timespec deadline, void* reserved);
+extern grpc_completion_queue_next_batch_type grpc_completion_queue_next_batch_import;
+#define grpc_completion_queue_next_batch grpc_completion_queue_next_batch_import
 typedef grpc_event(*grpc_completion_queue_pluck_type)(grpc_completion_queue* cq, void* tag, gpr_timespec deadline, void* reserved);
 extern grpc_completion_queue_pluck_type grpc_completion_queue_pluck_import;
 #define grpc_completion_queue_pluck grpc_completion_queue_pluck_import
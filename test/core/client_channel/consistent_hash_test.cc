@@ -0,0 +1,182 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/strings/str_cat.h"
+#define XXH_INLINE_ALL
+#include "xxhash.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using Endpoint = ConsistentHashTable::Endpoint;
+
+std::vector<Endpoint> MakeEndpoints(const std::vector<uint32_t>& weights) {
+  std::vector<Endpoint> endpoints;
+  for (size_t i = 0; i < weights.size(); ++i) {
+    endpoints.push_back({absl::StrCat("10.0.0.", i, ":443"), weights[i]});
+  }
+  return endpoints;
+}
+
+std::vector<size_t> CountSlots(const ConsistentHashTable& table,
+                               size_t num_endpoints) {
+  std::vector<size_t> counts(num_endpoints);
+  for (size_t slot = 0; slot < table.size(); ++slot) {
+    ++counts[table.endpoint_index(slot)];
+  }
+  return counts;
+}
+
+void ExpectSameTable(const ConsistentHashTable& a,
+                     const ConsistentHashTable& b) {
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t slot = 0; slot < a.size(); ++slot) {
+    ASSERT_EQ(a.endpoint_index(slot), b.endpoint_index(slot)) << slot;
+  }
+  std::mt19937_64 rng(1);
+  for (int i = 0; i < 10000; ++i) {
+    const uint64_t hash = rng();
+    ASSERT_EQ(a.Pick(hash), b.Pick(hash)) << hash;
+  }
+}
+
+TEST(HashRingTest, EqualWeightsGetEqualShares) {
+  HashRing ring(MakeEndpoints({1, 1, 1}), 1024, 8388608);
+  // ceil(1024 / 3) entries each.
+  EXPECT_EQ(ring.size(), 1026u);
+  EXPECT_EQ(CountSlots(ring, 3), std::vector<size_t>({342, 342, 342}));
+}
+
+TEST(HashRingTest, SharesFollowWeights) {
+  HashRing ring(MakeEndpoints({1, 2, 3}), 1024, 8388608);
+  EXPECT_EQ(CountSlots(ring, 3), std::vector<size_t>({171, 342, 513}));
+}
+
+TEST(HashRingTest, SizeCappedAtMaxRingSize) {
+  HashRing ring(MakeEndpoints({1, 10000}), 1024, 4096);
+  EXPECT_EQ(ring.size(), 4096u);
+}
+
+TEST(HashRingTest, PickReturnsFirstEntryAtOrAfterHash) {
+  const std::vector<Endpoint> endpoints = MakeEndpoints({1, 2, 3, 4});
+  HashRing ring(endpoints, 64, 8388608);
+  std::vector<size_t> counts = CountSlots(ring, endpoints.size());
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    for (size_t n = 0; n < counts[i]; ++n) {
+      const std::string key = absl::StrCat(endpoints[i].key, "_", n);
+      const uint64_t hash = XXH64(key.data(), key.size(), 0);
+      EXPECT_EQ(ring.endpoint_index(ring.Pick(hash)), i) << key;
+      if (hash > 0) {
+        const size_t slot = ring.Pick(hash - 1);
+        EXPECT_EQ(ring.endpoint_index(slot), i) << key;
+      }
+    }
+  }
+  EXPECT_EQ(ring.Pick(0), 0u);
+  EXPECT_EQ(ring.Pick(std::numeric_limits<uint64_t>::max()), 0u);
+}
+
+TEST(HashRingTest, RebuildFromPreviousRingMatchesFullBuild) {
+  const std::vector<Endpoint> original = MakeEndpoints({1, 1, 2, 1, 1, 3});
+  HashRing previous(original, 1024, 8388608);
+  std::vector<std::vector<Endpoint>> updates;
+  // Unchanged.
+  updates.push_back(original);
+  // Endpoint removed.
+  updates.push_back(original);
+  updates.back().erase(updates.back().begin() + 1);
+  // Endpoint added.
+  updates.push_back(original);
+  updates.back().push_back({"10.0.1.1:443", 1});
+  // Weight changed.
+  updates.push_back(original);
+  updates.back()[2].weight = 5;
+  // Order changed.
+  updates.push_back(original);
+  std::swap(updates.back()[0], updates.back()[5]);
+  // Key duplicated.
+  updates.push_back(original);
+  updates.back().push_back(original[3]);
+  // Nothing in common.
+  updates.push_back({{"10.0.2.1:443", 1}, {"10.0.2.2:443", 1}});
+  for (const std::vector<Endpoint>& endpoints : updates) {
+    HashRing full(endpoints, 1024, 8388608);
+    HashRing incremental(endpoints, 1024, 8388608, &previous);
+    ExpectSameTable(full, incremental);
+  }
+}
+
+TEST(HashRingTest, RebuildFromRingWithDuplicateKeys) {
+  std::vector<Endpoint> endpoints = MakeEndpoints({1, 1, 1});
+  endpoints.push_back(endpoints[0]);
+  HashRing previous(endpoints, 1024, 8388608);
+  endpoints.pop_back();
+  HashRing full(endpoints, 1024, 8388608);
+  HashRing incremental(endpoints, 1024, 8388608, &previous);
+  ExpectSameTable(full, incremental);
+}
+
+TEST(MaglevTableTest, SharesFollowWeights) {
+  MaglevTable table(MakeEndpoints({1, 1, 2}), MaglevTable::kDefaultTableSize);
+  ASSERT_EQ(table.size(), MaglevTable::kDefaultTableSize);
+  std::vector<size_t> counts = CountSlots(table, 3);
+  const double size = static_cast<double>(table.size());
+  EXPECT_NEAR(counts[0] / size, 0.25, 0.01);
+  EXPECT_NEAR(counts[1] / size, 0.25, 0.01);
+  EXPECT_NEAR(counts[2] / size, 0.5, 0.01);
+}
+
+TEST(MaglevTableTest, PickIsHashModuloSize) {
+  MaglevTable table(MakeEndpoints({1, 1}), 7);
+  EXPECT_EQ(table.Pick(20), 6u);
+  EXPECT_EQ(table.Pick(21), 0u);
+}
+
+TEST(MaglevTableTest, RemovingEndpointMovesFewOtherSlots) {
+  std::vector<Endpoint> endpoints =
+      MakeEndpoints(std::vector<uint32_t>(20, 1));
+  MaglevTable before(endpoints, MaglevTable::kDefaultTableSize);
+  endpoints.erase(endpoints.begin() + 7);
+  MaglevTable after(endpoints, MaglevTable::kDefaultTableSize);
+  size_t moved = 0;
+  for (size_t slot = 0; slot < before.size(); ++slot) {
+    uint32_t old_index = before.endpoint_index(slot);
+    if (old_index == 7) continue;
+    if (old_index > 7) --old_index;
+    if (after.endpoint_index(slot) != old_index) ++moved;
+  }
+  EXPECT_LT(moved, before.size() / 20);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -550,6 +550,50 @@ TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigRoundRobin) {
   EXPECT_STREQ(lb_config->name(), "round_robin");
 }
 
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigLeastRequest) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": "
+      "[{\"least_request\":{\"choiceCount\":3,\"decayTime\":\"5s\"}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* parsed_config =
+      static_cast<internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_STREQ(lb_config->name(), "least_request");
+}
+
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigWeightedRoundRobin) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": [{\"weighted_round_robin\":{"
+      "\"enableOobLoadReport\":true,\"oobReportingPeriod\":\"5s\","
+      "\"blackoutPeriod\":\"0s\",\"weightUpdatePeriod\":\"0.01s\","
+      "\"weightExpirationPeriod\":\"60s\"}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* parsed_config =
+      static_cast<internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_STREQ(lb_config->name(), "weighted_round_robin");
+}
+
+TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigMaglev) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": "
+      "[{\"maglev_experimental\":{\"table_size\":65537}}]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  ASSERT_EQ(error, GRPC_ERROR_NONE) << grpc_error_std_string(error);
+  const auto* parsed_config =
+      static_cast<internal::ClientChannelGlobalParsedConfig*>(
+          svc_cfg->GetGlobalParsedConfig(0));
+  auto lb_config = parsed_config->parsed_lb_config();
+  EXPECT_STREQ(lb_config->name(), "maglev_experimental");
+}
+
 TEST_F(ClientChannelParserTest, ValidLoadBalancingConfigGrpclb) {
   const char* test_json =
       "{\"loadBalancingConfig\": "
@@ -620,6 +664,63 @@ TEST_F(ClientChannelParserTest, InvalidGrpclbLoadBalancingConfig) {
   GRPC_ERROR_UNREF(error);
 }
 
+TEST_F(ClientChannelParserTest, InvalidLeastRequestLoadBalancingConfig) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": ["
+      "  {\"least_request\":{\"choiceCount\":1,\"decayTime\":\"-1s\"}}"
+      "]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "Client channel global parser" CHILD_ERROR_TAG
+                  "field:loadBalancingConfig" CHILD_ERROR_TAG
+                  "least_request LB policy config" CHILD_ERROR_TAG
+                  "field:choiceCount error:must be at least 2"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(ClientChannelParserTest, InvalidWeightedRoundRobinLoadBalancingConfig) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": ["
+      "  {\"weighted_round_robin\":{\"enableOobLoadReport\":1,"
+      "   \"oobReportingPeriod\":\"0s\"}}"
+      "]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "Client channel global parser" CHILD_ERROR_TAG
+                  "field:loadBalancingConfig" CHILD_ERROR_TAG
+                  "weighted_round_robin LB policy config" CHILD_ERROR_TAG
+                  "field:enableOobLoadReport error:type should be BOOLEAN.*"
+                  "field:oobReportingPeriod error:must be positive"));
+  GRPC_ERROR_UNREF(error);
+}
+
+TEST_F(ClientChannelParserTest, InvalidMaglevLoadBalancingConfig) {
+  const char* test_json =
+      "{\"loadBalancingConfig\": ["
+      "  {\"maglev_experimental\":{\"table_size\":65536}}"
+      "]}";
+  grpc_error_handle error = GRPC_ERROR_NONE;
+  auto svc_cfg = ServiceConfigImpl::Create(nullptr, test_json, &error);
+  EXPECT_THAT(grpc_error_std_string(error),
+              ::testing::ContainsRegex(
+                  "Service config parsing error" CHILD_ERROR_TAG
+                  "Global Params" CHILD_ERROR_TAG
+                  "Client channel global parser" CHILD_ERROR_TAG
+                  "field:loadBalancingConfig" CHILD_ERROR_TAG
+                  "maglev_experimental LB policy config" CHILD_ERROR_TAG
+                  "field:table_size error:must be a prime no larger than "
+                  "5000011"));
+  GRPC_ERROR_UNREF(error);
+}
+
 TEST_F(ClientChannelParserTest, ValidLoadBalancingPolicy) {
   const char* test_json = "{\"loadBalancingPolicy\":\"pick_first\"}";
   grpc_error_handle error = GRPC_ERROR_NONE;
@@ -211,6 +211,8 @@ extern void simple_request(grpc_end2end_test_config config);
 extern void simple_request_pre_init(void);
 extern void streaming_error_response(grpc_end2end_test_config config);
 extern void streaming_error_response_pre_init(void);
+extern void subchannel_connection_pool(grpc_end2end_test_config config);
+extern void subchannel_connection_pool_pre_init(void);
 extern void trailing_metadata(grpc_end2end_test_config config);
 extern void trailing_metadata_pre_init(void);
 extern void write_buffering(grpc_end2end_test_config config);
@@ -312,6 +314,7 @@ void grpc_end2end_tests_pre_init(void) {
   simple_metadata_pre_init();
   simple_request_pre_init();
   streaming_error_response_pre_init();
+  subchannel_connection_pool_pre_init();
   trailing_metadata_pre_init();
   write_buffering_pre_init();
   write_buffering_at_end_pre_init();
@@ -416,6 +419,7 @@ void grpc_end2end_tests(int argc, char **argv,
     simple_metadata(config);
     simple_request(config);
     streaming_error_response(config);
+    subchannel_connection_pool(config);
     trailing_metadata(config);
     write_buffering(config);
     write_buffering_at_end(config);
@@ -787,6 +791,10 @@ void grpc_end2end_tests(int argc, char **argv,
       streaming_error_response(config);
       continue;
     }
+    if (0 == strcmp("subchannel_connection_pool", argv[i])) {
+      subchannel_connection_pool(config);
+      continue;
+    }
     if (0 == strcmp("trailing_metadata", argv[i])) {
       trailing_metadata(config);
       continue;
@@ -0,0 +1,120 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/iomgr/port.h"
+
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+
+#include <inttypes.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "absl/strings/str_format.h"
+
+#include <grpc/grpc_security.h>
+#include <grpc/support/log.h>
+
+#include "test/core/end2end/end2end_tests.h"
+#include "test/core/util/test_config.h"
+
+struct fullstack_fixture_data {
+  std::string localaddr;
+};
+
+static int unique = 1;
+
+static grpc_end2end_test_fixture chttp2_create_fixture_shm(
+    const grpc_channel_args* /*client_args*/,
+    const grpc_channel_args* /*server_args*/) {
+  gpr_timespec now = gpr_now(GPR_CLOCK_REALTIME);
+  fullstack_fixture_data* ffd = new fullstack_fixture_data;
+  ffd->localaddr = absl::StrFormat(
+      "shm:/tmp/grpc_fullstack_test.shm.%d.%" PRId64 ".%" PRId32 ".%d",
+      getpid(), now.tv_sec, now.tv_nsec, unique++);
+
+  grpc_end2end_test_fixture f;
+  memset(&f, 0, sizeof(f));
+  f.fixture_data = ffd;
+  f.cq = grpc_completion_queue_create_for_next(nullptr);
+
+  return f;
+}
+
+void chttp2_init_client_shm(grpc_end2end_test_fixture* f,
+                            const grpc_channel_args* client_args) {
+  fullstack_fixture_data* ffd =
+      static_cast<fullstack_fixture_data*>(f->fixture_data);
+  grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+  f->client = grpc_channel_create(ffd->localaddr.c_str(), creds, client_args);
+  grpc_channel_credentials_release(creds);
+}
+
+void chttp2_init_server_shm(grpc_end2end_test_fixture* f,
+                            const grpc_channel_args* server_args) {
+  fullstack_fixture_data* ffd =
+      static_cast<fullstack_fixture_data*>(f->fixture_data);
+  if (f->server) {
+    grpc_server_destroy(f->server);
+  }
+  f->server = grpc_server_create(server_args, nullptr);
+  grpc_server_register_completion_queue(f->server, f->cq, nullptr);
+  grpc_server_credentials* server_creds =
+      grpc_insecure_server_credentials_create();
+  GPR_ASSERT(grpc_server_add_http2_port(f->server, ffd->localaddr.c_str(),
+                                        server_creds));
+  grpc_server_credentials_release(server_creds);
+  grpc_server_start(f->server);
+}
+
+void chttp2_tear_down_shm(grpc_end2end_test_fixture* f) {
+  fullstack_fixture_data* ffd =
+      static_cast<fullstack_fixture_data*>(f->fixture_data);
+  delete ffd;
+}
+
+/* All test configurations */
+static grpc_end2end_test_config configs[] = {
+    {"chttp2/fullstack_shm",
+     FEATURE_MASK_SUPPORTS_DELAYED_CONNECTION |
+         FEATURE_MASK_SUPPORTS_CLIENT_CHANNEL |
+         FEATURE_MASK_SUPPORTS_AUTHORITY_HEADER,
+     nullptr, chttp2_create_fixture_shm, chttp2_init_client_shm,
+     chttp2_init_server_shm, chttp2_tear_down_shm},
+};
+
+int main(int argc, char** argv) {
+  size_t i;
+
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_end2end_tests_pre_init();
+  grpc_init();
+
+  for (i = 0; i < sizeof(configs) / sizeof(*configs); i++) {
+    grpc_end2end_tests(argc, argv, configs[i]);
+  }
+
+  grpc_shutdown();
+
+  return 0;
+}
+
+#else  // GRPC_HAVE_SHM_TRANSPORT
+
+int main(int /*argc*/, char** /*argv*/) { return 1; }
+
+#endif  // GRPC_HAVE_SHM_TRANSPORT
@@ -309,7 +309,8 @@ static void on_client_read_done_locked(void* arg, grpc_error_handle error) {
   GRPC_CLOSURE_INIT(&conn->on_client_read_done, on_client_read_done, conn,
                     grpc_schedule_on_exec_ctx);
   grpc_endpoint_read(conn->client_endpoint, &conn->client_read_buffer,
-                     &conn->on_client_read_done, /*urgent=*/false);
+                     &conn->on_client_read_done, /*urgent=*/false,
+                     /*min_progress_size=*/1);
 }
 
 static void on_client_read_done(void* arg, grpc_error_handle error) {
@@ -351,7 +352,8 @@ static void on_server_read_done_locked(void* arg, grpc_error_handle error) {
   GRPC_CLOSURE_INIT(&conn->on_server_read_done, on_server_read_done, conn,
                     grpc_schedule_on_exec_ctx);
   grpc_endpoint_read(conn->server_endpoint, &conn->server_read_buffer,
-                     &conn->on_server_read_done, /*urgent=*/false);
+                     &conn->on_server_read_done, /*urgent=*/false,
+                     /*min_progress_size=*/1);
 }
 
 static void on_server_read_done(void* arg, grpc_error_handle error) {
@@ -381,11 +383,13 @@ static void on_write_response_done_locked(void* arg, grpc_error_handle error) {
   GRPC_CLOSURE_INIT(&conn->on_client_read_done, on_client_read_done, conn,
                     grpc_schedule_on_exec_ctx);
   grpc_endpoint_read(conn->client_endpoint, &conn->client_read_buffer,
-                     &conn->on_client_read_done, /*urgent=*/false);
+                     &conn->on_client_read_done, /*urgent=*/false,
+                     /*min_progress_size=*/1);
   GRPC_CLOSURE_INIT(&conn->on_server_read_done, on_server_read_done, conn,
                     grpc_schedule_on_exec_ctx);
   grpc_endpoint_read(conn->server_endpoint, &conn->server_read_buffer,
-                     &conn->on_server_read_done, /*urgent=*/false);
+                     &conn->on_server_read_done, /*urgent=*/false,
+                     /*min_progress_size=*/1);
 }
 
 static void on_write_response_done(void* arg, grpc_error_handle error) {
@@ -485,7 +489,8 @@ static void on_read_request_done_locked(void* arg, grpc_error_handle error) {
     GRPC_CLOSURE_INIT(&conn->on_read_request_done, on_read_request_done, conn,
                       grpc_schedule_on_exec_ctx);
     grpc_endpoint_read(conn->client_endpoint, &conn->client_read_buffer,
-                       &conn->on_read_request_done, /*urgent=*/false);
+                       &conn->on_read_request_done, /*urgent=*/false,
+                       /*min_progress_size=*/1);
     return;
   }
   // Make sure we got a CONNECT request.
@@ -579,7 +584,8 @@ static void on_accept(void* arg, grpc_endpoint* endpoint,
   GRPC_CLOSURE_INIT(&conn->on_read_request_done, on_read_request_done, conn,
                     grpc_schedule_on_exec_ctx);
   grpc_endpoint_read(conn->client_endpoint, &conn->client_read_buffer,
-                     &conn->on_read_request_done, /*urgent=*/false);
+                     &conn->on_read_request_done, /*urgent=*/false,
+                     /*min_progress_size=*/1);
 }
 
 //
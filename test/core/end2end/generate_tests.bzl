@@ -90,6 +90,11 @@ END2END_FIXTURES = {
         dns_resolver = False,
         client_channel = False,
     ),
+    "h2_sockpair_coalesce": _fixture_options(
+        fullstack = False,
+        dns_resolver = False,
+        client_channel = False,
+    ),
     "h2_sockpair+trace": _fixture_options(
         fullstack = False,
         dns_resolver = False,
@@ -126,6 +131,10 @@ END2END_FIXTURES = {
         _platforms = ["linux", "mac", "posix"],
     ),
     "h2_ssl_proxy": _fixture_options(includes_proxy = True, secure = True),
+    "h2_shm": _fixture_options(
+        dns_resolver = False,
+        _platforms = ["linux"],
+    ),
     "h2_uds": _fixture_options(
         dns_resolver = False,
         _platforms = ["linux", "mac", "posix"],
@@ -333,6 +342,11 @@ END2END_TESTS = {
     "simple_metadata": _test_options(),
     "simple_request": _test_options(),
     "streaming_error_response": _test_options(),
+    "subchannel_connection_pool": _test_options(
+        needs_fullstack = True,
+        needs_client_channel = True,
+        proxyable = False,
+    ),
     "trailing_metadata": _test_options(),
     "authority_not_supported": _test_options(),
     "filter_latency": _test_options(),
@@ -0,0 +1,275 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/end2end/end2end_tests.h"
+
+static void* tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+static grpc_end2end_test_fixture begin_test(grpc_end2end_test_config config,
+                                            const char* test_name,
+                                            grpc_channel_args* client_args,
+                                            grpc_channel_args* server_args) {
+  grpc_end2end_test_fixture f;
+  gpr_log(GPR_INFO, "Running test: %s/%s", test_name, config.name);
+  f = config.create_fixture(client_args, server_args);
+  config.init_server(&f, server_args);
+  config.init_client(&f, client_args);
+  return f;
+}
+
+static gpr_timespec n_seconds_from_now(int n) {
+  return grpc_timeout_seconds_to_deadline(n);
+}
+
+static gpr_timespec five_seconds_from_now(void) {
+  return n_seconds_from_now(5);
+}
+
+static void drain_cq(grpc_completion_queue* cq) {
+  grpc_event ev;
+  do {
+    ev = grpc_completion_queue_next(cq, five_seconds_from_now(), nullptr);
+  } while (ev.type != GRPC_QUEUE_SHUTDOWN);
+}
+
+static void shutdown_server(grpc_end2end_test_fixture* f) {
+  if (!f->server) return;
+  grpc_server_shutdown_and_notify(f->server, f->cq, tag(1000));
+  grpc_event ev;
+  do {
+    ev = grpc_completion_queue_next(f->cq, grpc_timeout_seconds_to_deadline(5),
+                                    nullptr);
+  } while (ev.type != GRPC_OP_COMPLETE || ev.tag != tag(1000));
+  grpc_server_destroy(f->server);
+  f->server = nullptr;
+}
+
+static void shutdown_client(grpc_end2end_test_fixture* f) {
+  if (!f->client) return;
+  grpc_channel_destroy(f->client);
+  f->client = nullptr;
+}
+
+static void end_test(grpc_end2end_test_fixture* f) {
+  shutdown_server(f);
+  shutdown_client(f);
+
+  grpc_completion_queue_shutdown(f->cq);
+  drain_cq(f->cq);
+  grpc_completion_queue_destroy(f->cq);
+}
+
+namespace {
+
+// Client side of one call.  Completes tag(base + 1) once the call has been
+// started on a stream, and tag(base + 2) once it has its status.
+struct ClientCall {
+  grpc_call* call = nullptr;
+  grpc_metadata_array initial_metadata_recv;
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_status_code status;
+  grpc_slice details;
+
+  ClientCall(grpc_end2end_test_fixture* f, const char* method, int base) {
+    grpc_metadata_array_init(&initial_metadata_recv);
+    grpc_metadata_array_init(&trailing_metadata_recv);
+    call = grpc_channel_create_call(
+        f->client, nullptr, GRPC_PROPAGATE_DEFAULTS, f->cq,
+        grpc_slice_from_static_string(method), nullptr, n_seconds_from_now(30),
+        nullptr);
+    GPR_ASSERT(call);
+    grpc_op ops[6];
+    grpc_op* op;
+    memset(ops, 0, sizeof(ops));
+    op = ops;
+    op->op = GRPC_OP_SEND_INITIAL_METADATA;
+    op->data.send_initial_metadata.count = 0;
+    op++;
+    op->op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    op++;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(call, ops, static_cast<size_t>(op - ops),
+                                     tag(base + 1), nullptr));
+    memset(ops, 0, sizeof(ops));
+    op = ops;
+    op->op = GRPC_OP_RECV_INITIAL_METADATA;
+    op->data.recv_initial_metadata.recv_initial_metadata =
+        &initial_metadata_recv;
+    op++;
+    op->op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    op->data.recv_status_on_client.trailing_metadata = &trailing_metadata_recv;
+    op->data.recv_status_on_client.status = &status;
+    op->data.recv_status_on_client.status_details = &details;
+    op++;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(call, ops, static_cast<size_t>(op - ops),
+                                     tag(base + 2), nullptr));
+  }
+
+  ~ClientCall() {
+    GPR_ASSERT(status == GRPC_STATUS_OK);
+    grpc_slice_unref(details);
+    grpc_metadata_array_destroy(&initial_metadata_recv);
+    grpc_metadata_array_destroy(&trailing_metadata_recv);
+    grpc_call_unref(call);
+  }
+};
+
+// Server side of one call.  Completes tag(base + 1) once a call has been
+// received, and tag(base + 2) once Finish() is done.
+struct ServerCall {
+  grpc_call* call = nullptr;
+  grpc_call_details call_details;
+  grpc_metadata_array request_metadata_recv;
+  int was_cancelled = 2;
+  int base;
+
+  ServerCall(grpc_end2end_test_fixture* f, int base) : base(base) {
+    grpc_call_details_init(&call_details);
+    grpc_metadata_array_init(&request_metadata_recv);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_server_request_call(f->server, &call, &call_details,
+                                        &request_metadata_recv, f->cq, f->cq,
+                                        tag(base + 1)));
+  }
+
+  void Finish() {
+    grpc_op ops[6];
+    grpc_op* op;
+    memset(ops, 0, sizeof(ops));
+    op = ops;
+    op->op = GRPC_OP_SEND_INITIAL_METADATA;
+    op->data.send_initial_metadata.count = 0;
+    op++;
+    op->op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    op->data.recv_close_on_server.cancelled = &was_cancelled;
+    op++;
+    op->op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    op->data.send_status_from_server.trailing_metadata_count = 0;
+    op->data.send_status_from_server.status = GRPC_STATUS_OK;
+    op++;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(call, ops, static_cast<size_t>(op - ops),
+                                     tag(base + 2), nullptr));
+  }
+
+  ~ServerCall() {
+    GPR_ASSERT(was_cancelled == 0);
+    grpc_call_details_destroy(&call_details);
+    grpc_metadata_array_destroy(&request_metadata_recv);
+    grpc_call_unref(call);
+  }
+};
+
+}  // namespace
+
+// The server only allows one stream per connection, and the client treats a
+// connection with one call as saturated and may open a second one.  With one
+// call running, a second call queues on the first connection (there is no
+// other connection yet) and makes the subchannel open another one, so a
+// third call goes out right away on the new connection instead of queueing
+// behind the first two.
+static void test_subchannel_connection_pool(grpc_end2end_test_config config) {
+  grpc_arg server_arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_MAX_CONCURRENT_STREAMS), 1);
+  grpc_channel_args server_args = {1, &server_arg};
+  grpc_arg client_arg_array[] = {
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_CONNECTIONS), 2),
+      grpc_channel_arg_integer_create(
+          const_cast<char*>(GRPC_ARG_SUBCHANNEL_MAX_STREAMS_PER_CONNECTION),
+          1)};
+  grpc_channel_args client_args = {GPR_ARRAY_SIZE(client_arg_array),
+                                   client_arg_array};
+  grpc_end2end_test_fixture f = begin_test(
+      config, "test_subchannel_connection_pool", &client_args, &server_args);
+  cq_verifier* cqv = cq_verifier_create(f.cq);
+
+  {
+    // Round trip a call so that the server's settings have been seen.
+    ClientCall c0(&f, "/warmup", 100);
+    ServerCall s0(&f, 200);
+    CQ_EXPECT_COMPLETION(cqv, tag(101), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(201), 1);
+    cq_verify(cqv);
+    s0.Finish();
+    CQ_EXPECT_COMPLETION(cqv, tag(102), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(202), 1);
+    cq_verify(cqv);
+  }
+
+  {
+    // First call occupies the only connection.
+    ClientCall c1(&f, "/alpha", 300);
+    ServerCall s1(&f, 400);
+    CQ_EXPECT_COMPLETION(cqv, tag(301), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(401), 1);
+    cq_verify(cqv);
+    GPR_ASSERT(0 == grpc_slice_str_cmp(s1.call_details.method, "/alpha"));
+
+    // Second call has to wait for the first one, but kicks off another
+    // connection.  Give that connection time to come up.
+    ClientCall c2(&f, "/beta", 500);
+    cq_verify_empty_timeout(cqv, 2);
+
+    // Third call goes out on the new connection while the first two are still
+    // where they were.
+    ClientCall c3(&f, "/gamma", 700);
+    ServerCall s3(&f, 800);
+    CQ_EXPECT_COMPLETION(cqv, tag(701), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(801), 1);
+    cq_verify(cqv);
+    GPR_ASSERT(0 == grpc_slice_str_cmp(s3.call_details.method, "/gamma"));
+
+    // Finishing the first call lets the second one through.
+    s1.Finish();
+    s3.Finish();
+    CQ_EXPECT_COMPLETION(cqv, tag(302), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(402), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(702), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(802), 1);
+    CQ_EXPECT_COMPLETION(cqv, tag(501), 1);
+    cq_verify(cqv);
+    {
+      ServerCall s2(&f, 600);
+      CQ_EXPECT_COMPLETION(cqv, tag(601), 1);
+      cq_verify(cqv);
+      GPR_ASSERT(0 == grpc_slice_str_cmp(s2.call_details.method, "/beta"));
+      s2.Finish();
+      CQ_EXPECT_COMPLETION(cqv, tag(502), 1);
+      CQ_EXPECT_COMPLETION(cqv, tag(602), 1);
+      cq_verify(cqv);
+    }
+  }
+
+  cq_verifier_destroy(cqv);
+  end_test(&f);
+  config.tear_down_data(&f);
+}
+
+void subchannel_connection_pool(grpc_end2end_test_config config) {
+  test_subchannel_connection_pool(config);
+}
+
+void subchannel_connection_pool_pre_init(void) {}
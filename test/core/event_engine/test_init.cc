@@ -15,17 +15,32 @@
 
 #include "test/core/event_engine/test_init.h"
 
+#include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 
 #include <grpc/support/log.h>
 
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/iomgr/port.h"
+
 namespace grpc_event_engine {
 namespace experimental {
 
 /// Sets the default EventEngine factory, used for testing.
 /// Valid engines are:
 /// * 'default' or 'libuv': the LibuvEventEngine
+/// * 'posix': the PosixEventEngine
 absl::Status InitializeTestingEventEngineFactory(absl::string_view engine) {
+#ifdef GRPC_POSIX_SOCKET
+  if (engine == "posix") {
+    static const auto* factory =
+        new std::function<std::unique_ptr<EventEngine>()>(
+            []() { return absl::make_unique<PosixEventEngine>(); });
+    SetDefaultEventEngineFactory(factory);
+    gpr_log(GPR_DEBUG, "Posix EventEngine initialized.");
+    return absl::OkStatus();
+  }
+#endif
   if (engine == "default" || engine == "libuv") {
     // TODO(hork): SetDefaultEventEngineFactory(LibuvEventEngineFactory)
     gpr_log(GPR_DEBUG, "Libuv EventEngine initialized.");
@@ -0,0 +1,102 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/event_engine/thread_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/synchronization/notification.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_event_engine {
+namespace experimental {
+
+TEST(ThreadPoolTest, CanRunClosure) {
+  ThreadPool p(1);
+  absl::Notification n;
+  p.Add([&n] { n.Notify(); });
+  n.WaitForNotification();
+}
+
+TEST(ThreadPoolTest, DestructorRunsPendingClosures) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool p(2);
+    for (int i = 0; i < 1000; ++i) {
+      p.Add([&count] { count.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ClosuresCanScheduleMoreWork) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool p(4);
+    for (int i = 0; i < 10; ++i) {
+      p.Add([&p, &count] {
+        // Work added from a worker lands on its local queue, and must still
+        // be visible to (and stealable by) the other workers.
+        for (int j = 0; j < 100; ++j) {
+          p.Add([&count] { count.fetch_add(1); });
+        }
+      });
+    }
+  }
+  EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPoolTest, IsThreadPoolThread) {
+  ThreadPool p(1);
+  EXPECT_FALSE(p.IsThreadPoolThread());
+  absl::Notification n;
+  bool on_pool_thread = false;
+  p.Add([&] {
+    on_pool_thread = p.IsThreadPoolThread();
+    n.Notify();
+  });
+  n.WaitForNotification();
+  EXPECT_TRUE(on_pool_thread);
+}
+
+TEST(ThreadPoolTest, ManyExternalThreadsCanAddConcurrently) {
+  std::atomic<int> count{0};
+  {
+    ThreadPool p(4);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&p, &count] {
+        for (int j = 0; j < 1000; ++j) {
+          p.Add([&count] { count.fetch_add(1); });
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+  }
+  EXPECT_EQ(count.load(), 8000);
+}
+
+}  // namespace experimental
+}  // namespace grpc_event_engine
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
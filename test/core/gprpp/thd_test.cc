@@ -23,6 +23,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <grpc/support/cpu.h>
 #include <grpc/support/log.h>
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
@@ -91,11 +92,31 @@ static void test2(void) {
   }
 }
 
+static void thd_body3(void* v) {
+  *static_cast<unsigned*>(v) = gpr_cpu_current_cpu();
+}
+
+/* Test that a thread given CPUs only runs on them, and that CPUs which do not
+   exist are ignored. */
+static void test3(void) {
+#if defined(GPR_LINUX) && !defined(GPR_MUSL_LIBC_COMPAT)
+  const unsigned last_cpu = gpr_cpu_num_cores() - 1;
+  unsigned ran_on = last_cpu + 1;
+  grpc_core::Thread th("grpc_thread_body3_test", &thd_body3, &ran_on, nullptr,
+                       grpc_core::Thread::Options().set_cpus(
+                           {last_cpu, last_cpu + 1000}));
+  th.Start();
+  th.Join();
+  GPR_ASSERT(ran_on == last_cpu);
+#endif
+}
+
 /* ------------------------------------------------- */
 
 int main(int argc, char* argv[]) {
   grpc::testing::TestEnvironment env(&argc, argv);
   test1();
   test2();
+  test3();
   return 0;
 }
@@ -21,6 +21,7 @@
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
+#include <grpc/support/thd_id.h>
 
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/thd.h"
@@ -136,6 +137,37 @@ static void test_execute_finally(void) {
   GRPC_COMBINER_UNREF(lock, "test_execute_finally");
 }
 
+static gpr_thd_id offload_caller;
+static gpr_event offloaded;
+
+static void run_past_budget(void* /*arg*/, grpc_error_handle /*error*/) {
+  // takes much longer than the default budget
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(20));
+}
+
+static void check_offloaded(void* /*arg*/, grpc_error_handle /*error*/) {
+  gpr_event_set(&offloaded,
+                reinterpret_cast<void*>(gpr_thd_currentid() != offload_caller));
+}
+
+static void test_offload_over_budget(void) {
+  gpr_log(GPR_DEBUG, "test_offload_over_budget");
+
+  grpc_core::Combiner* lock = grpc_combiner_create();
+  grpc_core::ExecCtx exec_ctx;
+  offload_caller = gpr_thd_currentid();
+  gpr_event_init(&offloaded);
+  lock->Run(GRPC_CLOSURE_CREATE(run_past_budget, nullptr, nullptr),
+            GRPC_ERROR_NONE);
+  lock->Run(GRPC_CLOSURE_CREATE(check_offloaded, nullptr, nullptr),
+            GRPC_ERROR_NONE);
+  grpc_core::ExecCtx::Get()->Flush();
+  // the second closure should have been left to the executor
+  GPR_ASSERT(gpr_event_wait(&offloaded, grpc_timeout_seconds_to_deadline(5)) ==
+             reinterpret_cast<void*>(1));
+  GRPC_COMBINER_UNREF(lock, "test_offload_over_budget");
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
@@ -143,6 +175,7 @@ int main(int argc, char** argv) {
   test_execute_one();
   test_execute_finally();
   test_execute_many();
+  test_offload_over_budget();
   grpc_shutdown();
 
   return 0;
@@ -37,6 +37,7 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/buffer_list.h"
 #include "src/core/lib/iomgr/ev_posix.h"
+#include "src/core/lib/iomgr/io_uring_linux.h"
 #include "src/core/lib/iomgr/sockaddr_posix.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/slice/slice_internal.h"
@@ -194,7 +195,7 @@ static void read_cb(void* user_data, grpc_error_handle error) {
   } else {
     gpr_mu_unlock(g_mu);
     grpc_endpoint_read(state->ep, &state->incoming, &state->read_cb,
-                       /*urgent=*/false);
+                       /*urgent=*/false, /*min_progress_size=*/1);
   }
 }
 
@@ -235,7 +236,8 @@ static void read_test(size_t num_bytes, size_t slice_size) {
   grpc_slice_buffer_init(&state.incoming);
   GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
 
-  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false,
+                     /*min_progress_size=*/1);
 
   gpr_mu_lock(g_mu);
   while (state.read_bytes < state.target_read_bytes) {
@@ -292,7 +294,8 @@ static void large_read_test(size_t slice_size) {
   grpc_slice_buffer_init(&state.incoming);
   GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
 
-  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false,
+                     /*min_progress_size=*/1);
 
   gpr_mu_lock(g_mu);
   while (state.read_bytes < state.target_read_bytes) {
@@ -312,6 +315,116 @@ static void large_read_test(size_t slice_size) {
       static_cast<grpc_resource_quota*>(a[1].value.pointer.p));
 }
 
+struct min_progress_read_state {
+  size_t read_bytes;
+  int callbacks;
+  grpc_slice_buffer incoming;
+  grpc_closure read_cb;
+};
+
+static void min_progress_read_cb(void* user_data, grpc_error_handle error) {
+  struct min_progress_read_state* state =
+      static_cast<struct min_progress_read_state*>(user_data);
+  int current_data = 0;
+
+  GPR_ASSERT(error == GRPC_ERROR_NONE);
+
+  gpr_mu_lock(g_mu);
+  state->read_bytes = count_slices(state->incoming.slices,
+                                   state->incoming.count, &current_data);
+  state->callbacks++;
+  GPR_ASSERT(GRPC_LOG_IF_ERROR("kick", grpc_pollset_kick(g_pollset, nullptr)));
+  gpr_mu_unlock(g_mu);
+}
+
+/* Write part of a message, start a read that asks for all of it, then write
+   the rest: the read must complete once, with every byte. */
+static void min_progress_read_test(size_t num_bytes, size_t first_write,
+                                   size_t slice_size) {
+  int sv[2];
+  grpc_endpoint* ep;
+  struct min_progress_read_state state;
+  grpc_core::ExecCtx exec_ctx;
+
+  gpr_log(GPR_INFO,
+          "Min progress read test of size %" PRIuPTR ", first write %" PRIuPTR
+          ", slice size %" PRIuPTR,
+          num_bytes, first_write, slice_size);
+
+  create_sockets(sv);
+
+  grpc_arg a[2];
+  a[0].key = const_cast<char*>(GRPC_ARG_TCP_READ_CHUNK_SIZE);
+  a[0].type = GRPC_ARG_INTEGER;
+  a[0].value.integer = static_cast<int>(slice_size);
+  a[1].key = const_cast<char*>(GRPC_ARG_RESOURCE_QUOTA);
+  a[1].type = GRPC_ARG_POINTER;
+  a[1].value.pointer.p = grpc_resource_quota_create("test");
+  a[1].value.pointer.vtable = grpc_resource_quota_arg_vtable();
+  grpc_channel_args args = {GPR_ARRAY_SIZE(a), a};
+  ep = grpc_tcp_create(grpc_fd_create(sv[1], "min_progress_read_test", false),
+                       &args, "test");
+  grpc_endpoint_add_to_pollset(ep, g_pollset);
+
+  unsigned char* buf = static_cast<unsigned char*>(gpr_malloc(num_bytes));
+  for (size_t i = 0; i < num_bytes; ++i) {
+    buf[i] = static_cast<uint8_t>(i % 256);
+  }
+  GPR_ASSERT(write(sv[0], buf, first_write) ==
+             static_cast<ssize_t>(first_write));
+
+  state.read_bytes = 0;
+  state.callbacks = 0;
+  grpc_slice_buffer_init(&state.incoming);
+  GRPC_CLOSURE_INIT(&state.read_cb, min_progress_read_cb, &state,
+                    grpc_schedule_on_exec_ctx);
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false,
+                     static_cast<int>(num_bytes));
+
+  /* The bytes written so far are not enough: the read must not complete. */
+  gpr_mu_lock(g_mu);
+  grpc_core::Timestamp deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_milliseconds_to_deadline(200));
+  while (grpc_core::ExecCtx::Get()->Now() < deadline) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+    GPR_ASSERT(state.callbacks == 0);
+  }
+  gpr_mu_unlock(g_mu);
+
+  size_t written = first_write;
+  while (written < num_bytes) {
+    ssize_t n = write(sv[0], buf + written, num_bytes - written);
+    if (n > 0) written += static_cast<size_t>(n);
+  }
+  gpr_free(buf);
+
+  deadline = grpc_core::Timestamp::FromTimespecRoundUp(
+      grpc_timeout_seconds_to_deadline(20));
+  gpr_mu_lock(g_mu);
+  while (state.callbacks == 0) {
+    grpc_pollset_worker* worker = nullptr;
+    GPR_ASSERT(GRPC_LOG_IF_ERROR(
+        "pollset_work", grpc_pollset_work(g_pollset, &worker, deadline)));
+    gpr_mu_unlock(g_mu);
+    grpc_core::ExecCtx::Get()->Flush();
+    gpr_mu_lock(g_mu);
+  }
+  GPR_ASSERT(state.callbacks == 1);
+  GPR_ASSERT(state.read_bytes == num_bytes);
+  gpr_mu_unlock(g_mu);
+
+  grpc_slice_buffer_destroy_internal(&state.incoming);
+  grpc_endpoint_destroy(ep);
+  close(sv[0]);
+  grpc_resource_quota_unref(
+      static_cast<grpc_resource_quota*>(a[1].value.pointer.p));
+}
+
 struct write_socket_state {
   grpc_endpoint* ep;
   int write_done;
@@ -543,7 +656,8 @@ static void release_fd_test(size_t num_bytes, size_t slice_size) {
   grpc_slice_buffer_init(&state.incoming);
   GRPC_CLOSURE_INIT(&state.read_cb, read_cb, &state, grpc_schedule_on_exec_ctx);
 
-  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false);
+  grpc_endpoint_read(ep, &state.incoming, &state.read_cb, /*urgent=*/false,
+                     /*min_progress_size=*/1);
 
   gpr_mu_lock(g_mu);
   while (state.read_bytes < state.target_read_bytes) {
@@ -591,6 +705,9 @@ void run_tests(void) {
   read_test(10000, 1);
   large_read_test(8192);
   large_read_test(1);
+  min_progress_read_test(100, 10, 8192);
+  min_progress_read_test(100000, 1000, 8192);
+  min_progress_read_test(100000, 1000, 137);
 
   write_test(100, 8192, false);
   write_test(100, 1, false);
@@ -650,9 +767,8 @@ static void destroy_pollset(void* p, grpc_error_handle /*error*/) {
   grpc_pollset_destroy(static_cast<grpc_pollset*>(p));
 }
 
-int main(int argc, char** argv) {
+static void run_all_tests() {
   grpc_closure destroyed;
-  grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
   grpc_core::grpc_tcp_set_write_timestamps_callback(timestamps_verifier);
   {
@@ -669,7 +785,18 @@ int main(int argc, char** argv) {
   }
   grpc_shutdown();
   gpr_free(g_pollset);
+}
 
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  run_all_tests();
+#ifdef GRPC_LINUX_IO_URING
+  /* Run everything again with reads and writes submitted through io_uring.
+   * Endpoints silently use regular I/O if the kernel does not support it. */
+  gpr_log(GPR_INFO, "Rerunning with io_uring");
+  GPR_GLOBAL_CONFIG_SET(grpc_experimental_tcp_io_uring, true);
+  run_all_tests();
+#endif /* GRPC_LINUX_IO_URING */
   return 0;
 }
 
@@ -29,6 +29,7 @@
 #include "src/core/lib/iomgr/iomgr_internal.h"
 #include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/timer.h"
+#include "src/core/lib/iomgr/timer_wheel.h"
 #include "test/core/util/test_config.h"
 #include "test/core/util/tracer_util.h"
 
@@ -228,12 +229,10 @@ void long_running_service_cleanup_test(void) {
   GPR_ASSERT(1 == cb_called[3][0]);
 }
 
-int main(int argc, char** argv) {
-  gpr_time_init();
-
+static void run_tests(int* argc, char** argv) {
   /* Tests with default g_start_time */
   {
-    grpc::testing::TestEnvironment env(&argc, argv);
+    grpc::testing::TestEnvironment env(argc, argv);
     grpc_core::ExecCtx exec_ctx;
     grpc_set_default_iomgr_platform();
     grpc_iomgr_platform_init();
@@ -245,7 +244,7 @@ int main(int argc, char** argv) {
 
   /* Begin long running service tests */
   {
-    grpc::testing::TestEnvironment env(&argc, argv);
+    grpc::testing::TestEnvironment env(argc, argv);
     /* Set g_start_time back 25 days. */
     /* We set g_start_time here in case there are any initialization
         dependencies that use g_start_time. */
@@ -262,6 +261,13 @@ int main(int argc, char** argv) {
     destruction_test();
     grpc_iomgr_platform_shutdown();
   }
+}
 
+int main(int argc, char** argv) {
+  gpr_time_init();
+  run_tests(&argc, argv);
+  /* Run everything again against the timing wheel implementation. */
+  GPR_GLOBAL_CONFIG_SET(grpc_experimental_timer_wheel, true);
+  run_tests(&argc, argv);
   return 0;
 }
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -235,6 +236,36 @@ TEST(WorkSerializerTest, WorkSerializerDestructionRaceMultipleThreads) {
   }
 }
 
+// Tests that a thread that used up its time budget hands the rest of the queue
+// over to the executor, without breaking the ordering of the callbacks.
+TEST(WorkSerializerTest, OffloadsToExecutorWhenOverBudget) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::WorkSerializer lock;
+  const std::thread::id caller = std::this_thread::get_id();
+  std::vector<int> order;
+  std::vector<std::thread::id> threads;
+  absl::Notification done;
+  for (int i = 1; i <= 3; ++i) {
+    lock.Schedule(
+        [&, i]() {
+          order.push_back(i);
+          threads.push_back(std::this_thread::get_id());
+          if (i == 3) done.Notify();
+        },
+        DEBUG_LOCATION);
+  }
+  // Takes much longer than the default budget.
+  lock.Run(
+      [&]() {
+        order.push_back(0);
+        gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(20));
+      },
+      DEBUG_LOCATION);
+  done.WaitForNotification();
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3}));
+  for (std::thread::id thread : threads) EXPECT_NE(thread, caller);
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -0,0 +1,188 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/iomgr/executor/work_stealing_queue.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+constexpr int kNumItems = 10000;
+
+// Elements are 1-based indices disguised as pointers, so none is null.
+void* Item(intptr_t i) { return reinterpret_cast<void*>(i + 1); }
+intptr_t Index(void* elem) { return reinterpret_cast<intptr_t>(elem) - 1; }
+
+TEST(WorkStealingDequeTest, OwnerIsLifoThiefIsFifo) {
+  WorkStealingDeque deque;
+  // Enough elements to grow the buffer a few times.
+  for (int i = 0; i < 1000; ++i) deque.Push(Item(i));
+  EXPECT_EQ(deque.size(), 1000u);
+  EXPECT_EQ(Index(deque.Steal()), 0);
+  EXPECT_EQ(Index(deque.Pop()), 999);
+  for (int i = 1; i < 500; ++i) EXPECT_EQ(Index(deque.Steal()), i);
+  for (int i = 998; i >= 500; --i) EXPECT_EQ(Index(deque.Pop()), i);
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.Steal(), nullptr);
+  EXPECT_EQ(deque.size(), 0u);
+}
+
+TEST(WorkStealingDequeTest, EveryElementIsTakenOnce) {
+  const int kNumThieves = 4;
+  WorkStealingDeque deque;
+  std::vector<std::atomic<int>> taken(kNumItems);
+  std::atomic<int> num_taken{0};
+  std::vector<std::thread> thieves;
+  for (int i = 0; i < kNumThieves; ++i) {
+    thieves.emplace_back([&]() {
+      while (num_taken.load() < kNumItems) {
+        void* elem = deque.Steal();
+        if (elem == nullptr) continue;
+        taken[Index(elem)].fetch_add(1);
+        num_taken.fetch_add(1);
+      }
+    });
+  }
+  // The owner interleaves pushes and pops, so it races with the thieves for
+  // the last element both when the deque is small and while it grows.
+  for (int i = 0; i < kNumItems; ++i) {
+    deque.Push(Item(i));
+    if (i % 3 == 0) {
+      void* elem = deque.Pop();
+      if (elem != nullptr) {
+        taken[Index(elem)].fetch_add(1);
+        num_taken.fetch_add(1);
+      }
+    }
+  }
+  void* elem;
+  while ((elem = deque.Pop()) != nullptr) {
+    taken[Index(elem)].fetch_add(1);
+    num_taken.fetch_add(1);
+  }
+  for (auto& thief : thieves) thief.join();
+  EXPECT_EQ(num_taken.load(), kNumItems);
+  for (int i = 0; i < kNumItems; ++i) EXPECT_EQ(taken[i].load(), 1) << i;
+}
+
+TEST(BoundedMPMCQueueTest, FifoAndBounded) {
+  BoundedMPMCQueue queue(100);  // rounded up to 128
+  for (int i = 0; i < 128; ++i) EXPECT_TRUE(queue.TryPush(Item(i)));
+  EXPECT_FALSE(queue.TryPush(Item(128)));
+  void* elem;
+  for (int i = 0; i < 128; ++i) {
+    ASSERT_TRUE(queue.TryPop(&elem));
+    EXPECT_EQ(Index(elem), i);
+  }
+  EXPECT_FALSE(queue.TryPop(&elem));
+  EXPECT_TRUE(queue.TryPush(nullptr));
+  ASSERT_TRUE(queue.TryPop(&elem));
+  EXPECT_EQ(elem, nullptr);
+}
+
+TEST(WorkStealingQueueTest, SharedPutsAreFifo) {
+  WorkStealingQueue queue(1);
+  // More than fits in the injector, so that some elements overflow.
+  for (int i = 0; i < kNumItems; ++i) queue.Put(Item(i));
+  EXPECT_EQ(queue.count(), kNumItems);
+  for (int i = 0; i < kNumItems; ++i) {
+    EXPECT_EQ(Index(queue.Get(nullptr)), i);
+  }
+  EXPECT_EQ(queue.count(), 0);
+  // Getting the shutdown signal unregisters this thread as a worker.
+  queue.Put(nullptr);
+  EXPECT_EQ(queue.Get(nullptr), nullptr);
+}
+
+TEST(WorkStealingQueueTest, WorkerRunsItsOwnPutsBeforeSharedWork) {
+  WorkStealingQueue queue(1);
+  std::vector<intptr_t> order;
+  queue.Put(Item(0));
+  queue.Put(Item(1));
+  std::thread worker([&]() {
+    // The first Get() registers this thread as a worker.
+    void* elem = queue.Get(nullptr);
+    order.push_back(Index(elem));
+    queue.Put(Item(10));
+    queue.Put(Item(11));
+    queue.PutShared(Item(12));
+    // The shutdown signal queues up behind every shared element.
+    queue.PutShared(nullptr);
+    while ((elem = queue.Get(nullptr)) != nullptr) {
+      order.push_back(Index(elem));
+    }
+  });
+  worker.join();
+  // Local puts come back newest first, ahead of the shared ones.
+  EXPECT_EQ(order, (std::vector<intptr_t>{0, 11, 10, 1, 12}));
+}
+
+TEST(WorkStealingQueueTest, ManyProducersAndWorkers) {
+  const int kNumProducers = 4;
+  const int kNumWorkers = 8;
+  WorkStealingQueue queue(kNumWorkers);
+  std::vector<std::atomic<int>> taken(kNumProducers * kNumItems * 2);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < kNumWorkers; ++i) {
+    workers.emplace_back([&]() {
+      void* elem;
+      while ((elem = queue.Get(nullptr)) != nullptr) {
+        intptr_t index = Index(elem);
+        // Half of the elements are put back by a worker, to exercise the
+        // worker deques and stealing.
+        if (index % 2 == 0) queue.Put(Item(index + 1));
+        taken[index].fetch_add(1);
+      }
+    });
+  }
+  std::vector<std::thread> producers;
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers.emplace_back([&queue, i]() {
+      for (int j = 0; j < kNumItems; ++j) {
+        queue.Put(Item((i * kNumItems + j) * 2));
+      }
+    });
+  }
+  for (auto& producer : producers) producer.join();
+  for (int i = 0; i < kNumWorkers; ++i) queue.Put(nullptr);
+  for (auto& worker : workers) worker.join();
+  EXPECT_EQ(queue.count(), 0);
+  for (size_t i = 0; i < taken.size(); ++i) {
+    EXPECT_EQ(taken[i].load(), 1) << i;
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int result = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return result;
+}
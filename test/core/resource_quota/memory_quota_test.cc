@@ -14,6 +14,9 @@
 
 #include "src/core/lib/resource_quota/memory_quota.h"
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "absl/synchronization/notification.h"
@@ -143,6 +146,33 @@ TEST(MemoryQuotaTest, BasicRebind) {
   EXPECT_EQ(object.get(), nullptr);
 }
 
+TEST(MemoryQuotaTest, FreeMemoryReleasedOnManyThreadsIsReclaimed) {
+  ExecCtx exec_ctx;
+
+  MemoryQuota memory_quota("foo");
+  memory_quota.SetSize(1024 * 1024);
+  auto idle = memory_quota.CreateMemoryAllocator("idle");
+  // Take half the quota, then release it from several threads so that the
+  // allocator ends up caching the memory wherever those threads ran.
+  std::vector<size_t> reservations;
+  for (int i = 0; i < 8; i++) {
+    reservations.push_back(idle.Reserve(MemoryRequest(64 * 1024)));
+  }
+  std::vector<std::thread> threads;
+  for (size_t n : reservations) {
+    threads.emplace_back([&idle, n] { idle.Release(n); });
+  }
+  for (auto& thread : threads) thread.join();
+
+  // Another allocator now needs most of the quota: all of the memory cached
+  // by the idle allocator should go back to the quota.
+  auto busy = memory_quota.CreateMemoryAllocator("busy");
+  size_t n = busy.Reserve(MemoryRequest(600 * 1024));
+  exec_ctx.Flush();
+  EXPECT_FALSE(memory_quota.IsMemoryPressureHigh());
+  busy.Release(n);
+}
+
 TEST(MemoryQuotaTest, ReserveRangeNoPressure) {
   MemoryQuota memory_quota("foo");
   auto memory_allocator = memory_quota.CreateMemoryAllocator("bar");
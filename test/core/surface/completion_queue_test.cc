@@ -281,6 +281,65 @@ static void test_shutdown_then_next_with_timeout(void) {
   }
 }
 
+static void test_next_batch(void) {
+  grpc_event events[48];
+  grpc_completion_queue* cc;
+  void* tags[100];
+  grpc_cq_completion completions[GPR_ARRAY_SIZE(tags)];
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+  LOG_TEST("test_next_batch");
+
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+    tags[i] = create_test_tag();
+  }
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  for (size_t pidx = 0; pidx < GPR_ARRAY_SIZE(polling_types); pidx++) {
+    grpc_core::ExecCtx exec_ctx;  // reset exec_ctx
+    attr.cq_polling_type = polling_types[pidx];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    for (size_t i = 0; i < GPR_ARRAY_SIZE(tags); i++) {
+      GPR_ASSERT(grpc_cq_begin_op(cc, tags[i]));
+      grpc_cq_end_op(cc, tags[i], GRPC_ERROR_NONE, do_nothing_end_completion,
+                     nullptr, &completions[i]);
+    }
+
+    // Events come back in order, as many at a time as there is room for.
+    size_t next_tag = 0;
+    while (next_tag < GPR_ARRAY_SIZE(tags)) {
+      int n = grpc_completion_queue_next_batch(
+          cc, events, GPR_ARRAY_SIZE(events), gpr_inf_past(GPR_CLOCK_REALTIME),
+          nullptr);
+      GPR_ASSERT(n >= 1);
+      GPR_ASSERT(n <= static_cast<int>(GPR_ARRAY_SIZE(events)));
+      for (int i = 0; i < n; i++) {
+        GPR_ASSERT(events[i].type == GRPC_OP_COMPLETE);
+        GPR_ASSERT(events[i].success);
+        GPR_ASSERT(events[i].tag == tags[next_tag++]);
+      }
+    }
+    GPR_ASSERT(next_tag == GPR_ARRAY_SIZE(tags));
+
+    // An empty queue times out with a single event.
+    GPR_ASSERT(grpc_completion_queue_next_batch(
+                   cc, events, GPR_ARRAY_SIZE(events),
+                   gpr_inf_past(GPR_CLOCK_REALTIME), nullptr) == 1);
+    GPR_ASSERT(events[0].type == GRPC_QUEUE_TIMEOUT);
+
+    grpc_completion_queue_shutdown(cc);
+    GPR_ASSERT(grpc_completion_queue_next_batch(
+                   cc, events, GPR_ARRAY_SIZE(events),
+                   gpr_inf_future(GPR_CLOCK_REALTIME), nullptr) == 1);
+    GPR_ASSERT(events[0].type == GRPC_QUEUE_SHUTDOWN);
+    grpc_completion_queue_destroy(cc);
+  }
+}
+
 static void test_pluck(void) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -495,6 +554,7 @@ int main(int argc, char** argv) {
   test_shutdown_then_next_polling();
   test_shutdown_then_next_with_timeout();
   test_cq_end_op();
+  test_next_batch();
   test_pluck();
   test_pluck_after_shutdown();
   test_cq_tls_cache_full();
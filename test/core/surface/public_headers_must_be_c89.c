@@ -94,6 +94,7 @@ int main(int argc, char **argv) {
   printf("%lx", (unsigned long) grpc_completion_queue_create_for_callback);
   printf("%lx", (unsigned long) grpc_completion_queue_create);
   printf("%lx", (unsigned long) grpc_completion_queue_next);
+  printf("%lx", (unsigned long) grpc_completion_queue_next_batch);
   printf("%lx", (unsigned long) grpc_completion_queue_pluck);
   printf("%lx", (unsigned long) grpc_completion_queue_shutdown);
   printf("%lx", (unsigned long) grpc_completion_queue_destroy);
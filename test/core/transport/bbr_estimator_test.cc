@@ -0,0 +1,83 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/transport/bbr_estimator.h"
+
+#include <gtest/gtest.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+Timestamp At(int64_t millis) {
+  return Timestamp::FromMillisecondsAfterProcessEpoch(millis);
+}
+
+TEST(BbrEstimatorTest, NoSamples) {
+  BbrEstimator est;
+  EXPECT_EQ(est.bandwidth(), 0);
+  EXPECT_EQ(est.min_rtt(), 0);
+  EXPECT_EQ(est.TargetWindow(), BbrEstimator::kInitialWindow);
+  EXPECT_EQ(est.phase(), BbrEstimator::Phase::kStartup);
+}
+
+TEST(BbrEstimatorTest, StartupDoublesUntilBandwidthPlateaus) {
+  BbrEstimator est;
+  // 1MB/s over a 100ms round trip: a BDP of 100KB, under the initial window.
+  int64_t now = 1000;
+  for (int i = 0; i < 3; i++) {
+    est.AddSample(100000, 0.1, BbrEstimator::kInitialWindow, At(now += 100));
+  }
+  EXPECT_EQ(est.phase(), BbrEstimator::Phase::kStartup);
+  EXPECT_DOUBLE_EQ(est.bandwidth(), 1e6);
+  EXPECT_DOUBLE_EQ(est.EstimateBdp(), 1e5);
+  EXPECT_DOUBLE_EQ(est.TargetWindow(), 2e5);
+  est.AddSample(100000, 0.1, BbrEstimator::kInitialWindow, At(now += 100));
+  EXPECT_EQ(est.phase(), BbrEstimator::Phase::kProbeBandwidth);
+  // The first sample of the cycle probes; the others stay at the estimate,
+  // never going under the initial window.
+  EXPECT_DOUBLE_EQ(est.TargetWindow(), BbrEstimator::kInitialWindow);
+}
+
+TEST(BbrEstimatorTest, AppLimitedSamplesOnlyRaiseBandwidth) {
+  BbrEstimator est;
+  est.AddSample(1000000, 0.1, 1000000, At(1000));
+  EXPECT_DOUBLE_EQ(est.bandwidth(), 1e7);
+  // Far less than the window: the peer had little to send.
+  est.AddSample(1000, 0.1, 1000000, At(1100));
+  EXPECT_DOUBLE_EQ(est.bandwidth(), 1e7);
+  est.AddSample(400000, 0.02, 1000000, At(1200));
+  EXPECT_DOUBLE_EQ(est.bandwidth(), 2e7);
+}
+
+TEST(BbrEstimatorTest, MinRttExpires) {
+  BbrEstimator est;
+  est.AddSample(100000, 0.05, 100000, At(1000));
+  est.AddSample(100000, 0.1, 100000, At(2000));
+  EXPECT_DOUBLE_EQ(est.min_rtt(), 0.05);
+  est.AddSample(100000, 0.1, 100000, At(20000));
+  EXPECT_DOUBLE_EQ(est.min_rtt(), 0.1);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,138 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/chttp2/transport/decode_huff.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/transport/chttp2/transport/huffsyms.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+std::vector<uint8_t> Decode(const std::vector<uint8_t>& in) {
+  std::vector<uint8_t> out;
+  HuffDecoder::Decode(in.data(), in.data() + in.size(),
+                      [&out](uint8_t c) { out.push_back(c); });
+  EXPECT_LE(out.size(), HuffDecoder::MaxDecodedLength(in.size()));
+  return out;
+}
+
+// Bit at a time reference decoder with the same leniency as HuffDecoder:
+// EOS is skipped and an incomplete trailing code is dropped.
+std::vector<uint8_t> ReferenceDecode(const std::vector<uint8_t>& in) {
+  std::vector<uint8_t> out;
+  uint32_t code = 0;
+  unsigned length = 0;
+  for (size_t i = 0; i < in.size() * 8; i++) {
+    code = (code << 1) | ((in[i / 8] >> (7 - i % 8)) & 1);
+    length++;
+    for (int sym = 0; sym < GRPC_CHTTP2_NUM_HUFFSYMS; sym++) {
+      if (grpc_chttp2_huffsyms[sym].length == length &&
+          grpc_chttp2_huffsyms[sym].bits == code) {
+        if (sym < 256) out.push_back(static_cast<uint8_t>(sym));
+        code = 0;
+        length = 0;
+        break;
+      }
+    }
+  }
+  return out;
+}
+
+std::vector<uint8_t> Compress(const std::vector<uint8_t>& in) {
+  std::vector<uint8_t> out;
+  uint64_t bits = 0;
+  unsigned length = 0;
+  for (uint8_t c : in) {
+    const grpc_chttp2_huffsym& sym = grpc_chttp2_huffsyms[c];
+    bits = (bits << sym.length) | sym.bits;
+    length += sym.length;
+    while (length >= 8) {
+      length -= 8;
+      out.push_back(static_cast<uint8_t>(bits >> length));
+    }
+  }
+  // Pad with the most significant bits of EOS.
+  if (length > 0) {
+    out.push_back(static_cast<uint8_t>((bits << (8 - length)) |
+                                       (0xff >> length)));
+  }
+  return out;
+}
+
+TEST(DecodeHuffTest, Empty) { EXPECT_TRUE(Decode({}).empty()); }
+
+TEST(DecodeHuffTest, Rfc7541Examples) {
+  // C.4.1: "www.example.com"
+  std::vector<uint8_t> www = {0xf1, 0xe3, 0xc2, 0xe5, 0xf2, 0x3a,
+                              0x6b, 0xa0, 0xab, 0x90, 0xf4, 0xff};
+  std::string expect = "www.example.com";
+  EXPECT_EQ(Decode(www), std::vector<uint8_t>(expect.begin(), expect.end()));
+  // C.4.2: "no-cache"
+  std::vector<uint8_t> no_cache = {0xa8, 0xeb, 0x10, 0x64, 0x9c, 0xbf};
+  expect = "no-cache";
+  EXPECT_EQ(Decode(no_cache),
+            std::vector<uint8_t>(expect.begin(), expect.end()));
+}
+
+TEST(DecodeHuffTest, RoundTripsEveryByte) {
+  std::vector<uint8_t> in;
+  for (int i = 0; i < 256; i++) in.push_back(static_cast<uint8_t>(i));
+  EXPECT_EQ(Decode(Compress(in)), in);
+}
+
+TEST(DecodeHuffTest, RoundTripsRandomStrings) {
+  std::mt19937 rng(42);
+  for (int i = 0; i < 1000; i++) {
+    std::vector<uint8_t> in(rng() % 200);
+    const bool printable = i % 2 == 0;
+    for (auto& c : in) {
+      c = printable ? static_cast<uint8_t>(' ' + rng() % 95)
+                    : static_cast<uint8_t>(rng());
+    }
+    EXPECT_EQ(Decode(Compress(in)), in);
+  }
+}
+
+TEST(DecodeHuffTest, MatchesReferenceOnArbitraryInput) {
+  std::mt19937 rng(1234);
+  for (int i = 0; i < 1000; i++) {
+    std::vector<uint8_t> in(rng() % 64);
+    for (auto& c : in) {
+      // Bias towards set bits so long codes and EOS show up.
+      c = static_cast<uint8_t>(i % 3 == 0 ? rng() | rng() : rng());
+    }
+    EXPECT_EQ(Decode(in), ReferenceDecode(in));
+  }
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int r = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return r;
+}
@@ -0,0 +1,338 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares the window sizing policies of chttp2 flow control on an emulated
+// link, with a fake clock so that the results are deterministic.
+//
+// A bulk sender streams to a receiver over a link with a bottleneck
+// bandwidth, a one-way propagation delay, and an unbounded queue in front of
+// the bottleneck. The sender may have at most one receive window of bytes
+// unacknowledged; the receiver consumes data as soon as it arrives and returns
+// the credit (WINDOW_UPDATE) after the propagation delay. BDP pings go from the
+// receiver to the sender, and their ACKs queue behind data at the bottleneck,
+// as they do on a real connection.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "absl/memory/memory.h"
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/chttp2/transport/flow_control.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/transport/bdp_estimator.h"
+#include "test/core/util/test_config.h"
+
+extern gpr_timespec (*gpr_now_impl)(gpr_clock_type clock_type);
+
+namespace grpc_core {
+namespace chttp2 {
+namespace testing {
+namespace {
+
+int64_t g_now_micros = 1000 * GPR_US_PER_SEC;
+
+gpr_timespec fake_gpr_now(gpr_clock_type clock_type) {
+  gpr_timespec ts;
+  ts.tv_sec = g_now_micros / GPR_US_PER_SEC;
+  ts.tv_nsec = static_cast<int32_t>((g_now_micros % GPR_US_PER_SEC) *
+                                    GPR_NS_PER_US);
+  ts.clock_type = clock_type;
+  return ts;
+}
+
+struct Link {
+  // Bottleneck bandwidth, in bytes per second.
+  double bandwidth;
+  int64_t one_way_delay_micros;
+
+  double Bdp() const {
+    return bandwidth * 2 * one_way_delay_micros / GPR_US_PER_SEC;
+  }
+};
+
+struct Result {
+  // When the delivery rate first reached 90% of the bottleneck bandwidth.
+  double seconds_to_converge = -1;
+  // Largest receive window the policy asked for: the memory the receiver
+  // committed to buffering.
+  double peak_window = 0;
+  // Average delivery rate over the last second, in bytes per second.
+  double final_throughput = 0;
+};
+
+enum class Policy { kPid, kBbr };
+
+const char* PolicyName(Policy policy) {
+  return policy == Policy::kPid ? "pid" : "bbr";
+}
+
+constexpr int64_t kTickMicros = 100;
+// Delivery rate is measured over bins of this length.
+constexpr int64_t kBinMicros = 50 * 1000;
+
+class Simulation {
+ public:
+  Simulation(const Link& link, Policy policy, double memory_pressure)
+      : link_(link), memory_pressure_(memory_pressure), bdp_("sim") {
+    switch (policy) {
+      case Policy::kPid:
+        policy_ = absl::make_unique<PidWindowSizingPolicy>(
+            &bdp_, memory_pressure_, ExecCtx::Get()->Now());
+        break;
+      case Policy::kBbr:
+        policy_ = absl::make_unique<BbrWindowSizingPolicy>(&bdp_);
+        break;
+    }
+    // As chttp2 does when the transport is created.
+    SetWindow(policy_->Update(memory_pressure_, ExecCtx::Get()->Now()));
+    sender_window_ = window_;
+  }
+
+  Result Run(double seconds) {
+    Result result;
+    const int64_t start = g_now_micros;
+    const int64_t end =
+        start + static_cast<int64_t>(seconds * GPR_US_PER_SEC);
+    int64_t bin_start = g_now_micros;
+    int64_t bin_bytes = 0;
+    int64_t last_second_bytes = 0;
+    while (g_now_micros < end) {
+      g_now_micros += kTickMicros;
+      ExecCtx::Get()->InvalidateNow();
+      int64_t delivered = Tick();
+      bin_bytes += delivered;
+      if (end - g_now_micros < GPR_US_PER_SEC) last_second_bytes += delivered;
+      if (g_now_micros - bin_start >= kBinMicros) {
+        double rate = static_cast<double>(bin_bytes) * GPR_US_PER_SEC /
+                      (g_now_micros - bin_start);
+        if (result.seconds_to_converge < 0 && rate >= 0.9 * link_.bandwidth) {
+          result.seconds_to_converge =
+              static_cast<double>(g_now_micros - start) / GPR_US_PER_SEC;
+        }
+        bin_start = g_now_micros;
+        bin_bytes = 0;
+      }
+    }
+    result.peak_window = peak_window_;
+    result.final_throughput = static_cast<double>(last_second_bytes);
+    return result;
+  }
+
+ private:
+  struct Packet {
+    int64_t bytes;
+    bool ping_ack;
+  };
+  struct InFlight {
+    int64_t arrival_micros;
+    Packet packet;
+  };
+  enum class Signal { kCredit, kPing, kWindow };
+  struct Reverse {
+    int64_t arrival_micros;
+    Signal signal;
+    int64_t value;
+  };
+
+  void SetWindow(double target) {
+    window_ = static_cast<int64_t>(
+        Clamp(target, double(kMinInitialWindowSize),
+              double(kMaxInitialWindowSize)));
+    peak_window_ = std::max(peak_window_, static_cast<double>(window_));
+  }
+
+  // Advances the link by one tick. Returns the bytes delivered to the
+  // receiver.
+  int64_t Tick() {
+    // Signals from the receiver reach the sender.
+    while (!reverse_.empty() &&
+           reverse_.front().arrival_micros <= g_now_micros) {
+      const Reverse& r = reverse_.front();
+      switch (r.signal) {
+        case Signal::kCredit:
+          unacked_ -= r.value;
+          break;
+        case Signal::kPing:
+          bottleneck_.push_back({0, true});
+          break;
+        case Signal::kWindow:
+          sender_window_ = r.value;
+          break;
+      }
+      reverse_.pop_front();
+    }
+    // The sender fills the window.
+    if (unacked_ < sender_window_) {
+      bottleneck_.push_back({sender_window_ - unacked_, false});
+      unacked_ = sender_window_;
+    }
+    // The bottleneck serves its queue.
+    double budget = link_.bandwidth * kTickMicros / GPR_US_PER_SEC + carry_;
+    while (!bottleneck_.empty()) {
+      Packet& p = bottleneck_.front();
+      if (p.ping_ack) {
+        forward_.push_back(
+            {g_now_micros + link_.one_way_delay_micros, {0, true}});
+        bottleneck_.pop_front();
+        continue;
+      }
+      int64_t n = std::min(p.bytes, static_cast<int64_t>(budget));
+      if (n == 0) break;
+      budget -= n;
+      forward_.push_back(
+          {g_now_micros + link_.one_way_delay_micros, {n, false}});
+      p.bytes -= n;
+      if (p.bytes > 0) break;
+      bottleneck_.pop_front();
+    }
+    carry_ = bottleneck_.empty() ? 0 : budget;
+    // The receiver gets data and ping ACKs.
+    int64_t delivered = 0;
+    while (!forward_.empty() &&
+           forward_.front().arrival_micros <= g_now_micros) {
+      const Packet p = forward_.front().packet;
+      forward_.pop_front();
+      if (p.ping_ack) {
+        CompletePing();
+        continue;
+      }
+      delivered += p.bytes;
+      bdp_.AddIncomingBytes(p.bytes);
+      reverse_.push_back({g_now_micros + link_.one_way_delay_micros,
+                          Signal::kCredit, p.bytes});
+    }
+    if (!ping_outstanding_ && ExecCtx::Get()->Now() >= next_ping_ &&
+        bdp_.accumulator() > 0) {
+      bdp_.SchedulePing();
+      bdp_.StartPing();
+      ping_outstanding_ = true;
+      reverse_.push_back(
+          {g_now_micros + link_.one_way_delay_micros, Signal::kPing, 0});
+    }
+    return delivered;
+  }
+
+  void CompletePing() {
+    ping_outstanding_ = false;
+    next_ping_ = bdp_.CompletePing();
+    SetWindow(policy_->Update(memory_pressure_, ExecCtx::Get()->Now()));
+    reverse_.push_back({g_now_micros + link_.one_way_delay_micros,
+                        Signal::kWindow, window_});
+  }
+
+  const Link link_;
+  const double memory_pressure_;
+  BdpEstimator bdp_;
+  std::unique_ptr<WindowSizingPolicy> policy_;
+  // Receive window the receiver has advertised, and the largest so far.
+  int64_t window_ = 0;
+  double peak_window_ = 0;
+  // Receive window as the sender knows it, and what it has outstanding.
+  int64_t sender_window_ = 0;
+  int64_t unacked_ = 0;
+  std::deque<Packet> bottleneck_;
+  // Bytes the bottleneck could have sent in the last tick but did not, because
+  // they arrived in the middle of it.
+  double carry_ = 0;
+  std::deque<InFlight> forward_;
+  std::deque<Reverse> reverse_;
+  bool ping_outstanding_ = false;
+  Timestamp next_ping_;
+};
+
+Result Simulate(const Link& link, Policy policy, double seconds,
+                double memory_pressure = 0) {
+  ExecCtx exec_ctx;
+  Result result = Simulation(link, policy, memory_pressure).Run(seconds);
+  gpr_log(GPR_INFO,
+          "%s: bw=%.0fMB/s rtt=%.0fms bdp=%.0fKB pressure=%.2f: converged "
+          "in %.2fs, peak window %.0fKB, final throughput %.1fMB/s",
+          PolicyName(policy), link.bandwidth / 1e6,
+          2.0 * link.one_way_delay_micros / 1000, link.Bdp() / 1024,
+          memory_pressure, result.seconds_to_converge,
+          result.peak_window / 1024, result.final_throughput / 1e6);
+  return result;
+}
+
+// A cross-region link with a BDP over the largest window the PID policy
+// will ever ask for (2^25 bytes).
+TEST(FlowControlSimulationTest, BbrFillsHighBdpLink) {
+  const Link link{1e9, 50000};
+  Result pid = Simulate(link, Policy::kPid, 10);
+  Result bbr = Simulate(link, Policy::kBbr, 10);
+  EXPECT_GT(bbr.seconds_to_converge, 0);
+  EXPECT_LT(bbr.seconds_to_converge, 5);
+  EXPECT_GE(bbr.final_throughput, 0.9 * link.bandwidth);
+  EXPECT_LT(pid.final_throughput, 0.5 * link.bandwidth);
+  // Startup overshoots by its gain, no more.
+  EXPECT_LE(bbr.peak_window, 2.05 * link.Bdp());
+}
+
+TEST(FlowControlSimulationTest, BbrWindowStaysNearBdp) {
+  const Link link{100e6, 50000};
+  Result pid = Simulate(link, Policy::kPid, 20);
+  Result bbr = Simulate(link, Policy::kBbr, 20);
+  EXPECT_GT(pid.seconds_to_converge, 0);
+  EXPECT_GT(bbr.seconds_to_converge, 0);
+  EXPECT_LT(bbr.seconds_to_converge, 2);
+  EXPECT_GE(bbr.final_throughput, 0.95 * link.bandwidth);
+  EXPECT_LE(bbr.peak_window, 2.05 * link.Bdp());
+  EXPECT_LT(bbr.peak_window, pid.peak_window);
+}
+
+// Long enough for min_rtt to expire a few times: the queue the window builds
+// must not ratchet the window up.
+TEST(FlowControlSimulationTest, BbrDoesNotOvercommitOnLowBdpLink) {
+  const Link link{10e6, 1000};
+  Result pid = Simulate(link, Policy::kPid, 60);
+  Result bbr = Simulate(link, Policy::kBbr, 60);
+  EXPECT_GE(pid.final_throughput, 0.95 * link.bandwidth);
+  EXPECT_GE(bbr.final_throughput, 0.95 * link.bandwidth);
+  EXPECT_LE(bbr.peak_window, 2 * BbrEstimator::kInitialWindow);
+  EXPECT_LT(10 * bbr.peak_window, pid.peak_window);
+}
+
+TEST(FlowControlSimulationTest, BbrShrinksUnderMemoryPressure) {
+  const Link link{10e6, 1000};
+  Result low = Simulate(link, Policy::kBbr, 5, 0.0);
+  Result high = Simulate(link, Policy::kBbr, 5, 0.85);
+  Result max = Simulate(link, Policy::kBbr, 5, 0.95);
+  EXPECT_LE(high.peak_window, 0.5 * low.peak_window);
+  EXPECT_LE(max.peak_window, kMinInitialWindowSize);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace chttp2
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  gpr_now_impl = grpc_core::chttp2::testing::fake_gpr_now;
+  grpc_init();
+  ::testing::InitGoogleTest(&argc, argv);
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
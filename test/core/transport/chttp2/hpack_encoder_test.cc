@@ -210,10 +210,29 @@ static void test_basic_headers() {
       false,
   };
   verify(params, "000005 0104 deadbeef 00 0161 0161", 1, "a", "a");
-  verify(params, "00000a 0104 deadbeef 00 0161 0161 00 0162 0163", 2, "a", "a",
+  verify(params, "00000a 0104 deadbeef 40 0161 0161 00 0162 0163", 2, "a", "a",
          "b", "c");
 }
 
+static void test_repeated_custom_headers() {
+  verify_params params = {
+      false,
+      false,
+  };
+  // Custom metadata is sent as a literal until it is seen repeating...
+  verify(params, "000005 0104 deadbeef 00 0161 0161", 1, "a", "a");
+  // ... is then added to the dynamic table...
+  verify(params, "000005 0104 deadbeef 40 0161 0161", 1, "a", "a");
+  // ... and sent as an index from there on.
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  verify(params, "000001 0104 deadbeef be", 1, "a", "a");
+  // Values that do not repeat never make it into the table.
+  verify(params, "000005 0104 deadbeef 00 0161 0162", 1, "a", "b");
+  verify(params, "000005 0104 deadbeef 00 0161 0163", 1, "a", "c");
+  verify(params, "000006 0104 deadbeef be 00 0161 0164", 2, "a", "a", "a",
+         "d");
+}
+
 static void verify_continuation_headers(const char* key, const char* value,
                                         bool is_eof) {
   auto arena = grpc_core::MakeScopedArena(1024, g_memory_allocator);
@@ -260,6 +279,7 @@ int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   grpc_init();
   TEST(test_basic_headers);
+  TEST(test_repeated_custom_headers);
   TEST(test_continuation_headers);
   grpc_shutdown();
   return g_failure;
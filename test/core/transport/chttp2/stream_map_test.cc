@@ -18,6 +18,10 @@
 
 #include "src/core/ext/transport/chttp2/transport/stream_map.h"
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include <grpc/support/log.h>
 
 #include "test/core/util/test_config.h"
@@ -73,7 +77,10 @@ static void test_basic_add_find(uint32_t n) {
 static void verify_for_each(void* user_data, uint32_t stream_id, void* ptr) {
   uint32_t* for_each_check = static_cast<uint32_t*>(user_data);
   GPR_ASSERT(ptr);
-  GPR_ASSERT(*for_each_check == stream_id);
+  /* streams are visited in no particular order: check that each is one of
+     the survivors, and count them */
+  GPR_ASSERT(reinterpret_cast<uintptr_t>(ptr) == stream_id);
+  GPR_ASSERT(stream_id & 1);
   *for_each_check += 2;
 }
 
@@ -167,6 +174,45 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+/* add a bunch of keys, delete them in a random order, and check that the
+   remaining keys are still found after every delete */
+static void test_random_deletes(uint32_t n) {
+  grpc_chttp2_stream_map map;
+  std::vector<uint32_t> keys;
+  uint32_t i;
+  size_t j;
+
+  LOG_TEST("test_random_deletes");
+  gpr_log(GPR_INFO, "n = %d", n);
+
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (i = 1; i <= n; i++) {
+    grpc_chttp2_stream_map_add(&map, 2 * i + 1,
+                               reinterpret_cast<void*>(2 * i + 1));
+    keys.push_back(2 * i + 1);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(n));
+  for (j = 0; j < keys.size(); j++) {
+    GPR_ASSERT((void*)(uintptr_t)keys[j] ==
+               grpc_chttp2_stream_map_delete(&map, keys[j]));
+    GPR_ASSERT(nullptr == grpc_chttp2_stream_map_find(&map, keys[j]));
+    /* spot check the survivors; checking all of them is quadratic */
+    if (j + 1 < keys.size()) {
+      size_t k = j + 1 + (j * 7919) % (keys.size() - j - 1);
+      GPR_ASSERT((void*)(uintptr_t)keys[k] ==
+                 grpc_chttp2_stream_map_find(&map, keys[k]));
+    }
+    if (j == keys.size() / 2) {
+      for (size_t k = j + 1; k < keys.size(); k++) {
+        GPR_ASSERT((void*)(uintptr_t)keys[k] ==
+                   grpc_chttp2_stream_map_find(&map, keys[k]));
+      }
+    }
+  }
+  GPR_ASSERT(0 == grpc_chttp2_stream_map_size(&map));
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 int main(int argc, char** argv) {
   uint32_t n = 1;
   uint32_t prev = 1;
@@ -182,6 +228,7 @@ int main(int argc, char** argv) {
     test_delete_evens_sweep(n);
     test_delete_evens_incremental(n);
     test_periodic_compaction(n);
+    test_random_deletes(n);
 
     tmp = n;
     n += prev;
@@ -0,0 +1,126 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/ext/transport/shm/shm_ring.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/support/log.h>
+
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+constexpr size_t kCapacity = 4096;
+
+class ShmRingTest : public ::testing::Test {
+ protected:
+  ShmRingTest()
+      : region_(mmap(nullptr, ShmRing::RegionSize(kCapacity),
+                     PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1,
+                     0)) {
+    GPR_ASSERT(region_ != MAP_FAILED);
+    ShmRing::Init(region_, kCapacity);
+  }
+  ~ShmRingTest() override { munmap(region_, ShmRing::RegionSize(kCapacity)); }
+
+  // Both ends of the ring use the same mapping, as two processes would.
+  void* const region_;
+};
+
+std::vector<uint8_t> Pattern(size_t len, uint8_t seed) {
+  std::vector<uint8_t> data(len);
+  for (size_t i = 0; i < len; ++i) data[i] = static_cast<uint8_t>(seed + i);
+  return data;
+}
+
+TEST_F(ShmRingTest, PassesBytesAcrossTheWrapAround) {
+  ShmRing producer(region_, kCapacity);
+  ShmRing consumer(region_, kCapacity);
+  for (int round = 0; round < 10; ++round) {
+    auto in = Pattern(kCapacity * 3 / 4, static_cast<uint8_t>(round));
+    ASSERT_EQ(producer.Write(in.data(), in.size()),
+              static_cast<int64_t>(in.size()));
+    ASSERT_EQ(consumer.Readable(), static_cast<int64_t>(in.size()));
+    std::vector<uint8_t> out(in.size());
+    ASSERT_EQ(consumer.Read(out.data(), out.size()),
+              static_cast<int64_t>(out.size()));
+    EXPECT_EQ(in, out);
+  }
+  EXPECT_EQ(consumer.Readable(), 0);
+}
+
+TEST_F(ShmRingTest, WritesStopWhenFull) {
+  ShmRing producer(region_, kCapacity);
+  ShmRing consumer(region_, kCapacity);
+  auto in = Pattern(kCapacity + 100, 7);
+  EXPECT_EQ(producer.Write(in.data(), in.size()),
+            static_cast<int64_t>(kCapacity));
+  EXPECT_EQ(producer.Write(in.data(), in.size()), 0);
+  std::vector<uint8_t> out(10);
+  EXPECT_EQ(consumer.Read(out.data(), out.size()), 10);
+  EXPECT_EQ(producer.Write(in.data() + kCapacity, 100), 10);
+}
+
+TEST_F(ShmRingTest, WaitersAreOnlyReportedOnce) {
+  ShmRing producer(region_, kCapacity);
+  ShmRing consumer(region_, kCapacity);
+  // Nothing to read: the consumer has to wait, and the next write wakes it.
+  EXPECT_TRUE(consumer.WaitForData());
+  uint8_t byte = 1;
+  EXPECT_EQ(producer.Write(&byte, 1), 1);
+  EXPECT_TRUE(producer.TakeConsumerWaiting());
+  EXPECT_FALSE(producer.TakeConsumerWaiting());
+  // There is data now, so waiting for more is pointless.
+  EXPECT_FALSE(consumer.WaitForData());
+  // Same for a producer facing a full ring.
+  auto in = Pattern(kCapacity, 3);
+  EXPECT_EQ(producer.Write(in.data(), in.size()),
+            static_cast<int64_t>(kCapacity - 1));
+  EXPECT_TRUE(producer.WaitForSpace());
+  EXPECT_EQ(consumer.Read(&byte, 1), 1);
+  EXPECT_TRUE(consumer.TakeProducerWaiting());
+  EXPECT_FALSE(consumer.TakeProducerWaiting());
+  EXPECT_FALSE(producer.WaitForSpace());
+}
+
+TEST_F(ShmRingTest, CorruptIndicesAreRejected) {
+  ShmRing producer(region_, kCapacity);
+  ShmRing consumer(region_, kCapacity);
+  // A misbehaving peer claims to have written more than the ring holds.
+  uint64_t head = kCapacity * 2;
+  memcpy(region_, &head, sizeof(head));
+  uint8_t buf[16];
+  EXPECT_EQ(consumer.Readable(), -1);
+  EXPECT_EQ(consumer.Read(buf, sizeof(buf)), -1);
+  EXPECT_EQ(producer.Write(buf, sizeof(buf)), -1);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -45,6 +45,7 @@
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/profiling/timers.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/surface/call.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/transport/transport_impl.h"
 #include "src/cpp/client/create_channel_internal.h"
@@ -134,6 +135,40 @@ static void BM_CallCreateDestroy(benchmark::State& state) {
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, InsecureChannel);
 BENCHMARK_TEMPLATE(BM_CallCreateDestroy, LameChannel);
 
+// Calls to two methods on one channel, one of which needs a lot more arena
+// memory than the other: state.range(0) small calls are made for every large
+// one. Arenas sized for the channel as a whole either waste memory on the
+// small calls or make the large ones spill into extra zones.
+template <class Fixture>
+static void BM_CallCreateDestroyMixedSizes(benchmark::State& state) {
+  TrackCounters track_counters;
+  Fixture fixture;
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  void* small_hdl = grpc_channel_register_call(
+      fixture.channel(), "/foo/small", nullptr, nullptr);
+  void* large_hdl = grpc_channel_register_call(
+      fixture.channel(), "/foo/large", nullptr, nullptr);
+  const int64_t small_per_large = state.range(0);
+  int64_t n = 0;
+  for (auto _ : state) {
+    const bool large = n++ % (small_per_large + 1) == 0;
+    grpc_call* call = grpc_channel_create_registered_call(
+        fixture.channel(), nullptr, GRPC_PROPAGATE_DEFAULTS, cq,
+        large ? large_hdl : small_hdl, deadline, nullptr);
+    if (large) grpc_call_arena_alloc(call, 16 * 1024);
+    grpc_call_unref(call);
+  }
+  grpc_completion_queue_destroy(cq);
+  track_counters.Finish(state);
+}
+
+BENCHMARK_TEMPLATE(BM_CallCreateDestroyMixedSizes, LameChannel)
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(1024);
+
 ////////////////////////////////////////////////////////////////////////////////
 // Benchmarks isolating individual filters
 
@@ -22,13 +22,19 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
+#include <utility>
 
 #include <benchmark/benchmark.h>
 
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+
 #include <grpc/slice.h>
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/ext/transport/chttp2/transport/bin_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_encoder.h"
 #include "src/core/ext/transport/chttp2/transport/hpack_parser.h"
 #include "src/core/lib/gprpp/time.h"
@@ -639,6 +645,123 @@ class SameDeadline {
   }
 };
 
+// Literal headers with new names that are not added to the table, and
+// huffman coded values (base64 + huffman for binary headers). This is how
+// per-call credentials and tracing context typically arrive: they change on
+// every request, so the dynamic table does not help and parsing is dominated
+// by huffman decoding.
+class HuffmanLiteralHeaders {
+ protected:
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  static std::vector<grpc_slice> Encode(const Headers& headers) {
+    std::vector<uint8_t> out;
+    for (const auto& header : headers) {
+      out.push_back(0x00);
+      AppendLength(&out, 0x00, header.first.size());
+      out.insert(out.end(), header.first.begin(), header.first.end());
+      grpc_slice value = grpc_slice_from_copied_buffer(header.second.data(),
+                                                       header.second.size());
+      grpc_slice coded =
+          absl::EndsWith(header.first, "-bin")
+              ? grpc_chttp2_base64_encode_and_huffman_compress(value)
+              : grpc_chttp2_huffman_compress(value);
+      AppendLength(&out, 0x80, GRPC_SLICE_LENGTH(coded));
+      out.insert(out.end(), GRPC_SLICE_START_PTR(coded),
+                 GRPC_SLICE_END_PTR(coded));
+      grpc_slice_unref(value);
+      grpc_slice_unref(coded);
+    }
+    return {MakeSlice(out)};
+  }
+
+  // A printable pseudo-random string drawn from the base64url alphabet, as
+  // found in bearer tokens.
+  static std::string Token(size_t length, uint32_t seed) {
+    static const char kAlphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string out;
+    for (size_t i = 0; i < length; i++) {
+      seed = seed * 1103515245 + 12345;
+      out.push_back(kAlphabet[(seed >> 16) % 64]);
+    }
+    return out;
+  }
+
+ private:
+  // Encode a string length as an HPACK integer with a 7 bit prefix.
+  static void AppendLength(std::vector<uint8_t>* out, uint8_t flags,
+                           size_t length) {
+    if (length < 0x7f) {
+      out->push_back(flags | static_cast<uint8_t>(length));
+      return;
+    }
+    out->push_back(flags | 0x7f);
+    length -= 0x7f;
+    while (length >= 0x80) {
+      out->push_back(static_cast<uint8_t>(0x80 | (length & 0x7f)));
+      length >>= 7;
+    }
+    out->push_back(static_cast<uint8_t>(length));
+  }
+};
+
+// A JWT bearer token, as sent by OAuth/OIDC call credentials.
+class AuthorizationBearerToken : public HuffmanLiteralHeaders {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    return Encode({{"authorization",
+                    absl::StrCat("Bearer eyJhbGciOiJSUzI1NiIsInR5cCI6IkpXVCJ9.",
+                                 Token(420, 1), ".", Token(342, 2))}});
+  }
+};
+
+// W3C trace context, OpenCensus binary context and a cloud trace header.
+class TracingHeaders : public HuffmanLiteralHeaders {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    return Encode(Tracing());
+  }
+
+ protected:
+  static Headers Tracing() {
+    return {
+        {"traceparent",
+         "00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"},
+        {"tracestate", "rojo=00f067aa0ba902b7,congo=t61rcWkgMzE"},
+        {"grpc-trace-bin",
+         std::string("\x00\x00\x0a\xf7\x65\x19\x16\xcd\x43\xdd\x84\x48"
+                     "\xeb\x21\x1c\x80\x31\x9c\x01\xb7\xad\x6b\x71\x69"
+                     "\x20\x33\x31\x02\x01",
+                     29)},
+        {"x-cloud-trace-context", "105445aa7843bc8bf206b12000100000/1;o=1"},
+    };
+  }
+};
+
+// Everything a typical authenticated, traced request from a cloud client
+// library carries besides the pseudo headers.
+class MetadataHeavyRequest : public TracingHeaders {
+ public:
+  static std::vector<grpc_slice> GetInitSlices() { return {}; }
+  static std::vector<grpc_slice> GetBenchmarkSlices() {
+    Headers headers = Tracing();
+    headers.insert(
+        headers.end(),
+        {{"authorization",
+          absl::StrCat("Bearer ya29.", Token(180, 3))},
+         {"x-goog-api-client", "gl-java/11.0.14 gapic/2.8.1 gax/2.12.2 "
+                               "grpc/1.44.1"},
+         {"x-goog-request-params",
+          "name=projects%2Fmy-project%2Flocations%2Fus-central1%2Fqueues%2Fq"},
+         {"x-request-id", "f058ebd6-02f7-4d3f-942e-904344e8cde5"},
+         {"user-agent", "grpc-java-netty/1.44.1"}});
+    return Encode(headers);
+  }
+};
+
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, EmptyBatch);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, IndexedSingleStaticElem);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, AddIndexedSingleStaticElem);
@@ -672,6 +795,9 @@ BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader,
                    RepresentativeServerInitialMetadata);
 BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, SameDeadline);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, AuthorizationBearerToken);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, TracingHeaders);
+BENCHMARK_TEMPLATE(BM_HpackParserParseHeader, MetadataHeavyRequest);
 
 }  // namespace hpack_parser_fixtures
 
@@ -0,0 +1,133 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark the chttp2 stream map with the access patterns a connection sees
+// as the number of concurrent streams grows.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/ext/transport/chttp2/transport/stream_map.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+// Client initiated stream ids are odd and increase monotonically.
+uint32_t StreamId(uint32_t n) { return 2 * n + 1; }
+
+void* StreamValue(uint32_t n) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(StreamId(n)));
+}
+
+// Look up streams while state.range(0) streams are open: this is what every
+// incoming frame does.
+void BM_StreamMapFind(benchmark::State& state) {
+  const uint32_t streams = static_cast<uint32_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (uint32_t i = 0; i < streams; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), StreamValue(i));
+  }
+  uint32_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grpc_chttp2_stream_map_find(&map, StreamId(next)));
+    // Stride through the open streams rather than hitting the same one.
+    next += 7919;
+    if (next >= streams) next %= streams;
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapFind)->RangeMultiplier(10)->Range(10, 100000);
+
+// Steady state with state.range(0) streams open: each iteration opens a new
+// stream, looks up a live one and closes one. Streams finish in a strided
+// order rather than oldest first, so deletes land all over the map.
+void BM_StreamMapChurn(benchmark::State& state) {
+  const uint32_t streams = static_cast<uint32_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  // open[] holds the index of each live stream; closing open[victim] and
+  // replacing it with the new stream keeps exactly `streams` alive.
+  std::vector<uint32_t> open(streams);
+  uint32_t next_id = 0;
+  for (uint32_t i = 0; i < streams; i++) {
+    open[i] = next_id;
+    grpc_chttp2_stream_map_add(&map, StreamId(next_id), StreamValue(next_id));
+    next_id++;
+  }
+  uint32_t victim = 0;
+  for (auto _ : state) {
+    victim = (victim + 7919) % streams;
+    benchmark::DoNotOptimize(
+        grpc_chttp2_stream_map_find(&map, StreamId(open[victim])));
+    grpc_chttp2_stream_map_delete(&map, StreamId(open[victim]));
+    open[victim] = next_id;
+    grpc_chttp2_stream_map_add(&map, StreamId(next_id), StreamValue(next_id));
+    // Stream ids are 31 bits and may not be reused on a connection.
+    if (++next_id == 0x3fffffff) {
+      state.SkipWithError("stream ids exhausted");
+      break;
+    }
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StreamMapChurn)->RangeMultiplier(10)->Range(10, 100000);
+
+// Walk every open stream, as happens when a connection is torn down or its
+// settings change.
+void BM_StreamMapForEach(benchmark::State& state) {
+  const uint32_t streams = static_cast<uint32_t>(state.range(0));
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (uint32_t i = 0; i < streams; i++) {
+    grpc_chttp2_stream_map_add(&map, StreamId(i), StreamValue(i));
+  }
+  for (auto _ : state) {
+    size_t visited = 0;
+    grpc_chttp2_stream_map_for_each(
+        &map,
+        [](void* user_data, uint32_t /*key*/, void* /*value*/) {
+          ++*static_cast<size_t*>(user_data);
+        },
+        &visited);
+    benchmark::DoNotOptimize(visited);
+  }
+  grpc_chttp2_stream_map_destroy(&map);
+  state.SetItemsProcessed(state.iterations() * streams);
+}
+BENCHMARK(BM_StreamMapForEach)->RangeMultiplier(10)->Range(10, 100000);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,169 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark building and picking from the tables of the ring_hash and
+// maglev policies as the number of endpoints grows: how long a build takes
+// when an update arrives, how much memory the table holds, and what a pick
+// costs.
+
+#include <stdint.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/lb_policy/ring_hash/consistent_hash.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+constexpr size_t kMaxRingSize = 8388608;
+
+std::vector<ConsistentHashTable::Endpoint> Endpoints(size_t n,
+                                                     size_t first = 0) {
+  std::vector<ConsistentHashTable::Endpoint> endpoints;
+  endpoints.reserve(n);
+  for (size_t i = first; i < first + n; ++i) {
+    endpoints.push_back({absl::StrCat("10.", i / 65536, ".", (i / 256) % 256,
+                                      ".", i % 256, ":443"),
+                         1});
+  }
+  return endpoints;
+}
+
+void SetTableCounters(benchmark::State& state,
+                      const ConsistentHashTable& table) {
+  state.counters["entries"] = table.size();
+  state.counters["bytes"] = table.SizeInBytes();
+}
+
+// Hashes for the pick benchmarks, spread over the whole hash space.
+const std::vector<uint64_t>& RequestHashes() {
+  static const std::vector<uint64_t>* hashes = [] {
+    auto* hashes = new std::vector<uint64_t>(4096);
+    std::mt19937_64 rng(42);
+    for (uint64_t& hash : *hashes) hash = rng();
+    return hashes;
+  }();
+  return *hashes;
+}
+
+void PickLoop(benchmark::State& state, const ConsistentHashTable& table) {
+  const std::vector<uint64_t>& hashes = RequestHashes();
+  size_t next = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.endpoint_index(table.Pick(hashes[next])));
+    next = (next + 1) % hashes.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Arguments: number of endpoints, min_ring_size.
+void RingArgs(benchmark::internal::Benchmark* b) {
+  for (int endpoints : {10, 1000, 100000}) {
+    for (int min_ring_size : {1024, 1 << 20, 1 << 23}) {
+      b->Args({endpoints, min_ring_size});
+    }
+  }
+}
+
+// Builds a ring from scratch, as for the first update.
+void BM_HashRingBuild(benchmark::State& state) {
+  const auto endpoints = Endpoints(state.range(0));
+  for (auto _ : state) {
+    HashRing ring(endpoints, state.range(1), kMaxRingSize);
+    benchmark::DoNotOptimize(ring.size());
+    state.PauseTiming();
+    SetTableCounters(state, ring);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_HashRingBuild)->Apply(RingArgs)->Unit(benchmark::kMillisecond);
+
+// Rebuilds a ring after one endpoint was replaced by another, as for an
+// update in which one backend was moved.
+void BM_HashRingRebuildOneReplaced(benchmark::State& state) {
+  auto endpoints = Endpoints(state.range(0));
+  const HashRing previous(endpoints, state.range(1), kMaxRingSize);
+  endpoints[endpoints.size() / 2] = Endpoints(1, endpoints.size())[0];
+  for (auto _ : state) {
+    HashRing ring(endpoints, state.range(1), kMaxRingSize, &previous);
+    benchmark::DoNotOptimize(ring.size());
+  }
+}
+BENCHMARK(BM_HashRingRebuildOneReplaced)
+    ->Apply(RingArgs)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_HashRingPick(benchmark::State& state) {
+  const HashRing ring(Endpoints(state.range(0)), state.range(1),
+                      kMaxRingSize);
+  SetTableCounters(state, ring);
+  PickLoop(state, ring);
+}
+BENCHMARK(BM_HashRingPick)->Apply(RingArgs);
+
+// Arguments: number of endpoints, table size.
+void MaglevArgs(benchmark::internal::Benchmark* b) {
+  for (int endpoints : {10, 1000, 100000}) {
+    for (int table_size : {65537, 5000011}) {
+      // Every endpoint needs at least one slot.
+      if (endpoints < table_size) b->Args({endpoints, table_size});
+    }
+  }
+}
+
+void BM_MaglevBuild(benchmark::State& state) {
+  const auto endpoints = Endpoints(state.range(0));
+  for (auto _ : state) {
+    MaglevTable table(endpoints, state.range(1));
+    benchmark::DoNotOptimize(table.size());
+    state.PauseTiming();
+    SetTableCounters(state, table);
+    state.ResumeTiming();
+  }
+}
+BENCHMARK(BM_MaglevBuild)->Apply(MaglevArgs)->Unit(benchmark::kMillisecond);
+
+void BM_MaglevPick(benchmark::State& state) {
+  const MaglevTable table(Endpoints(state.range(0)), state.range(1));
+  SetTableCounters(state, table);
+  PickLoop(state, table);
+}
+BENCHMARK(BM_MaglevPick)->Apply(MaglevArgs);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
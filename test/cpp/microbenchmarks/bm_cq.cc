@@ -19,6 +19,9 @@
 /* This benchmark exists to ensure that the benchmark integration is
  * working */
 
+#include <memory>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
@@ -153,6 +156,92 @@ static void BM_EmptyCore(benchmark::State& state) {
 }
 BENCHMARK(BM_EmptyCore);
 
+// Each iteration queues state.range(0) completions and then drains them, one
+// event per call (BM_Drain*) or as many as are ready per call
+// (BM_DrainBatch*).
+static void QueueCompletions(grpc_completion_queue* cq, void* tag,
+                             std::vector<grpc_cq_completion>* completions) {
+  grpc_core::ExecCtx exec_ctx;
+  for (grpc_cq_completion& completion : *completions) {
+    GPR_ASSERT(grpc_cq_begin_op(cq, tag));
+    grpc_cq_end_op(cq, tag, GRPC_ERROR_NONE, DoneWithCompletionOnStack,
+                   nullptr, &completion);
+  }
+}
+
+static void BM_DrainCore(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  std::vector<grpc_cq_completion> completions(state.range(0));
+  for (auto _ : state) {
+    QueueCompletions(cq, nullptr, &completions);
+    for (size_t i = 0; i < completions.size(); i++) {
+      grpc_completion_queue_next(cq, deadline, nullptr);
+    }
+  }
+  grpc_completion_queue_destroy(cq);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_DrainCore)->RangeMultiplier(4)->Range(1, 256);
+
+static void BM_DrainBatchCore(benchmark::State& state) {
+  TrackCounters track_counters;
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  std::vector<grpc_cq_completion> completions(state.range(0));
+  std::vector<grpc_event> events(completions.size());
+  for (auto _ : state) {
+    QueueCompletions(cq, nullptr, &completions);
+    for (size_t n = 0; n < completions.size();) {
+      n += grpc_completion_queue_next_batch(
+          cq, events.data(), static_cast<int>(events.size()), deadline,
+          nullptr);
+    }
+  }
+  grpc_completion_queue_destroy(cq);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_DrainBatchCore)->RangeMultiplier(4)->Range(1, 256);
+
+static void BM_DrainCpp(benchmark::State& state) {
+  TrackCounters track_counters;
+  CompletionQueue cq;
+  PhonyTag phony_tag;
+  std::vector<grpc_cq_completion> completions(state.range(0));
+  for (auto _ : state) {
+    QueueCompletions(cq.cq(), &phony_tag, &completions);
+    void* tag;
+    bool ok;
+    for (size_t i = 0; i < completions.size(); i++) {
+      cq.Next(&tag, &ok);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_DrainCpp)->RangeMultiplier(4)->Range(1, 256);
+
+static void BM_DrainBatchCpp(benchmark::State& state) {
+  TrackCounters track_counters;
+  CompletionQueue cq;
+  PhonyTag phony_tag;
+  std::vector<grpc_cq_completion> completions(state.range(0));
+  std::vector<void*> tags(completions.size());
+  std::unique_ptr<bool[]> oks(new bool[completions.size()]);
+  for (auto _ : state) {
+    QueueCompletions(cq.cq(), &phony_tag, &completions);
+    for (size_t n = 0; n < completions.size();) {
+      n += cq.NextBatch(tags.data(), oks.get(), static_cast<int>(tags.size()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  track_counters.Finish(state);
+}
+BENCHMARK(BM_DrainBatchCpp)->RangeMultiplier(4)->Range(1, 256);
+
 // Helper for tests to shutdown correctly and tersely
 static void shutdown_and_destroy(grpc_completion_queue* cc) {
   grpc_completion_queue_shutdown(cc);
@@ -0,0 +1,136 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Compares callback scheduling and timer churn on the PosixEventEngine against
+// the legacy iomgr Executor and timer implementations.
+
+#include <atomic>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/lib/event_engine/posix_engine/posix_engine.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
+#include "src/core/lib/iomgr/timer.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::PosixEventEngine;
+
+// Schedules state.range(0) callbacks per iteration and waits for all of them.
+void BM_EventEngineRunFanOut(benchmark::State& state) {
+  const int fan_out = state.range(0);
+  PosixEventEngine engine;
+  for (auto _ : state) {
+    std::atomic<int> remaining{fan_out};
+    absl::Notification done;
+    for (int i = 0; i < fan_out; ++i) {
+      engine.Run([&remaining, &done]() {
+        if (remaining.fetch_sub(1) == 1) done.Notify();
+      });
+    }
+    done.WaitForNotification();
+  }
+  state.SetItemsProcessed(state.iterations() * fan_out);
+}
+BENCHMARK(BM_EventEngineRunFanOut)->Range(1, 4096);
+
+struct ExecutorFanOutArg {
+  std::atomic<int> remaining;
+  absl::Notification done;
+};
+
+void ExecutorFanOutCallback(void* arg, grpc_error_handle /*error*/) {
+  auto* fan_out = static_cast<ExecutorFanOutArg*>(arg);
+  if (fan_out->remaining.fetch_sub(1) == 1) fan_out->done.Notify();
+}
+
+void BM_ExecutorRunFanOut(benchmark::State& state) {
+  const int fan_out = state.range(0);
+  std::vector<grpc_closure> closures(fan_out);
+  for (auto _ : state) {
+    ExecutorFanOutArg arg;
+    arg.remaining.store(fan_out);
+    {
+      grpc_core::ExecCtx exec_ctx;
+      for (auto& closure : closures) {
+        GRPC_CLOSURE_INIT(&closure, ExecutorFanOutCallback, &arg, nullptr);
+        grpc_core::Executor::Run(&closure, GRPC_ERROR_NONE);
+      }
+    }
+    arg.done.WaitForNotification();
+  }
+  state.SetItemsProcessed(state.iterations() * fan_out);
+}
+BENCHMARK(BM_ExecutorRunFanOut)->Range(1, 4096);
+
+// Each deadline-bearing call arms a timer and almost always cancels it, so
+// insert+cancel is the hot path for both timer implementations.
+void BM_EventEngineRunAtCancel(benchmark::State& state) {
+  PosixEventEngine engine;
+  for (auto _ : state) {
+    EventEngine::TaskHandle handle =
+        engine.RunAt(absl::Now() + absl::Seconds(30), []() {});
+    GPR_ASSERT(engine.Cancel(handle));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventEngineRunAtCancel);
+
+void BM_IomgrTimerInitCancel(benchmark::State& state) {
+  grpc_core::ExecCtx exec_ctx;
+  grpc_timer timer;
+  grpc_closure closure;
+  GRPC_CLOSURE_INIT(
+      &closure, [](void* /*arg*/, grpc_error_handle /*error*/) {}, nullptr,
+      grpc_schedule_on_exec_ctx);
+  for (auto _ : state) {
+    grpc_timer_init(&timer,
+                    grpc_core::ExecCtx::Get()->Now() +
+                        grpc_core::Duration::Seconds(30),
+                    &closure);
+    grpc_timer_cancel(&timer);
+    grpc_core::ExecCtx::Get()->Flush();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IomgrTimerInitCancel);
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -33,6 +33,10 @@ BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, TCP)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, UDS)
     ->Range(0, 128 * 1024 * 1024);
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, Shm)
+    ->Range(0, 128 * 1024 * 1024);
+#endif
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, InProcess)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, InProcessCHTTP2)
@@ -41,16 +45,26 @@ BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, TCP)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, UDS)
     ->Range(0, 128 * 1024 * 1024);
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, Shm)
+    ->Range(0, 128 * 1024 * 1024);
+#endif
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, InProcess)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, InProcessCHTTP2)
     ->Range(0, 128 * 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinTCP)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinUDS)->Arg(0);
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinShm)->Arg(0);
+#endif
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinInProcess)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamClientToServer, MinInProcessCHTTP2)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinTCP)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinUDS)->Arg(0);
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinShm)->Arg(0);
+#endif
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcess)->Arg(0);
 BENCHMARK_TEMPLATE(BM_PumpStreamServerToClient, MinInProcessCHTTP2)->Arg(0);
 
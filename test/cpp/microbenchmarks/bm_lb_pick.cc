@@ -0,0 +1,235 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark starting calls on one client channel from many threads at once,
+// as clients that send all of their RPCs over a single channel do. Each call
+// goes through the channel's LB pick.
+
+#include <string.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/grpc.h>
+#include <grpc/grpc_security.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+// A channel to a unix socket using the given LB policy, with retries off so
+// that every call makes exactly one pick. With a server on the socket the picks
+// complete; without one the channel is in TRANSIENT_FAILURE and picks fail
+// fast without going near a transport.
+class Fixture {
+ public:
+  Fixture(bool with_server, const char* lb_policy)
+      : address_(absl::StrCat("unix:/tmp/bm_lb_pick.", getpid())) {
+    if (with_server) {
+      server_cq_ = grpc_completion_queue_create_for_next(nullptr);
+      server_ = grpc_server_create(nullptr, nullptr);
+      grpc_server_register_completion_queue(server_, server_cq_, nullptr);
+      grpc_server_credentials* server_creds =
+          grpc_insecure_server_credentials_create();
+      GPR_ASSERT(
+          grpc_server_add_http2_port(server_, address_.c_str(), server_creds));
+      grpc_server_credentials_release(server_creds);
+      grpc_server_start(server_);
+    }
+    std::string service_config = absl::StrCat(
+        "{\"loadBalancingConfig\": [{\"", lb_policy, "\": {}}]}");
+    grpc_arg args[] = {
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_ENABLE_RETRIES), 0),
+        grpc_channel_arg_string_create(
+            const_cast<char*>(GRPC_ARG_SERVICE_CONFIG),
+            const_cast<char*>(service_config.c_str())),
+    };
+    grpc_channel_args channel_args = {GPR_ARRAY_SIZE(args), args};
+    grpc_channel_credentials* creds = grpc_insecure_credentials_create();
+    channel_ = grpc_channel_create(address_.c_str(), creds, &channel_args);
+    grpc_channel_credentials_release(creds);
+    WaitForState(with_server ? GRPC_CHANNEL_READY
+                             : GRPC_CHANNEL_TRANSIENT_FAILURE);
+  }
+
+  ~Fixture() {
+    grpc_channel_destroy(channel_);
+    if (server_ != nullptr) {
+      grpc_server_shutdown_and_notify(server_, server_cq_, Tag(1));
+      grpc_server_cancel_all_calls(server_);
+      grpc_event ev;
+      do {
+        ev = grpc_completion_queue_next(
+            server_cq_, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+      } while (ev.type != GRPC_OP_COMPLETE || ev.tag != Tag(1));
+      grpc_server_destroy(server_);
+      grpc_completion_queue_shutdown(server_cq_);
+      while (grpc_completion_queue_next(server_cq_,
+                                        gpr_inf_future(GPR_CLOCK_REALTIME),
+                                        nullptr)
+                 .type != GRPC_QUEUE_SHUTDOWN) {
+      }
+      grpc_completion_queue_destroy(server_cq_);
+    }
+  }
+
+  grpc_channel* channel() const { return channel_; }
+
+ private:
+  void WaitForState(grpc_connectivity_state want) {
+    grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+    grpc_connectivity_state state;
+    while ((state = grpc_channel_check_connectivity_state(channel_, 1)) !=
+           want) {
+      grpc_channel_watch_connectivity_state(
+          channel_, state, gpr_inf_future(GPR_CLOCK_REALTIME), cq, nullptr);
+      grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                 nullptr);
+    }
+    grpc_completion_queue_shutdown(cq);
+    while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq);
+  }
+
+  std::string address_;
+  grpc_completion_queue* server_cq_ = nullptr;
+  grpc_server* server_ = nullptr;
+  grpc_channel* channel_;
+};
+
+// The threads of one benchmark run share a fixture. Thread 0 creates it
+// before the timed loop, which starts once every thread is ready; the last
+// thread to finish destroys it.
+Fixture* g_fixture;
+std::atomic<int> g_threads_done{0};
+
+void SetUp(const benchmark::State& state, bool with_server,
+           const char* lb_policy) {
+  if (state.thread_index() == 0) {
+    g_fixture = new Fixture(with_server, lb_policy);
+  }
+}
+
+void TearDown(const benchmark::State& state) {
+  if (g_threads_done.fetch_add(1) + 1 != state.threads()) return;
+  g_threads_done.store(0);
+  delete g_fixture;
+}
+
+// Starts a call that sends its initial metadata, so that it is picked, and
+// waits for its status. If cancel is set, the call is cancelled right after
+// it is started, since nothing on the server answers it.
+grpc_status_code RunCall(grpc_completion_queue* cq, bool cancel) {
+  grpc_call* call = grpc_channel_create_call(
+      g_fixture->channel(), nullptr, GRPC_PROPAGATE_DEFAULTS, cq,
+      grpc_slice_from_static_string("/foo/bar"), nullptr,
+      gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  grpc_metadata_array trailing_metadata_recv;
+  grpc_metadata_array_init(&trailing_metadata_recv);
+  grpc_status_code status;
+  grpc_slice details;
+  grpc_op ops[2];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[1].data.recv_status_on_client.trailing_metadata =
+      &trailing_metadata_recv;
+  ops[1].data.recv_status_on_client.status = &status;
+  ops[1].data.recv_status_on_client.status_details = &details;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(call, ops, 2, Tag(1), nullptr));
+  if (cancel) grpc_call_cancel(call, nullptr);
+  grpc_event ev = grpc_completion_queue_next(
+      cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  GPR_ASSERT(ev.type == GRPC_OP_COMPLETE && ev.tag == Tag(1));
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&trailing_metadata_recv);
+  grpc_call_unref(call);
+  return status;
+}
+
+void DestroyCq(grpc_completion_queue* cq) {
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+// Picks complete, and the call is then cancelled.
+void BM_PickComplete(benchmark::State& state, const char* lb_policy) {
+  SetUp(state, /*with_server=*/true, lb_policy);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  for (auto _ : state) {
+    GPR_ASSERT(RunCall(cq, /*cancel=*/true) == GRPC_STATUS_CANCELLED);
+  }
+  DestroyCq(cq);
+  state.SetItemsProcessed(state.iterations());
+  TearDown(state);
+}
+BENCHMARK_CAPTURE(BM_PickComplete, round_robin, "round_robin")
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(BM_PickComplete, least_request, "least_request")
+    ->ThreadRange(1, 32)
+    ->UseRealTime();
+
+// Picks fail, which fails the call.
+void BM_PickFailFast(benchmark::State& state) {
+  SetUp(state, /*with_server=*/false, "round_robin");
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  for (auto _ : state) {
+    GPR_ASSERT(RunCall(cq, /*cancel=*/false) == GRPC_STATUS_UNAVAILABLE);
+  }
+  DestroyCq(cq);
+  state.SetItemsProcessed(state.iterations());
+  TearDown(state);
+}
+BENCHMARK(BM_PickFailFast)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -0,0 +1,110 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Reserve/release throughput as the number of threads sharing a memory
+// allocator grows. Every call on a channel reserves its arena from the
+// channel's allocator, so this is the contention a busy channel sees.
+
+#include <atomic>
+
+#include <benchmark/benchmark.h>
+
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace {
+
+grpc_core::MemoryQuota* g_quota;
+grpc_core::MemoryOwner* g_allocator;
+
+// The threads of one benchmark run all share the allocator. Thread 0 creates
+// it before the timed loop, which starts once every thread is ready; the last
+// thread to finish destroys it.
+std::atomic<int> g_threads_done{0};
+
+void SetUp(const benchmark::State& state) {
+  if (state.thread_index() != 0) return;
+  g_quota = new grpc_core::MemoryQuota("bm");
+  g_allocator =
+      new grpc_core::MemoryOwner(g_quota->CreateMemoryOwner("bm_allocator"));
+}
+
+void TearDown(const benchmark::State& state) {
+  if (g_threads_done.fetch_add(1) + 1 != state.threads()) return;
+  g_threads_done.store(0);
+  delete g_allocator;
+  delete g_quota;
+}
+
+// Each iteration reserves state.range(0) bytes from the shared allocator and
+// releases them again.
+void BM_MemoryAllocatorReserveRelease(benchmark::State& state) {
+  SetUp(state);
+  const size_t size = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    size_t n = g_allocator->Reserve(grpc_core::MemoryRequest(size));
+    benchmark::DoNotOptimize(n);
+    g_allocator->Release(n);
+  }
+  state.SetItemsProcessed(state.iterations());
+  TearDown(state);
+}
+BENCHMARK(BM_MemoryAllocatorReserveRelease)
+    ->Arg(1024)
+    ->Arg(64 * 1024)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+// Like BM_MemoryAllocatorReserveRelease, but each thread holds a few
+// reservations at once so that releases land on memory other threads took.
+void BM_MemoryAllocatorReserveHoldRelease(benchmark::State& state) {
+  SetUp(state);
+  const size_t size = static_cast<size_t>(state.range(0));
+  constexpr int kHeld = 8;
+  size_t held[kHeld] = {};
+  int next = 0;
+  for (auto _ : state) {
+    if (held[next] != 0) g_allocator->Release(held[next]);
+    held[next] = g_allocator->Reserve(grpc_core::MemoryRequest(size));
+    next = (next + 1) % kHeld;
+  }
+  for (size_t n : held) {
+    if (n != 0) g_allocator->Release(n);
+  }
+  state.SetItemsProcessed(state.iterations());
+  TearDown(state);
+}
+BENCHMARK(BM_MemoryAllocatorReserveHoldRelease)
+    ->Arg(1024)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+
+}  // namespace
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
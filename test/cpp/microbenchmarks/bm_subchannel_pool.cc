@@ -0,0 +1,167 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmark the global subchannel pool with many threads creating and looking
+// up subchannels at once, as happens when thousands of channels are created at
+// startup or re-resolve together.
+
+#include <atomic>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include "src/core/ext/filters/client_channel/global_subchannel_pool.h"
+#include "src/core/ext/filters/client_channel/subchannel.h"
+#include "src/core/lib/address_utils/parse_address.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Number of distinct addresses each benchmark works with.
+constexpr int kAddresses = 1000;
+
+grpc_resolved_address Address(int i) {
+  grpc_resolved_address address;
+  GPR_ASSERT(grpc_parse_ipv4_hostport(
+      absl::StrCat("10.", i / 65536, ".", (i / 256) % 256, ".", i % 256,
+                   ":443"),
+      &address, /*log_errors=*/true));
+  return address;
+}
+
+// Channel args along the lines of what a channel hands its subchannels.
+// Channelz is off so that its registry doesn't dominate creation costs.
+const grpc_channel_args* ChannelArgs() {
+  static const grpc_channel_args* channel_args = [] {
+    grpc_arg args[] = {
+        SubchannelPoolInterface::CreateChannelArg(
+            GlobalSubchannelPool::instance().get()),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_ENABLE_CHANNELZ), 0),
+        grpc_channel_arg_integer_create(
+            const_cast<char*>(GRPC_ARG_KEEPALIVE_TIME_MS), 30000),
+        grpc_channel_arg_string_create(
+            const_cast<char*>(GRPC_ARG_PRIMARY_USER_AGENT_STRING),
+            const_cast<char*>("bm_subchannel_pool")),
+    };
+    return grpc_channel_args_copy_and_add(nullptr, args, GPR_ARRAY_SIZE(args));
+  }();
+  return channel_args;
+}
+
+RefCountedPtr<Subchannel> CreateSubchannel(int i) {
+  return Subchannel::Create(OrphanablePtr<SubchannelConnector>(), Address(i),
+                            ChannelArgs());
+}
+
+// The threads of one benchmark run share a set of registered subchannels.
+// Thread 0 creates them before the timed loop, which starts once every thread
+// is ready; the last thread to finish releases them.
+std::vector<RefCountedPtr<Subchannel>>* g_subchannels;
+std::atomic<int> g_threads_done{0};
+
+void SetUp(const benchmark::State& state) {
+  if (state.thread_index() != 0) return;
+  ExecCtx exec_ctx;
+  g_subchannels = new std::vector<RefCountedPtr<Subchannel>>();
+  for (int i = 0; i < kAddresses; i++) {
+    g_subchannels->push_back(CreateSubchannel(i));
+  }
+}
+
+void TearDown(const benchmark::State& state) {
+  if (g_threads_done.fetch_add(1) + 1 != state.threads()) return;
+  g_threads_done.store(0);
+  ExecCtx exec_ctx;
+  delete g_subchannels;
+}
+
+// Looks up registered subchannels by key.
+void BM_SubchannelPoolFind(benchmark::State& state) {
+  SetUp(state);
+  ExecCtx exec_ctx;
+  RefCountedPtr<GlobalSubchannelPool> pool = GlobalSubchannelPool::instance();
+  std::vector<SubchannelKey> keys;
+  for (int i = 0; i < kAddresses; i++) {
+    keys.emplace_back(Address(i), ChannelArgs());
+  }
+  // Stride through the keys, starting each thread somewhere different.
+  int next = (state.thread_index() * 7919) % kAddresses;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pool->FindSubchannel(keys[next]));
+    next = (next + 7919) % kAddresses;
+  }
+  state.SetItemsProcessed(state.iterations());
+  TearDown(state);
+}
+BENCHMARK(BM_SubchannelPoolFind)->ThreadRange(1, 16)->UseRealTime();
+
+// What a new channel does for each of its addresses: build the key from the
+// channel's args and get the subchannel that is already in the pool.
+void BM_SubchannelCreateExisting(benchmark::State& state) {
+  SetUp(state);
+  ExecCtx exec_ctx;
+  int next = (state.thread_index() * 7919) % kAddresses;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(CreateSubchannel(next));
+    next = (next + 7919) % kAddresses;
+  }
+  state.SetItemsProcessed(state.iterations());
+  TearDown(state);
+}
+BENCHMARK(BM_SubchannelCreateExisting)->ThreadRange(1, 16)->UseRealTime();
+
+// Each thread registers a new subchannel and then drops it, unregistering it,
+// on addresses of its own while the shared ones stay registered.
+void BM_SubchannelCreateRelease(benchmark::State& state) {
+  SetUp(state);
+  ExecCtx exec_ctx;
+  const int first = (state.thread_index() + 1) * kAddresses;
+  int next = 0;
+  for (auto _ : state) {
+    RefCountedPtr<Subchannel> subchannel = CreateSubchannel(first + next);
+    benchmark::DoNotOptimize(subchannel);
+    subchannel.reset();
+    next = (next + 1) % kAddresses;
+  }
+  state.SetItemsProcessed(state.iterations());
+  TearDown(state);
+}
+BENCHMARK(BM_SubchannelCreateRelease)->ThreadRange(1, 16)->UseRealTime();
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
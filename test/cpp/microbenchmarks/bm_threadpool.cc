@@ -17,12 +17,18 @@
  */
 
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
+#include <grpc/support/time.h>
 
+#include "src/core/lib/gpr/time_precise.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/executor/threadpool.h"
 #include "test/core/util/test_config.h"
 #include "test/cpp/microbenchmarks/helpers.h"
@@ -31,6 +37,19 @@
 namespace grpc {
 namespace testing {
 
+// Every thread pool benchmark takes the pool's queue type as its last
+// argument: 0 for the shared FIFO queue, 1 for the work-stealing queue.
+static grpc_core::ThreadPool* NewThreadPool(int num_threads, int64_t queue) {
+  return new grpc_core::ThreadPool(
+      num_threads, "ThreadPoolWorker", grpc_core::Thread::Options(),
+      queue == 0 ? grpc_core::ThreadPool::QueueType::kFifo
+                 : grpc_core::ThreadPool::QueueType::kWorkStealing);
+}
+
+static void QueueTypeLabel(benchmark::State& state, int64_t queue) {
+  state.SetLabel(queue == 0 ? "fifo" : "work_stealing");
+}
+
 // This helper class allows a thread to block for a pre-specified number of
 // actions. BlockingCounter has an initial non-negative count on initialization.
 // Each call to DecrementCount will decrease the count by 1. When making a call
@@ -93,13 +112,20 @@ class AddAnotherFunctor : public grpc_completion_queue_functor {
   int num_add_;
 };
 
+static void ThreadPoolArgs(benchmark::internal::Benchmark* b) {
+  b->Ranges({{524288, 524288}, {1, 1024}, {0, 1}});
+}
+
 template <int kConcurrentFunctor>
 static void ThreadPoolAddAnother(benchmark::State& state) {
   const int num_iterations = state.range(0);
   const int num_threads = state.range(1);
   // Number of adds done by each closure.
   const int num_add = num_iterations / kConcurrentFunctor;
-  grpc_core::ThreadPool pool(num_threads);
+  std::unique_ptr<grpc_core::ThreadPool> owned_pool(
+      NewThreadPool(num_threads, state.range(2)));
+  grpc_core::ThreadPool& pool = *owned_pool;
+  QueueTypeLabel(state, state.range(2));
   while (state.KeepRunningBatch(num_iterations)) {
     BlockingCounter counter(kConcurrentFunctor);
     for (int i = 0; i < kConcurrentFunctor; ++i) {
@@ -112,21 +138,16 @@ static void ThreadPoolAddAnother(benchmark::State& state) {
 
 // First pair of arguments is range for number of iterations (num_iterations).
 // Second pair of arguments is range for thread pool size (num_threads).
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 1)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 4)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 8)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 16)
-    ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 32)
-    ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 64)
-    ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 128)
-    ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 512)
-    ->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 2048)
-    ->RangePair(524288, 524288, 1, 1024);
+// Third pair of arguments is the queue type.
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 1)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 4)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 8)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 16)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 32)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 64)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 128)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 512)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddAnother, 2048)->Apply(ThreadPoolArgs);
 
 // A functor class that will delete self on end of running.
 class SuicideFunctorForAdd : public grpc_completion_queue_functor {
@@ -156,7 +177,8 @@ static void BM_ThreadPoolExternalAdd(benchmark::State& state) {
   // Setup for each run of test.
   if (thread_idx == 0) {
     const int num_threads = state.range(1);
-    external_add_pool = new grpc_core::ThreadPool(num_threads);
+    external_add_pool = NewThreadPool(num_threads, state.range(2));
+    QueueTypeLabel(state, state.range(2));
   }
   const int num_iterations = state.range(0) / state.threads();
   while (state.KeepRunningBatch(num_iterations)) {
@@ -176,7 +198,8 @@ static void BM_ThreadPoolExternalAdd(benchmark::State& state) {
 BENCHMARK(BM_ThreadPoolExternalAdd)
     // First pair is range for number of iterations (num_iterations).
     // Second pair is range for thread pool size (num_threads).
-    ->RangePair(524288, 524288, 1, 1024)
+    // Third pair is the queue type.
+    ->Apply(ThreadPoolArgs)
     ->ThreadRange(1, 256);  // Concurrent external thread(s) up to 256
 
 // Functor (closure) that adds itself into pool repeatedly. By adding self, the
@@ -216,7 +239,10 @@ static void ThreadPoolAddSelf(benchmark::State& state) {
   const int num_threads = state.range(1);
   // Number of adds done by each closure.
   const int num_add = num_iterations / kConcurrentFunctor;
-  grpc_core::ThreadPool pool(num_threads);
+  std::unique_ptr<grpc_core::ThreadPool> owned_pool(
+      NewThreadPool(num_threads, state.range(2)));
+  grpc_core::ThreadPool& pool = *owned_pool;
+  QueueTypeLabel(state, state.range(2));
   while (state.KeepRunningBatch(num_iterations)) {
     BlockingCounter counter(kConcurrentFunctor);
     for (int i = 0; i < kConcurrentFunctor; ++i) {
@@ -229,15 +255,16 @@ static void ThreadPoolAddSelf(benchmark::State& state) {
 
 // First pair of arguments is range for number of iterations (num_iterations).
 // Second pair of arguments is range for thread pool size (num_threads).
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 1)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 4)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 8)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 16)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 32)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 64)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 128)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 512)->RangePair(524288, 524288, 1, 1024);
-BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 2048)->RangePair(524288, 524288, 1, 1024);
+// Third pair of arguments is the queue type.
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 1)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 4)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 8)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 16)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 32)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 64)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 128)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 512)->Apply(ThreadPoolArgs);
+BENCHMARK_TEMPLATE(ThreadPoolAddSelf, 2048)->Apply(ThreadPoolArgs);
 
 #if defined(__GNUC__) && !defined(SWIG)
 #if defined(__i386__) || defined(__x86_64__)
@@ -297,20 +324,94 @@ static void BM_SpikyLoad(benchmark::State& state) {
   const int kNumSpikes = 1000;
   const int batch_size = 3 * num_threads;
   std::vector<ShortWorkFunctorForAdd> work_vector(batch_size);
-  grpc_core::ThreadPool pool(num_threads);
+  std::unique_ptr<grpc_core::ThreadPool> pool(
+      NewThreadPool(num_threads, state.range(1)));
+  QueueTypeLabel(state, state.range(1));
   while (state.KeepRunningBatch(kNumSpikes * batch_size)) {
     for (int i = 0; i != kNumSpikes; ++i) {
       BlockingCounter counter(batch_size);
       for (auto& w : work_vector) {
         w.counter_ = &counter;
-        pool.Add(&w);
+        pool->Add(&w);
       }
       counter.Wait();
     }
   }
   state.SetItemsProcessed(state.iterations() * batch_size);
 }
-BENCHMARK(BM_SpikyLoad)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Arg(16);
+BENCHMARK(BM_SpikyLoad)->Ranges({{1, 16}, {0, 1}});
+
+// A functor that records when it gets to run.
+class TimestampFunctor : public grpc_completion_queue_functor {
+ public:
+  TimestampFunctor() {
+    functor_run = &TimestampFunctor::Run;
+    inlineable = false;
+    internal_next = this;
+    internal_success = 0;
+  }
+
+  static void Run(grpc_completion_queue_functor* cb, int /*ok*/) {
+    auto* callback = static_cast<TimestampFunctor*>(cb);
+    callback->run_cycle_ = gpr_get_cycle_counter();
+    callback->counter_->DecrementCount();
+  }
+
+  BlockingCounter* counter_ = nullptr;
+  gpr_cycle_counter run_cycle_ = 0;
+};
+
+// Measures how long a closure added to a pool whose workers are all idle
+// takes to start running, i.e. how quickly a worker wakes up. The pause
+// between adds is long enough for the workers to stop spinning and park.
+static void BM_ThreadPoolWakeLatency(benchmark::State& state) {
+  std::unique_ptr<grpc_core::ThreadPool> pool(
+      NewThreadPool(state.range(0), state.range(1)));
+  QueueTypeLabel(state, state.range(1));
+  TimestampFunctor functor;
+  for (auto _ : state) {
+    gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(1));
+    BlockingCounter counter(1);
+    functor.counter_ = &counter;
+    gpr_cycle_counter start = gpr_get_cycle_counter();
+    pool->Add(&functor);
+    counter.Wait();
+    state.SetIterationTime(gpr_timespec_to_micros(gpr_cycle_counter_sub(
+                               functor.run_cycle_, start)) /
+                           1e6);
+  }
+}
+BENCHMARK(BM_ThreadPoolWakeLatency)
+    ->Ranges({{1, 16}, {0, 1}})
+    ->UseManualTime();
+
+// Performs the scenario of an external thread scheduling closures onto the
+// default executor, which keeps its pending closures in a WorkStealingQueue.
+static void BM_ExecutorRun(benchmark::State& state) {
+  const int num_closures = state.range(0);
+  struct Closure {
+    grpc_closure closure;
+    BlockingCounter* counter;
+  };
+  std::vector<Closure> closures(num_closures);
+  while (state.KeepRunningBatch(num_closures)) {
+    grpc_core::ExecCtx exec_ctx;
+    BlockingCounter counter(num_closures);
+    for (auto& c : closures) {
+      c.counter = &counter;
+      GRPC_CLOSURE_INIT(
+          &c.closure,
+          [](void* arg, grpc_error_handle /*error*/) {
+            static_cast<Closure*>(arg)->counter->DecrementCount();
+          },
+          &c, nullptr);
+      grpc_core::Executor::Run(&c.closure, GRPC_ERROR_NONE);
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ExecutorRun)->Range(1, 4096);
 
 }  // namespace testing
 }  // namespace grpc
@@ -33,6 +33,7 @@
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/endpoint_pair.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/iomgr/port.h"
 #include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
@@ -151,6 +152,29 @@ class UDS : public FullstackFixture {
   }
 };
 
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+class Shm : public FullstackFixture {
+ public:
+  explicit Shm(Service* service,
+               const FixtureConfiguration& fixture_configuration =
+                   FixtureConfiguration())
+      : FullstackFixture(service, fixture_configuration, MakeAddress(&port_)) {}
+
+  ~Shm() override { grpc_recycle_unused_port(port_); }
+
+ private:
+  int port_;
+
+  static std::string MakeAddress(int* port) {
+    *port = grpc_pick_unused_port_or_die();  // just for a unique id - not a
+                                             // real port
+    std::stringstream addr;
+    addr << "shm:/tmp/bm_fullstack_shm." << *port;
+    return addr.str();
+  }
+};
+#endif  // GRPC_HAVE_SHM_TRANSPORT
+
 class InProcess : public FullstackFixture {
  public:
   explicit InProcess(Service* service,
@@ -324,6 +348,9 @@ class MinStackize : public Base {
 
 typedef MinStackize<TCP> MinTCP;
 typedef MinStackize<UDS> MinUDS;
+#ifdef GRPC_HAVE_SHM_TRANSPORT
+typedef MinStackize<Shm> MinShm;
+#endif
 typedef MinStackize<InProcess> MinInProcess;
 typedef MinStackize<SockPair> MinSockPair;
 typedef MinStackize<InProcessCHTTP2> MinInProcessCHTTP2;
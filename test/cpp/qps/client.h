@@ -362,8 +362,14 @@ class Client {
         // Closed-loop doesn't use random dist at all
         break;
       case LoadParams::kPoisson:
-        random_dist = absl::make_unique<ExpDist>(load.poisson().offered_load() /
-                                                 num_threads);
+        if (load.poisson().mean_burst_size() > 1) {
+          random_dist = absl::make_unique<BurstyExpDist>(
+              load.poisson().offered_load() / num_threads,
+              load.poisson().mean_burst_size());
+        } else {
+          random_dist = absl::make_unique<ExpDist>(
+              load.poisson().offered_load() / num_threads);
+        }
         break;
       default:
         GPR_ASSERT(false);
@@ -67,6 +67,32 @@ class ExpDist final : public RandomDistInterface {
   double lambda_recip_;
 };
 
+// BurstyExpDist implements the interarrival distribution of a compound
+// Poisson process: bursts arrive as a Poisson process with rate
+// lambda/burst_size, and each burst brings a geometrically distributed number
+// of arrivals (mean burst_size) at once. The mean rate of arrivals is still
+// lambda, but they come in clumps, as they do when many clients react to the
+// same event.
+
+class BurstyExpDist final : public RandomDistInterface {
+ public:
+  BurstyExpDist(double lambda, double burst_size)
+      : new_burst_prob_(1.0 / burst_size),
+        burst_lambda_recip_(burst_size / lambda) {}
+  ~BurstyExpDist() override {}
+  double transform(double uni) const override {
+    // The lowest 1-1/burst_size of the range continues the current burst;
+    // the rest is rescaled to [0,1) and picks the gap to the next burst.
+    const double burst_uni = uni - (1.0 - new_burst_prob_);
+    if (burst_uni < 0) return 0;
+    return burst_lambda_recip_ * (-log(1.0 - burst_uni / new_burst_prob_));
+  }
+
+ private:
+  double new_burst_prob_;
+  double burst_lambda_recip_;
+};
+
 // A class library for generating pseudo-random interarrival times
 // in an efficient re-entrant way. The random table is built at construction
 // time, and each call must include the thread id of the invoker
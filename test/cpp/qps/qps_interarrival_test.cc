@@ -49,6 +49,7 @@ static void RunTest(RandomDistInterface&& r, int threads,
   grpc_histogram_destroy(h);
 }
 
+using grpc::testing::BurstyExpDist;
 using grpc::testing::ExpDist;
 
 int main(int argc, char** argv) {
@@ -56,5 +57,7 @@ int main(int argc, char** argv) {
   grpc::testing::InitTest(&argc, &argv, true);
 
   RunTest(ExpDist(10.0), 5, std::string("Exponential(10)"));
+  RunTest(BurstyExpDist(10.0, 4.0), 5,
+          std::string("Bursty exponential(10, mean burst 4)"));
   return 0;
 }
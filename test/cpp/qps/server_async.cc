@@ -16,12 +16,20 @@
  *
  */
 
+#include <grpc/support/port_platform.h>
+
+#ifdef GPR_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include <algorithm>
 #include <forward_list>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include <grpc/grpc.h>
 #include <grpc/support/alloc.h>
@@ -44,6 +52,46 @@
 namespace grpc {
 namespace testing {
 
+namespace {
+
+// Splits the server's cores into num_cqs contiguous sets. With more queues
+// than cores, queues share cores.
+std::vector<std::vector<int>> PartitionCores(const ServerConfig& config,
+                                             int cores, int num_cqs) {
+  std::vector<int> cpus(config.core_list().begin(), config.core_list().end());
+  if (cpus.empty()) {
+    for (int i = 0; i < cores; i++) cpus.push_back(i);
+  }
+  const int n = static_cast<int>(cpus.size());
+  std::vector<std::vector<int>> sets(num_cqs);
+  for (int j = 0; j < num_cqs; j++) {
+    if (num_cqs >= n) {
+      sets[j].push_back(cpus[j % n]);
+    } else {
+      sets[j].assign(cpus.begin() + j * n / num_cqs,
+                     cpus.begin() + (j + 1) * n / num_cqs);
+    }
+  }
+  return sets;
+}
+
+void PinCurrentThread(const std::vector<int>& cpus) {
+#ifdef GPR_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+    gpr_log(GPR_ERROR, "Server: failed to pin thread to its queue's cores");
+  }
+#else
+  (void)cpus;
+#endif
+}
+
+}  // namespace
+
 template <class RequestType, class ResponseType, class ServiceType,
           class ServerContextType>
 class AsyncQpsServerTest final : public grpc::testing::Server {
@@ -106,6 +154,10 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
     for (int i = 0; i < num_threads; i++) {
       cq_.emplace_back(i % srv_cqs_.size());
     }
+    if (config.cq_core_affinity()) {
+      cq_cpus_ = PartitionCores(config, cores(), num_cqs);
+      builder->experimental().SetCompletionQueueCpuSets(cq_cpus_);
+    }
 
     ApplyConfigToBuilder(config, builder.get());
 
@@ -204,6 +256,7 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
 
  private:
   void ThreadFunc(int thread_idx) {
+    if (!cq_cpus_.empty()) PinCurrentThread(cq_cpus_[cq_[thread_idx]]);
     // Wait until work is available or we are shutting down
     bool ok;
     void* got_tag;
@@ -524,6 +577,8 @@ class AsyncQpsServerTest final : public grpc::testing::Server {
   std::unique_ptr<grpc::Server> server_;
   std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> srv_cqs_;
   std::vector<int> cq_;
+  // CPUs each completion queue is bound to; empty unless cq_core_affinity.
+  std::vector<std::vector<int>> cq_cpus_;
   ServiceType async_service_;
   std::vector<std::unique_ptr<ServerRpcContext>> contexts_;
 
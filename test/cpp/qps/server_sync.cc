@@ -167,6 +167,11 @@ class SynchronousServer final : public grpc::testing::Server {
     }
 
     ApplyConfigToBuilder(config, builder.get());
+    if (config.sync_server_worker_threads() > 0) {
+      builder->SetSyncServerOption(
+          ServerBuilder::SyncServerOption::WORKER_THREADS,
+          config.sync_server_worker_threads());
+    }
 
     builder->RegisterService(&service_);
 
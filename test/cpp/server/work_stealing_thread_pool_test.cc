@@ -0,0 +1,106 @@
+// Copyright 2022 The gRPC Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/cpp/server/work_stealing_thread_pool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "absl/synchronization/notification.h"
+
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace {
+
+TEST(WorkStealingThreadPoolTest, CanRunCallback) {
+  WorkStealingThreadPool p(1);
+  absl::Notification n;
+  p.Add([&n] { n.Notify(); });
+  n.WaitForNotification();
+}
+
+TEST(WorkStealingThreadPoolTest, DestructorRunsPendingCallbacks) {
+  std::atomic<int> count{0};
+  {
+    WorkStealingThreadPool p(2);
+    for (int i = 0; i < 1000; ++i) {
+      p.Add([&count] { count.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(WorkStealingThreadPoolTest, IdleWorkersStealFromBusyOnes) {
+  WorkStealingThreadPool p(2);
+  absl::Notification release;
+  absl::Notification blocked;
+  absl::Notification done;
+  // Callbacks are placed round-robin, so the third one lands on the same
+  // queue as the first. While one worker is blocked, the other has to run
+  // whatever is queued for it.
+  p.Add([&] {
+    blocked.Notify();
+    release.WaitForNotification();
+  });
+  p.Add([] {});
+  blocked.WaitForNotification();
+  p.Add([&done] { done.Notify(); });
+  done.WaitForNotification();
+  release.Notify();
+}
+
+TEST(WorkStealingThreadPoolTest, CallbacksCanAddMoreWork) {
+  std::atomic<int> count{0};
+  {
+    WorkStealingThreadPool p(4);
+    for (int i = 0; i < 10; ++i) {
+      p.Add([&p, &count] {
+        for (int j = 0; j < 100; ++j) {
+          p.Add([&count] { count.fetch_add(1); });
+        }
+      });
+    }
+  }
+  EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(WorkStealingThreadPoolTest, ManyThreadsCanAddConcurrently) {
+  std::atomic<int> count{0};
+  {
+    WorkStealingThreadPool p(4);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&p, &count] {
+        for (int j = 0; j < 1000; ++j) {
+          p.Add([&count] { count.fetch_add(1); });
+        }
+      });
+    }
+    for (auto& t : threads) t.join();
+  }
+  EXPECT_EQ(count.load(), 8000);
+}
+
+}  // namespace
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -30,6 +30,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_server_calls_created"] = massage_qps_stats_helpers.counter(
                     core_stats, "server_calls_created")
+            stats[
+                "core_call_arena_zone_spills"] = massage_qps_stats_helpers.counter(
+                    core_stats, "call_arena_zone_spills")
             stats["core_cqs_created"] = massage_qps_stats_helpers.counter(
                 core_stats, "cqs_created")
             stats[
@@ -75,6 +78,8 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_tcp_backup_poller_polls"] = massage_qps_stats_helpers.counter(
                     core_stats, "tcp_backup_poller_polls")
+            stats["core_tcp_write_more"] = massage_qps_stats_helpers.counter(
+                core_stats, "tcp_write_more")
             stats["core_http2_op_batches"] = massage_qps_stats_helpers.counter(
                 core_stats, "http2_op_batches")
             stats["core_http2_op_cancel"] = massage_qps_stats_helpers.counter(
@@ -114,6 +119,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_partial_writes"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_partial_writes")
+            stats[
+                "core_http2_writes_coalesced"] = massage_qps_stats_helpers.counter(
+                    core_stats, "http2_writes_coalesced")
             stats[
                 "core_http2_initiate_write_due_to_initial_write"] = massage_qps_stats_helpers.counter(
                     core_stats, "http2_initiate_write_due_to_initial_write")
@@ -258,6 +266,15 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_hpack_send_binary_base64"] = massage_qps_stats_helpers.counter(
                     core_stats, "hpack_send_binary_base64")
+            stats[
+                "core_hpack_send_custom_indexed"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_custom_indexed")
+            stats[
+                "core_hpack_send_custom_added"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_custom_added")
+            stats[
+                "core_hpack_send_custom_literal"] = massage_qps_stats_helpers.counter(
+                    core_stats, "hpack_send_custom_literal")
             stats[
                 "core_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(
                     core_stats, "combiner_locks_initiated")
@@ -270,6 +287,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_combiner_locks_offloaded"] = massage_qps_stats_helpers.counter(
                     core_stats, "combiner_locks_offloaded")
+            stats[
+                "core_combiner_locks_offloaded_over_budget"] = massage_qps_stats_helpers.counter(
+                    core_stats, "combiner_locks_offloaded_over_budget")
             stats[
                 "core_call_combiner_locks_initiated"] = massage_qps_stats_helpers.counter(
                     core_stats, "call_combiner_locks_initiated")
@@ -282,6 +302,9 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_call_combiner_cancelled"] = massage_qps_stats_helpers.counter(
                     core_stats, "call_combiner_cancelled")
+            stats[
+                "core_work_serializer_offloaded"] = massage_qps_stats_helpers.counter(
+                    core_stats, "work_serializer_offloaded")
             stats[
                 "core_executor_scheduled_short_items"] = massage_qps_stats_helpers.counter(
                     core_stats, "executor_scheduled_short_items")
@@ -492,6 +515,66 @@ def massage_qps_stats(scenario_result):
             stats[
                 "core_http2_send_flowctl_per_write_99p"] = massage_qps_stats_helpers.percentile(
                     h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "combiner_locks_items_per_hold")
+            stats["core_combiner_locks_items_per_hold"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_locks_items_per_hold_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_locks_items_per_hold_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_locks_items_per_hold_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_locks_items_per_hold_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "combiner_locks_hold_micros")
+            stats["core_combiner_locks_hold_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_combiner_locks_hold_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_combiner_locks_hold_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_combiner_locks_hold_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_combiner_locks_hold_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_items_per_drain")
+            stats["core_work_serializer_items_per_drain"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_items_per_drain_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_items_per_drain_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_items_per_drain_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_items_per_drain_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
+            h = massage_qps_stats_helpers.histogram(
+                core_stats, "work_serializer_drain_micros")
+            stats["core_work_serializer_drain_micros"] = ",".join(
+                "%f" % x for x in h.buckets)
+            stats["core_work_serializer_drain_micros_bkts"] = ",".join(
+                "%f" % x for x in h.boundaries)
+            stats[
+                "core_work_serializer_drain_micros_50p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 50, h.boundaries)
+            stats[
+                "core_work_serializer_drain_micros_95p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 95, h.boundaries)
+            stats[
+                "core_work_serializer_drain_micros_99p"] = massage_qps_stats_helpers.percentile(
+                    h.buckets, 99, h.boundaries)
             h = massage_qps_stats_helpers.histogram(core_stats,
                                                     "server_cqs_checked")
             stats["core_server_cqs_checked"] = ",".join(
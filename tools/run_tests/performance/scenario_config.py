@@ -85,13 +85,15 @@ def _payload_type(use_generic_payload, req_size, resp_size):
     return r
 
 
-def _load_params(offered_load):
+def _load_params(offered_load, mean_burst_size=None):
     r = {}
     if offered_load is None:
         r['closed_loop'] = {}
     else:
         load = {}
         load['offered_load'] = offered_load
+        if mean_burst_size is not None:
+            load['mean_burst_size'] = mean_burst_size
         r['poisson'] = load
     return r
 
@@ -135,7 +137,10 @@ def _ping_pong_scenario(name,
                         messages_per_stream=None,
                         excluded_poll_engines=None,
                         minimal_stack=False,
-                        offered_load=None):
+                        offered_load=None,
+                        mean_burst_size=None,
+                        server_cq_core_affinity=False,
+                        sync_server_worker_threads=0):
     """Creates a basic ping pong scenario."""
     scenario = {
         'name': name,
@@ -168,6 +173,11 @@ def _ping_pong_scenario(name,
     }
     if resource_quota_size:
         scenario['server_config']['resource_quota_size'] = resource_quota_size
+    if server_cq_core_affinity:
+        scenario['server_config']['cq_core_affinity'] = True
+    if sync_server_worker_threads:
+        scenario['server_config'][
+            'sync_server_worker_threads'] = sync_server_worker_threads
     if use_generic_payload:
         if server_type != 'ASYNC_GENERIC_SERVER':
             raise Exception('Use ASYNC_GENERIC_SERVER for generic payload.')
@@ -205,7 +215,8 @@ def _ping_pong_scenario(name,
         scenario['client_config']['async_client_threads'] = 1
         optimization_target = 'latency'
 
-    scenario['client_config']['load_params'] = _load_params(offered_load)
+    scenario['client_config']['load_params'] = _load_params(
+        offered_load, mean_burst_size)
 
     optimization_channel_arg = {
         'name': 'grpc.optimization_target',
@@ -424,6 +435,17 @@ class CXXLanguage(Language):
                 server_threads_per_cq=1000000,
                 categories=inproc_categories + [SCALABLE])
 
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_unary_qps_unconstrained_cq_affinity_%s' %
+                secstr,
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='ASYNC_SERVER',
+                unconstrained_client='async',
+                secure=secure,
+                server_cq_core_affinity=True,
+                categories=[SWEEP])
+
             yield _ping_pong_scenario(
                 'cpp_generic_async_streaming_qps_one_server_core_%s' % secstr,
                 rpc_type='STREAMING',
@@ -448,6 +470,25 @@ class CXXLanguage(Language):
                 categories=smoketest_categories + inproc_categories +
                 [SCALABLE])
 
+            # Open-loop load arriving in bursts (16 RPCs on average), to
+            # compare sync server tail latency with pollers running handlers
+            # against pollers handing RPCs to a fixed work-stealing pool.
+            for worker_threads in [0, 16]:
+                yield _ping_pong_scenario(
+                    'cpp_protobuf_async_client_sync_server_unary_bursty_%s_%s'
+                    % ('work_stealing' if worker_threads else 'thread_manager',
+                       secstr),
+                    rpc_type='UNARY',
+                    client_type='ASYNC_CLIENT',
+                    server_type='SYNC_SERVER',
+                    unconstrained_client='async',
+                    offered_load=20000,
+                    mean_burst_size=16,
+                    sync_server_worker_threads=worker_threads,
+                    secure=secure,
+                    minimal_stack=not secure,
+                    categories=[SWEEP])
+
             yield _ping_pong_scenario(
                 'cpp_protobuf_async_client_unary_1channel_64wide_128Breq_8MBresp_%s'
                 % (secstr),